@@ -0,0 +1,228 @@
+/**
+ * @file account_bloom.c
+ * @brief This file contains the implementation of the Bloom filter placed in front of the hash index.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdlib.h>             /* For malloc(), free() */
+#include <string.h>             /* For memset() */
+#include <math.h>               /* For log() */
+#include "account_key.h"        /* For Account_Key_Hash() */
+#include "account_bloom.h"      /* Include header file of this function file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BLOOM_CACHE_LINE        64U                     /* Alignment of the blocks */
+#define BLOOM_BIT_SHIFT         55U                     /* The top 9 bits of a mixed value are a position in a block */
+#define BLOOM_MIX               0x9E3779B97F4A7C15ULL   /* Spreads the hash again for each bit position */
+#define BLOOM_LN2               0.69314718055994531     /* Natural logarithm of 2 */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Find the block of a key and the value its bit positions are drawn from.
+ *
+ * The index uses the low bits of the hash, so the block is taken from the high bits.
+ * Each bit position is the top bits of the value, which is multiplied by an odd
+ * constant before the next one, so every position depends on the whole hash.
+ *
+ * @param bloom The filter, built.
+ * @param key The key.
+ * @param bits Output, the value of the first bit position.
+ * @return The block of the key.
+ */
+static Bloom_Block_t* Bloom_Locate(const Bloom_t* bloom, uint64_t key, uint64_t* bits)
+{
+    uint64_t hash = Account_Key_Hash(key);      /* Hash of the key */
+
+    *bits = hash * BLOOM_MIX;
+
+    return &bloom->blocks[(hash >> 32) & bloom->block_mask];
+}
+
+/**
+ * @brief Allocate an empty filter.
+ *
+ * The size is chosen so that the filter holding capacity keys answers "maybe present"
+ * for an absent key with about the given rate. The previous bits are dropped, the
+ * counters are kept.
+ *
+ * @param bloom The filter.
+ * @param capacity The number of keys the filter is built for.
+ * @param rate The false-positive rate at the capacity, between 0 and 1.
+ * @return 1 if the filter is built, 0 if memory allocation failed. In that case the
+ *         filter is not built and lets every key through.
+ */
+int32_t Bloom_Build(Bloom_t* bloom, uint64_t capacity, double rate)
+{
+    double bits_per_key = 0.0;      /* Bits of the filter per key */
+    uint64_t blocks = 1U;           /* Number of blocks, a power of 2 */
+    uint64_t needed = 0;            /* Number of blocks for the capacity */
+
+    Bloom_Free(bloom);
+    capacity = (capacity < BLOOM_MIN_KEYS) ? BLOOM_MIN_KEYS : capacity;
+
+    /* An ideal filter needs -ln(rate) / ln(2)^2 bits per key and ln(2) hashes per bit */
+    bits_per_key = -log(rate) / (BLOOM_LN2 * BLOOM_LN2);
+    bloom->hashes = (uint32_t)(bits_per_key * BLOOM_LN2 + 0.5);
+    bloom->hashes = (bloom->hashes < 1U) ? 1U : ((bloom->hashes > BLOOM_MAX_HASHES) ? BLOOM_MAX_HASHES : bloom->hashes);
+
+    needed = (uint64_t)((double)capacity * bits_per_key / (double)BLOOM_BLOCK_BITS) + 1U;
+    while (blocks < needed)
+    {
+        blocks *= 2U;
+    }
+
+    /* Allocate one extra cache line so the array can be aligned */
+    bloom->memory = malloc((size_t)blocks * sizeof(Bloom_Block_t) + BLOOM_CACHE_LINE);
+    if (bloom->memory != NULL)
+    {
+        bloom->blocks = (Bloom_Block_t*)(((uintptr_t)bloom->memory + BLOOM_CACHE_LINE - 1U)
+                                         & ~(uintptr_t)(BLOOM_CACHE_LINE - 1U));
+        memset(bloom->blocks, 0, (size_t)blocks * sizeof(Bloom_Block_t));
+        bloom->block_mask = blocks - 1U;
+        bloom->capacity = capacity;
+        bloom->stats.rebuilds++;
+    }
+
+    return (bloom->memory != NULL) ? 1 : 0;
+}
+
+/**
+ * @brief Add a key to the filter.
+ *
+ * Nothing is done when the filter is not built.
+ *
+ * @param bloom The filter.
+ * @param key The key.
+ */
+void Bloom_Add(Bloom_t* bloom, uint64_t key)
+{
+    Bloom_Block_t* block = NULL;    /* Block of the key */
+    uint64_t bits = 0;              /* Source of the current bit position */
+    uint32_t bit = 0;               /* Position of the current bit */
+    uint32_t i = 0;                 /* Hash counter */
+
+    if (bloom->blocks != NULL)
+    {
+        block = Bloom_Locate(bloom, key, &bits);
+        for (i = 0; i < bloom->hashes; i++)
+        {
+            bit = (uint32_t)(bits >> BLOOM_BIT_SHIFT);
+            /* Only the owner writes, so a plain load and store set the bit without a locked instruction */
+            atomic_store_explicit(&block->words[bit >> 6],
+                                  atomic_load_explicit(&block->words[bit >> 6], memory_order_relaxed) |
+                                  (1ULL << (bit & 63U)), memory_order_relaxed);
+            bits *= BLOOM_MIX;
+        }
+        bloom->added++;
+    }
+}
+
+/**
+ * @brief Check if a key may have been added to the filter.
+ *
+ * @param bloom The filter.
+ * @param key The key.
+ * @return 0 if the key was never added, 1 if it may have been or the filter is not built.
+ */
+int32_t Bloom_May_Contain(Bloom_t* bloom, uint64_t key)
+{
+    int32_t maybe = 1;              /* Cleared when the filter rules the key out */
+
+    if (bloom->blocks != NULL)
+    {
+        maybe = Bloom_Test(bloom, key);
+        bloom->stats.queries++;
+        bloom->stats.negatives += (maybe == 0) ? 1U : 0U;
+    }
+
+    return maybe;
+}
+
+/**
+ * @brief Check if a key may have been added to a built filter, without counting the lookup.
+ *
+ * Any thread may call it while the owner adds keys; a key whose addition finished
+ * before the call started is always reported.
+ *
+ * @param bloom The filter, built.
+ * @param key The key.
+ * @return 0 if the key was never added, 1 if it may have been.
+ */
+int32_t Bloom_Test(const Bloom_t* bloom, uint64_t key)
+{
+    int32_t maybe = 1;              /* Cleared by the first bit that is not set */
+    const Bloom_Block_t* block;     /* Block of the key */
+    uint64_t bits = 0;              /* Source of the current bit position */
+    uint32_t bit = 0;               /* Position of the current bit */
+    uint32_t i = 0;                 /* Hash counter */
+
+    block = Bloom_Locate(bloom, key, &bits);
+    for (i = 0; (i < bloom->hashes) && maybe; i++)
+    {
+        bit = (uint32_t)(bits >> BLOOM_BIT_SHIFT);
+        maybe = (int32_t)((atomic_load_explicit(&block->words[bit >> 6], memory_order_relaxed) >> (bit & 63U)) & 1U);
+        bits *= BLOOM_MIX;
+    }
+
+    return maybe;
+}
+
+/**
+ * @brief Start loading the block of a key into the cache.
+ *
+ * @param bloom The filter.
+ * @param key The key about to be checked.
+ */
+void Bloom_Prefetch(const Bloom_t* bloom, uint64_t key)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    uint64_t bits = 0;              /* Unused, filled by Bloom_Locate() */
+
+    if (bloom->blocks != NULL)
+    {
+        __builtin_prefetch(Bloom_Locate(bloom, key, &bits), 0, 1);
+    }
+#else
+    (void)bloom;
+    (void)key;
+#endif
+}
+
+/**
+ * @brief Check if the filter should be rebuilt from the live keys.
+ *
+ * It should once more keys were added than it was built for, or once the removed keys
+ * are a quarter of the keys added.
+ *
+ * @param bloom The filter.
+ * @return 1 if the filter is built and should be rebuilt, 0 if not.
+ */
+int32_t Bloom_Should_Rebuild(const Bloom_t* bloom)
+{
+    return (bloom->blocks != NULL && (bloom->added > bloom->capacity || bloom->removed * 4U > bloom->added)) ? 1 : 0;
+}
+
+/**
+ * @brief Release the memory of the filter. The counters are kept.
+ *
+ * @param bloom The filter.
+ */
+void Bloom_Free(Bloom_t* bloom)
+{
+    free(bloom->memory);
+    bloom->memory = NULL;
+    bloom->blocks = NULL;
+    bloom->block_mask = 0;
+    bloom->capacity = 0;
+    bloom->added = 0;
+    bloom->removed = 0;
+} /* EOF */
@@ -0,0 +1,157 @@
+/**
+ * @file account_bloom.h
+ * @brief This file contains the declarations of the Bloom filter placed in front of the hash index.
+ *
+ * The filter is blocked: the hash of a key selects one 64-byte block and every bit of
+ * the key is set inside that block, so a lookup reads a single cache line. When any of
+ * those bits is clear the key was never added and the index does not have to be probed.
+ *
+ * A plain Bloom filter cannot forget a key. Removed accounts keep their bits until the
+ * filter is rebuilt from the live accounts, which the owner does once the removals or
+ * the additions since the last build make the filter too loose.
+ *
+ * Only the owner adds keys, but the bits are read and written as relaxed atomics, so
+ * other threads may test a built filter with Bloom_Test() while the owner adds to it.
+ * Bloom_May_Contain() also counts the lookups in the filter and is for the owner only.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include <stdatomic.h>          /* For the bits tested by other threads */
+
+#ifndef ACCOUNT_BLOOM_H
+#define ACCOUNT_BLOOM_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BLOOM_BLOCK_WORDS       8U      /* 64-bit words in one 64-byte block */
+#define BLOOM_BLOCK_BITS        512U    /* Bits in one block */
+#define BLOOM_MIN_KEYS          1024U   /* Smallest number of keys a filter is built for */
+#define BLOOM_MAX_HASHES        16U     /* Largest number of bits set per key */
+#define BLOOM_DEFAULT_RATE      0.01    /* False-positive rate of a filter at its capacity */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for a block of the filter, one cache line.
+ */
+typedef struct
+{
+    _Atomic uint64_t words[BLOOM_BLOCK_WORDS];  /* The bits of the block. */
+} Bloom_Block_t;
+
+/**
+ * @brief Structure for the counters of the filter.
+ */
+typedef struct
+{
+    uint64_t queries;           /* Lookups that asked the filter. */
+    uint64_t negatives;         /* Lookups answered "not present" by the filter alone. */
+    uint64_t false_positives;   /* Lookups the filter let through for an absent key, counted by the owner. */
+    uint64_t rebuilds;          /* Times the filter was built. */
+    uint64_t shared_queries;    /* Concurrent searches that asked the filter, counted by the owner of the filter. */
+    uint64_t shared_negatives;  /* Concurrent searches answered "not present" by the filter alone. */
+    uint64_t shared_false_positives;    /* Concurrent searches the filter let through for an absent key. */
+} Bloom_Stats_t;
+
+/**
+ * @brief Structure for the filter.
+ *
+ * A zero-initialized structure is a valid filter that is not built yet and lets every
+ * key through.
+ */
+typedef struct
+{
+    void* memory;               /* Memory block returned by malloc(), used to free the blocks. */
+    Bloom_Block_t* blocks;      /* Cache-line aligned array of blocks, NULL if the filter is not built. */
+    uint64_t block_mask;        /* Number of blocks minus one, the number of blocks is a power of 2. */
+    uint32_t hashes;            /* Number of bits set per key. */
+    uint64_t capacity;          /* Number of keys the filter was built for. */
+    uint64_t added;             /* Number of keys added since the filter was built. */
+    uint64_t removed;           /* Number of keys removed from the owner since the filter was built. */
+    Bloom_Stats_t stats;        /* Counters of the filter. */
+} Bloom_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Allocate an empty filter.
+ *
+ * The size is chosen so that the filter holding capacity keys answers "maybe present"
+ * for an absent key with about the given rate. The previous bits are dropped, the
+ * counters are kept.
+ *
+ * @param bloom The filter.
+ * @param capacity The number of keys the filter is built for.
+ * @param rate The false-positive rate at the capacity, between 0 and 1.
+ * @return 1 if the filter is built, 0 if memory allocation failed. In that case the
+ *         filter is not built and lets every key through.
+ */
+int32_t Bloom_Build(Bloom_t* bloom, uint64_t capacity, double rate);
+
+/**
+ * @brief Add a key to the filter.
+ *
+ * Nothing is done when the filter is not built.
+ *
+ * @param bloom The filter.
+ * @param key The key.
+ */
+void Bloom_Add(Bloom_t* bloom, uint64_t key);
+
+/**
+ * @brief Check if a key may have been added to the filter.
+ *
+ * @param bloom The filter.
+ * @param key The key.
+ * @return 0 if the key was never added, 1 if it may have been or the filter is not built.
+ */
+int32_t Bloom_May_Contain(Bloom_t* bloom, uint64_t key);
+
+/**
+ * @brief Check if a key may have been added to a built filter, without counting the lookup.
+ *
+ * Any thread may call it while the owner adds keys; a key whose addition finished
+ * before the call started is always reported.
+ *
+ * @param bloom The filter, built.
+ * @param key The key.
+ * @return 0 if the key was never added, 1 if it may have been.
+ */
+int32_t Bloom_Test(const Bloom_t* bloom, uint64_t key);
+
+/**
+ * @brief Start loading the block of a key into the cache.
+ *
+ * @param bloom The filter.
+ * @param key The key about to be checked.
+ */
+void Bloom_Prefetch(const Bloom_t* bloom, uint64_t key);
+
+/**
+ * @brief Check if the filter should be rebuilt from the live keys.
+ *
+ * It should once more keys were added than it was built for, or once the removed keys
+ * are a quarter of the keys added.
+ *
+ * @param bloom The filter.
+ * @return 1 if the filter is built and should be rebuilt, 0 if not.
+ */
+int32_t Bloom_Should_Rebuild(const Bloom_t* bloom);
+
+/**
+ * @brief Release the memory of the filter. The counters are kept.
+ *
+ * @param bloom The filter.
+ */
+void Bloom_Free(Bloom_t* bloom);
+
+#endif /* ACCOUNT_BLOOM_H */
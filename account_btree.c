@@ -0,0 +1,905 @@
+/**
+ * @file account_btree.c
+ * @brief This file contains the implementation of the ordered index of the accounts.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdlib.h>             /* For malloc(), free() */
+#include <string.h>             /* For memcpy(), memmove() */
+#include <sched.h>              /* For sched_yield() */
+#include "account_btree.h"      /* Include header file of this function file */
+#include "account_epoch.h"      /* For the records given up while a reader pins them */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BTREE_LEAF_MIN          (BTREE_LEAF_KEYS / 2U)      /* Fewest keys of a leaf that is not the root */
+#define BTREE_INNER_MIN         (BTREE_INNER_KEYS / 2U)     /* Fewest separators of an inner node that is not the root */
+#define BTREE_LEAF_SPLIT        ((BTREE_LEAF_KEYS + 1U) / 2U)   /* Keys left in a leaf that splits */
+#define BTREE_INNER_SPLIT       ((BTREE_INNER_KEYS + 1U) / 2U)  /* Separators left in an inner node that splits */
+
+/* Leaves and inner nodes share one allocation size, so a spare node can become either */
+_Static_assert(sizeof(Btree_Leaf_t) == sizeof(Btree_Inner_t), "leaves and inner nodes must have the same size");
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Find the first key that is not smaller than a given key.
+ *
+ * @param keys The keys, in increasing order.
+ * @param count The number of keys.
+ * @param key The key.
+ * @return The position of the first key not smaller than key, count if there is none.
+ */
+static uint32_t Btree_Lower_Bound(const uint64_t* keys, uint32_t count, uint64_t key)
+{
+    uint32_t low = 0;           /* First candidate */
+    uint32_t high = count;      /* One past the last candidate */
+    uint32_t middle = 0;        /* Middle candidate */
+
+    while (low < high)
+    {
+        middle = (low + high) / 2U;
+        if (keys[middle] < key)
+        {
+            low = middle + 1U;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * @brief Find the child of an inner node whose subtree may hold a key.
+ *
+ * @param inner The inner node.
+ * @param key The key.
+ * @return The number of separators not larger than key, which is the child to follow.
+ */
+static uint32_t Btree_Child_Index(const Btree_Inner_t* inner, uint64_t key)
+{
+    uint32_t i = Btree_Lower_Bound(inner->keys, inner->node.count, key);    /* First separator not smaller than key */
+
+    /* A key equal to a separator is in the subtree on its right */
+    if (i < inner->node.count && inner->keys[i] == key)
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Allocate spare nodes until the tree holds a given number of them.
+ *
+ * @param tree The tree.
+ * @param count The number of spare nodes, at most BTREE_MAX_SPARES.
+ * @return 1 if the tree holds them, 0 if memory allocation failed.
+ */
+static int32_t Btree_Reserve(Btree_t* tree, uint32_t count)
+{
+    int32_t result = 1;         /* Result of the allocations */
+    Btree_Node_t* node = NULL;  /* A new node */
+
+    while (result == 1 && tree->spares < count)
+    {
+        node = (Btree_Node_t*)malloc(sizeof(Btree_Inner_t));
+        if (node == NULL)
+        {
+            result = 0;
+        }
+        else
+        {
+            tree->spare[tree->spares] = node;
+            tree->spares++;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Take one of the nodes allocated ahead by Btree_Reserve().
+ *
+ * @param tree The tree.
+ * @return The node, referred to once.
+ */
+static Btree_Node_t* Btree_Take_Spare(Btree_t* tree)
+{
+    tree->spares--;
+    atomic_store_explicit(&tree->spare[tree->spares]->refs, 1U, memory_order_relaxed);
+    return tree->spare[tree->spares];
+}
+
+/**
+ * @brief Give back a node of the tree that nothing else refers to.
+ *
+ * The node is kept as a spare for a later change if there is room, freed if not.
+ *
+ * @param tree The tree.
+ * @param node The node.
+ */
+static void Btree_Release(Btree_t* tree, Btree_Node_t* node)
+{
+    if (tree->spares < BTREE_MAX_SPARES)
+    {
+        tree->spare[tree->spares] = node;
+        tree->spares++;
+    }
+    else
+    {
+        free(node);
+    }
+}
+
+/**
+ * @brief Drop a reference to a subtree, freeing the nodes nothing refers to any more.
+ *
+ * It may run in any thread, so the nodes are freed rather than kept as spares.
+ *
+ * @param node The root of the subtree.
+ */
+static void Btree_Unref(Btree_Node_t* node)
+{
+    uint32_t i = 0;             /* Child counter */
+
+    if (atomic_fetch_sub_explicit(&node->refs, 1U, memory_order_acq_rel) == 1U)
+    {
+        if (!node->leaf)
+        {
+            for (i = 0; i <= node->count; i++)
+            {
+                Btree_Unref(((Btree_Inner_t*)node)->children[i]);
+            }
+        }
+        free(node);
+    }
+}
+
+/**
+ * @brief Release a published record no thread can pin any more, with its reference to the root.
+ *
+ * @param block The record.
+ */
+static void Btree_Version_Release(void* block)
+{
+    Btree_Version_t* version = (Btree_Version_t*)block;     /* The record */
+
+    if (version->root != NULL)
+    {
+        Btree_Unref(version->root);
+    }
+    free(version);
+}
+
+/**
+ * @brief Stop publishing the tree, leaving its record to the pins in progress.
+ *
+ * A reader may still hold the record it loaded, so the last reference retires it.
+ *
+ * @param tree The tree.
+ */
+static void Btree_Unpublish(Btree_t* tree)
+{
+    Btree_Version_t* version = atomic_load_explicit(&tree->published, memory_order_relaxed);   /* The record */
+
+    if (version != NULL)
+    {
+        atomic_store_explicit(&tree->published, NULL, memory_order_release);
+        if (atomic_fetch_sub_explicit(&version->refs, 1U, memory_order_acq_rel) == 1U)
+        {
+            Epoch_Retire(version, Btree_Version_Release);
+        }
+    }
+}
+
+/**
+ * @brief Close the published record of the tree before a change.
+ *
+ * Once closed, no thread can pin the record, which gives its reference to the root up,
+ * so the nodes only the tree refers to are changed in place. A record a reader is
+ * pinning is given up instead, and its nodes are copied by the change.
+ *
+ * @param tree The tree.
+ */
+static void Btree_Close(Btree_t* tree)
+{
+    Btree_Version_t* version = atomic_load_explicit(&tree->published, memory_order_relaxed);   /* The record */
+    uint32_t open = 1U;         /* References of a record no reader is pinning */
+
+    if (version != NULL && atomic_compare_exchange_strong_explicit(&version->refs, &open, 0U, memory_order_acquire,
+                                                                   memory_order_relaxed))
+    {
+        if (version->root != NULL)
+        {
+            Btree_Unref(version->root);
+        }
+    }
+    else
+    {
+        Btree_Unpublish(tree);
+    }
+}
+
+/**
+ * @brief Make a node of the tree writable, copying it if a version still shares it.
+ *
+ * The copy takes a reference to every child, and the shared node loses the reference
+ * of the tree. The parent must already be writable.
+ *
+ * @param tree The tree, holding a spare node for the copy.
+ * @param link The pointer to the node in its parent, or the root of the tree.
+ * @return The writable node.
+ */
+static Btree_Node_t* Btree_Own(Btree_t* tree, Btree_Node_t** link)
+{
+    Btree_Node_t* node = *link;     /* The node */
+    Btree_Node_t* copy = NULL;      /* Copy of a shared node */
+    uint32_t i = 0;                 /* Child counter */
+
+    /* Only the thread changing the tree adds references, the readers only to the root of an
+       open record, which a change closes first, so a node referred to once stays ours */
+    if (atomic_load_explicit(&node->refs, memory_order_acquire) > 1U)
+    {
+        copy = Btree_Take_Spare(tree);
+        copy->count = node->count;
+        copy->leaf = node->leaf;
+        memcpy((uint8_t*)copy + sizeof(Btree_Node_t), (const uint8_t*)node + sizeof(Btree_Node_t),
+               sizeof(Btree_Inner_t) - sizeof(Btree_Node_t));
+        if (!node->leaf)
+        {
+            for (i = 0; i <= node->count; i++)
+            {
+                atomic_fetch_add_explicit(&((Btree_Inner_t*)node)->children[i]->refs, 1U, memory_order_relaxed);
+            }
+        }
+        /* A version dropped since the check may leave the tree the last reference */
+        Btree_Unref(node);
+        *link = copy;
+    }
+
+    return *link;
+}
+
+/**
+ * @brief Drop a node taken out of the tree whose children moved to another node.
+ *
+ * A node only the tree refers to is released alone, its children now belong to the other
+ * node. A node a version shares keeps its children, which gain the reference of the other node.
+ *
+ * @param tree The tree.
+ * @param node The node.
+ */
+static void Btree_Drop(Btree_t* tree, Btree_Node_t* node)
+{
+    uint32_t i = 0;             /* Child counter */
+
+    if (atomic_load_explicit(&node->refs, memory_order_acquire) == 1U)
+    {
+        Btree_Release(tree, node);
+    }
+    else
+    {
+        if (!node->leaf)
+        {
+            for (i = 0; i <= node->count; i++)
+            {
+                atomic_fetch_add_explicit(&((Btree_Inner_t*)node)->children[i]->refs, 1U, memory_order_relaxed);
+            }
+        }
+        Btree_Unref(node);
+    }
+}
+
+/**
+ * @brief Insert a key into a subtree.
+ *
+ * @param tree The tree, holding enough spare nodes for every copy and split.
+ * @param link The pointer to the root of the subtree in its parent, which is writable.
+ * @param key The key.
+ * @param separator Output, the smallest key of the new node when the node splits.
+ * @param split Output, the new right node when the node splits, NULL if it does not.
+ * @return 1 if the key is inserted, 0 if it is already in the subtree.
+ */
+static int32_t Btree_Insert_Node(Btree_t* tree, Btree_Node_t** link, uint64_t key, uint64_t* separator,
+                                 Btree_Node_t** split)
+{
+    Btree_Node_t* node = Btree_Own(tree, link); /* The root of the subtree, writable */
+    int32_t result = 1;                         /* Result of the insertion */
+    Btree_Leaf_t* leaf = (Btree_Leaf_t*)node;   /* The node as a leaf */
+    Btree_Inner_t* inner = (Btree_Inner_t*)node;/* The node as an inner node */
+    Btree_Leaf_t* right_leaf = NULL;            /* New leaf of a split */
+    Btree_Inner_t* right_inner = NULL;          /* New inner node of a split */
+    Btree_Node_t* child_split = NULL;           /* New node of a split of the child */
+    uint64_t child_separator = 0;               /* Smallest key of the new node of the child */
+    uint64_t keys[BTREE_LEAF_KEYS + 1U];        /* Keys of a full node and the new key */
+    Btree_Node_t* children[BTREE_INNER_KEYS + 2U];  /* Children of a full inner node and the new child */
+    uint32_t i = 0;                             /* Position of the key or of the child */
+
+    *split = NULL;
+    if (node->leaf)
+    {
+        i = Btree_Lower_Bound(leaf->keys, node->count, key);
+        if (i < node->count && leaf->keys[i] == key)
+        {
+            result = 0;
+        }
+        else if (node->count < BTREE_LEAF_KEYS)
+        {
+            memmove(&leaf->keys[i + 1U], &leaf->keys[i], (size_t)(node->count - i) * sizeof(uint64_t));
+            leaf->keys[i] = key;
+            node->count++;
+        }
+        else
+        {
+            /* Split the full leaf in two halves, the new key included */
+            memcpy(keys, leaf->keys, (size_t)i * sizeof(uint64_t));
+            keys[i] = key;
+            memcpy(&keys[i + 1U], &leaf->keys[i], (size_t)(node->count - i) * sizeof(uint64_t));
+
+            right_leaf = (Btree_Leaf_t*)Btree_Take_Spare(tree);
+            right_leaf->node.leaf = 1U;
+            right_leaf->node.count = BTREE_LEAF_KEYS + 1U - BTREE_LEAF_SPLIT;
+            memcpy(right_leaf->keys, &keys[BTREE_LEAF_SPLIT], (size_t)right_leaf->node.count * sizeof(uint64_t));
+            node->count = BTREE_LEAF_SPLIT;
+            memcpy(leaf->keys, keys, (size_t)BTREE_LEAF_SPLIT * sizeof(uint64_t));
+
+            *separator = right_leaf->keys[0];
+            *split = &right_leaf->node;
+        }
+    }
+    else
+    {
+        i = Btree_Child_Index(inner, key);
+        result = Btree_Insert_Node(tree, &inner->children[i], key, &child_separator, &child_split);
+
+        if (child_split != NULL && node->count < BTREE_INNER_KEYS)
+        {
+            /* Link the new child right after the child that split */
+            memmove(&inner->keys[i + 1U], &inner->keys[i], (size_t)(node->count - i) * sizeof(uint64_t));
+            memmove(&inner->children[i + 2U], &inner->children[i + 1U],
+                    (size_t)(node->count - i) * sizeof(Btree_Node_t*));
+            inner->keys[i] = child_separator;
+            inner->children[i + 1U] = child_split;
+            node->count++;
+        }
+        else if (child_split != NULL)
+        {
+            /* Split the full inner node, the middle separator moves up */
+            memcpy(keys, inner->keys, (size_t)i * sizeof(uint64_t));
+            keys[i] = child_separator;
+            memcpy(&keys[i + 1U], &inner->keys[i], (size_t)(node->count - i) * sizeof(uint64_t));
+            memcpy(children, inner->children, (size_t)(i + 1U) * sizeof(Btree_Node_t*));
+            children[i + 1U] = child_split;
+            memcpy(&children[i + 2U], &inner->children[i + 1U], (size_t)(node->count - i) * sizeof(Btree_Node_t*));
+
+            right_inner = (Btree_Inner_t*)Btree_Take_Spare(tree);
+            right_inner->node.leaf = 0U;
+            right_inner->node.count = BTREE_INNER_KEYS - BTREE_INNER_SPLIT;
+            memcpy(right_inner->keys, &keys[BTREE_INNER_SPLIT + 1U],
+                   (size_t)right_inner->node.count * sizeof(uint64_t));
+            memcpy(right_inner->children, &children[BTREE_INNER_SPLIT + 1U],
+                   (size_t)(right_inner->node.count + 1U) * sizeof(Btree_Node_t*));
+            node->count = BTREE_INNER_SPLIT;
+            memcpy(inner->keys, keys, (size_t)BTREE_INNER_SPLIT * sizeof(uint64_t));
+            memcpy(inner->children, children, (size_t)(BTREE_INNER_SPLIT + 1U) * sizeof(Btree_Node_t*));
+
+            *separator = keys[BTREE_INNER_SPLIT];
+            *split = &right_inner->node;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Insert a key into the tree.
+ *
+ * The nodes the insertion may copy or split are allocated first, so a failed allocation
+ * leaves the tree unchanged.
+ *
+ * @param tree The tree.
+ * @param key The key.
+ * @return 1 if the key is inserted, 0 if it is already in the tree, -1 if memory allocation failed.
+ */
+int32_t Btree_Insert(Btree_t* tree, uint64_t key)
+{
+    int32_t result = 1;                 /* Result of the insertion */
+    Btree_Node_t* split = NULL;         /* New node of a split of the root */
+    Btree_Inner_t* root = NULL;         /* New root above a split root */
+    uint64_t separator = 0;             /* Smallest key of the new node of the root */
+
+    /* Every level may be copied and split, and the root may need a new level above it */
+    if (Btree_Reserve(tree, 2U * tree->height + 1U) == 0)
+    {
+        result = -1;
+    }
+    else if (tree->shared)
+    {
+        Btree_Close(tree);
+    }
+
+    if (result == 1 && tree->root == NULL)
+    {
+        ((Btree_Leaf_t*)tree->spare[tree->spares - 1U])->keys[0] = key;
+        tree->root = Btree_Take_Spare(tree);
+        tree->root->leaf = 1U;
+        tree->root->count = 1U;
+        tree->height = 1U;
+    }
+    else if (result == 1)
+    {
+        result = Btree_Insert_Node(tree, &tree->root, key, &separator, &split);
+        if (split != NULL)
+        {
+            /* The tree grows by one level at the top */
+            root = (Btree_Inner_t*)Btree_Take_Spare(tree);
+            root->node.leaf = 0U;
+            root->node.count = 1U;
+            root->keys[0] = separator;
+            root->children[0] = tree->root;
+            root->children[1] = split;
+            tree->root = &root->node;
+            tree->height++;
+        }
+    }
+
+    if (result == 1)
+    {
+        tree->count++;
+    }
+    /* A record that cannot be allocated again is published by the next change */
+    if (result >= 0 && tree->shared)
+    {
+        Btree_Publish(tree);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Refill a child of an inner node that fell below half full.
+ *
+ * The child borrows a key from a sibling that can spare one, otherwise it is merged
+ * with a sibling and the inner node loses a separator. The sibling that changes is
+ * made writable first.
+ *
+ * @param tree The tree, holding a spare node to copy a sibling.
+ * @param parent The inner node, writable.
+ * @param i The position of the child in the inner node, writable.
+ */
+static void Btree_Rebalance(Btree_t* tree, Btree_Inner_t* parent, uint32_t i)
+{
+    Btree_Node_t* child = parent->children[i];                                      /* The child that is too small */
+    Btree_Node_t* left = (i > 0U) ? parent->children[i - 1U] : NULL;                /* Left sibling */
+    Btree_Node_t* right = (i < parent->node.count) ? parent->children[i + 1U] : NULL;   /* Right sibling */
+    uint32_t minimum = child->leaf ? BTREE_LEAF_MIN : BTREE_INNER_MIN;              /* Fewest keys of a sibling that lends one */
+    Btree_Node_t* into = NULL;                  /* Node that absorbs a merge */
+    Btree_Node_t* from = NULL;                  /* Node emptied by a merge */
+    uint32_t s = 0;                             /* Position of the separator between into and from */
+
+    /* The left sibling changes when it lends a key or absorbs the child */
+    if (left != NULL && (left->count > minimum || right == NULL || right->count <= minimum))
+    {
+        left = Btree_Own(tree, &parent->children[i - 1U]);
+    }
+    else if (right != NULL && right->count > minimum)
+    {
+        right = Btree_Own(tree, &parent->children[i + 1U]);
+    }
+
+    if (left != NULL && left->count > minimum)
+    {
+        /* Move the largest key of the left sibling to the front of the child */
+        if (child->leaf)
+        {
+            memmove(&((Btree_Leaf_t*)child)->keys[1], ((Btree_Leaf_t*)child)->keys, (size_t)child->count * sizeof(uint64_t));
+            ((Btree_Leaf_t*)child)->keys[0] = ((Btree_Leaf_t*)left)->keys[left->count - 1U];
+            parent->keys[i - 1U] = ((Btree_Leaf_t*)child)->keys[0];
+        }
+        else
+        {
+            memmove(&((Btree_Inner_t*)child)->keys[1], ((Btree_Inner_t*)child)->keys, (size_t)child->count * sizeof(uint64_t));
+            memmove(&((Btree_Inner_t*)child)->children[1], ((Btree_Inner_t*)child)->children,
+                    (size_t)(child->count + 1U) * sizeof(Btree_Node_t*));
+            ((Btree_Inner_t*)child)->keys[0] = parent->keys[i - 1U];
+            ((Btree_Inner_t*)child)->children[0] = ((Btree_Inner_t*)left)->children[left->count];
+            parent->keys[i - 1U] = ((Btree_Inner_t*)left)->keys[left->count - 1U];
+        }
+        child->count++;
+        left->count--;
+    }
+    else if (right != NULL && right->count > minimum)
+    {
+        /* Move the smallest key of the right sibling to the end of the child */
+        if (child->leaf)
+        {
+            ((Btree_Leaf_t*)child)->keys[child->count] = ((Btree_Leaf_t*)right)->keys[0];
+            memmove(((Btree_Leaf_t*)right)->keys, &((Btree_Leaf_t*)right)->keys[1],
+                    (size_t)(right->count - 1U) * sizeof(uint64_t));
+            parent->keys[i] = ((Btree_Leaf_t*)right)->keys[0];
+        }
+        else
+        {
+            ((Btree_Inner_t*)child)->keys[child->count] = parent->keys[i];
+            ((Btree_Inner_t*)child)->children[child->count + 1U] = ((Btree_Inner_t*)right)->children[0];
+            parent->keys[i] = ((Btree_Inner_t*)right)->keys[0];
+            memmove(((Btree_Inner_t*)right)->keys, &((Btree_Inner_t*)right)->keys[1],
+                    (size_t)(right->count - 1U) * sizeof(uint64_t));
+            memmove(((Btree_Inner_t*)right)->children, &((Btree_Inner_t*)right)->children[1],
+                    (size_t)right->count * sizeof(Btree_Node_t*));
+        }
+        child->count++;
+        right->count--;
+    }
+    else
+    {
+        /* Neither sibling can lend a key, so the child and one sibling fit in one node */
+        into = (left != NULL) ? left : child;
+        from = (left != NULL) ? child : right;
+        s = (left != NULL) ? (i - 1U) : i;
+        if (into->leaf)
+        {
+            memcpy(&((Btree_Leaf_t*)into)->keys[into->count], ((Btree_Leaf_t*)from)->keys,
+                   (size_t)from->count * sizeof(uint64_t));
+            into->count += from->count;
+        }
+        else
+        {
+            /* The separator comes down between the keys of the two nodes */
+            ((Btree_Inner_t*)into)->keys[into->count] = parent->keys[s];
+            memcpy(&((Btree_Inner_t*)into)->keys[into->count + 1U], ((Btree_Inner_t*)from)->keys,
+                   (size_t)from->count * sizeof(uint64_t));
+            memcpy(&((Btree_Inner_t*)into)->children[into->count + 1U], ((Btree_Inner_t*)from)->children,
+                   (size_t)(from->count + 1U) * sizeof(Btree_Node_t*));
+            into->count += from->count + 1U;
+        }
+        memmove(&parent->keys[s], &parent->keys[s + 1U], (size_t)(parent->node.count - s - 1U) * sizeof(uint64_t));
+        memmove(&parent->children[s + 1U], &parent->children[s + 2U],
+                (size_t)(parent->node.count - s - 1U) * sizeof(Btree_Node_t*));
+        parent->node.count--;
+        Btree_Drop(tree, from);
+    }
+}
+
+/**
+ * @brief Remove a key from a subtree.
+ *
+ * @param tree The tree, holding enough spare nodes for every copy.
+ * @param link The pointer to the root of the subtree in its parent, which is writable.
+ * @param key The key.
+ * @return 1 if the key is removed, 0 if it is not in the subtree.
+ */
+static int32_t Btree_Remove_Node(Btree_t* tree, Btree_Node_t** link, uint64_t key)
+{
+    Btree_Node_t* node = Btree_Own(tree, link); /* The root of the subtree, writable */
+    int32_t result = 0;                         /* Result of the removal */
+    Btree_Leaf_t* leaf = (Btree_Leaf_t*)node;   /* The node as a leaf */
+    Btree_Inner_t* inner = (Btree_Inner_t*)node;/* The node as an inner node */
+    Btree_Node_t* child = NULL;                 /* Child that held the key */
+    uint32_t i = 0;                             /* Position of the key or of the child */
+
+    if (node->leaf)
+    {
+        i = Btree_Lower_Bound(leaf->keys, node->count, key);
+        if (i < node->count && leaf->keys[i] == key)
+        {
+            memmove(&leaf->keys[i], &leaf->keys[i + 1U], (size_t)(node->count - i - 1U) * sizeof(uint64_t));
+            node->count--;
+            result = 1;
+        }
+    }
+    else
+    {
+        i = Btree_Child_Index(inner, key);
+        result = Btree_Remove_Node(tree, &inner->children[i], key);
+        child = inner->children[i];
+        if (result == 1 && child->count < (child->leaf ? BTREE_LEAF_MIN : BTREE_INNER_MIN))
+        {
+            Btree_Rebalance(tree, inner, i);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Remove a key from the tree.
+ *
+ * The nodes the removal may copy are allocated first, so a failed allocation leaves the
+ * tree unchanged.
+ *
+ * @param tree The tree.
+ * @param key The key.
+ * @return 1 if the key is removed, 0 if it is not in the tree, -1 if memory allocation failed.
+ */
+int32_t Btree_Remove(Btree_t* tree, uint64_t key)
+{
+    int32_t result = 0;                 /* Result of the removal */
+    Btree_Node_t* root = NULL;          /* Root after the copies of the removal */
+
+    /* Every level and one sibling of each may be copied */
+    if (tree->root != NULL && Btree_Reserve(tree, 2U * tree->height) == 0)
+    {
+        result = -1;
+    }
+    else if (tree->root != NULL)
+    {
+        if (tree->shared)
+        {
+            Btree_Close(tree);
+        }
+        result = Btree_Remove_Node(tree, &tree->root, key);
+        root = tree->root;
+    }
+
+    if (result == 1)
+    {
+        tree->count--;
+        /* An empty root leaf empties the tree, an inner root left with one child hands over to it */
+        if (root->count == 0U)
+        {
+            tree->root = root->leaf ? NULL : ((Btree_Inner_t*)root)->children[0];
+            tree->height--;
+            Btree_Release(tree, root);
+        }
+    }
+    if (root != NULL && tree->shared)
+    {
+        Btree_Publish(tree);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Move a cursor whose leaf position is past the end of its leaf to the next key.
+ *
+ * @param cursor The cursor.
+ */
+static void Btree_Cursor_Settle(Btree_Cursor_t* cursor)
+{
+    const Btree_Node_t* node = NULL;    /* Node being entered */
+    uint32_t level = 0;                 /* Level of the inner node with a next child */
+
+    if (cursor->depth > 0U && cursor->positions[cursor->depth - 1U] >= cursor->nodes[cursor->depth - 1U]->count)
+    {
+        /* Climb to the lowest inner node that has a child after the current one */
+        level = cursor->depth - 1U;
+        while (level > 0U && cursor->positions[level - 1U] >= cursor->nodes[level - 1U]->count)
+        {
+            level--;
+        }
+
+        if (level == 0U)
+        {
+            /* The cursor passed the last key */
+            cursor->depth = 0;
+        }
+        else
+        {
+            /* Go down the leftmost path of the next child, leaves are never empty */
+            cursor->positions[level - 1U]++;
+            node = ((const Btree_Inner_t*)cursor->nodes[level - 1U])->children[cursor->positions[level - 1U]];
+            cursor->depth = level;
+            while (!node->leaf)
+            {
+                cursor->nodes[cursor->depth] = node;
+                cursor->positions[cursor->depth] = 0;
+                cursor->depth++;
+                node = ((const Btree_Inner_t*)node)->children[0];
+            }
+            cursor->nodes[cursor->depth] = node;
+            cursor->positions[cursor->depth] = 0;
+            cursor->depth++;
+        }
+    }
+}
+
+/**
+ * @brief Place a cursor before the first key that is not smaller than a given key.
+ *
+ * The tree must not change while the cursor is in use.
+ *
+ * @param tree The tree.
+ * @param key The key.
+ * @param cursor Output, the cursor.
+ */
+void Btree_Seek(const Btree_t* tree, uint64_t key, Btree_Cursor_t* cursor)
+{
+    const Btree_Node_t* node = tree->root;  /* Node being entered */
+
+    cursor->depth = 0;
+    while (node != NULL)
+    {
+        cursor->nodes[cursor->depth] = node;
+        if (node->leaf)
+        {
+            cursor->positions[cursor->depth] = Btree_Lower_Bound(((const Btree_Leaf_t*)node)->keys, node->count, key);
+            node = NULL;
+        }
+        else
+        {
+            cursor->positions[cursor->depth] = Btree_Child_Index((const Btree_Inner_t*)node, key);
+            node = ((const Btree_Inner_t*)node)->children[cursor->positions[cursor->depth]];
+        }
+        cursor->depth++;
+    }
+
+    /* Every key of the leaf may be smaller than the key */
+    Btree_Cursor_Settle(cursor);
+}
+
+/**
+ * @brief Read the key at a cursor and move the cursor to the next key.
+ *
+ * @param cursor The cursor.
+ * @param key Output, the key.
+ * @return 1 if a key is read, 0 if the cursor passed the last key.
+ */
+int32_t Btree_Next(Btree_Cursor_t* cursor, uint64_t* key)
+{
+    int32_t result = 0;         /* Result of the read */
+    uint32_t leaf = 0;          /* Level of the leaf */
+
+    if (cursor->depth > 0U)
+    {
+        leaf = cursor->depth - 1U;
+        *key = ((const Btree_Leaf_t*)cursor->nodes[leaf])->keys[cursor->positions[leaf]];
+        cursor->positions[leaf]++;
+        Btree_Cursor_Settle(cursor);
+        result = 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Publish the tree so that any thread can pin it.
+ *
+ * It must be called by the thread that changes the tree. From then on every change
+ * publishes the version it leaves, until Btree_Free().
+ *
+ * @param tree The tree.
+ * @return 1 if the tree is published, 0 if memory allocation failed.
+ */
+int32_t Btree_Publish(Btree_t* tree)
+{
+    Btree_Version_t* version = atomic_load_explicit(&tree->published, memory_order_relaxed);   /* The record */
+    int32_t result = 1;         /* Result of the publication */
+
+    tree->shared = 1;
+    /* A record given up to a reader is replaced */
+    if (version == NULL)
+    {
+        version = (Btree_Version_t*)malloc(sizeof(Btree_Version_t));
+        if (version == NULL)
+        {
+            result = 0;
+        }
+        else
+        {
+            atomic_init(&version->refs, 0U);
+        }
+    }
+
+    /* Only a closed record changes, an open one already holds the current version */
+    if (version != NULL && atomic_load_explicit(&version->refs, memory_order_relaxed) == 0U)
+    {
+        version->root = tree->root;
+        version->height = tree->height;
+        version->count = tree->count;
+        /* The next change of the tree copies the root, and below it only the nodes of its path */
+        if (tree->root != NULL)
+        {
+            atomic_fetch_add_explicit(&tree->root->refs, 1U, memory_order_relaxed);
+        }
+        atomic_store_explicit(&version->refs, 1U, memory_order_release);
+        atomic_store_explicit(&tree->published, version, memory_order_release);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Pin the last published version of the tree, from any thread, in O(1).
+ *
+ * The version shares every node with the tree and is only read with Btree_Seek() and
+ * Btree_Next(), then freed with Btree_Free(), by any thread while the tree keeps changing.
+ * A pin that meets a change in progress waits for it to publish its version. The tree
+ * must stay allocated during the call, which reads it inside a read section (see
+ * account_epoch.h).
+ *
+ * @param tree The tree.
+ * @param version Output, the version, empty if none is published.
+ * @return 1 if the version is pinned, 0 if the tree is not published.
+ */
+int32_t Btree_Pin(Btree_t* tree, Btree_t* version)
+{
+    Btree_Version_t* published = NULL;  /* Record of the tree */
+    uint32_t refs = 0;                  /* References of the record */
+    int32_t last = 0;                   /* Set when the pin drops the last reference of a record given up */
+
+    version->root = NULL;
+    version->height = 0;
+    version->count = 0;
+    version->spares = 0;
+    atomic_init(&version->published, NULL);
+    version->shared = 0;
+
+    /* The read section keeps the record allocated while it is read */
+    Epoch_Enter();
+    published = atomic_load_explicit(&tree->published, memory_order_acquire);
+    while (published != NULL && refs == 0U)
+    {
+        /* Hold the record unless a change closed it */
+        refs = atomic_load_explicit(&published->refs, memory_order_relaxed);
+        while (refs > 0U && !atomic_compare_exchange_weak_explicit(&published->refs, &refs, refs + 1U,
+                                                                   memory_order_acquire, memory_order_relaxed))
+        {
+            /* refs now holds the current references */
+        }
+        if (refs == 0U)
+        {
+            /* Let the change finish, it publishes the record again or a new one */
+            Epoch_Exit();
+            sched_yield();
+            Epoch_Enter();
+            published = atomic_load_explicit(&tree->published, memory_order_acquire);
+        }
+    }
+
+    if (published != NULL)
+    {
+        version->root = published->root;
+        version->height = published->height;
+        version->count = published->count;
+        if (version->root != NULL)
+        {
+            atomic_fetch_add_explicit(&version->root->refs, 1U, memory_order_relaxed);
+        }
+        last = (atomic_fetch_sub_explicit(&published->refs, 1U, memory_order_acq_rel) == 1U) ? 1 : 0;
+    }
+    Epoch_Exit();
+    if (last)
+    {
+        Epoch_Retire(published, Btree_Version_Release);
+    }
+
+    return (published != NULL) ? 1 : 0;
+}
+
+/**
+ * @brief Release all the nodes of the tree and leave it empty.
+ *
+ * The nodes shared with a pinned version stay until the version is freed as well. A
+ * published tree stops being published.
+ *
+ * @param tree The tree, or a version given by Btree_Pin().
+ */
+void Btree_Free(Btree_t* tree)
+{
+    Btree_Unpublish(tree);
+    tree->shared = 0;
+    if (tree->root != NULL)
+    {
+        Btree_Unref(tree->root);
+    }
+    while (tree->spares > 0U)
+    {
+        free(Btree_Take_Spare(tree));
+    }
+    tree->root = NULL;
+    tree->height = 0;
+    tree->count = 0;
+} /* EOF */
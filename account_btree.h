@@ -0,0 +1,206 @@
+/**
+ * @file account_btree.h
+ * @brief This file contains the declarations of the ordered index of the accounts.
+ *
+ * The index is a B+-tree of packed keys. Keys sort in the strcmp() order of their
+ * accounts (see account_key.h), so the accounts starting with a prefix are one range
+ * of keys and a prefix query only reads the leaves of that range.
+ *
+ * Every node takes 256 bytes, four cache lines: a leaf holds up to BTREE_LEAF_KEYS keys,
+ * an inner node up to BTREE_INNER_KEYS separators and one child more. Nodes that fall
+ * below half full after a removal borrow from or merge with a sibling.
+ *
+ * A cursor keeps the path from the root to its leaf instead of following links between
+ * the leaves, so the leaves only point to their keys.
+ *
+ * The tree is copy-on-write: Btree_Pin() gives a read-only version sharing every node
+ * with the tree in O(1). Each node counts the parents and versions referring to it, and
+ * a change copies the nodes of its path that are still shared, so a version never sees
+ * a change made after it was pinned. Readers of a version need no lock, and the last
+ * reference to a node frees it, whichever thread drops it.
+ *
+ * Once the thread changing the tree publishes it with Btree_Publish(), any thread can pin
+ * it. Each change closes the published record of the root, height and count and publishes
+ * it again once it is done. A change never waits, a pin in progress only makes it copy the
+ * path, while a pin that meets a change waits for its end.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include <stdatomic.h>          /* For the references shared with the readers of the versions */
+
+#ifndef ACCOUNT_BTREE_H
+#define ACCOUNT_BTREE_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BTREE_LEAF_KEYS         31U     /* Keys in a full leaf */
+#define BTREE_INNER_KEYS        15U     /* Separators in a full inner node */
+#define BTREE_MAX_DEPTH         24U     /* Levels a cursor can follow, far more than 2^64 keys need */
+#define BTREE_MAX_SPARES        (2U * BTREE_MAX_DEPTH + 1U)     /* Nodes a change may need: a copy and a split per level, and a root */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for the header shared by the leaves and the inner nodes.
+ */
+typedef struct
+{
+    uint16_t count;             /* Number of keys or separators. */
+    uint16_t leaf;              /* 1 for a leaf, 0 for an inner node. */
+    _Atomic uint32_t refs;      /* Parents and versions referring to the node, it is shared while above 1. */
+} Btree_Node_t;
+
+/**
+ * @brief Structure for a leaf.
+ */
+typedef struct
+{
+    Btree_Node_t node;                  /* Header of the node. */
+    uint64_t keys[BTREE_LEAF_KEYS];     /* Keys in increasing order. */
+} Btree_Leaf_t;
+
+/**
+ * @brief Structure for an inner node.
+ *
+ * The keys of children[i] are smaller than keys[i], which is not larger than any
+ * key of children[i + 1].
+ */
+typedef struct
+{
+    Btree_Node_t node;                              /* Header of the node. */
+    uint64_t keys[BTREE_INNER_KEYS];                /* Separators in increasing order. */
+    Btree_Node_t* children[BTREE_INNER_KEYS + 1U];  /* Subtrees, count + 1 of them are used. */
+} Btree_Inner_t;
+
+/**
+ * @brief Structure for a version of the tree published to the pinning threads.
+ *
+ * The record refers to its root like a version does. Its fields only change while
+ * refs is 0, when no thread can pin it.
+ */
+typedef struct
+{
+    Btree_Node_t* root;         /* Root node, NULL if the tree is empty. */
+    uint32_t height;            /* Number of levels. */
+    uint64_t count;             /* Number of keys. */
+    _Atomic uint32_t refs;      /* 1 for the tree while it is open, plus the pins in progress; 0 once closed. */
+} Btree_Version_t;
+
+/**
+ * @brief Structure for the tree.
+ *
+ * A zero-initialized structure is a valid empty tree.
+ */
+typedef struct
+{
+    Btree_Node_t* root;                     /* Root node, NULL if the tree is empty. */
+    uint32_t height;                        /* Number of levels, 0 if the tree is empty. */
+    uint64_t count;                         /* Number of keys. */
+    Btree_Node_t* spare[BTREE_MAX_SPARES];  /* Nodes allocated ahead for the copies and splits of a change. */
+    uint32_t spares;                        /* Number of spare nodes. */
+    Btree_Version_t* _Atomic published;     /* Version the other threads pin, NULL if none. */
+    int32_t shared;                         /* Set by Btree_Publish(), every change then publishes the new version. */
+} Btree_t;
+
+/**
+ * @brief Structure for a position in the tree.
+ */
+typedef struct
+{
+    const Btree_Node_t* nodes[BTREE_MAX_DEPTH];     /* Node of each level, from the root. */
+    uint32_t positions[BTREE_MAX_DEPTH];            /* Child or key of each level. */
+    uint32_t depth;                                 /* Number of levels, 0 once the cursor passed the last key. */
+} Btree_Cursor_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Insert a key into the tree.
+ *
+ * The nodes the insertion may copy or split are allocated first, so a failed allocation
+ * leaves the tree unchanged.
+ *
+ * @param tree The tree.
+ * @param key The key.
+ * @return 1 if the key is inserted, 0 if it is already in the tree, -1 if memory allocation failed.
+ */
+int32_t Btree_Insert(Btree_t* tree, uint64_t key);
+
+/**
+ * @brief Remove a key from the tree.
+ *
+ * The nodes the removal may copy are allocated first, so a failed allocation leaves the
+ * tree unchanged.
+ *
+ * @param tree The tree.
+ * @param key The key.
+ * @return 1 if the key is removed, 0 if it is not in the tree, -1 if memory allocation failed.
+ */
+int32_t Btree_Remove(Btree_t* tree, uint64_t key);
+
+/**
+ * @brief Publish the tree so that any thread can pin it.
+ *
+ * It must be called by the thread that changes the tree. From then on every change
+ * publishes the version it leaves, until Btree_Free().
+ *
+ * @param tree The tree.
+ * @return 1 if the tree is published, 0 if memory allocation failed.
+ */
+int32_t Btree_Publish(Btree_t* tree);
+
+/**
+ * @brief Pin the last published version of the tree, from any thread, in O(1).
+ *
+ * The version shares every node with the tree and is only read with Btree_Seek() and
+ * Btree_Next(), then freed with Btree_Free(), by any thread while the tree keeps changing.
+ * A pin that meets a change in progress waits for it to publish its version. The tree
+ * must stay allocated during the call, which reads it inside a read section (see
+ * account_epoch.h).
+ *
+ * @param tree The tree.
+ * @param version Output, the version, empty if none is published.
+ * @return 1 if the version is pinned, 0 if the tree is not published.
+ */
+int32_t Btree_Pin(Btree_t* tree, Btree_t* version);
+
+/**
+ * @brief Place a cursor before the first key that is not smaller than a given key.
+ *
+ * The tree must not change while the cursor is in use.
+ *
+ * @param tree The tree.
+ * @param key The key.
+ * @param cursor Output, the cursor.
+ */
+void Btree_Seek(const Btree_t* tree, uint64_t key, Btree_Cursor_t* cursor);
+
+/**
+ * @brief Read the key at a cursor and move the cursor to the next key.
+ *
+ * @param cursor The cursor.
+ * @param key Output, the key.
+ * @return 1 if a key is read, 0 if the cursor passed the last key.
+ */
+int32_t Btree_Next(Btree_Cursor_t* cursor, uint64_t* key);
+
+/**
+ * @brief Release all the nodes of the tree and leave it empty.
+ *
+ * The nodes shared with a pinned version stay until the version is freed as well. A
+ * published tree stops being published.
+ *
+ * @param tree The tree, or a version given by Btree_Pin().
+ */
+void Btree_Free(Btree_t* tree);
+
+#endif /* ACCOUNT_BTREE_H */
@@ -0,0 +1,367 @@
+/**
+ * @file account_check.c
+ * @brief This file contains the implementation of the batch account validator.
+ *
+ * An account has at most 10 characters, so the vector kernels load each account into a
+ * 16-byte lane and test every character against the three accepted ranges at once.
+ * The bytes past the end of the account are ignored through a bit mask, so the lane is
+ * loaded in place whenever the load stays within one page, and copied otherwise.
+ * Signed byte compares are enough because every accepted character is below 0x80.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdatomic.h>          /* For the atomic kernel selection */
+#include "account_check.h"      /* Include header file of this function file */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>          /* For the SSE2 and AVX2 intrinsics */
+#define CHECK_HAVE_X86      1
+#else
+#define CHECK_HAVE_X86      0
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define CHECK_MAX_LENGTH    10U     /* Maximum length accepted by Check_Account() */
+#define CHECK_LANE          16U     /* Bytes of one account lane */
+#define CHECK_PAGE_SIZE     4096U   /* Smallest page size of the supported platforms */
+
+/**
+ * @brief Check that a 16-byte load from ptr stays within the page of ptr.
+ *
+ * Such a load cannot fault even when the account is shorter than 16 bytes. The bytes
+ * after the account are masked out, so their values never change the result.
+ */
+#define CHECK_LANE_IN_PAGE(ptr) ((((uintptr_t)(ptr)) & (CHECK_PAGE_SIZE - 1U)) <= (CHECK_PAGE_SIZE - CHECK_LANE))
+
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 7))
+#define CHECK_NO_SANITIZE   __attribute__((no_sanitize_address))   /* The in-page over-read is intended */
+#else
+#define CHECK_NO_SANITIZE
+#endif
+
+/**
+ * @brief Typedef for a kernel of the batch validator.
+ */
+typedef void (*check_kernel_fn)(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out);
+
+/**
+ * @brief Structure describing a kernel of the batch validator.
+ */
+typedef struct
+{
+    check_kernel_fn run;        /* The kernel function. */
+    const char* name;           /* The name of the kernel. */
+} check_kernel_desc_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void Check_Kernel_Scalar(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out);
+#if CHECK_HAVE_X86
+static void Check_Kernel_Sse2(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out);
+static void Check_Kernel_Avx2(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out);
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const check_kernel_desc_t kernel_scalar = { Check_Kernel_Scalar, "scalar" };
+#if CHECK_HAVE_X86
+static const check_kernel_desc_t kernel_sse2 = { Check_Kernel_Sse2, "sse2" };
+static const check_kernel_desc_t kernel_avx2 = { Check_Kernel_Avx2, "avx2" };
+#endif
+
+/* Kernel used by Check_Batch(), NULL until selected. It is published with a single atomic
+store, so threads that select it concurrently on first use all see a complete descriptor. */
+static const check_kernel_desc_t* _Atomic check_kernel = NULL;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Check one account one character at a time.
+ *
+ * This is the same test as Check_Account().
+ *
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @return The status of the account.
+ */
+static status_enum_t Check_One_Scalar(const int8_t* ptr, uint8_t length)
+{
+    status_enum_t status = CORRECT;     /* Status of the account */
+    uint32_t i = 0;                     /* Counter of characters */
+
+    if (length > CHECK_MAX_LENGTH)
+    {
+        status = LENGHT_INVALID;
+    }
+    else
+    {
+        for (i = 0; (i < length) && (status == CORRECT); i++)
+        {
+            if (!((ptr[i] >= 'a' && ptr[i] <= 'z') || (ptr[i] >= 'A' && ptr[i] <= 'Z') || (ptr[i] >= '1' && ptr[i] <= '9')))
+            {
+                status = CHAR_INVALID;
+            }
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Scalar kernel, available on every CPU.
+ *
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+static void Check_Kernel_Scalar(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out)
+{
+    size_t i = 0;       /* Counter of accounts */
+
+    for (i = 0; i < n; i++)
+    {
+        out[i] = Check_One_Scalar(ptrs[i], lens[i]);
+    }
+}
+
+#if CHECK_HAVE_X86
+/**
+ * @brief Load an account into a 16-byte lane.
+ *
+ * The account is loaded in place when the load stays within one page, otherwise it is
+ * copied first. Only the first length bytes of the lane are meaningful.
+ *
+ * @param ptr The pointer to the account.
+ * @param length The length of the account, at most CHECK_LANE.
+ * @return The lane holding the account.
+ */
+__attribute__((target("sse2"))) CHECK_NO_SANITIZE
+static inline __m128i Check_Load_Lane(const int8_t* ptr, uint32_t length)
+{
+    uint64_t lane[2] = { 0, 0 };    /* Zero-filled copy of the account */
+    __m128i chars;                  /* Characters of the account */
+
+    if (CHECK_LANE_IN_PAGE(ptr))
+    {
+        chars = _mm_loadu_si128((const __m128i*)ptr);
+    }
+    else
+    {
+        memcpy(lane, ptr, length);
+        chars = _mm_loadu_si128((const __m128i*)lane);
+    }
+
+    return chars;
+}
+
+/**
+ * @brief Turn the accepted-character mask of an account into its status.
+ *
+ * @param mask One bit per accepted character, starting at bit 0.
+ * @param length The length of the account.
+ * @return The status of the account.
+ */
+static inline status_enum_t Check_Mask_Status(uint32_t mask, uint32_t length)
+{
+    uint32_t need = (1U << (length & 0x1FU)) - 1U;      /* Bits of the characters of the account */
+
+    return (length > CHECK_MAX_LENGTH) ? LENGHT_INVALID : (((mask & need) == need) ? CORRECT : CHAR_INVALID);
+}
+
+/**
+ * @brief SSE2 kernel, one account per 16-byte vector.
+ *
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+__attribute__((target("sse2"))) CHECK_NO_SANITIZE
+static void Check_Kernel_Sse2(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out)
+{
+    const __m128i lower_lo = _mm_set1_epi8('a' - 1);    /* Bounds of the accepted ranges, exclusive */
+    const __m128i lower_hi = _mm_set1_epi8('z' + 1);
+    const __m128i upper_lo = _mm_set1_epi8('A' - 1);
+    const __m128i upper_hi = _mm_set1_epi8('Z' + 1);
+    const __m128i digit_lo = _mm_set1_epi8('1' - 1);
+    const __m128i digit_hi = _mm_set1_epi8('9' + 1);
+    __m128i chars;                  /* Characters of the account */
+    __m128i accepted;               /* 0xFF for each accepted character */
+    uint32_t length = 0;            /* Length of the account, clamped to the lane */
+    size_t i = 0;                   /* Counter of accounts */
+
+    for (i = 0; i < n; i++)
+    {
+        /* A too long account is only loaded up to the lane size, its status does not depend on it */
+        length = (lens[i] > CHECK_MAX_LENGTH) ? 0U : lens[i];
+        chars = Check_Load_Lane(ptrs[i], length);
+
+        accepted = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi8(chars, lower_lo), _mm_cmpgt_epi8(lower_hi, chars)),
+                         _mm_and_si128(_mm_cmpgt_epi8(chars, upper_lo), _mm_cmpgt_epi8(upper_hi, chars))),
+            _mm_and_si128(_mm_cmpgt_epi8(chars, digit_lo), _mm_cmpgt_epi8(digit_hi, chars)));
+
+        out[i] = Check_Mask_Status((uint32_t)_mm_movemask_epi8(accepted), lens[i]);
+    }
+}
+
+/**
+ * @brief AVX2 kernel, two accounts per 32-byte vector.
+ *
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+__attribute__((target("avx2"))) CHECK_NO_SANITIZE
+static void Check_Kernel_Avx2(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out)
+{
+    const __m256i lower_lo = _mm256_set1_epi8('a' - 1);     /* Bounds of the accepted ranges, exclusive */
+    const __m256i lower_hi = _mm256_set1_epi8('z' + 1);
+    const __m256i upper_lo = _mm256_set1_epi8('A' - 1);
+    const __m256i upper_hi = _mm256_set1_epi8('Z' + 1);
+    const __m256i digit_lo = _mm256_set1_epi8('1' - 1);
+    const __m256i digit_hi = _mm256_set1_epi8('9' + 1);
+    __m256i chars;                  /* Characters of the two accounts, one per 16-byte half */
+    __m256i accepted;               /* 0xFF for each accepted character */
+    uint32_t mask = 0;              /* One bit per accepted character */
+    uint32_t first = 0;             /* Length of the first account, clamped to the lane */
+    uint32_t second = 0;            /* Length of the second account, clamped to the lane */
+    size_t i = 0;                   /* Counter of accounts */
+
+    for (i = 0; i + 1U < n; i += 2U)
+    {
+        first = (lens[i] > CHECK_MAX_LENGTH) ? 0U : lens[i];
+        second = (lens[i + 1U] > CHECK_MAX_LENGTH) ? 0U : lens[i + 1U];
+        chars = _mm256_inserti128_si256(_mm256_castsi128_si256(Check_Load_Lane(ptrs[i], first)),
+                                        Check_Load_Lane(ptrs[i + 1U], second), 1);
+
+        accepted = _mm256_or_si256(
+            _mm256_or_si256(_mm256_and_si256(_mm256_cmpgt_epi8(chars, lower_lo), _mm256_cmpgt_epi8(lower_hi, chars)),
+                            _mm256_and_si256(_mm256_cmpgt_epi8(chars, upper_lo), _mm256_cmpgt_epi8(upper_hi, chars))),
+            _mm256_and_si256(_mm256_cmpgt_epi8(chars, digit_lo), _mm256_cmpgt_epi8(digit_hi, chars)));
+        mask = (uint32_t)_mm256_movemask_epi8(accepted);
+
+        out[i] = Check_Mask_Status(mask & 0xFFFFU, lens[i]);
+        out[i + 1U] = Check_Mask_Status(mask >> CHECK_LANE, lens[i + 1U]);
+    }
+
+    /* The last account of an odd batch has no partner */
+    if (i < n)
+    {
+        Check_Kernel_Sse2(&ptrs[i], &lens[i], 1U, &out[i]);
+    }
+}
+#endif /* CHECK_HAVE_X86 */
+
+/**
+ * @brief Select the kernel used by Check_Batch().
+ *
+ * @param kernel The kernel to use, CHECK_KERNEL_AUTO for the fastest one.
+ * @return 1 if the kernel is selected, 0 if the CPU does not support it.
+ */
+int32_t Check_Batch_Set_Kernel(check_kernel_t kernel)
+{
+    int32_t selected = 0;       /* Result of the selection */
+    int32_t sse2 = 0;           /* CPU supports SSE2 */
+    int32_t avx2 = 0;           /* CPU supports AVX2 */
+
+#if CHECK_HAVE_X86
+    __builtin_cpu_init();
+    sse2 = __builtin_cpu_supports("sse2");
+    avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+    /* Pick the fastest kernel the CPU supports */
+    if (kernel == CHECK_KERNEL_AUTO)
+    {
+        kernel = avx2 ? CHECK_KERNEL_AVX2 : (sse2 ? CHECK_KERNEL_SSE2 : CHECK_KERNEL_SCALAR);
+    }
+
+    switch (kernel)
+    {
+#if CHECK_HAVE_X86
+        case CHECK_KERNEL_AVX2:
+        {
+            if (avx2)
+            {
+                atomic_store_explicit(&check_kernel, &kernel_avx2, memory_order_release);
+                selected = 1;
+            }
+            break;
+        }
+        case CHECK_KERNEL_SSE2:
+        {
+            if (sse2)
+            {
+                atomic_store_explicit(&check_kernel, &kernel_sse2, memory_order_release);
+                selected = 1;
+            }
+            break;
+        }
+#endif
+        case CHECK_KERNEL_SCALAR:
+        {
+            atomic_store_explicit(&check_kernel, &kernel_scalar, memory_order_release);
+            selected = 1;
+            break;
+        }
+        default:
+        {
+            /* The kernel is not built for this CPU family */
+            break;
+        }
+    }
+
+    return selected;
+}
+
+/**
+ * @brief Get the name of the kernel used by Check_Batch().
+ *
+ * @return The name of the kernel.
+ */
+const char* Check_Batch_Kernel_Name(void)
+{
+    /* Make sure a kernel is selected */
+    if (atomic_load_explicit(&check_kernel, memory_order_acquire) == NULL)
+    {
+        Check_Batch_Set_Kernel(CHECK_KERNEL_AUTO);
+    }
+    return atomic_load_explicit(&check_kernel, memory_order_acquire)->name;
+}
+
+/**
+ * @brief Check the validity of many accounts.
+ *
+ * The callback function is not called, the caller reads the results from out.
+ * This function does not use any global state, so several threads may call it at once.
+ *
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+void Check_Batch(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out)
+{
+    const check_kernel_desc_t* kernel = atomic_load_explicit(&check_kernel, memory_order_acquire);
+
+    /* Select the fastest kernel on first use */
+    if (kernel == NULL)
+    {
+        Check_Batch_Set_Kernel(CHECK_KERNEL_AUTO);
+        kernel = atomic_load_explicit(&check_kernel, memory_order_acquire);
+    }
+    kernel->run(ptrs, lens, n, out);
+} /* EOF */
@@ -0,0 +1,68 @@
+/**
+ * @file account_check.h
+ * @brief This file contains the declarations of the batch account validator.
+ *
+ * The batch validator applies the rules of Check_Account() to many accounts at once.
+ * Several kernels are available (scalar, SSE2, AVX2). The fastest one supported by
+ * the CPU is selected on first use, and all of them give the same results as Check_Account().
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stddef.h>             /* For size_t */
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include "account_manage.h"     /* For status_enum_t */
+
+#ifndef ACCOUNT_CHECK_H
+#define ACCOUNT_CHECK_H
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the kernels of the batch validator.
+ */
+typedef enum
+{
+    CHECK_KERNEL_AUTO,      /* Select the fastest kernel supported by the CPU. */
+    CHECK_KERNEL_SCALAR,    /* One character at a time, available everywhere. */
+    CHECK_KERNEL_SSE2,      /* One account per 16-byte vector. */
+    CHECK_KERNEL_AVX2       /* Two accounts per 32-byte vector. */
+} check_kernel_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Check the validity of many accounts.
+ *
+ * The callback function is not called, the caller reads the results from out.
+ * This function does not use any global state, so several threads may call it at once.
+ *
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+void Check_Batch(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out);
+
+/**
+ * @brief Select the kernel used by Check_Batch().
+ *
+ * @param kernel The kernel to use, CHECK_KERNEL_AUTO for the fastest one.
+ * @return 1 if the kernel is selected, 0 if the CPU does not support it.
+ */
+int32_t Check_Batch_Set_Kernel(check_kernel_t kernel);
+
+/**
+ * @brief Get the name of the kernel used by Check_Batch().
+ *
+ * @return The name of the kernel.
+ */
+const char* Check_Batch_Kernel_Name(void);
+
+#endif /* ACCOUNT_CHECK_H */
@@ -0,0 +1,696 @@
+/**
+ * @file account_dedupe.c
+ * @brief This file contains the implementation of the parallel import of large files.
+ *
+ * Each stage runs one function per worker, on threads started for the stage. The first
+ * worker runs on the calling thread, and a worker whose thread cannot be started runs
+ * there too, after it.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "account_dedupe.h"     /* Include header file of this function file */
+#include "account_key.h"        /* For ACCOUNT_KEY_NONE */
+#include <stdatomic.h>          /* For the partition counter of the dedupe stage */
+#include <pthread.h>            /* For the threads of the stages */
+#ifdef _WIN32
+#include <windows.h>            /* For GetSystemInfo() and QueryPerformanceCounter() */
+#else
+#include <unistd.h>             /* For sysconf() */
+#include <time.h>               /* For clock_gettime() */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define DEDUPE_MIN_RANGE        (64U * 1024U)           /* Smallest range of the input given to a thread */
+#define DEDUPE_MIN_BLOCK        1024U                   /* Items of a growing block on its first allocation */
+#define DEDUPE_READ_SIZE        (1024U * 1024U)         /* Bytes of a file read at once */
+#define DEDUPE_HASH_FACTOR      0x9E3779B97F4A7C15ULL   /* Multiplier of the hash of a key */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for the work of one thread.
+ */
+typedef struct
+{
+    struct Dedupe_Job* job;             /* The import. */
+    size_t begin;                       /* First byte of the range of the thread. */
+    size_t end;                         /* End of the range of the thread. */
+    uint64_t* keys;                     /* Keys of the valid accounts of the range, in input order. */
+    uint64_t count;                     /* Number of keys. */
+    uint64_t capacity;                  /* Keys the block can hold. */
+    uint64_t base;                      /* Position of keys[0] among the valid accounts of the input. */
+    Dispatch_Report_t* reports;         /* Reports of the rejected accounts of the range. */
+    uint64_t report_count;              /* Number of reports. */
+    uint64_t report_capacity;           /* Reports the block can hold. */
+    uint64_t accounts;                  /* Accounts of the range. */
+    uint64_t rejected[SEQUENCE_INVALID + 1];    /* Rejected accounts of the range, by status. */
+    uint64_t cursors[DEDUPE_PARTITIONS];    /* Keys per partition, then the next place of each partition. */
+    uint64_t* table;                    /* Hash set of the current partition. */
+    uint64_t table_size;                /* Slots of the hash set. */
+    uint64_t duplicates;                /* Keys found earlier in their partition. */
+    int32_t failed;                     /* Set when memory allocation failed. */
+} Dedupe_Worker_t;
+
+/**
+ * @brief Structure for the state of an import shared by the threads.
+ */
+typedef struct Dedupe_Job
+{
+    const int8_t* data;                 /* The input. */
+    int32_t keep_rejected;              /* Set to report the rejected accounts. */
+    uint32_t threads;                   /* Number of workers. */
+    Dedupe_Worker_t* workers;           /* The workers. */
+    uint64_t* part_keys;                /* Keys grouped by partition. */
+    uint32_t* part_index;               /* Position of each of them among the valid accounts. */
+    uint64_t part_start[DEDUPE_PARTITIONS + 1U];    /* First key of each partition. */
+    uint8_t* keep;                      /* Set for the first occurrence of each key, by position. */
+    _Atomic uint32_t next_partition;    /* Next partition to dedupe. */
+} Dedupe_Job_t;
+
+/**
+ * @brief Type for the function of a worker in a stage.
+ */
+typedef void* (*dedupe_stage_t)(void* worker);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return The time in ns.
+ */
+static uint64_t Dedupe_Now(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;     /* Ticks of the performance counter per second */
+    LARGE_INTEGER counter;              /* Current value of the performance counter */
+
+    if (frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;                /* Current time */
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Hash a key.
+ *
+ * The top DEDUPE_PARTITION_BITS bits select the partition and the bits below them the
+ * slot of the hash set, the low bits of short accounts are all 0.
+ *
+ * @param key The key.
+ * @return The hash of the key.
+ */
+static inline uint64_t Dedupe_Hash(uint64_t key)
+{
+    return key * DEDUPE_HASH_FACTOR;
+}
+
+/**
+ * @brief Make room for one more item in a growing block.
+ *
+ * @param block The block, NULL before the first item.
+ * @param capacity The items the block can hold, updated.
+ * @param count The items in the block.
+ * @param item The size of an item.
+ * @return 1 if the block can hold one more item, 0 if memory allocation failed.
+ */
+static int32_t Dedupe_Reserve(void** block, uint64_t* capacity, uint64_t count, size_t item)
+{
+    int32_t result = 1;         /* Result of the growth */
+    uint64_t grown = 0;         /* Capacity of the new block */
+    void* moved = NULL;         /* The new block */
+
+    if (count == *capacity)
+    {
+        grown = (*capacity == 0U) ? DEDUPE_MIN_BLOCK : 2U * *capacity;
+        moved = realloc(*block, (size_t)grown * item);
+        if (moved == NULL)
+        {
+            result = 0;
+        }
+        else
+        {
+            *block = moved;
+            *capacity = grown;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Find the start of the first line at or after a position.
+ *
+ * @param data The input.
+ * @param size The size of the input.
+ * @param position The position.
+ * @return The start of the line, size if there is none.
+ */
+static size_t Dedupe_Line_Start(const int8_t* data, size_t size, size_t position)
+{
+    const int8_t* newline = NULL;       /* End of the line before the position */
+
+    if (position > 0U && position < size)
+    {
+        newline = (const int8_t*)memchr(data + position - 1U, '\n', size - position + 1U);
+        position = (newline == NULL) ? size : (size_t)(newline - data) + 1U;
+    }
+
+    return (position > size) ? size : position;
+}
+
+/**
+ * @brief Check stage: check the accounts of the range of a worker and keep their keys.
+ *
+ * @param argument The worker.
+ * @return NULL.
+ */
+static void* Dedupe_Check(void* argument)
+{
+    Dedupe_Worker_t* worker = (Dedupe_Worker_t*)argument;   /* The worker */
+    const int8_t* data = worker->job->data;                 /* The input */
+    const int8_t* line = data + worker->begin;              /* Current line */
+    const int8_t* end = data + worker->end;                 /* End of the range */
+    const int8_t* newline = NULL;                           /* End of the current line */
+    size_t length = 0;                                      /* Length of the current account */
+    uint64_t key = 0;                                       /* Key of the current account */
+    status_enum_t status = CORRECT;                         /* Status of the current account */
+    Dispatch_Report_t* report = NULL;                       /* Report of the current account */
+
+    while (line < end && worker->failed == 0)
+    {
+        newline = (const int8_t*)memchr(line, '\n', (size_t)(end - line));
+        newline = (newline == NULL) ? end : newline;
+        length = (size_t)(newline - line);
+        /* Lines may end with "\r\n" */
+        if (length > 0U && line[length - 1U] == '\r')
+        {
+            length--;
+        }
+
+        if (length > 0U)
+        {
+            worker->accounts++;
+            /* A length past UINT8_MAX is clamped, which keeps it LENGHT_INVALID */
+            status = Check_Account_Ctx(NULL, line, (length > UINT8_MAX) ? (uint8_t)UINT8_MAX : (uint8_t)length, &key);
+            if (status == CORRECT)
+            {
+                if (Dedupe_Reserve((void**)&worker->keys, &worker->capacity, worker->count, sizeof(uint64_t)))
+                {
+                    worker->keys[worker->count++] = key;
+                }
+                else
+                {
+                    worker->failed = 1;
+                }
+            }
+            else
+            {
+                worker->rejected[status]++;
+                if (worker->job->keep_rejected == 0)
+                {
+                    /* The rejected accounts are only counted */
+                }
+                else if (Dedupe_Reserve((void**)&worker->reports, &worker->report_capacity, worker->report_count,
+                                        sizeof(Dispatch_Report_t)))
+                {
+                    report = &worker->reports[worker->report_count++];
+                    memset(report, 0, sizeof(Dispatch_Report_t));
+                    report->offset = (uint64_t)(line - data);
+                    report->repeats = 1U;
+                    report->status = (uint8_t)status;
+                    report->length = (length > UINT8_MAX) ? (uint8_t)UINT8_MAX : (uint8_t)length;
+                    memcpy(report->token, line, (length < DISPATCH_TOKEN_SIZE) ? length : DISPATCH_TOKEN_SIZE);
+                }
+                else
+                {
+                    worker->failed = 1;
+                }
+            }
+        }
+        line = newline + 1;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Partition stage, first pass: count the keys of a worker in each partition.
+ *
+ * @param argument The worker.
+ * @return NULL.
+ */
+static void* Dedupe_Count(void* argument)
+{
+    Dedupe_Worker_t* worker = (Dedupe_Worker_t*)argument;   /* The worker */
+    uint64_t i = 0;                                         /* Key counter */
+
+    memset(worker->cursors, 0, sizeof(worker->cursors));
+    for (i = 0; i < worker->count; i++)
+    {
+        worker->cursors[Dedupe_Hash(worker->keys[i]) >> (64U - DEDUPE_PARTITION_BITS)]++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Partition stage, second pass: move the keys of a worker to their partitions.
+ *
+ * @param argument The worker, its cursors hold the first place of its keys in each partition.
+ * @return NULL.
+ */
+static void* Dedupe_Scatter(void* argument)
+{
+    Dedupe_Worker_t* worker = (Dedupe_Worker_t*)argument;   /* The worker */
+    Dedupe_Job_t* job = worker->job;                        /* The import */
+    uint64_t place = 0;                                     /* Place of the current key */
+    uint64_t i = 0;                                         /* Key counter */
+
+    for (i = 0; i < worker->count; i++)
+    {
+        place = worker->cursors[Dedupe_Hash(worker->keys[i]) >> (64U - DEDUPE_PARTITION_BITS)]++;
+        job->part_keys[place] = worker->keys[i];
+        job->part_index[place] = (uint32_t)(worker->base + i);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Dedupe stage: mark the first occurrence of each key, one partition at a time.
+ *
+ * The keys of a partition are in input order, so the first one inserted in the hash set
+ * is the first occurrence.
+ *
+ * @param argument The worker.
+ * @return NULL.
+ */
+static void* Dedupe_Partitions(void* argument)
+{
+    Dedupe_Worker_t* worker = (Dedupe_Worker_t*)argument;   /* The worker */
+    Dedupe_Job_t* job = worker->job;                        /* The import */
+    uint32_t partition = 0;                                 /* Current partition */
+    uint64_t count = 0;                                     /* Keys of the partition */
+    uint32_t bits = 0;                                      /* Bits of the slot of a key */
+    uint64_t mask = 0;                                      /* Slots of the hash set minus one */
+    uint64_t slot = 0;                                      /* Slot of the current key */
+    uint64_t key = 0;                                       /* Current key */
+    uint64_t i = 0;                                         /* Key counter */
+    uint64_t* table = NULL;                                 /* Grown hash set */
+
+    partition = atomic_fetch_add(&job->next_partition, 1U);
+    while (partition < DEDUPE_PARTITIONS && worker->failed == 0)
+    {
+        count = job->part_start[partition + 1U] - job->part_start[partition];
+        /* Keep the hash set at most half full */
+        bits = 4U;
+        while ((1ULL << bits) < 2U * count)
+        {
+            bits++;
+        }
+        mask = (1ULL << bits) - 1U;
+        if (mask + 1U > worker->table_size)
+        {
+            table = (uint64_t*)realloc(worker->table, (size_t)(mask + 1U) * sizeof(uint64_t));
+            worker->failed = (table == NULL) ? 1 : 0;
+            worker->table = (table == NULL) ? worker->table : table;
+            worker->table_size = (table == NULL) ? worker->table_size : mask + 1U;
+        }
+
+        if (worker->failed == 0 && count > 0U)
+        {
+            memset(worker->table, 0xFF, (size_t)(mask + 1U) * sizeof(uint64_t));
+            for (i = job->part_start[partition]; i < job->part_start[partition + 1U]; i++)
+            {
+                key = job->part_keys[i];
+                slot = (Dedupe_Hash(key) >> (64U - DEDUPE_PARTITION_BITS - bits)) & mask;
+                while (worker->table[slot] != ACCOUNT_KEY_NONE && worker->table[slot] != key)
+                {
+                    slot = (slot + 1U) & mask;
+                }
+                if (worker->table[slot] == key)
+                {
+                    worker->duplicates++;
+                }
+                else
+                {
+                    worker->table[slot] = key;
+                    job->keep[job->part_index[i]] = 1U;
+                }
+            }
+        }
+        partition = atomic_fetch_add(&job->next_partition, 1U);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Run a stage on every worker and wait for them.
+ *
+ * @param job The import.
+ * @param stage The function of the stage.
+ * @return 1 if no worker failed, 0 if one did.
+ */
+static int32_t Dedupe_Run(Dedupe_Job_t* job, dedupe_stage_t stage)
+{
+    pthread_t threads[DEDUPE_MAX_THREADS];  /* Threads of the workers */
+    int32_t started[DEDUPE_MAX_THREADS];    /* Set for the workers with a thread of their own */
+    int32_t result = 1;                     /* Result of the stage */
+    uint32_t i = 0;                         /* Worker counter */
+
+    for (i = 1; i < job->threads; i++)
+    {
+        started[i] = (pthread_create(&threads[i], NULL, stage, &job->workers[i]) == 0) ? 1 : 0;
+    }
+    stage(&job->workers[0]);
+    for (i = 1; i < job->threads; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+        else
+        {
+            stage(&job->workers[i]);
+        }
+    }
+    for (i = 0; i < job->threads; i++)
+    {
+        result = (job->workers[i].failed != 0) ? 0 : result;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Get the number of processors.
+ *
+ * @return The number of processors, at least 1 and at most DEDUPE_MAX_THREADS.
+ */
+uint32_t Dedupe_Processors(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;           /* Description of the system */
+    long count = 0;             /* Number of processors */
+
+    GetSystemInfo(&info);
+    count = (long)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);     /* Number of processors */
+#endif
+
+    return (count < 1) ? 1U : ((count > (long)DEDUPE_MAX_THREADS) ? DEDUPE_MAX_THREADS : (uint32_t)count);
+}
+
+/**
+ * @brief Import the accounts of a memory block into a store.
+ *
+ * The block holds one account per line, "\n" or "\r\n" terminated. Empty lines are skipped.
+ *
+ * @param store The store.
+ * @param data The block.
+ * @param size The size of the block.
+ * @param config The settings of the import, NULL for one thread per processor without reports.
+ * @param stats Output, the results of the import.
+ * @param reports Output, a malloc() block holding the reports of the rejected accounts in
+ *        input order when config->keep_rejected is set, NULL otherwise. May be NULL.
+ * @param report_count Output, the number of reports. May be NULL.
+ * @return DEDUPE_OK if the accounts are imported, an error code if not.
+ */
+dedupe_status_t Dedupe_Import_Buffer(account_store_t* store, const int8_t* data, size_t size,
+                                     const Dedupe_Config_t* config, Dedupe_Stats_t* stats,
+                                     Dispatch_Report_t** reports, uint64_t* report_count)
+{
+    dedupe_status_t result = DEDUPE_OK;     /* Result of the import */
+    Dedupe_Job_t job;                       /* State shared by the threads */
+    Dedupe_Worker_t* worker = NULL;         /* Current worker */
+    uint64_t valid = 0;                     /* Valid accounts of the input */
+    uint64_t place = 0;                     /* First place of the keys of a worker in a partition */
+    uint64_t collected = 0;                 /* Reports copied */
+    uint64_t rejected = 0;                  /* Rejected accounts of every status */
+    uint64_t start = Dedupe_Now();          /* Start time of the current stage */
+    uint64_t i = 0;                         /* Key counter */
+    uint32_t w = 0;                         /* Worker counter */
+    uint32_t p = 0;                         /* Partition counter */
+    uint32_t s = 0;                         /* Status counter */
+    int32_t added = 0;                      /* Result of adding the current account */
+
+    memset(stats, 0, sizeof(Dedupe_Stats_t));
+    memset(&job, 0, sizeof(job));
+    stats->bytes = (uint64_t)size;
+    job.data = data;
+    job.keep_rejected = (config != NULL) ? config->keep_rejected : 0;
+    job.threads = (config != NULL && config->threads > 0U) ? config->threads : Dedupe_Processors();
+    job.threads = (job.threads > DEDUPE_MAX_THREADS) ? DEDUPE_MAX_THREADS : job.threads;
+    /* A small input is not worth the threads */
+    job.threads = (size / DEDUPE_MIN_RANGE + 1U < job.threads) ? (uint32_t)(size / DEDUPE_MIN_RANGE + 1U) : job.threads;
+    stats->threads = job.threads;
+    job.workers = (Dedupe_Worker_t*)calloc(job.threads, sizeof(Dedupe_Worker_t));
+    if (reports != NULL)
+    {
+        *reports = NULL;
+    }
+    if (report_count != NULL)
+    {
+        *report_count = 0;
+    }
+
+    if (job.workers == NULL)
+    {
+        result = DEDUPE_NO_MEMORY;
+    }
+    else
+    {
+        /* Check stage, each worker takes the lines of its range */
+        for (w = 0; w < job.threads; w++)
+        {
+            job.workers[w].job = &job;
+            job.workers[w].begin = Dedupe_Line_Start(data, size, (size_t)((uint64_t)size * w / job.threads));
+            job.workers[w].end = Dedupe_Line_Start(data, size, (size_t)((uint64_t)size * (w + 1U) / job.threads));
+        }
+        result = Dedupe_Run(&job, Dedupe_Check) ? DEDUPE_OK : DEDUPE_NO_MEMORY;
+        for (w = 0; w < job.threads; w++)
+        {
+            worker = &job.workers[w];
+            worker->base = valid;
+            valid += worker->count;
+            stats->accounts += worker->accounts;
+            for (s = CHAR_INVALID; s <= SEQUENCE_INVALID; s++)
+            {
+                stats->rejected[s] += worker->rejected[s];
+            }
+        }
+        stats->check_ns = Dedupe_Now() - start;
+        start = Dedupe_Now();
+
+        if (result == DEDUPE_OK && valid > UINT32_MAX)
+        {
+            result = DEDUPE_TOO_LARGE;
+        }
+        else if (result == DEDUPE_OK)
+        {
+            job.part_keys = (uint64_t*)malloc((size_t)(valid + 1U) * sizeof(uint64_t));
+            job.part_index = (uint32_t*)malloc((size_t)(valid + 1U) * sizeof(uint32_t));
+            job.keep = (uint8_t*)calloc((size_t)(valid + 1U), sizeof(uint8_t));
+            result = (job.part_keys == NULL || job.part_index == NULL || job.keep == NULL) ? DEDUPE_NO_MEMORY
+                                                                                             : DEDUPE_OK;
+        }
+
+        /* Partition stage, the keys of a partition are laid out worker after worker */
+        if (result == DEDUPE_OK)
+        {
+            Dedupe_Run(&job, Dedupe_Count);
+            for (p = 0; p < DEDUPE_PARTITIONS; p++)
+            {
+                job.part_start[p] = place;
+                for (w = 0; w < job.threads; w++)
+                {
+                    i = job.workers[w].cursors[p];
+                    job.workers[w].cursors[p] = place;
+                    place += i;
+                }
+            }
+            job.part_start[DEDUPE_PARTITIONS] = place;
+            Dedupe_Run(&job, Dedupe_Scatter);
+            stats->partition_ns = Dedupe_Now() - start;
+            start = Dedupe_Now();
+
+            /* Dedupe stage */
+            atomic_store(&job.next_partition, 0U);
+            result = Dedupe_Run(&job, Dedupe_Partitions) ? DEDUPE_OK : DEDUPE_NO_MEMORY;
+            for (w = 0; w < job.threads; w++)
+            {
+                stats->batch_duplicates += job.workers[w].duplicates;
+                free(job.workers[w].table);
+            }
+            stats->dedupe_ns = Dedupe_Now() - start;
+            start = Dedupe_Now();
+        }
+        free(job.part_keys);
+        free(job.part_index);
+
+        /* Collect the reports in input order */
+        if (result == DEDUPE_OK && job.keep_rejected && reports != NULL)
+        {
+            for (s = CHAR_INVALID; s <= SEQUENCE_INVALID; s++)
+            {
+                rejected += stats->rejected[s];
+            }
+            *reports = (Dispatch_Report_t*)malloc((size_t)(rejected + 1U) * sizeof(Dispatch_Report_t));
+            for (w = 0; (w < job.threads) && (*reports != NULL); w++)
+            {
+                memcpy(*reports + collected, job.workers[w].reports,
+                       (size_t)job.workers[w].report_count * sizeof(Dispatch_Report_t));
+                collected += job.workers[w].report_count;
+            }
+            result = (*reports == NULL) ? DEDUPE_NO_MEMORY : DEDUPE_OK;
+        }
+        if (report_count != NULL)
+        {
+            *report_count = collected;
+        }
+
+        /* Merge stage, the first occurrences go to the store in input order */
+        if (result == DEDUPE_OK)
+        {
+            Account_Store_Reserve(store, valid - stats->batch_duplicates);
+        }
+        for (w = 0; (w < job.threads) && (result == DEDUPE_OK); w++)
+        {
+            worker = &job.workers[w];
+            for (i = 0; i < worker->count; i++)
+            {
+                if (job.keep[worker->base + i])
+                {
+                    added = Account_Store_Add(store, worker->keys[i]);
+                    stats->added += (added == 1) ? 1U : 0U;
+                    stats->store_duplicates += (added == 0) ? 1U : 0U;
+                    stats->failed += (added < 0) ? 1U : 0U;
+                }
+            }
+        }
+        stats->merge_ns = (result == DEDUPE_OK) ? Dedupe_Now() - start : 0U;
+
+        for (w = 0; w < job.threads; w++)
+        {
+            free(job.workers[w].keys);
+            free(job.workers[w].reports);
+        }
+        free(job.keep);
+        free(job.workers);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Import the accounts of a file into a store.
+ *
+ * The file is read to its end, then imported with Dedupe_Import_Buffer().
+ *
+ * @param store The store.
+ * @param file The file, a pipe works too.
+ * @param config The settings of the import, NULL for one thread per processor without reports.
+ * @param stats Output, the results of the import.
+ * @param reports Output, see Dedupe_Import_Buffer(). May be NULL.
+ * @param report_count Output, the number of reports. May be NULL.
+ * @return DEDUPE_OK if the accounts are imported, an error code if not.
+ */
+dedupe_status_t Dedupe_Import_File(account_store_t* store, FILE* file, const Dedupe_Config_t* config,
+                                   Dedupe_Stats_t* stats, Dispatch_Report_t** reports, uint64_t* report_count)
+{
+    dedupe_status_t result = DEDUPE_OK;     /* Result of the import */
+    int8_t* data = NULL;                    /* The whole file */
+    uint64_t capacity = 0;                  /* Bytes the block can hold */
+    uint64_t size = 0;                      /* Bytes read */
+    size_t n = 1;                           /* Bytes of the last read */
+    uint64_t start = Dedupe_Now();          /* Start time of the reading */
+    int8_t* grown = NULL;                   /* The grown block */
+
+    memset(stats, 0, sizeof(Dedupe_Stats_t));
+    while (n > 0U && result == DEDUPE_OK)
+    {
+        if (size + DEDUPE_READ_SIZE > capacity)
+        {
+            capacity = (capacity == 0U) ? 4U * DEDUPE_READ_SIZE : 2U * capacity;
+            grown = (int8_t*)realloc(data, (size_t)capacity);
+            result = (grown == NULL) ? DEDUPE_NO_MEMORY : DEDUPE_OK;
+            data = (grown == NULL) ? data : grown;
+        }
+        if (result == DEDUPE_OK)
+        {
+            n = fread(data + size, 1U, DEDUPE_READ_SIZE, file);
+            size += n;
+        }
+    }
+    if (result == DEDUPE_OK && ferror(file))
+    {
+        result = DEDUPE_IO_ERROR;
+    }
+
+    if (result == DEDUPE_OK)
+    {
+        result = Dedupe_Import_Buffer(store, data, (size_t)size, config, stats, reports, report_count);
+        stats->load_ns = Dedupe_Now() - start - stats->check_ns - stats->partition_ns - stats->dedupe_ns
+                         - stats->merge_ns;
+    }
+    free(data);
+
+    return result;
+}
+
+/**
+ * @brief Get the message of a result of the import.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Dedupe_Status_Message(dedupe_status_t status)
+{
+    const char* message = "Unknown error";     /* Message of the result */
+
+    switch (status)
+    {
+        case DEDUPE_OK:
+        {
+            message = "Success";
+            break;
+        }
+        case DEDUPE_IO_ERROR:
+        {
+            message = "Input cannot be read";
+            break;
+        }
+        case DEDUPE_NO_MEMORY:
+        {
+            message = "Memory allocation failed";
+            break;
+        }
+        case DEDUPE_TOO_LARGE:
+        {
+            message = "Input holds more than 4294967295 valid accounts";
+            break;
+        }
+    }
+
+    return message;
+} /* EOF */
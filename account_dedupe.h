@@ -0,0 +1,137 @@
+/**
+ * @file account_dedupe.h
+ * @brief This file contains the declarations of the parallel import of large files.
+ *
+ * The import runs in four stages:
+ * 1. check: the input is cut into one range per thread at line boundaries, and every
+ *    thread checks the accounts of its range and packs them into keys,
+ * 2. partition: the keys are scattered by their hash into DEDUPE_PARTITIONS partitions,
+ *    each thread moving its own keys, so a partition keeps the input order,
+ * 3. dedupe: the threads take the partitions one by one and keep the first occurrence
+ *    of each key with a hash set of the partition,
+ * 4. merge: the first occurrences are added to the store in input order by the calling
+ *    thread, and the accounts the store already holds are counted apart.
+ * The store ends up exactly as if every account had been added one at a time.
+ *
+ * The whole input is held in memory, with about 21 more bytes per valid account.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stddef.h>             /* For size_t */
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include <stdio.h>              /* For FILE */
+#include "account_store.h"      /* For account_store_t */
+#include "account_dispatch.h"   /* For Dispatch_Report_t */
+
+#ifndef ACCOUNT_DEDUPE_H
+#define ACCOUNT_DEDUPE_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define DEDUPE_PARTITION_BITS   8U                              /* Bits of the hash that select the partition */
+#define DEDUPE_PARTITIONS       (1U << DEDUPE_PARTITION_BITS)   /* Number of partitions */
+#define DEDUPE_MAX_THREADS      64U                             /* Largest number of threads */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the results of the import.
+ */
+typedef enum
+{
+    DEDUPE_OK,                  /* The input is imported. */
+    DEDUPE_IO_ERROR,            /* The input cannot be read. */
+    DEDUPE_NO_MEMORY,           /* Memory allocation failed, the store is not changed. */
+    DEDUPE_TOO_LARGE            /* The input holds more than UINT32_MAX valid accounts. */
+} dedupe_status_t;
+
+/**
+ * @brief Structure for the settings of the import.
+ */
+typedef struct
+{
+    uint32_t threads;           /* Threads of the parallel stages, 0 for one per processor. */
+    int32_t keep_rejected;      /* 1 to hand out a report for each rejected account. */
+} Dedupe_Config_t;
+
+/**
+ * @brief Structure for the results of the import.
+ */
+typedef struct
+{
+    uint64_t bytes;             /* Bytes of the input. */
+    uint64_t accounts;          /* Accounts read, the non-empty lines. */
+    uint64_t rejected[SEQUENCE_INVALID + 1];    /* Rejected accounts, by status_enum_t. */
+    uint64_t batch_duplicates;  /* Valid accounts found earlier in the input. */
+    uint64_t store_duplicates;  /* First occurrences already in the store. */
+    uint64_t added;             /* Accounts added to the store. */
+    uint64_t failed;            /* Accounts not added because memory allocation failed. */
+    uint32_t threads;           /* Threads used. */
+    uint64_t load_ns;           /* Time of reading the input. */
+    uint64_t check_ns;          /* Time of the check stage. */
+    uint64_t partition_ns;      /* Time of the partition stage. */
+    uint64_t dedupe_ns;         /* Time of the dedupe stage. */
+    uint64_t merge_ns;          /* Time of the merge stage. */
+} Dedupe_Stats_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Get the number of processors.
+ *
+ * @return The number of processors, at least 1 and at most DEDUPE_MAX_THREADS.
+ */
+uint32_t Dedupe_Processors(void);
+
+/**
+ * @brief Import the accounts of a memory block into a store.
+ *
+ * The block holds one account per line, "\n" or "\r\n" terminated. Empty lines are skipped.
+ *
+ * @param store The store.
+ * @param data The block.
+ * @param size The size of the block.
+ * @param config The settings of the import, NULL for one thread per processor without reports.
+ * @param stats Output, the results of the import.
+ * @param reports Output, a malloc() block holding the reports of the rejected accounts in
+ *        input order when config->keep_rejected is set, NULL otherwise. May be NULL.
+ * @param report_count Output, the number of reports. May be NULL.
+ * @return DEDUPE_OK if the accounts are imported, an error code if not.
+ */
+dedupe_status_t Dedupe_Import_Buffer(account_store_t* store, const int8_t* data, size_t size,
+                                     const Dedupe_Config_t* config, Dedupe_Stats_t* stats,
+                                     Dispatch_Report_t** reports, uint64_t* report_count);
+
+/**
+ * @brief Import the accounts of a file into a store.
+ *
+ * The file is read to its end, then imported with Dedupe_Import_Buffer().
+ *
+ * @param store The store.
+ * @param file The file, a pipe works too.
+ * @param config The settings of the import, NULL for one thread per processor without reports.
+ * @param stats Output, the results of the import.
+ * @param reports Output, see Dedupe_Import_Buffer(). May be NULL.
+ * @param report_count Output, the number of reports. May be NULL.
+ * @return DEDUPE_OK if the accounts are imported, an error code if not.
+ */
+dedupe_status_t Dedupe_Import_File(account_store_t* store, FILE* file, const Dedupe_Config_t* config,
+                                   Dedupe_Stats_t* stats, Dispatch_Report_t** reports, uint64_t* report_count);
+
+/**
+ * @brief Get the message of a result of the import.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Dedupe_Status_Message(dedupe_status_t status);
+
+#endif /* ACCOUNT_DEDUPE_H */
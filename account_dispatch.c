@@ -0,0 +1,397 @@
+/**
+ * @file account_dispatch.c
+ * @brief This file contains the implementation of the asynchronous delivery of rejected accounts.
+ *
+ * The ring is a bounded queue where every slot carries a sequence number: a producer claims
+ * a position by moving the tail with a compare-and-swap once the slot of that position is
+ * free, writes the report and publishes it by setting the sequence. The single consumer reads
+ * the slots in order and frees each one for the position one turn of the ring later.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdlib.h>             /* For malloc(), free() */
+#include <string.h>             /* For memset(), memcpy() */
+#include <sched.h>              /* For sched_yield() */
+#include "account_dispatch.h"   /* Include header file of this function file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define DISPATCH_CACHE_LINE     64U     /* Alignment of the slots */
+#define DISPATCH_SPINS          64U     /* Empty polls of the consumer before it sleeps */
+
+_Static_assert(sizeof(Dispatch_Slot_t) == DISPATCH_CACHE_LINE, "a slot must fill one cache line");
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Wake the consumer if it sleeps.
+ *
+ * The fence orders the report published before it with the read of the sleeping flag;
+ * the consumer sets the flag and reads the ring the other way round, so at least one
+ * of them sees the other.
+ *
+ * @param dispatcher The dispatcher.
+ */
+static void Dispatch_Wake(Dispatcher_t* dispatcher)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&dispatcher->sleeping, memory_order_relaxed) != 0)
+    {
+        pthread_mutex_lock(&dispatcher->lock);
+        pthread_cond_signal(&dispatcher->wake);
+        pthread_mutex_unlock(&dispatcher->lock);
+    }
+}
+
+/**
+ * @brief Check if the consumer has something to deliver.
+ *
+ * @param dispatcher The dispatcher.
+ * @return 1 if a report is in the ring or a summary is waiting, 0 if not.
+ */
+static int32_t Dispatch_Pending(Dispatcher_t* dispatcher)
+{
+    const Dispatch_Slot_t* slot = &dispatcher->slots[dispatcher->head & dispatcher->mask];  /* Next slot read */
+    int32_t pending = 0;        /* Result of the check */
+    uint32_t i = 0;             /* Status counter */
+
+    pending = (atomic_load_explicit(&slot->sequence, memory_order_acquire) == dispatcher->head + 1U) ? 1 : 0;
+    for (i = 0; (i < DISPATCH_MAX_STATUS) && (pending == 0); i++)
+    {
+        pending = (atomic_load_explicit(&dispatcher->folded[i], memory_order_relaxed) != 0U) ? 1 : 0;
+    }
+
+    return pending;
+}
+
+/**
+ * @brief Read the next reports of the ring and the waiting summaries into the batch.
+ *
+ * @param dispatcher The dispatcher.
+ * @return The number of reports in the batch.
+ */
+static uint32_t Dispatch_Take(Dispatcher_t* dispatcher)
+{
+    Dispatch_Slot_t* slot = NULL;   /* Current slot */
+    Dispatch_Report_t* summary;     /* Summary being filled */
+    uint64_t folded = 0;            /* Reports folded into the current summary */
+    uint32_t n = 0;                 /* Reports in the batch */
+    uint32_t i = 0;                 /* Status counter */
+    int32_t empty = 0;              /* Set once the next slot is not written yet */
+
+    while ((n < dispatcher->config.batch) && (empty == 0))
+    {
+        slot = &dispatcher->slots[dispatcher->head & dispatcher->mask];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != dispatcher->head + 1U)
+        {
+            empty = 1;
+        }
+        else
+        {
+            dispatcher->batch[n++] = slot->report;
+            /* Free the slot for the producer of the next turn */
+            atomic_store_explicit(&slot->sequence, dispatcher->head + dispatcher->mask + 1U, memory_order_release);
+            dispatcher->head++;
+        }
+    }
+
+    /* The batch has room for one summary per status */
+    for (i = 0; i < DISPATCH_MAX_STATUS; i++)
+    {
+        if (atomic_load_explicit(&dispatcher->folded[i], memory_order_relaxed) != 0U)
+        {
+            folded = atomic_exchange_explicit(&dispatcher->folded[i], 0U, memory_order_acquire);
+            summary = &dispatcher->batch[n++];
+            memset(summary, 0, sizeof(Dispatch_Report_t));
+            summary->offset = atomic_load_explicit(&dispatcher->folded_offset[i], memory_order_relaxed);
+            summary->repeats = folded;
+            summary->status = (uint8_t)i;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Body of the consumer thread.
+ *
+ * @param argument The dispatcher.
+ * @return NULL.
+ */
+static void* Dispatch_Consumer(void* argument)
+{
+    Dispatcher_t* dispatcher = (Dispatcher_t*)argument;     /* The dispatcher served by the thread */
+    uint64_t delivered = 0;     /* Reports of the current batch, summaries counted with their repeats */
+    uint32_t spins = 0;         /* Empty polls since the last batch */
+    uint32_t n = 0;             /* Reports in the current batch */
+    uint32_t i = 0;             /* Report counter */
+    int32_t stop = 0;           /* Set once the ring is empty after the stop request */
+
+    while (stop == 0)
+    {
+        n = Dispatch_Take(dispatcher);
+        if (n > 0U)
+        {
+            dispatcher->callback(dispatcher->batch, n, dispatcher->user_data);
+            delivered = 0;
+            for (i = 0; i < n; i++)
+            {
+                delivered += dispatcher->batch[i].repeats;
+            }
+            atomic_fetch_add_explicit(&dispatcher->batches, 1U, memory_order_relaxed);
+            atomic_fetch_add_explicit(&dispatcher->delivered, delivered, memory_order_release);
+            spins = 0;
+        }
+        else if (atomic_load_explicit(&dispatcher->stopping, memory_order_acquire) != 0)
+        {
+            stop = 1;
+        }
+        else if (spins < DISPATCH_SPINS)
+        {
+            /* Reports often come in bursts, poll a little before sleeping */
+            spins++;
+            sched_yield();
+        }
+        else
+        {
+            pthread_mutex_lock(&dispatcher->lock);
+            atomic_store_explicit(&dispatcher->sleeping, 1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            if ((Dispatch_Pending(dispatcher) == 0)
+                && (atomic_load_explicit(&dispatcher->stopping, memory_order_relaxed) == 0))
+            {
+                pthread_cond_wait(&dispatcher->wake, &dispatcher->lock);
+            }
+            atomic_store_explicit(&dispatcher->sleeping, 0, memory_order_relaxed);
+            pthread_mutex_unlock(&dispatcher->lock);
+            spins = 0;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Allocate the ring and start the consumer thread.
+ *
+ * @param dispatcher The dispatcher, stopped.
+ * @param config The settings, NULL for DISPATCH_BLOCK with the default sizes.
+ * @param callback The function receiving the reports.
+ * @param user_data A pointer given back to the callback.
+ * @return 1 if the dispatcher is started, 0 if memory allocation or thread creation failed.
+ */
+int32_t Dispatch_Start(Dispatcher_t* dispatcher, const Dispatch_Config_t* config, dispatch_callback_t callback,
+                       void* user_data)
+{
+    Dispatch_Config_t defaults = { DISPATCH_BLOCK, DISPATCH_DEFAULT_CAPACITY, DISPATCH_DEFAULT_BATCH };
+    uint64_t slots = 2U;        /* Number of slots, a power of 2 */
+    uint64_t i = 0;             /* Slot counter */
+    int32_t result = 1;         /* Result of the start */
+
+    memset(dispatcher, 0, sizeof(Dispatcher_t));
+    dispatcher->config = (config != NULL) ? *config : defaults;
+    dispatcher->callback = callback;
+    dispatcher->user_data = user_data;
+
+    while (slots < dispatcher->config.capacity)
+    {
+        slots *= 2U;
+    }
+    dispatcher->config.capacity = (uint32_t)slots;
+    dispatcher->mask = slots - 1U;
+    if (dispatcher->config.batch == 0U || dispatcher->config.batch > dispatcher->config.capacity)
+    {
+        dispatcher->config.batch = dispatcher->config.capacity;
+    }
+
+    /* Allocate one extra cache line so the ring can be aligned */
+    dispatcher->memory = malloc((size_t)slots * sizeof(Dispatch_Slot_t) + DISPATCH_CACHE_LINE);
+    dispatcher->batch = (Dispatch_Report_t*)malloc((dispatcher->config.batch + DISPATCH_MAX_STATUS)
+                                                    * sizeof(Dispatch_Report_t));
+    if (dispatcher->memory == NULL || dispatcher->batch == NULL)
+    {
+        result = 0;
+    }
+    else
+    {
+        dispatcher->slots = (Dispatch_Slot_t*)(((uintptr_t)dispatcher->memory + DISPATCH_CACHE_LINE - 1U)
+                                               & ~(uintptr_t)(DISPATCH_CACHE_LINE - 1U));
+        for (i = 0; i < slots; i++)
+        {
+            atomic_init(&dispatcher->slots[i].sequence, i);
+        }
+        pthread_mutex_init(&dispatcher->lock, NULL);
+        pthread_cond_init(&dispatcher->wake, NULL);
+        if (pthread_create(&dispatcher->consumer, NULL, Dispatch_Consumer, dispatcher) != 0)
+        {
+            pthread_cond_destroy(&dispatcher->wake);
+            pthread_mutex_destroy(&dispatcher->lock);
+            result = 0;
+        }
+        else
+        {
+            dispatcher->running = 1;
+        }
+    }
+
+    if (result == 0)
+    {
+        free(dispatcher->memory);
+        free(dispatcher->batch);
+        dispatcher->memory = NULL;
+        dispatcher->slots = NULL;
+        dispatcher->batch = NULL;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Report a rejected account.
+ *
+ * Any number of threads may report at the same time.
+ *
+ * @param dispatcher The dispatcher, started.
+ * @param status The status of the account, smaller than DISPATCH_MAX_STATUS.
+ * @param offset The position of the account in the input.
+ * @param ptr The account.
+ * @param length The length of the account.
+ * @return 1 if the report is in the ring, 0 if it was dropped or folded into a summary.
+ */
+int32_t Dispatch_Report(Dispatcher_t* dispatcher, uint32_t status, uint64_t offset, const int8_t* ptr,
+                        uint32_t length)
+{
+    Dispatch_Slot_t* slot = NULL;   /* Slot of the claimed position */
+    uint64_t position = atomic_load_explicit(&dispatcher->tail, memory_order_relaxed);  /* Position to claim */
+    int64_t lag = 0;                /* Sequence of the slot minus the position */
+    uint32_t copied = (length < DISPATCH_TOKEN_SIZE) ? length : DISPATCH_TOKEN_SIZE;    /* Bytes of the copy */
+    int32_t queued = 0;             /* Set once the report is in the ring */
+    int32_t done = 0;               /* Set once the report is placed, dropped or folded */
+    int32_t waited = 0;             /* Set if the report waited for room */
+
+    while (done == 0)
+    {
+        slot = &dispatcher->slots[position & dispatcher->mask];
+        lag = (int64_t)(atomic_load_explicit(&slot->sequence, memory_order_acquire) - position);
+        if (lag == 0)
+        {
+            /* The slot is free, claim its position */
+            if (atomic_compare_exchange_weak_explicit(&dispatcher->tail, &position, position + 1U,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                slot->report.offset = offset;
+                slot->report.repeats = 1U;
+                slot->report.status = (uint8_t)status;
+                slot->report.length = (length > UINT8_MAX) ? (uint8_t)UINT8_MAX : (uint8_t)length;
+                memcpy(slot->report.token, ptr, copied);
+                slot->report.token[copied] = '\0';
+                atomic_store_explicit(&slot->sequence, position + 1U, memory_order_release);
+                queued = 1;
+                done = 1;
+            }
+        }
+        else if (lag > 0)
+        {
+            /* Another thread claimed the position first */
+            position = atomic_load_explicit(&dispatcher->tail, memory_order_relaxed);
+        }
+        else if (dispatcher->config.policy == DISPATCH_BLOCK)
+        {
+            /* The ring is full, let the consumer make room */
+            waited = 1;
+            Dispatch_Wake(dispatcher);
+            sched_yield();
+            position = atomic_load_explicit(&dispatcher->tail, memory_order_relaxed);
+        }
+        else if (dispatcher->config.policy == DISPATCH_DROP)
+        {
+            atomic_fetch_add_explicit(&dispatcher->dropped, 1U, memory_order_relaxed);
+            done = 1;
+        }
+        else
+        {
+            atomic_store_explicit(&dispatcher->folded_offset[status], offset, memory_order_relaxed);
+            atomic_fetch_add_explicit(&dispatcher->folded[status], 1U, memory_order_release);
+            atomic_fetch_add_explicit(&dispatcher->coalesced, 1U, memory_order_relaxed);
+            done = 1;
+        }
+    }
+
+    if (waited != 0)
+    {
+        atomic_fetch_add_explicit(&dispatcher->blocked, 1U, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&dispatcher->reported, 1U, memory_order_release);
+    Dispatch_Wake(dispatcher);
+
+    return queued;
+}
+
+/**
+ * @brief Wait until every report made before the call is delivered or dropped.
+ *
+ * @param dispatcher The dispatcher, started.
+ */
+void Dispatch_Flush(Dispatcher_t* dispatcher)
+{
+    uint64_t reported = atomic_load_explicit(&dispatcher->reported, memory_order_acquire);  /* Reports to wait for */
+
+    while (atomic_load_explicit(&dispatcher->delivered, memory_order_acquire)
+           + atomic_load_explicit(&dispatcher->dropped, memory_order_relaxed) < reported)
+    {
+        Dispatch_Wake(dispatcher);
+        sched_yield();
+    }
+}
+
+/**
+ * @brief Deliver the remaining reports, stop the consumer thread and release the ring.
+ *
+ * No report may be made during or after the call. Nothing is done for a stopped dispatcher.
+ *
+ * @param dispatcher The dispatcher.
+ */
+void Dispatch_Stop(Dispatcher_t* dispatcher)
+{
+    if (dispatcher->running != 0)
+    {
+        atomic_store_explicit(&dispatcher->stopping, 1, memory_order_release);
+        pthread_mutex_lock(&dispatcher->lock);
+        pthread_cond_signal(&dispatcher->wake);
+        pthread_mutex_unlock(&dispatcher->lock);
+        pthread_join(dispatcher->consumer, NULL);
+        pthread_cond_destroy(&dispatcher->wake);
+        pthread_mutex_destroy(&dispatcher->lock);
+        dispatcher->running = 0;
+
+        /* The counters stay readable */
+        free(dispatcher->memory);
+        free(dispatcher->batch);
+        dispatcher->memory = NULL;
+        dispatcher->slots = NULL;
+        dispatcher->batch = NULL;
+    }
+}
+
+/**
+ * @brief Get the counters of a dispatcher.
+ *
+ * @param dispatcher The dispatcher.
+ * @param stats Output, the counters.
+ */
+void Dispatch_Get_Stats(Dispatcher_t* dispatcher, Dispatch_Stats_t* stats)
+{
+    stats->reported = atomic_load_explicit(&dispatcher->reported, memory_order_relaxed);
+    stats->delivered = atomic_load_explicit(&dispatcher->delivered, memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&dispatcher->dropped, memory_order_relaxed);
+    stats->coalesced = atomic_load_explicit(&dispatcher->coalesced, memory_order_relaxed);
+    stats->blocked = atomic_load_explicit(&dispatcher->blocked, memory_order_relaxed);
+    stats->batches = atomic_load_explicit(&dispatcher->batches, memory_order_relaxed);
+} /* EOF */
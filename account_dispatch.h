@@ -0,0 +1,196 @@
+/**
+ * @file account_dispatch.h
+ * @brief This file contains the declarations of the asynchronous delivery of rejected accounts.
+ *
+ * A dispatcher takes the reports of rejected accounts off the checking threads. Each report
+ * (status, position of the account in the input and a copy of its first bytes) is written
+ * to a bounded ring without locks, by any number of threads. One consumer thread reads the
+ * ring and passes the reports to the callback in batches, so the checks never wait for the
+ * console or the file the callback writes to.
+ *
+ * When the ring is full the policy of the dispatcher decides what happens to a new report:
+ * - DISPATCH_BLOCK: the thread waits until the consumer makes room, nothing is lost.
+ * - DISPATCH_DROP: the report is dropped and counted.
+ * - DISPATCH_COALESCE: the report is folded into a summary per status (a count and the
+ *   position of the last folded account), delivered once the ring has room again.
+ *
+ * The reports of one thread are delivered in the order they were made. Summaries are
+ * delivered after the batch that was read when they were taken.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include <stdatomic.h>          /* For the positions of the ring */
+#include <pthread.h>            /* For the consumer thread */
+
+#ifndef ACCOUNT_DISPATCH_H
+#define ACCOUNT_DISPATCH_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define DISPATCH_TOKEN_SIZE         35U     /* Bytes of a rejected account kept in a report */
+#define DISPATCH_MAX_STATUS         8U      /* Statuses are smaller than this */
+#define DISPATCH_DEFAULT_CAPACITY   4096U   /* Reports the ring holds by default */
+#define DISPATCH_DEFAULT_BATCH      256U    /* Largest batch passed to the callback by default */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for what happens to a report when the ring is full.
+ */
+typedef enum
+{
+    DISPATCH_BLOCK,             /* Wait for the consumer. */
+    DISPATCH_DROP,              /* Drop the report and count it. */
+    DISPATCH_COALESCE           /* Fold the report into the summary of its status. */
+} dispatch_policy_t;
+
+/**
+ * @brief Structure for the report of a rejected account.
+ */
+typedef struct
+{
+    uint64_t offset;                        /* Position of the account in the input. */
+    uint64_t repeats;                       /* 1, or the number of reports folded into a summary. */
+    uint8_t status;                         /* Status of the account. */
+    uint8_t length;                         /* Length of the account up to 255, 0 in a summary. The copy holds at most DISPATCH_TOKEN_SIZE bytes. */
+    int8_t token[DISPATCH_TOKEN_SIZE + 1U]; /* First bytes of the account, NUL terminated, empty in a summary. */
+} Dispatch_Report_t;
+
+/**
+ * @brief Structure for a slot of the ring, one cache line.
+ */
+typedef struct
+{
+    _Atomic uint64_t sequence;  /* Position the slot is ready to be written for, plus 1 once written. */
+    Dispatch_Report_t report;   /* The report. */
+} Dispatch_Slot_t;
+
+/**
+ * @brief Type for the function receiving the reports.
+ *
+ * It is called from the consumer thread only, so it does not have to be reentrant.
+ *
+ * @param reports The reports, in order.
+ * @param n The number of reports.
+ * @param user_data The pointer given to Dispatch_Start().
+ */
+typedef void (*dispatch_callback_t)(const Dispatch_Report_t* reports, uint32_t n, void* user_data);
+
+/**
+ * @brief Structure for the settings of a dispatcher.
+ */
+typedef struct
+{
+    dispatch_policy_t policy;   /* What happens to a report when the ring is full. */
+    uint32_t capacity;          /* Reports the ring holds, rounded up to a power of 2. */
+    uint32_t batch;             /* Largest number of reports passed to the callback at once. */
+} Dispatch_Config_t;
+
+/**
+ * @brief Structure for the counters of a dispatcher.
+ */
+typedef struct
+{
+    uint64_t reported;          /* Reports made. */
+    uint64_t delivered;         /* Reports passed to the callback, those folded into summaries included. */
+    uint64_t dropped;           /* Reports dropped by DISPATCH_DROP. */
+    uint64_t coalesced;         /* Reports folded into summaries by DISPATCH_COALESCE. */
+    uint64_t blocked;           /* Reports that waited for room with DISPATCH_BLOCK. */
+    uint64_t batches;           /* Calls of the callback. */
+} Dispatch_Stats_t;
+
+/**
+ * @brief Structure for a dispatcher.
+ *
+ * A zero-initialized structure is a stopped dispatcher.
+ */
+typedef struct
+{
+    void* memory;                                       /* Memory of the ring, NULL if the dispatcher is stopped. */
+    Dispatch_Slot_t* slots;                             /* The ring, aligned on a cache line. */
+    uint64_t mask;                                      /* Number of slots minus 1. */
+    Dispatch_Config_t config;                           /* Settings of the dispatcher. */
+    dispatch_callback_t callback;                       /* Function receiving the reports. */
+    void* user_data;                                    /* Passed to the callback. */
+    Dispatch_Report_t* batch;                           /* Reports of the current batch, owned by the consumer. */
+    uint64_t head;                                      /* Next position read by the consumer. */
+    _Alignas(64) _Atomic uint64_t tail;                 /* Next position written by the producers. */
+    _Alignas(64) _Atomic uint64_t reported;             /* Reports made. */
+    _Atomic uint64_t dropped;                           /* Reports dropped. */
+    _Atomic uint64_t blocked;                           /* Reports that waited for room. */
+    _Atomic uint64_t folded[DISPATCH_MAX_STATUS];       /* Reports of each status waiting in a summary. */
+    _Atomic uint64_t folded_offset[DISPATCH_MAX_STATUS];    /* Position of the last report folded for each status. */
+    _Atomic uint64_t coalesced;                         /* Reports folded into summaries. */
+    _Alignas(64) _Atomic uint64_t delivered;            /* Reports passed to the callback. */
+    _Atomic uint64_t batches;                           /* Calls of the callback. */
+    _Atomic int32_t sleeping;                           /* Set while the consumer may wait on wake. */
+    _Atomic int32_t stopping;                           /* Asks the consumer to stop once the ring is empty. */
+    pthread_mutex_t lock;                               /* Protects the sleep of the consumer. */
+    pthread_cond_t wake;                                /* Wakes the consumer. */
+    pthread_t consumer;                                 /* The consumer thread. */
+    int32_t running;                                    /* Set while the consumer thread exists. */
+} Dispatcher_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Allocate the ring and start the consumer thread.
+ *
+ * @param dispatcher The dispatcher, stopped.
+ * @param config The settings, NULL for DISPATCH_BLOCK with the default sizes.
+ * @param callback The function receiving the reports.
+ * @param user_data A pointer given back to the callback.
+ * @return 1 if the dispatcher is started, 0 if memory allocation or thread creation failed.
+ */
+int32_t Dispatch_Start(Dispatcher_t* dispatcher, const Dispatch_Config_t* config, dispatch_callback_t callback,
+                       void* user_data);
+
+/**
+ * @brief Report a rejected account.
+ *
+ * Any number of threads may report at the same time.
+ *
+ * @param dispatcher The dispatcher, started.
+ * @param status The status of the account, smaller than DISPATCH_MAX_STATUS.
+ * @param offset The position of the account in the input.
+ * @param ptr The account.
+ * @param length The length of the account.
+ * @return 1 if the report is in the ring, 0 if it was dropped or folded into a summary.
+ */
+int32_t Dispatch_Report(Dispatcher_t* dispatcher, uint32_t status, uint64_t offset, const int8_t* ptr,
+                        uint32_t length);
+
+/**
+ * @brief Wait until every report made before the call is delivered or dropped.
+ *
+ * @param dispatcher The dispatcher, started.
+ */
+void Dispatch_Flush(Dispatcher_t* dispatcher);
+
+/**
+ * @brief Deliver the remaining reports, stop the consumer thread and release the ring.
+ *
+ * No report may be made during or after the call. Nothing is done for a stopped dispatcher.
+ *
+ * @param dispatcher The dispatcher.
+ */
+void Dispatch_Stop(Dispatcher_t* dispatcher);
+
+/**
+ * @brief Get the counters of a dispatcher.
+ *
+ * @param dispatcher The dispatcher.
+ * @param stats Output, the counters.
+ */
+void Dispatch_Get_Stats(Dispatcher_t* dispatcher, Dispatch_Stats_t* stats);
+
+#endif /* ACCOUNT_DISPATCH_H */
@@ -0,0 +1,318 @@
+/**
+ * @file account_epoch.c
+ * @brief This file contains the implementation of the epoch-based memory reclamation.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdlib.h>             /* For malloc(), free() */
+#include <stdatomic.h>          /* For the epochs shared with the readers */
+#include <pthread.h>            /* For the lock of the retired blocks */
+#include <sched.h>              /* For sched_yield() */
+#include "account_epoch.h"      /* Include header file of this function file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define EPOCH_CACHE_LINE        64U     /* Each slot has its own cache line */
+#define EPOCH_IDLE              0U      /* Epoch of a slot outside any read section */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for the slot of a reading thread.
+ */
+typedef struct
+{
+    _Alignas(EPOCH_CACHE_LINE) _Atomic uint64_t epoch;  /* Epoch the read section started in, EPOCH_IDLE outside. */
+    _Atomic int32_t taken;                              /* Set while a thread owns the slot. */
+} Epoch_Slot_t;
+
+/**
+ * @brief Structure for a slot shared by the threads that found no slot of their own.
+ *
+ * The slot keeps the epoch of its first reader until its last reader leaves.
+ */
+typedef struct
+{
+    _Alignas(EPOCH_CACHE_LINE) _Atomic uint64_t epoch;  /* Epoch of the oldest reader, EPOCH_IDLE without reader. */
+    uint32_t readers;                                   /* Read sections inside, changed under epoch_shared_lock. */
+} Epoch_Shared_t;
+
+/**
+ * @brief Structure for a retired block waiting to be freed.
+ */
+typedef struct Epoch_Retired
+{
+    void* block;                    /* The block. */
+    epoch_free_t release;           /* The function releasing the block. */
+    uint64_t epoch;                 /* Epoch the block was retired in. */
+    struct Epoch_Retired* next;     /* Next retired block. */
+} Epoch_Retired_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static _Atomic uint64_t epoch_global = 1U;                  /* Current epoch, never EPOCH_IDLE */
+static Epoch_Slot_t epoch_slots[EPOCH_MAX_THREADS];         /* Slots of the reading threads */
+static pthread_mutex_t epoch_lock = PTHREAD_MUTEX_INITIALIZER;  /* Protects the retired list */
+static Epoch_Retired_t* epoch_retired = NULL;               /* Blocks waiting to be freed */
+static Epoch_Shared_t epoch_shared[2];                      /* Slots shared once every slot is taken */
+static uint32_t epoch_shared_current = 0;                   /* Shared slot new readers join */
+static pthread_mutex_t epoch_shared_lock = PTHREAD_MUTEX_INITIALIZER;   /* Protects the shared slots */
+static pthread_once_t epoch_key_once = PTHREAD_ONCE_INIT;   /* Creates epoch_key once */
+static pthread_key_t epoch_key;                             /* Gives the slot of a thread back when it ends */
+static _Thread_local Epoch_Slot_t* epoch_self = NULL;       /* Slot of the calling thread */
+static _Thread_local Epoch_Shared_t* epoch_joined = NULL;   /* Shared slot of the current read section, if any */
+static _Thread_local uint32_t epoch_depth = 0;              /* Nesting of the read sections of the calling thread */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Find the oldest epoch a reader is still in.
+ *
+ * @return The oldest epoch of the read sections, UINT64_MAX if there is no reader.
+ */
+static uint64_t Epoch_Oldest(void)
+{
+    uint64_t oldest = UINT64_MAX;   /* Oldest epoch found */
+    uint64_t epoch = 0;             /* Epoch of the current slot */
+    uint32_t i = 0;                 /* Slot counter */
+
+    for (i = 0; i < EPOCH_MAX_THREADS + 2U; i++)
+    {
+        epoch = (i < EPOCH_MAX_THREADS) ? atomic_load(&epoch_slots[i].epoch)
+                                        : atomic_load(&epoch_shared[i - EPOCH_MAX_THREADS].epoch);
+        if (epoch != EPOCH_IDLE && epoch < oldest)
+        {
+            oldest = epoch;
+        }
+    }
+
+    return oldest;
+}
+
+/**
+ * @brief Free the retired blocks no reader can see. The lock must be held.
+ *
+ * @param oldest The oldest epoch of the read sections.
+ */
+static void Epoch_Reclaim_Locked(uint64_t oldest)
+{
+    Epoch_Retired_t** link = &epoch_retired;    /* Link to the current block */
+    Epoch_Retired_t* current = NULL;            /* Current block */
+
+    while (*link != NULL)
+    {
+        current = *link;
+        /* A reader that started in the epoch of the block may still see it */
+        if (current->epoch < oldest)
+        {
+            *link = current->next;
+            current->release(current->block);
+            free(current);
+        }
+        else
+        {
+            link = &current->next;
+        }
+    }
+}
+
+/**
+ * @brief Give the slot of a thread that ended back.
+ *
+ * @param slot The slot of the thread, an Epoch_Slot_t*.
+ */
+static void Epoch_Release_Slot(void* slot)
+{
+    atomic_store(&((Epoch_Slot_t*)slot)->epoch, EPOCH_IDLE);
+    atomic_store(&((Epoch_Slot_t*)slot)->taken, 0);
+}
+
+/**
+ * @brief Create the key that gives the slots of the ending threads back.
+ */
+static void Epoch_Create_Key(void)
+{
+    pthread_key_create(&epoch_key, Epoch_Release_Slot);
+}
+
+/**
+ * @brief Take a free slot for the calling thread, if there is one.
+ */
+static void Epoch_Take_Slot(void)
+{
+    uint32_t i = 0;             /* Slot counter */
+    int32_t expected = 0;       /* Value of a free slot */
+
+    pthread_once(&epoch_key_once, Epoch_Create_Key);
+    for (i = 0; (i < EPOCH_MAX_THREADS) && (epoch_self == NULL); i++)
+    {
+        expected = 0;
+        if (atomic_compare_exchange_strong(&epoch_slots[i].taken, &expected, 1))
+        {
+            epoch_self = &epoch_slots[i];
+            pthread_setspecific(epoch_key, epoch_self);
+        }
+    }
+}
+
+/**
+ * @brief Start a read section in a shared slot.
+ *
+ * Once a block was retired after the readers of the current shared slot entered, new
+ * readers join the other slot as soon as it is empty. The old slot then drains, so a
+ * steady flow of readers does not hold back the blocks forever.
+ */
+static void Epoch_Join_Shared(void)
+{
+    Epoch_Shared_t* shared = NULL;      /* Slot joined */
+    Epoch_Shared_t* other = NULL;       /* The other shared slot */
+
+    pthread_mutex_lock(&epoch_shared_lock);
+    shared = &epoch_shared[epoch_shared_current];
+    other = &epoch_shared[1U - epoch_shared_current];
+    if (shared->readers > 0U && other->readers == 0U
+        && atomic_load(&shared->epoch) < atomic_load(&epoch_global))
+    {
+        epoch_shared_current = 1U - epoch_shared_current;
+        shared = other;
+    }
+    if (shared->readers == 0U)
+    {
+        atomic_store(&shared->epoch, atomic_load(&epoch_global));
+    }
+    shared->readers++;
+    pthread_mutex_unlock(&epoch_shared_lock);
+    epoch_joined = shared;
+}
+
+/**
+ * @brief Start a read section in the calling thread.
+ *
+ * The first call of a thread takes one of the EPOCH_MAX_THREADS slots, which the thread
+ * gives back when it ends. While every slot is taken, the read sections of the other
+ * threads share two slots behind a lock, so a thread is always protected, only more
+ * slowly. Read sections may be nested.
+ */
+void Epoch_Enter(void)
+{
+    if (epoch_depth++ == 0U)
+    {
+        /* A thread without a slot tries again, a slot may have been given back since */
+        if (epoch_self == NULL)
+        {
+            Epoch_Take_Slot();
+        }
+        /* The announcement must be visible before any shared pointer is read */
+        if (epoch_self != NULL)
+        {
+            atomic_store(&epoch_self->epoch, atomic_load(&epoch_global));
+        }
+        else
+        {
+            Epoch_Join_Shared();
+        }
+    }
+}
+
+/**
+ * @brief End the read section of the calling thread.
+ */
+void Epoch_Exit(void)
+{
+    if (--epoch_depth == 0U)
+    {
+        if (epoch_joined != NULL)
+        {
+            pthread_mutex_lock(&epoch_shared_lock);
+            epoch_joined->readers--;
+            if (epoch_joined->readers == 0U)
+            {
+                atomic_store(&epoch_joined->epoch, EPOCH_IDLE);
+            }
+            pthread_mutex_unlock(&epoch_shared_lock);
+            epoch_joined = NULL;
+        }
+        else
+        {
+            atomic_store_explicit(&epoch_self->epoch, EPOCH_IDLE, memory_order_release);
+        }
+    }
+}
+
+/**
+ * @brief Free a block once no reader can see it any more.
+ *
+ * The block must already be unlinked from every shared structure.
+ *
+ * @param block The block.
+ * @param release The function releasing the block.
+ */
+void Epoch_Retire(void* block, epoch_free_t release)
+{
+    Epoch_Retired_t* retired = (Epoch_Retired_t*)malloc(sizeof(Epoch_Retired_t));
+
+    if (retired == NULL)
+    {
+        /* Without memory to queue the block, wait for the readers that may see it */
+        Epoch_Flush();
+        release(block);
+    }
+    else
+    {
+        pthread_mutex_lock(&epoch_lock);
+        retired->block = block;
+        retired->release = release;
+        /* Readers that start from now on are in a later epoch and cannot see the block */
+        retired->epoch = atomic_fetch_add(&epoch_global, 1U);
+        retired->next = epoch_retired;
+        epoch_retired = retired;
+        Epoch_Reclaim_Locked(Epoch_Oldest());
+        pthread_mutex_unlock(&epoch_lock);
+    }
+}
+
+/**
+ * @brief Wait for the current readers and free every retired block.
+ *
+ * The calling thread must not be inside a read section.
+ */
+void Epoch_Flush(void)
+{
+    uint64_t epoch = 0;         /* Epoch every retired block is older than */
+
+    pthread_mutex_lock(&epoch_lock);
+    epoch = atomic_fetch_add(&epoch_global, 1U);
+    /* Readers that started before the new epoch may still see a retired block */
+    while (Epoch_Oldest() <= epoch)
+    {
+        sched_yield();
+    }
+    Epoch_Reclaim_Locked(UINT64_MAX);
+    pthread_mutex_unlock(&epoch_lock);
+}
+
+/**
+ * @brief Give the slot of the calling thread back.
+ *
+ * A thread gives its slot back when it ends, this function only does it sooner. It
+ * must not be called inside a read section.
+ */
+void Epoch_Thread_Exit(void)
+{
+    if (epoch_self != NULL)
+    {
+        /* The slot must not be given back a second time when the thread ends */
+        pthread_setspecific(epoch_key, NULL);
+        Epoch_Release_Slot(epoch_self);
+        epoch_self = NULL;
+    }
+} /* EOF */
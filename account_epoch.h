@@ -0,0 +1,81 @@
+/**
+ * @file account_epoch.h
+ * @brief This file contains the declarations of the epoch-based memory reclamation.
+ *
+ * Readers of a shared structure announce the global epoch they started in and then
+ * read without any lock. A writer that unlinks a block hands it to Epoch_Retire(),
+ * which tags it with the current epoch and moves the epoch forward. The block is
+ * freed once every reader still inside a read section started after that epoch,
+ * so no reader can hold a pointer to it any more.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+
+#ifndef ACCOUNT_EPOCH_H
+#define ACCOUNT_EPOCH_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define EPOCH_MAX_THREADS       128U    /* Threads with a slot of their own, the others share two slots */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Type for the function releasing a retired block.
+ *
+ * @param block The block.
+ */
+typedef void (*epoch_free_t)(void* block);
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Start a read section in the calling thread.
+ *
+ * The first call of a thread takes one of the EPOCH_MAX_THREADS slots, which the thread
+ * gives back when it ends. While every slot is taken, the read sections of the other
+ * threads share two slots behind a lock, so a thread is always protected, only more
+ * slowly. Read sections may be nested.
+ */
+void Epoch_Enter(void);
+
+/**
+ * @brief End the read section of the calling thread.
+ */
+void Epoch_Exit(void);
+
+/**
+ * @brief Free a block once no reader can see it any more.
+ *
+ * The block must already be unlinked from every shared structure.
+ *
+ * @param block The block.
+ * @param release The function releasing the block.
+ */
+void Epoch_Retire(void* block, epoch_free_t release);
+
+/**
+ * @brief Wait for the current readers and free every retired block.
+ *
+ * The calling thread must not be inside a read section.
+ */
+void Epoch_Flush(void);
+
+/**
+ * @brief Give the slot of the calling thread back.
+ *
+ * A thread gives its slot back when it ends, this function only does it sooner. It
+ * must not be called inside a read section.
+ */
+void Epoch_Thread_Exit(void);
+
+#endif /* ACCOUNT_EPOCH_H */
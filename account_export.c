@@ -0,0 +1,212 @@
+/**
+ * @file account_export.c
+ * @brief This file contains the implementation of the bulk output of the accounts of a store.
+ *
+ * Each page of keys is formatted straight into the output buffer: the text of an account
+ * is unpacked in place and the line numbers are converted by hand, so no call of the
+ * printf() family is made per account.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "account_export.h"     /* Include header file of this function file */
+#include "account_key.h"        /* For Account_Decode() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define EXPORT_LINE_MAX         40U     /* Longest line: a 20-digit number, ". ", an account and "\n" */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Write a number in decimal.
+ *
+ * @param number The number.
+ * @param out Output buffer of at least 20 bytes, not NUL terminated.
+ * @return The number of digits written.
+ */
+static uint32_t Export_Number(uint64_t number, int8_t* out)
+{
+    int8_t digits[20];          /* Digits from the last one */
+    uint32_t length = 0;        /* Number of digits */
+    uint32_t i = 0;             /* Digit counter */
+
+    do
+    {
+        digits[length] = (int8_t)('0' + (number % 10U));
+        length++;
+        number /= 10U;
+    } while (number != 0U);
+    for (i = 0; i < length; i++)
+    {
+        out[i] = digits[length - 1U - i];
+    }
+
+    return length;
+}
+
+/**
+ * @brief Write every account of a store or of a view to a file.
+ *
+ * @param store The store, unused when view is set.
+ * @param view The view, NULL to read the store.
+ * @param out The file, opened in binary mode for EXPORT_BINARY.
+ * @param format The format of the accounts.
+ * @param sorted 1 for alphabetical order, 0 for display order.
+ * @param count Output, the number of accounts written. May be NULL.
+ * @return EXPORT_OK if every account is written, an error code if not.
+ */
+static export_status_t Export_Run(account_store_t* store, const account_view_t* view, FILE* out,
+                                  export_format_t format, int32_t sorted, uint64_t* count)
+{
+    export_status_t result = EXPORT_OK;     /* Result of the export */
+    uint64_t* keys = (uint64_t*)malloc(EXPORT_PAGE_SIZE * sizeof(uint64_t));    /* Keys of the current page */
+    int8_t* buffer = (int8_t*)malloc(EXPORT_BUFFER_SIZE);                       /* Formatted accounts */
+    Account_Cursor_t cursor;                /* Position in the accounts of the store */
+    int64_t page = 1;                       /* Accounts of the current page */
+    uint64_t written = 0;                   /* Accounts formatted */
+    size_t used = 0;                        /* Bytes of the buffer in use */
+    int64_t i = 0;                          /* Account counter within the page */
+
+    if (keys == NULL || buffer == NULL)
+    {
+        result = EXPORT_NO_MEMORY;
+        page = 0;
+    }
+    else if (view != NULL)
+    {
+        Account_View_Open_Cursor(view, &cursor);
+    }
+    else
+    {
+        Account_Store_Open_Cursor(store, sorted, &cursor);
+    }
+
+    while (page > 0 && result == EXPORT_OK)
+    {
+        page = (view != NULL) ? Account_View_Next_Page(view, &cursor, keys, NULL, EXPORT_PAGE_SIZE)
+                              : Account_Store_Next_Page(store, &cursor, keys, NULL, EXPORT_PAGE_SIZE);
+        if (page < 0)
+        {
+            result = EXPORT_NO_MEMORY;
+        }
+        /* The keys of the page are copied as they are */
+        else if (format == EXPORT_BINARY)
+        {
+            if (fwrite(keys, sizeof(uint64_t), (size_t)page, out) != (size_t)page)
+            {
+                result = EXPORT_IO_ERROR;
+            }
+            written += (uint64_t)page;
+        }
+        else
+        {
+            for (i = 0; (i < page) && (result == EXPORT_OK); i++)
+            {
+                written++;
+                if (format == EXPORT_NUMBERED)
+                {
+                    used += Export_Number(written, &buffer[used]);
+                    buffer[used++] = '.';
+                    buffer[used++] = ' ';
+                }
+                /* The terminating NUL is replaced by the newline */
+                used += Account_Decode(keys[i], &buffer[used]);
+                buffer[used++] = '\n';
+                /* Write the buffer once the next line may not fit */
+                if (EXPORT_BUFFER_SIZE - used < EXPORT_LINE_MAX)
+                {
+                    result = (fwrite(buffer, 1U, used, out) == used) ? EXPORT_OK : EXPORT_IO_ERROR;
+                    used = 0;
+                }
+            }
+        }
+    }
+
+    /* Write the last lines */
+    if (result == EXPORT_OK && used > 0U && fwrite(buffer, 1U, used, out) != used)
+    {
+        result = EXPORT_IO_ERROR;
+    }
+    if (count != NULL)
+    {
+        *count = written;
+    }
+    free(keys);
+    free(buffer);
+
+    return result;
+}
+
+/**
+ * @brief Write every account of a store to a file.
+ *
+ * The file is not flushed, so the output of a store that fits in the buffer of the file
+ * reaches the file when it is closed or flushed.
+ *
+ * @param store The store.
+ * @param out The file, opened in binary mode for EXPORT_BINARY.
+ * @param format The format of the accounts.
+ * @param sorted 1 for alphabetical order, 0 for display order.
+ * @param count Output, the number of accounts written. May be NULL.
+ * @return EXPORT_OK if every account is written, an error code if not.
+ */
+export_status_t Export_Accounts(account_store_t* store, FILE* out, export_format_t format, int32_t sorted,
+                                uint64_t* count)
+{
+    return Export_Run(store, NULL, out, format, sorted, count);
+}
+
+/**
+ * @brief Write every account of a view to a file, in alphabetical order.
+ *
+ * The view may be read while its store keeps changing, in another thread.
+ *
+ * @param view The view.
+ * @param out The file, opened in binary mode for EXPORT_BINARY.
+ * @param format The format of the accounts.
+ * @param count Output, the number of accounts written. May be NULL.
+ * @return EXPORT_OK if every account is written, an error code if not.
+ */
+export_status_t Export_View(const account_view_t* view, FILE* out, export_format_t format, uint64_t* count)
+{
+    return Export_Run(NULL, view, out, format, 1, count);
+}
+
+/**
+ * @brief Get the message of a result of the export.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Export_Status_Message(export_status_t status)
+{
+    const char* message = "Unknown error";     /* Message of the result */
+
+    switch (status)
+    {
+        case EXPORT_OK:
+        {
+            message = "Success";
+            break;
+        }
+        case EXPORT_IO_ERROR:
+        {
+            message = "File cannot be written";
+            break;
+        }
+        case EXPORT_NO_MEMORY:
+        {
+            message = "Memory allocation failed";
+            break;
+        }
+    }
+
+    return message;
+} /* EOF */
@@ -0,0 +1,97 @@
+/**
+ * @file account_export.h
+ * @brief This file contains the declarations of the bulk output of the accounts of a store.
+ *
+ * The accounts are read from a cursor page by page, formatted into one large buffer
+ * and written with one fwrite() per buffer, instead of one printf() per account.
+ *
+ * Formats:
+ * - EXPORT_TEXT: one account per line, "\n" terminated,
+ * - EXPORT_NUMBERED: "<n>. <account>" per line, numbered from 1, as the menu lists them,
+ * - EXPORT_BINARY: the keys of the accounts (see account_key.h), 8 bytes each in native
+ *   byte order, the layout of the records of a snapshot file.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include <stdio.h>              /* For FILE */
+#include "account_store.h"      /* For account_store_t */
+
+#ifndef ACCOUNT_EXPORT_H
+#define ACCOUNT_EXPORT_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define EXPORT_BUFFER_SIZE      (1024U * 1024U)     /* Bytes formatted before each write */
+#define EXPORT_PAGE_SIZE        4096U               /* Accounts read from the cursor at once */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the results of the export.
+ */
+typedef enum
+{
+    EXPORT_OK,                  /* Every account is written. */
+    EXPORT_IO_ERROR,            /* The output cannot be written. */
+    EXPORT_NO_MEMORY            /* Memory allocation failed, nothing is written. */
+} export_status_t;
+
+/**
+ * @brief Enumeration for the formats of the export.
+ */
+typedef enum
+{
+    EXPORT_TEXT,                /* One account per line. */
+    EXPORT_NUMBERED,            /* One numbered account per line. */
+    EXPORT_BINARY               /* One 8-byte key per account. */
+} export_format_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Write every account of a store to a file.
+ *
+ * The file is not flushed, so the output of a store that fits in the buffer of the file
+ * reaches the file when it is closed or flushed.
+ *
+ * @param store The store.
+ * @param out The file, opened in binary mode for EXPORT_BINARY.
+ * @param format The format of the accounts.
+ * @param sorted 1 for alphabetical order, 0 for display order.
+ * @param count Output, the number of accounts written. May be NULL.
+ * @return EXPORT_OK if every account is written, an error code if not.
+ */
+export_status_t Export_Accounts(account_store_t* store, FILE* out, export_format_t format, int32_t sorted,
+                                uint64_t* count);
+
+/**
+ * @brief Write every account of a view to a file, in alphabetical order.
+ *
+ * The view may be read while its store keeps changing, in another thread.
+ *
+ * @param view The view.
+ * @param out The file, opened in binary mode for EXPORT_BINARY.
+ * @param format The format of the accounts.
+ * @param count Output, the number of accounts written. May be NULL.
+ * @return EXPORT_OK if every account is written, an error code if not.
+ */
+export_status_t Export_View(const account_view_t* view, FILE* out, export_format_t format, uint64_t* count);
+
+/**
+ * @brief Get the message of a result of the export.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Export_Status_Message(export_status_t status);
+
+#endif /* ACCOUNT_EXPORT_H */
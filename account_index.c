@@ -0,0 +1,319 @@
+/**
+ * @file account_index.c
+ * @brief This file contains the implementation of the hash index used to look up accounts.
+ *
+ * Entries are placed with linear probing over 64-byte buckets. The keys are stored
+ * in the buckets, so a probe compares integers without reading the slot array and
+ * most lookups cost one cache miss.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "account_index.h"      /* Include header file of this function file */
+#include "account_key.h"        /* For Account_Key_Hash() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define INDEX_CACHE_LINE        64U                     /* Alignment of the bucket array */
+#define INDEX_TOMBSTONE         UINT64_MAX              /* Marker for a removed entry, a slot no array reaches */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Move every live entry into a new bucket array.
+ *
+ * Tombstones are dropped during the move.
+ *
+ * @param index The index to rebuild.
+ * @param bucket_count The number of buckets of the new array, a power of 2.
+ * @return 1 if the index is rebuilt, 0 if memory allocation failed.
+ */
+static int32_t Index_Rehash(Account_Index_t* index, uint32_t bucket_count)
+{
+    int32_t result = 0;             /* Result of the rebuild */
+    void* memory;                   /* Memory block of the new array */
+    Index_Bucket_t* buckets;        /* New bucket array */
+    uint32_t mask = bucket_count - 1U;
+    uint32_t b = 0;                 /* Bucket counter of the old array */
+    uint32_t s = 0;                 /* Slot counter */
+
+    /* Allocate one extra cache line so the array can be aligned */
+    memory = malloc((size_t)bucket_count * sizeof(Index_Bucket_t) + INDEX_CACHE_LINE);
+    if (memory != NULL)
+    {
+        buckets = (Index_Bucket_t*)(((uintptr_t)memory + INDEX_CACHE_LINE - 1U) & ~(uintptr_t)(INDEX_CACHE_LINE - 1U));
+        memset(buckets, 0, (size_t)bucket_count * sizeof(Index_Bucket_t));
+
+        /* Re-insert every live entry of the old array */
+        for (b = 0; (index->buckets != NULL) && (b <= index->bucket_mask); b++)
+        {
+            for (s = 0; s < INDEX_BUCKET_SLOTS; s++)
+            {
+                account_handle_t handle = index->buckets[b].handle[s];
+                if (handle != ACCOUNT_HANDLE_NONE && handle != INDEX_TOMBSTONE)
+                {
+                    uint64_t key = index->buckets[b].key[s];
+                    uint32_t target = (uint32_t)Account_Key_Hash(key) & mask;
+                    uint32_t slot = 0;
+
+                    /* The new array has no tombstones, take the first empty slot */
+                    while (buckets[target].handle[slot] != ACCOUNT_HANDLE_NONE)
+                    {
+                        slot++;
+                        if (slot == INDEX_BUCKET_SLOTS)
+                        {
+                            slot = 0;
+                            target = (target + 1U) & mask;
+                        }
+                    }
+                    buckets[target].key[slot] = key;
+                    buckets[target].handle[slot] = handle;
+                }
+            }
+        }
+
+        /* Replace the old array */
+        free(index->memory);
+        index->memory = memory;
+        index->buckets = buckets;
+        index->bucket_mask = mask;
+        index->tombstones = 0;
+        result = 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Locate the slot of an account.
+ *
+ * @param index The index to search.
+ * @param key The key of the account to look for.
+ * @param bucket Output, the bucket of the account if it is found.
+ * @param slot Output, the slot of the account if it is found.
+ * @return 1 if the account is found, 0 if not.
+ */
+static int32_t Index_Locate(const Account_Index_t* index, uint64_t key, uint32_t* bucket, uint32_t* slot)
+{
+    int32_t found = 0;          /* Result of the search */
+    int32_t searching = 1;      /* Cleared when an empty slot ends the probe sequence */
+    uint32_t b = 0;             /* Current bucket */
+    uint32_t s = 0;             /* Current slot */
+
+    /* An index without buckets is empty */
+    if (index->buckets == NULL)
+    {
+        searching = 0;
+    }
+    else
+    {
+        b = (uint32_t)Account_Key_Hash(key) & index->bucket_mask;
+    }
+
+    /* Probe bucket by bucket until the account or an empty slot is found */
+    while (searching)
+    {
+        const Index_Bucket_t* current = &index->buckets[b];
+
+        for (s = 0; (s < INDEX_BUCKET_SLOTS) && searching; s++)
+        {
+            account_handle_t handle = current->handle[s];
+
+            /* An empty slot ends the probe sequence */
+            if (handle == ACCOUNT_HANDLE_NONE)
+            {
+                searching = 0;
+            }
+            /* A removed entry keeps its key, so check the handle as well */
+            else if ((current->key[s] == key) && (handle != INDEX_TOMBSTONE))
+            {
+                *bucket = b;
+                *slot = s;
+                found = 1;
+                searching = 0;
+            }
+        }
+        /* Continue with the next bucket */
+        b = (b + 1U) & index->bucket_mask;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Find an account in the index.
+ *
+ * @param index The index to search.
+ * @param key The key of the account to look for.
+ * @return The handle of the account, ACCOUNT_HANDLE_NONE if the account is not in the index.
+ */
+account_handle_t Index_Find(const Account_Index_t* index, uint64_t key)
+{
+    account_handle_t handle = ACCOUNT_HANDLE_NONE;  /* Handle of the account */
+    uint32_t bucket = 0;        /* Bucket of the account */
+    uint32_t slot = 0;          /* Slot of the account */
+
+    if (Index_Locate(index, key, &bucket, &slot))
+    {
+        handle = index->buckets[bucket].handle[slot];
+    }
+
+    return handle;
+}
+
+/**
+ * @brief Start loading the first bucket of an account into the cache.
+ *
+ * A batch of lookups prefetches the buckets of all its accounts first, so the cache
+ * misses overlap instead of following one another.
+ *
+ * @param index The index.
+ * @param key The key of the account about to be looked up.
+ */
+void Index_Prefetch(const Account_Index_t* index, uint64_t key)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if (index->buckets != NULL)
+    {
+        __builtin_prefetch(&index->buckets[(uint32_t)Account_Key_Hash(key) & index->bucket_mask], 0, 1);
+    }
+#else
+    (void)index;
+    (void)key;
+#endif
+}
+
+/**
+ * @brief Insert an account into the index.
+ *
+ * The caller is responsible for checking that the account is not already in the index.
+ *
+ * @param index The index to insert into.
+ * @param key The key of the account.
+ * @param handle The handle of the account.
+ * @return 1 if the account is inserted, 0 if memory allocation failed.
+ */
+int32_t Index_Insert(Account_Index_t* index, uint64_t key, account_handle_t handle)
+{
+    int32_t result = 1;                             /* Result of the insertion */
+    uint64_t hash = Account_Key_Hash(key);          /* Hash of the new account */
+    uint32_t buckets = 0;                           /* Number of buckets */
+    uint32_t b = 0;                                 /* Current bucket */
+    uint32_t s = 0;                                 /* Current slot */
+
+    /* Allocate the first bucket array */
+    if (index->buckets == NULL)
+    {
+        result = Index_Rehash(index, INDEX_MIN_BUCKETS);
+    }
+    else
+    {
+        buckets = index->bucket_mask + 1U;
+        /* Rebuild when live entries and tombstones fill three quarters of the slots */
+        if ((uint64_t)(index->used + index->tombstones + 1U) * 4U > (uint64_t)buckets * INDEX_BUCKET_SLOTS * 3U)
+        {
+            /* Double the array if live entries fill half of it, otherwise only drop the tombstones */
+            if ((uint64_t)(index->used + 1U) * 2U > (uint64_t)buckets * INDEX_BUCKET_SLOTS)
+            {
+                buckets *= 2U;
+            }
+            result = Index_Rehash(index, buckets);
+        }
+    }
+
+    if (result == 1)
+    {
+        /* Take the first empty or removed slot of the probe sequence */
+        b = (uint32_t)hash & index->bucket_mask;
+        while ((index->buckets[b].handle[s] != ACCOUNT_HANDLE_NONE) && (index->buckets[b].handle[s] != INDEX_TOMBSTONE))
+        {
+            s++;
+            if (s == INDEX_BUCKET_SLOTS)
+            {
+                s = 0;
+                b = (b + 1U) & index->bucket_mask;
+            }
+        }
+        /* Reusing a removed slot reclaims its tombstone */
+        if (index->buckets[b].handle[s] == INDEX_TOMBSTONE)
+        {
+            index->tombstones--;
+        }
+        index->buckets[b].key[s] = key;
+        index->buckets[b].handle[s] = handle;
+        index->used++;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Make room in the index for a number of accounts.
+ *
+ * The bucket array is grown at once, so inserting that many accounts does not rehash.
+ *
+ * @param index The index.
+ * @param count The number of accounts the index will hold.
+ * @return 1 if the index can hold them, 0 if memory allocation failed.
+ */
+int32_t Index_Reserve(Account_Index_t* index, uint32_t count)
+{
+    int32_t result = 1;                         /* Result of the growth */
+    uint64_t buckets = INDEX_MIN_BUCKETS;       /* Number of buckets needed */
+
+    /* Live entries fill at most half of the slots */
+    while (buckets * INDEX_BUCKET_SLOTS < 2U * (uint64_t)count)
+    {
+        buckets *= 2U;
+    }
+    if (buckets <= UINT32_MAX && (index->buckets == NULL || buckets > (uint64_t)index->bucket_mask + 1U))
+    {
+        result = Index_Rehash(index, (uint32_t)buckets);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Remove an account from the index.
+ *
+ * @param index The index to remove from.
+ * @param key The key of the account to remove.
+ * @return The handle of the account, ACCOUNT_HANDLE_NONE if the account is not in the index.
+ */
+account_handle_t Index_Remove(Account_Index_t* index, uint64_t key)
+{
+    account_handle_t handle = ACCOUNT_HANDLE_NONE;  /* Handle of the account */
+    uint32_t bucket = 0;        /* Bucket of the account */
+    uint32_t slot = 0;          /* Slot of the account */
+
+    if (Index_Locate(index, key, &bucket, &slot))
+    {
+        handle = index->buckets[bucket].handle[slot];
+        /* Keep the probe sequence intact for the entries placed after this one */
+        index->buckets[bucket].handle[slot] = INDEX_TOMBSTONE;
+        index->used--;
+        index->tombstones++;
+    }
+
+    return handle;
+}
+
+/**
+ * @brief Release the memory used by the index.
+ *
+ * The accounts themselves are not removed from the slot array. The index is left empty and can be reused.
+ *
+ * @param index The index to release.
+ */
+void Index_Free(Account_Index_t* index)
+{
+    free(index->memory);
+    memset(index, 0, sizeof(Account_Index_t));
+} /* EOF */
@@ -0,0 +1,122 @@
+/**
+ * @file account_index.h
+ * @brief This file contains the declarations of the hash index used to look up accounts.
+ *
+ * The index is an open-addressing hash table whose buckets are one cache line wide.
+ * Each bucket holds several (key, handle) pairs, so a lookup usually touches a single
+ * cache line and never reads the slot array to compare accounts. The table grows
+ * by doubling and removed entries are marked as tombstones until the next rehash.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include "account_manage.h"     /* For account_handle_t */
+
+#ifndef ACCOUNT_INDEX_H
+#define ACCOUNT_INDEX_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define INDEX_BUCKET_SLOTS      4U      /* Number of entries in one 64-byte bucket */
+#define INDEX_MIN_BUCKETS       16U     /* Number of buckets allocated on first insert */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for a bucket of the hash index.
+ *
+ * The keys and the handles are kept in separate arrays so that a probe
+ * compares the keys of the whole bucket before looking at any handle.
+ */
+typedef struct
+{
+    uint64_t key[INDEX_BUCKET_SLOTS];       /* Key of the account stored in each slot. */
+    account_handle_t handle[INDEX_BUCKET_SLOTS];    /* Handle stored in each slot, ACCOUNT_HANDLE_NONE if the slot is empty. */
+} Index_Bucket_t;
+
+/**
+ * @brief Structure for the hash index.
+ *
+ * A zero-initialized structure is a valid empty index.
+ */
+typedef struct
+{
+    void* memory;               /* Memory block returned by malloc(), used to free the buckets. */
+    Index_Bucket_t* buckets;    /* Cache-line aligned array of buckets. */
+    uint32_t bucket_mask;       /* Number of buckets minus one, the number of buckets is a power of 2. */
+    uint32_t used;              /* Number of live entries. */
+    uint32_t tombstones;        /* Number of removed entries not yet reclaimed by a rehash. */
+} Account_Index_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Find an account in the index.
+ *
+ * @param index The index to search.
+ * @param key The key of the account to look for.
+ * @return The handle of the account, ACCOUNT_HANDLE_NONE if the account is not in the index.
+ */
+account_handle_t Index_Find(const Account_Index_t* index, uint64_t key);
+
+/**
+ * @brief Start loading the first bucket of an account into the cache.
+ *
+ * A batch of lookups prefetches the buckets of all its accounts first, so the cache
+ * misses overlap instead of following one another.
+ *
+ * @param index The index.
+ * @param key The key of the account about to be looked up.
+ */
+void Index_Prefetch(const Account_Index_t* index, uint64_t key);
+
+/**
+ * @brief Insert an account into the index.
+ *
+ * The caller is responsible for checking that the account is not already in the index.
+ *
+ * @param index The index to insert into.
+ * @param key The key of the account.
+ * @param handle The handle of the account.
+ * @return 1 if the account is inserted, 0 if memory allocation failed.
+ */
+int32_t Index_Insert(Account_Index_t* index, uint64_t key, account_handle_t handle);
+
+/**
+ * @brief Make room in the index for a number of accounts.
+ *
+ * The bucket array is grown at once, so inserting that many accounts does not rehash.
+ *
+ * @param index The index.
+ * @param count The number of accounts the index will hold.
+ * @return 1 if the index can hold them, 0 if memory allocation failed.
+ */
+int32_t Index_Reserve(Account_Index_t* index, uint32_t count);
+
+/**
+ * @brief Remove an account from the index.
+ *
+ * @param index The index to remove from.
+ * @param key The key of the account to remove.
+ * @return The handle of the account, ACCOUNT_HANDLE_NONE if the account is not in the index.
+ */
+account_handle_t Index_Remove(Account_Index_t* index, uint64_t key);
+
+/**
+ * @brief Release the memory used by the index.
+ *
+ * The accounts themselves are not removed from the slot array. The index is left empty and can be reused.
+ *
+ * @param index The index to release.
+ */
+void Index_Free(Account_Index_t* index);
+
+#endif /* ACCOUNT_INDEX_H */
@@ -0,0 +1,794 @@
+/**
+ * @file account_journal.c
+ * @brief This file contains the implementation of the write-ahead journal of the account list.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdlib.h>             /* For malloc(), free() */
+#include <string.h>             /* For memcmp(), memcpy(), memmove() */
+#include <errno.h>              /* For ETIMEDOUT */
+#ifdef _WIN32
+#include <io.h>                 /* For _commit(), _chsize_s() */
+#else
+#include <unistd.h>             /* For fsync(), ftruncate() */
+#endif
+#include "account_key.h"        /* For Account_Key_Hash() */
+#include "account_journal.h"    /* Include header file of this function file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define JOURNAL_BUFFER_SIZE     (JOURNAL_MAX_BATCH * JOURNAL_RECORD_SIZE)   /* Size of the record buffer */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Compute the check byte of a record.
+ *
+ * @param op The operation of the record.
+ * @param key The key of the record.
+ * @return The check byte.
+ */
+static uint8_t Journal_Check(uint8_t op, uint64_t key)
+{
+    return (uint8_t)(Account_Key_Hash(key ^ ((uint64_t)op << 56)) >> 56);
+}
+
+/**
+ * @brief Write a record into a buffer.
+ *
+ * @param record Output, JOURNAL_RECORD_SIZE bytes.
+ * @param op The operation.
+ * @param key The key of the account.
+ */
+static void Journal_Encode(uint8_t* record, journal_op_t op, uint64_t key)
+{
+    uint32_t i = 0;             /* Byte counter of the key */
+
+    record[0] = (uint8_t)op;
+    /* Store the key in little endian so the file does not depend on the machine */
+    for (i = 0; i < 8U; i++)
+    {
+        record[1U + i] = (uint8_t)(key >> (8U * i));
+    }
+    record[9] = Journal_Check(record[0], key);
+}
+
+/**
+ * @brief Read a record from a buffer.
+ *
+ * @param record The JOURNAL_RECORD_SIZE bytes of the record.
+ * @param op Output, the operation.
+ * @param key Output, the key of the account.
+ * @return 1 if the record is valid, 0 if its operation or its check byte is wrong.
+ */
+static int32_t Journal_Decode(const uint8_t* record, journal_op_t* op, uint64_t* key)
+{
+    int32_t valid = 0;          /* Result of the check */
+    uint64_t value = 0;         /* Key being read */
+    uint32_t i = 0;             /* Byte counter of the key */
+
+    for (i = 0; i < 8U; i++)
+    {
+        value |= (uint64_t)record[1U + i] << (8U * i);
+    }
+
+    if ((record[0] == (uint8_t)JOURNAL_ADD || record[0] == (uint8_t)JOURNAL_REMOVE)
+        && (record[9] == Journal_Check(record[0], value)))
+    {
+        *op = (journal_op_t)record[0];
+        *key = value;
+        valid = 1;
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Force the written content of a file to the disk.
+ *
+ * @param file The file.
+ * @return 0 on success, -1 on error.
+ */
+static int32_t Journal_Sync(FILE* file)
+{
+    int32_t result = -1;        /* Result of the synchronization */
+
+    if (fflush(file) == 0)
+    {
+#ifdef _WIN32
+        result = (_commit(_fileno(file)) == 0) ? 0 : -1;
+#else
+        result = (fsync(fileno(file)) == 0) ? 0 : -1;
+#endif
+    }
+
+    return result;
+}
+
+/**
+ * @brief Cut a file to a given size and move to its end.
+ *
+ * @param file The file.
+ * @param size The new size of the file.
+ * @return 0 on success, -1 on error.
+ */
+static int32_t Journal_Truncate(FILE* file, uint64_t size)
+{
+    int32_t result = -1;        /* Result of the truncation */
+
+    if (fflush(file) == 0)
+    {
+#ifdef _WIN32
+        result = (_chsize_s(_fileno(file), (__int64)size) == 0) ? 0 : -1;
+#else
+        result = (ftruncate(fileno(file), (off_t)size) == 0) ? 0 : -1;
+#endif
+    }
+    if (result == 0 && (fseek(file, 0, SEEK_END) != 0 || Journal_Sync(file) != 0))
+    {
+        result = -1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Copy a path with a suffix appended.
+ *
+ * @param path The path.
+ * @param suffix The suffix.
+ * @return A malloc() block holding the new path, NULL if memory allocation failed.
+ */
+static char* Journal_Path(const char* path, const char* suffix)
+{
+    char* copy = (char*)malloc(strlen(path) + strlen(suffix) + 1U);
+
+    if (copy != NULL)
+    {
+        strcpy(copy, path);
+        strcat(copy, suffix);
+    }
+
+    return copy;
+}
+
+/**
+ * @brief Write the pending records and force them to the disk.
+ *
+ * The records are dropped from the buffer even if the write fails. The lock must be held.
+ *
+ * @param journal The open journal.
+ * @return JOURNAL_OK if the records are on the disk, JOURNAL_IO_ERROR if not.
+ */
+static journal_status_t Journal_Flush_Locked(Journal_t* journal)
+{
+    journal_status_t result = JOURNAL_OK;   /* Result of the commit */
+
+    if (journal->pending > 0U)
+    {
+        if ((journal->file == NULL)
+            || (fwrite(journal->buffer, JOURNAL_RECORD_SIZE, journal->pending, journal->file) != journal->pending)
+            || (Journal_Sync(journal->file) != 0))
+        {
+            result = JOURNAL_IO_ERROR;
+        }
+        journal->pending = 0;
+        journal->stats.commits++;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Body of the thread committing the records on the commit window.
+ *
+ * @param argument The open journal.
+ * @return NULL.
+ */
+static void* Journal_Flusher(void* argument)
+{
+    Journal_t* journal = (Journal_t*)argument;  /* The journal served by the thread */
+
+    pthread_mutex_lock(&journal->lock);
+    while (journal->stopping == 0)
+    {
+        /* Sleep until a record arrives, then until the window of the oldest record ends */
+        if (journal->pending == 0U)
+        {
+            pthread_cond_wait(&journal->wake, &journal->lock);
+        }
+        else if ((pthread_cond_timedwait(&journal->wake, &journal->lock, &journal->deadline) == ETIMEDOUT)
+                 && (journal->pending > 0U))
+        {
+            if (Journal_Flush_Locked(journal) != JOURNAL_OK)
+            {
+                journal->failed = 1;
+            }
+        }
+    }
+    pthread_mutex_unlock(&journal->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Body of the thread writing the snapshot of a compaction.
+ *
+ * @param argument The open journal.
+ * @return NULL.
+ */
+static void* Journal_Compactor(void* argument)
+{
+    Journal_t* journal = (Journal_t*)argument;  /* The journal served by the thread */
+    snapshot_status_t status;                   /* Result of the snapshot write */
+
+    /* The keys and the paths do not change while the compaction is busy */
+    status = Snapshot_Write(journal->snapshot_path, journal->compact_keys, journal->compact_count);
+
+    pthread_mutex_lock(&journal->lock);
+    if (status == SNAPSHOT_OK)
+    {
+        /* The snapshot holds every change of the old journal */
+        remove(journal->old_path);
+        journal->old_pending = 0;
+    }
+    else
+    {
+        journal->stats.compact_failures++;
+    }
+    free(journal->compact_keys);
+    journal->compact_keys = NULL;
+    journal->compact_busy = 0;
+    pthread_mutex_unlock(&journal->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Apply the valid records of a journal file.
+ *
+ * @param journal The journal being opened, its buffer is used for reading.
+ * @param path The path of the journal file.
+ * @param apply The function applying the records.
+ * @param user_data A pointer given back to apply.
+ * @param valid Output, the size of the file up to the end of the last valid record.
+ * @param exists Output, 1 if the file exists, 0 if not.
+ * @return JOURNAL_OK if the file is replayed or does not exist, an error code if not.
+ */
+static journal_status_t Journal_Replay(Journal_t* journal, const char* path, journal_apply_t apply,
+                                       void* user_data, uint64_t* valid, int32_t* exists)
+{
+    journal_status_t result = JOURNAL_OK;   /* Result of the replay */
+    FILE* file = fopen(path, "rb");         /* The journal file */
+    uint8_t magic[JOURNAL_HEADER_SIZE];     /* First bytes of the file */
+    int32_t reading = 1;                    /* Cleared at the end of the valid records */
+    size_t filled = 0;                      /* Bytes in the buffer */
+    size_t position = 0;                    /* Current record in the buffer */
+    journal_op_t op;                        /* Operation of the current record */
+    uint64_t key = 0;                       /* Key of the current record */
+
+    *valid = 0;
+    *exists = (file != NULL) ? 1 : 0;
+
+    if (file == NULL)
+    {
+        reading = 0;
+    }
+    /* A file shorter than the magic was cut while it was created */
+    else if (fread(magic, 1, JOURNAL_HEADER_SIZE, file) != JOURNAL_HEADER_SIZE)
+    {
+        reading = 0;
+    }
+    else if (memcmp(magic, JOURNAL_MAGIC, JOURNAL_HEADER_SIZE) != 0)
+    {
+        result = JOURNAL_BAD_FORMAT;
+        reading = 0;
+    }
+    else
+    {
+        *valid = JOURNAL_HEADER_SIZE;
+    }
+
+    /* Read the records chunk by chunk */
+    while (reading)
+    {
+        filled += fread(journal->buffer + filled, 1, JOURNAL_BUFFER_SIZE - filled, file);
+        position = 0;
+
+        /* Stop at the first record that does not check, the commit it belongs to was cut */
+        while (reading && (position + JOURNAL_RECORD_SIZE <= filled))
+        {
+            if (Journal_Decode(journal->buffer + position, &op, &key))
+            {
+                apply(op, key, user_data);
+                journal->stats.replayed++;
+                *valid += JOURNAL_RECORD_SIZE;
+                position += JOURNAL_RECORD_SIZE;
+            }
+            else
+            {
+                reading = 0;
+            }
+        }
+
+        /* A short read is the end of the file, the bytes left over are a torn record */
+        if (filled < JOURNAL_BUFFER_SIZE)
+        {
+            reading = 0;
+        }
+        else
+        {
+            memmove(journal->buffer, journal->buffer + position, filled - position);
+            filled -= position;
+        }
+    }
+
+    if (file != NULL)
+    {
+        if (ferror(file))
+        {
+            result = JOURNAL_IO_ERROR;
+        }
+        fclose(file);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Release the memory of a journal and mark it closed.
+ *
+ * @param journal The journal, its threads are stopped and its file is closed.
+ */
+static void Journal_Release(Journal_t* journal)
+{
+    pthread_cond_destroy(&journal->wake);
+    pthread_mutex_destroy(&journal->lock);
+    free(journal->path);
+    free(journal->old_path);
+    free(journal->snapshot_path);
+    free(journal->buffer);
+    memset(journal, 0, sizeof(Journal_t));
+}
+
+/**
+ * @brief Replay a journal and open it for appending.
+ *
+ * The old journal of an unfinished compaction is replayed first, then the journal.
+ * A torn tail is cut off. A missing journal is created.
+ *
+ * @param journal Output, the open journal.
+ * @param path The path of the journal file.
+ * @param snapshot_path The snapshot written by the compactions, NULL to never compact.
+ * @param config The settings of the journal.
+ * @param apply The function applying the replayed records.
+ * @param user_data A pointer given back to apply.
+ * @return JOURNAL_OK if the journal is open, an error code if not.
+ */
+journal_status_t Journal_Open(Journal_t* journal, const char* path, const char* snapshot_path,
+                              const Journal_Config_t* config, journal_apply_t apply, void* user_data)
+{
+    journal_status_t result = JOURNAL_OK;   /* Result of the opening */
+    uint64_t valid = 0;                     /* Size of the valid part of a file */
+    int32_t exists = 0;                     /* Set if a file exists */
+
+    memset(journal, 0, sizeof(Journal_t));
+    pthread_mutex_init(&journal->lock, NULL);
+    pthread_cond_init(&journal->wake, NULL);
+
+    /* Keep a group within the buffer */
+    journal->config = *config;
+    if (journal->config.commit_count == 0U)
+    {
+        journal->config.commit_count = 1U;
+    }
+    if (journal->config.commit_count > JOURNAL_MAX_BATCH)
+    {
+        journal->config.commit_count = JOURNAL_MAX_BATCH;
+    }
+
+    journal->path = Journal_Path(path, "");
+    journal->old_path = Journal_Path(path, JOURNAL_OLD_SUFFIX);
+    journal->snapshot_path = (snapshot_path != NULL) ? Journal_Path(snapshot_path, "") : NULL;
+    journal->buffer = (uint8_t*)malloc(JOURNAL_BUFFER_SIZE);
+    if (journal->path == NULL || journal->old_path == NULL || journal->buffer == NULL
+        || (snapshot_path != NULL && journal->snapshot_path == NULL))
+    {
+        result = JOURNAL_NO_MEMORY;
+    }
+
+    /* The old journal is older than the journal, replay it first */
+    if (result == JOURNAL_OK)
+    {
+        result = Journal_Replay(journal, journal->old_path, apply, user_data, &valid, &exists);
+        journal->old_pending = exists;
+    }
+    if (result == JOURNAL_OK)
+    {
+        result = Journal_Replay(journal, journal->path, apply, user_data, &valid, &exists);
+    }
+
+    /* Open the journal and cut it after its last valid record */
+    if (result == JOURNAL_OK)
+    {
+        journal->file = fopen(journal->path, exists ? "r+b" : "w+b");
+        if (journal->file == NULL)
+        {
+            result = JOURNAL_IO_ERROR;
+        }
+        else if (valid < JOURNAL_HEADER_SIZE)
+        {
+            valid = JOURNAL_HEADER_SIZE;
+            if ((fwrite(JOURNAL_MAGIC, 1, JOURNAL_HEADER_SIZE, journal->file) != JOURNAL_HEADER_SIZE)
+                || (Journal_Truncate(journal->file, valid) != 0))
+            {
+                result = JOURNAL_IO_ERROR;
+            }
+        }
+        else if (Journal_Truncate(journal->file, valid) != 0)
+        {
+            result = JOURNAL_IO_ERROR;
+        }
+        journal->size = valid;
+        journal->compact_at = JOURNAL_HEADER_SIZE + journal->config.compact_size;
+    }
+
+    /* Start the thread of the commit window */
+    if (result == JOURNAL_OK && journal->config.commit_window_ms > 0U)
+    {
+        if (pthread_create(&journal->flusher, NULL, Journal_Flusher, journal) != 0)
+        {
+            result = JOURNAL_NO_MEMORY;
+        }
+        else
+        {
+            journal->flusher_running = 1;
+        }
+    }
+
+    if (result != JOURNAL_OK)
+    {
+        if (journal->file != NULL)
+        {
+            fclose(journal->file);
+        }
+        Journal_Release(journal);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Append a record to the journal.
+ *
+ * The record is durable once its group is committed, which happens here when enough
+ * records are pending and on the commit thread when the commit window ends.
+ *
+ * @param journal The open journal.
+ * @param op The operation.
+ * @param key The key of the account.
+ * @return JOURNAL_OK if the record is accepted, JOURNAL_IO_ERROR if a commit failed.
+ */
+journal_status_t Journal_Append(Journal_t* journal, journal_op_t op, uint64_t key)
+{
+    journal_status_t result = JOURNAL_OK;   /* Result of the append */
+    uint32_t window = journal->config.commit_window_ms;
+
+    pthread_mutex_lock(&journal->lock);
+
+    /* Report a failed commit of the background thread once */
+    if (journal->failed)
+    {
+        journal->failed = 0;
+        result = JOURNAL_IO_ERROR;
+    }
+
+    Journal_Encode(journal->buffer + (size_t)journal->pending * JOURNAL_RECORD_SIZE, op, key);
+    journal->pending++;
+    journal->size += JOURNAL_RECORD_SIZE;
+    journal->stats.records++;
+
+    if (journal->pending >= journal->config.commit_count)
+    {
+        if (Journal_Flush_Locked(journal) != JOURNAL_OK)
+        {
+            result = JOURNAL_IO_ERROR;
+        }
+    }
+    /* The first record of a group sets the end of its window */
+    else if (journal->pending == 1U && journal->flusher_running)
+    {
+        clock_gettime(CLOCK_REALTIME, &journal->deadline);
+        journal->deadline.tv_sec += (time_t)(window / 1000U);
+        journal->deadline.tv_nsec += (long)(window % 1000U) * 1000000L;
+        if (journal->deadline.tv_nsec >= 1000000000L)
+        {
+            journal->deadline.tv_sec++;
+            journal->deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_signal(&journal->wake);
+    }
+
+    pthread_mutex_unlock(&journal->lock);
+
+    return result;
+}
+
+/**
+ * @brief Commit the pending records now.
+ *
+ * @param journal The open journal.
+ * @return JOURNAL_OK if the records are on the disk, JOURNAL_IO_ERROR if not.
+ */
+journal_status_t Journal_Commit(Journal_t* journal)
+{
+    journal_status_t result;    /* Result of the commit */
+
+    pthread_mutex_lock(&journal->lock);
+    result = Journal_Flush_Locked(journal);
+    pthread_mutex_unlock(&journal->lock);
+
+    return result;
+}
+
+/**
+ * @brief Check if the journal should be folded into the snapshot.
+ *
+ * @param journal The open journal.
+ * @return 1 if the journal passed its size limit and no compaction is running, 0 if not.
+ */
+int32_t Journal_Should_Compact(Journal_t* journal)
+{
+    int32_t result = 0;         /* Result of the check */
+
+    if (journal->snapshot_path != NULL && journal->config.compact_size > 0U)
+    {
+        pthread_mutex_lock(&journal->lock);
+        result = (journal->size >= journal->compact_at && journal->compact_busy == 0) ? 1 : 0;
+        pthread_mutex_unlock(&journal->lock);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Fold the journal into a new snapshot.
+ *
+ * The journal is rotated and the snapshot is written by a background thread. If an
+ * earlier old journal was never folded into a snapshot, the snapshot is written
+ * right away instead, because the old journal cannot be replaced.
+ *
+ * @param journal The open journal.
+ * @param keys The keys of the whole list, as of the last appended record. The journal
+ *             takes ownership of this malloc() block.
+ * @param count The number of keys.
+ * @return JOURNAL_OK if the compaction started or completed, an error code if not.
+ */
+journal_status_t Journal_Compact(Journal_t* journal, uint64_t* keys, uint64_t count)
+{
+    journal_status_t result = JOURNAL_OK;   /* Result of the compaction */
+
+    /* Only one compaction runs at a time */
+    Journal_Wait(journal);
+
+    pthread_mutex_lock(&journal->lock);
+    if (journal->snapshot_path == NULL || journal->file == NULL)
+    {
+        free(keys);
+    }
+    else if (journal->old_pending)
+    {
+        /* The snapshot holds every change of both journals, so both can be emptied */
+        journal->stats.compactions++;
+        result = Journal_Flush_Locked(journal);
+        if (result == JOURNAL_OK && Snapshot_Write(journal->snapshot_path, keys, count) != SNAPSHOT_OK)
+        {
+            journal->stats.compact_failures++;
+            result = JOURNAL_IO_ERROR;
+        }
+        if (result == JOURNAL_OK)
+        {
+            if (Journal_Truncate(journal->file, JOURNAL_HEADER_SIZE) != 0)
+            {
+                result = JOURNAL_IO_ERROR;
+            }
+            else
+            {
+                journal->size = JOURNAL_HEADER_SIZE;
+                remove(journal->old_path);
+                journal->old_pending = 0;
+            }
+        }
+        free(keys);
+    }
+    else
+    {
+        /* Move the journal aside and start a new one */
+        journal->stats.compactions++;
+        result = Journal_Flush_Locked(journal);
+        if (result == JOURNAL_OK)
+        {
+            fclose(journal->file);
+#ifdef _WIN32
+            remove(journal->old_path);
+#endif
+            if (rename(journal->path, journal->old_path) == 0)
+            {
+                journal->old_pending = 1;
+                journal->file = fopen(journal->path, "w+b");
+                journal->size = JOURNAL_HEADER_SIZE;
+                if ((journal->file == NULL)
+                    || (fwrite(JOURNAL_MAGIC, 1, JOURNAL_HEADER_SIZE, journal->file) != JOURNAL_HEADER_SIZE)
+                    || (Journal_Sync(journal->file) != 0))
+                {
+                    result = JOURNAL_IO_ERROR;
+                }
+            }
+            else
+            {
+                /* Keep appending to the journal that could not be moved */
+                journal->file = fopen(journal->path, "r+b");
+                if (journal->file == NULL || fseek(journal->file, 0, SEEK_END) != 0)
+                {
+                    result = JOURNAL_IO_ERROR;
+                }
+            }
+        }
+
+        /* Write the snapshot in the background */
+        if (result == JOURNAL_OK && journal->old_pending)
+        {
+            journal->compact_keys = keys;
+            journal->compact_count = count;
+            journal->compact_busy = 1;
+            if (pthread_create(&journal->compactor, NULL, Journal_Compactor, journal) != 0)
+            {
+                /* The next compaction writes the snapshot itself */
+                journal->compact_keys = NULL;
+                journal->compact_busy = 0;
+                result = JOURNAL_NO_MEMORY;
+            }
+            else
+            {
+                journal->compactor_running = 1;
+                keys = NULL;
+            }
+        }
+        free(keys);
+    }
+    /* Wait for another compaction size before trying again, even after a failure */
+    journal->compact_at = journal->size + journal->config.compact_size;
+    pthread_mutex_unlock(&journal->lock);
+
+    return result;
+}
+
+/**
+ * @brief Wait for a running compaction to finish.
+ *
+ * @param journal The journal, open or closed.
+ */
+void Journal_Wait(Journal_t* journal)
+{
+    if (journal->compactor_running)
+    {
+        pthread_join(journal->compactor, NULL);
+        journal->compactor_running = 0;
+    }
+}
+
+/**
+ * @brief Get the counters of a journal.
+ *
+ * @param journal The journal, open or closed.
+ * @param stats Output, the counters since the journal was opened.
+ */
+void Journal_Get_Stats(Journal_t* journal, Journal_Stats_t* stats)
+{
+    /* A closed journal has no lock to take */
+    if (journal->path == NULL)
+    {
+        memset(stats, 0, sizeof(Journal_Stats_t));
+    }
+    else
+    {
+        pthread_mutex_lock(&journal->lock);
+        *stats = journal->stats;
+        pthread_mutex_unlock(&journal->lock);
+    }
+}
+
+/**
+ * @brief Get a message describing a result of the journal functions.
+ *
+ * @param status The result.
+ * @return A constant string describing the result.
+ */
+const char* Journal_Status_Message(journal_status_t status)
+{
+    const char* message = "Unknown error";     /* Message of the result */
+
+    switch (status)
+    {
+        case JOURNAL_OK:
+        {
+            message = "Success";
+            break;
+        }
+        case JOURNAL_IO_ERROR:
+        {
+            message = "File cannot be opened, written or synchronized";
+            break;
+        }
+        case JOURNAL_BAD_FORMAT:
+        {
+            message = "File is not a journal";
+            break;
+        }
+        case JOURNAL_NO_MEMORY:
+        {
+            message = "Memory allocation failed";
+            break;
+        }
+    }
+
+    return message;
+}
+
+/**
+ * @brief Commit the pending records and close the journal.
+ *
+ * @param journal The journal, open or closed.
+ * @param reset 1 if the whole list was just saved to the snapshot, which empties the
+ *              journal and deletes the old journal, 0 to keep them.
+ * @return JOURNAL_OK if every record is on the disk, JOURNAL_IO_ERROR if not.
+ */
+journal_status_t Journal_Close(Journal_t* journal, int32_t reset)
+{
+    journal_status_t result = JOURNAL_OK;   /* Result of the closing */
+
+    if (journal->path != NULL)
+    {
+        /* Stop the background threads */
+        if (journal->flusher_running)
+        {
+            pthread_mutex_lock(&journal->lock);
+            journal->stopping = 1;
+            pthread_cond_signal(&journal->wake);
+            pthread_mutex_unlock(&journal->lock);
+            pthread_join(journal->flusher, NULL);
+        }
+        Journal_Wait(journal);
+
+        result = Journal_Flush_Locked(journal);
+        if (journal->failed)
+        {
+            result = JOURNAL_IO_ERROR;
+        }
+        if (result == JOURNAL_OK && reset && journal->file != NULL)
+        {
+            if (Journal_Truncate(journal->file, JOURNAL_HEADER_SIZE) != 0)
+            {
+                result = JOURNAL_IO_ERROR;
+            }
+            else
+            {
+                remove(journal->old_path);
+            }
+        }
+        if (journal->file != NULL && fclose(journal->file) != 0)
+        {
+            result = JOURNAL_IO_ERROR;
+        }
+        Journal_Release(journal);
+    }
+
+    return result;
+} /* EOF */
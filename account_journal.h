@@ -0,0 +1,232 @@
+/**
+ * @file account_journal.h
+ * @brief This file contains the declarations of the write-ahead journal of the account list.
+ *
+ * Every change of the list is appended to the journal as a fixed-size binary record.
+ * Records are collected in memory and written with a single fsync (a group commit)
+ * once enough records are pending or the oldest pending record has waited for the
+ * commit window, so the cost of the fsync is shared by many changes.
+ *
+ * File layout:
+ *
+ *      uint8_t magic[8]                         JOURNAL_MAGIC
+ *      uint8_t records[n][JOURNAL_RECORD_SIZE]  operation, key (little endian), check byte
+ *
+ * On start-up the journal is replayed over the snapshot. Replay stops at the first
+ * record that is incomplete or does not check, which is where a crash cut the last
+ * commit, and the journal is truncated there. Replaying a record twice leaves the list
+ * unchanged, so a journal may safely hold changes that a snapshot already contains.
+ *
+ * Once the journal grows past a size limit it is renamed to "<journal>.old", a new
+ * journal is started and a background thread writes the current list to the snapshot
+ * file. The old journal is deleted when the snapshot is safely on the disk.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include <stdio.h>              /* For FILE */
+#include <pthread.h>            /* For the commit and compaction threads */
+#include <time.h>               /* For struct timespec */
+#include "account_snapshot.h"   /* For snapshot_status_t */
+
+#ifndef ACCOUNT_JOURNAL_H
+#define ACCOUNT_JOURNAL_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define JOURNAL_MAGIC           "ACCTJRNL"  /* First 8 bytes of a journal file */
+#define JOURNAL_HEADER_SIZE     8U          /* Size of the magic */
+#define JOURNAL_RECORD_SIZE     10U         /* Operation, 8-byte key and check byte */
+#define JOURNAL_MAX_BATCH       4096U       /* Largest number of records in one commit */
+#define JOURNAL_OLD_SUFFIX      ".old"      /* Suffix of a journal waiting for its compaction */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the operations stored in the journal.
+ */
+typedef enum
+{
+    JOURNAL_ADD = 'A',          /* The account was added. */
+    JOURNAL_REMOVE = 'R'        /* The account was removed. */
+} journal_op_t;
+
+/**
+ * @brief Enumeration for the results of the journal functions.
+ */
+typedef enum
+{
+    JOURNAL_OK,                 /* The operation succeeded. */
+    JOURNAL_IO_ERROR,           /* The file cannot be opened, written or forced to the disk. */
+    JOURNAL_BAD_FORMAT,         /* The file is not a journal. */
+    JOURNAL_NO_MEMORY           /* Memory allocation or thread creation failed. */
+} journal_status_t;
+
+/**
+ * @brief Type for the function applying a replayed record.
+ *
+ * @param op The operation of the record.
+ * @param key The key of the account.
+ * @param user_data The pointer given to Journal_Open().
+ */
+typedef void (*journal_apply_t)(journal_op_t op, uint64_t key, void* user_data);
+
+/**
+ * @brief Structure for the settings of a journal.
+ */
+typedef struct
+{
+    uint32_t commit_count;      /* Pending records that start a commit, 1 commits every record. */
+    uint32_t commit_window_ms;  /* Longest wait of a record before its commit, 0 for no limit. */
+    uint64_t compact_size;      /* Journal size in bytes that starts a compaction, 0 to never compact. */
+} Journal_Config_t;
+
+/**
+ * @brief Structure for the counters of a journal.
+ */
+typedef struct
+{
+    uint64_t records;           /* Records appended since the journal was opened. */
+    uint64_t commits;           /* Group commits, one fsync each. */
+    uint64_t replayed;          /* Records applied by the replay. */
+    uint64_t compactions;       /* Compactions started. */
+    uint64_t compact_failures;  /* Compactions whose snapshot could not be written. */
+} Journal_Stats_t;
+
+/**
+ * @brief Structure for an open journal.
+ *
+ * A zero-initialized structure is a closed journal.
+ */
+typedef struct
+{
+    FILE* file;                 /* Journal file, NULL if the journal is closed. */
+    char* path;                 /* Path of the journal file. */
+    char* old_path;             /* Path of the journal waiting for its compaction. */
+    char* snapshot_path;        /* Snapshot written by the compaction, NULL to never compact. */
+    Journal_Config_t config;    /* Settings of the journal. */
+    uint8_t* buffer;            /* Records waiting for their commit. */
+    uint32_t pending;           /* Number of records in the buffer. */
+    uint64_t size;              /* Size of the journal file including the pending records. */
+    uint64_t compact_at;        /* Size that starts the next compaction. */
+    struct timespec deadline;   /* Time the oldest pending record must be committed by. */
+    int32_t failed;             /* Set when a commit of the background thread failed. */
+    int32_t old_pending;        /* Set while the old journal is not folded into a snapshot. */
+    Journal_Stats_t stats;      /* Counters of the journal. */
+    pthread_mutex_t lock;       /* Protects the buffer, the file and the flags. */
+    pthread_cond_t wake;        /* Wakes the commit thread. */
+    pthread_t flusher;          /* Thread committing on the commit window. */
+    int32_t flusher_running;    /* Set while the commit thread exists. */
+    int32_t stopping;           /* Asks the commit thread to stop. */
+    pthread_t compactor;        /* Thread writing the snapshot. */
+    int32_t compactor_running;  /* Set until the compaction thread is joined. */
+    int32_t compact_busy;       /* Set while the compaction thread writes the snapshot. */
+    uint64_t* compact_keys;     /* Keys written by the compaction thread. */
+    uint64_t compact_count;     /* Number of keys written by the compaction thread. */
+} Journal_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Replay a journal and open it for appending.
+ *
+ * The old journal of an unfinished compaction is replayed first, then the journal.
+ * A torn tail is cut off. A missing journal is created.
+ *
+ * @param journal Output, the open journal.
+ * @param path The path of the journal file.
+ * @param snapshot_path The snapshot written by the compactions, NULL to never compact.
+ * @param config The settings of the journal.
+ * @param apply The function applying the replayed records.
+ * @param user_data A pointer given back to apply.
+ * @return JOURNAL_OK if the journal is open, an error code if not.
+ */
+journal_status_t Journal_Open(Journal_t* journal, const char* path, const char* snapshot_path,
+                              const Journal_Config_t* config, journal_apply_t apply, void* user_data);
+
+/**
+ * @brief Append a record to the journal.
+ *
+ * The record is durable once its group is committed, which happens here when enough
+ * records are pending and on the commit thread when the commit window ends.
+ *
+ * @param journal The open journal.
+ * @param op The operation.
+ * @param key The key of the account.
+ * @return JOURNAL_OK if the record is accepted, JOURNAL_IO_ERROR if a commit failed.
+ */
+journal_status_t Journal_Append(Journal_t* journal, journal_op_t op, uint64_t key);
+
+/**
+ * @brief Commit the pending records now.
+ *
+ * @param journal The open journal.
+ * @return JOURNAL_OK if the records are on the disk, JOURNAL_IO_ERROR if not.
+ */
+journal_status_t Journal_Commit(Journal_t* journal);
+
+/**
+ * @brief Check if the journal should be folded into the snapshot.
+ *
+ * @param journal The open journal.
+ * @return 1 if the journal passed its size limit and no compaction is running, 0 if not.
+ */
+int32_t Journal_Should_Compact(Journal_t* journal);
+
+/**
+ * @brief Fold the journal into a new snapshot.
+ *
+ * The journal is rotated and the snapshot is written by a background thread. If an
+ * earlier old journal was never folded into a snapshot, the snapshot is written
+ * right away instead, because the old journal cannot be replaced.
+ *
+ * @param journal The open journal.
+ * @param keys The keys of the whole list, as of the last appended record. The journal
+ *             takes ownership of this malloc() block.
+ * @param count The number of keys.
+ * @return JOURNAL_OK if the compaction started or completed, an error code if not.
+ */
+journal_status_t Journal_Compact(Journal_t* journal, uint64_t* keys, uint64_t count);
+
+/**
+ * @brief Wait for a running compaction to finish.
+ *
+ * @param journal The journal, open or closed.
+ */
+void Journal_Wait(Journal_t* journal);
+
+/**
+ * @brief Get the counters of a journal.
+ *
+ * @param journal The journal, open or closed.
+ * @param stats Output, the counters since the journal was opened.
+ */
+void Journal_Get_Stats(Journal_t* journal, Journal_Stats_t* stats);
+
+/**
+ * @brief Get a message describing a result of the journal functions.
+ *
+ * @param status The result.
+ * @return A constant string describing the result.
+ */
+const char* Journal_Status_Message(journal_status_t status);
+
+/**
+ * @brief Commit the pending records and close the journal.
+ *
+ * @param journal The journal, open or closed.
+ * @param reset 1 if the whole list was just saved to the snapshot, which empties the
+ *              journal and deletes the old journal, 0 to keep them.
+ * @return JOURNAL_OK if every record is on the disk, JOURNAL_IO_ERROR if not.
+ */
+journal_status_t Journal_Close(Journal_t* journal, int32_t reset);
+
+#endif /* ACCOUNT_JOURNAL_H */
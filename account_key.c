@@ -0,0 +1,110 @@
+/**
+ * @file account_key.c
+ * @brief This file contains the implementation of the packed 64-bit account keys.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "account_key.h"        /* Include header file of this function file */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/**
+ * @brief Code of every byte value in a key.
+ *
+ * '0'-'9' are 1-10, 'A'-'Z' are 11-36 and 'a'-'z' are 37-62, in ASCII order.
+ * 0 marks an unused position and every other byte.
+ */
+const uint8_t account_char_code[256] =
+{
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  2,  3,  4,  5,  6,  7,  8,  9, 10,  0,  0,  0,  0,  0,  0,
+     0, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,
+    26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,  0,  0,  0,  0,  0,
+     0, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0
+};
+
+/**
+ * @brief Character of every code of a key, the inverse of account_char_code.
+ */
+static const char account_code_char[64] =
+    "\0" "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Pack an account into a key.
+ *
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param key Output, the key of the account.
+ * @return 1 if the account can be stored in a key, 0 if it is too long or has a character
+ * that is not a letter or a digit.
+ */
+int32_t Account_Encode(const int8_t* ptr, uint32_t length, uint64_t* key)
+{
+    int32_t valid = (length <= ACCOUNT_MAX_LENGTH);     /* Result of the packing */
+    uint64_t packed = 0;                                /* Key being built */
+    uint32_t shift = ACCOUNT_KEY_TOP_SHIFT;             /* Position of the current character */
+    uint32_t i = 0;                                     /* Counter of characters */
+    uint8_t code = 0;                                   /* Code of the current character */
+
+    /* Place each character below the previous one */
+    for (i = 0; (i < length) && valid; i++)
+    {
+        code = account_char_code[(uint8_t)ptr[i]];
+        valid = (code != 0U);
+        packed |= (uint64_t)code << shift;
+        shift -= ACCOUNT_KEY_BITS;
+    }
+
+    if (valid)
+    {
+        *key = packed;
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Unpack a key into the text of the account.
+ *
+ * @param key The key to unpack.
+ * @param account Output buffer of at least ACCOUNT_MAX_LENGTH + 1 bytes, NUL terminated.
+ * @return The length of the account.
+ */
+uint32_t Account_Decode(uint64_t key, int8_t* account)
+{
+    uint32_t length = 0;                                /* Number of characters written */
+    uint32_t shift = ACCOUNT_KEY_TOP_SHIFT;             /* Position of the current character */
+    uint8_t code = (uint8_t)((key >> shift) & 0x3FU);   /* Code of the current character */
+
+    /* Unused positions are only found after the last character */
+    while ((length < ACCOUNT_MAX_LENGTH) && (code != 0U))
+    {
+        account[length] = (int8_t)account_code_char[code];
+        length++;
+        shift -= ACCOUNT_KEY_BITS;
+        code = (length < ACCOUNT_MAX_LENGTH) ? (uint8_t)((key >> shift) & 0x3FU) : 0U;
+    }
+    account[length] = '\0';
+
+    return length;
+} /* EOF */
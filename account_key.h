@@ -0,0 +1,77 @@
+/**
+ * @file account_key.h
+ * @brief This file contains the declarations of the packed 64-bit account keys.
+ *
+ * An account has at most 10 characters taken from '0'-'9', 'A'-'Z' and 'a'-'z', so each
+ * character fits in 6 bits. The first character is stored in the highest bits and unused
+ * positions are 0, which makes the numeric order of the keys the same as the strcmp()
+ * order of the accounts.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>         /* Include standard integer types library for fixed-width integers */
+
+#ifndef ACCOUNT_KEY_H
+#define ACCOUNT_KEY_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ACCOUNT_MAX_LENGTH      10U     /* Maximum number of characters of an account */
+#define ACCOUNT_KEY_BITS        6U      /* Number of bits used by one character */
+#define ACCOUNT_KEY_TOP_SHIFT   54U     /* Position of the first character in the key */
+#define ACCOUNT_KEY_NONE        UINT64_MAX  /* A key no account packs to, never found in the list */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/**
+ * @brief Code of every byte value in a key, 0 if the byte cannot be stored in a key.
+ */
+extern const uint8_t account_char_code[256];
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Pack an account into a key.
+ *
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param key Output, the key of the account.
+ * @return 1 if the account can be stored in a key, 0 if it is too long or has a character
+ * that is not a letter or a digit.
+ */
+int32_t Account_Encode(const int8_t* ptr, uint32_t length, uint64_t* key);
+
+/**
+ * @brief Unpack a key into the text of the account.
+ *
+ * @param key The key to unpack.
+ * @param account Output buffer of at least ACCOUNT_MAX_LENGTH + 1 bytes, NUL terminated.
+ * @return The length of the account.
+ */
+uint32_t Account_Decode(uint64_t key, int8_t* account);
+
+/**
+ * @brief Compute the hash of a key.
+ *
+ * @param key The key to hash.
+ * @return The hash of the key, every bit depends on every bit of the key.
+ */
+static inline uint64_t Account_Key_Hash(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+#endif /* ACCOUNT_KEY_H */
@@ -2,7 +2,7 @@
  * @file account_manage.c
  * @brief This file contains the implementation of the functions for managing student accounts.
  *
- * It includes the definition of the status_enum_t, Node_t, func types, as well as functions.
+ * It includes the definition of the status_enum_t, account_handle_t, func types, as well as functions.
  * The file also contains the implementation of the RegisterCallback, Check_Account, and Show_Error functions.
  * Additionally, it includes the implementation of the Add_Account, Remove_Account, Is_Account_Exist,
  * Display_ListAccounts, and Search_Account functions.
@@ -15,6 +15,24 @@
  * Include
  ******************************************************************************/
 #include "account_manage.h"     /* Include header file of this function file */
+#include "account_store.h"      /* For the stores of accounts */
+#include "account_epoch.h"      /* For the read sections of the calls on the live store */
+#include "account_key.h"        /* For the packed keys of the accounts */
+#include "account_check.h"      /* For the batch validator */
+#include "account_stats.h"      /* For the counters and latency histograms */
+#include "account_dispatch.h"   /* For the asynchronous delivery of the rejected accounts */
+#include "account_export.h"     /* For the bulk output of the listings */
+#include "account_rules.h"      /* For the configurable validation rules */
+#include "account_trace.h"      /* For recording the operations */
+#include <stdatomic.h>          /* For the pointer to the live store */
+#ifdef _WIN32
+#include <conio.h>              /* For getch() */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ACCOUNT_BATCH_KEYS      256U    /* Accounts of a batch packed into keys at a time */
 
 /*******************************************************************************
  * Prototypes
@@ -30,7 +48,13 @@ func callback_function;
  * Variables
  ******************************************************************************/
 status_enum_t current_status = CORRECT; /* This variable is used to store the current status of the account. */
-Node_t* head = NULL;                    /* This variable is used to store the head of the linked list. */
+account_store_t* _Atomic live_store = &default_account_store;  /* This variable is used to store the store the list functions work on. */
+Dispatcher_t error_dispatcher;          /* This variable is used to call the callback function off the checking thread. */
+uint64_t checked_accounts = 0;          /* This variable is used to number the accounts in the reports of the dispatcher. */
+const account_rules_t* _Atomic active_rules = NULL;    /* This variable is used to store the rules of the checks, NULL for the built-in ones. */
+Trace_Writer_t trace_writer;            /* This variable is used to record the operations started by Start_Trace(). */
+Trace_Writer_t* _Atomic active_trace = NULL;    /* This variable is used to point to trace_writer while a trace is recorded. */
+const int8_t* expired_account = NULL;   /* This variable is used to give the account of an EXPIRED call to the callback function. */
 
 /*******************************************************************************
  * Code
@@ -48,6 +72,100 @@ void RegisterCallback(func func_add)
     callback_function = func_add;
 }
 
+/**
+ * @brief Get the account whose expiry is being reported.
+ *
+ * This function is used by the callback function, while it is called with EXPIRED.
+ *
+ * @return The account, NUL terminated, NULL outside of an EXPIRED call.
+ */
+const int8_t* Get_Expired_Account(void)
+{
+    return expired_account;
+}
+
+/**
+ * @brief Record an operation on an account given as text, if a trace is recorded.
+ *
+ * @param op The operation.
+ * @param account The account, as given to the operation.
+ * @param length The length of the account.
+ * @param result The result of the operation.
+ */
+static void Trace_Text(trace_op_t op, const int8_t* account, size_t length, int32_t result)
+{
+    Trace_Writer_t* writer = atomic_load_explicit(&active_trace, memory_order_acquire);    /* Trace being recorded */
+
+    if (writer != NULL)
+    {
+        Trace_Write(writer, op, account, (length > UINT8_MAX) ? (uint8_t)UINT8_MAX : (uint8_t)length, result);
+    }
+}
+
+/**
+ * @brief Record an operation on an account given as a key, if a trace is recorded.
+ *
+ * @param op The operation.
+ * @param key The key of the account, ACCOUNT_KEY_NONE is recorded as an empty account.
+ * @param result The result of the operation.
+ */
+static void Trace_Key(trace_op_t op, uint64_t key, int32_t result)
+{
+    Trace_Writer_t* writer = atomic_load_explicit(&active_trace, memory_order_acquire);    /* Trace being recorded */
+    int8_t account[ACCOUNT_MAX_LENGTH + 1U];    /* Text of the account */
+    uint32_t length = 0;                        /* Length of the account */
+
+    if (writer != NULL)
+    {
+        length = (key == ACCOUNT_KEY_NONE) ? 0U : Account_Decode(key, account);
+        Trace_Write(writer, op, account, (uint8_t)length, result);
+    }
+}
+
+/**
+ * @brief Pass a rejected account to the registered callback function.
+ *
+ * The account is queued in the dispatcher when the asynchronous delivery is started,
+ * the callback function is called at once otherwise.
+ *
+ * @param status The status of the account.
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param number The number of accounts checked before this one.
+ */
+static void Report_Error(status_enum_t status, const int8_t* ptr, uint8_t length, uint64_t number)
+{
+    if (error_dispatcher.running != 0)
+    {
+        Dispatch_Report(&error_dispatcher, (uint32_t)status, number, ptr, length);
+    }
+    else
+    {
+        callback_function(status);
+    }
+}
+
+/**
+ * @brief Call the registered callback function for a batch of rejected accounts.
+ *
+ * @param reports The reports of the rejected accounts.
+ * @param n The number of reports.
+ * @param user_data Not used.
+ */
+static void Deliver_Errors(const Dispatch_Report_t* reports, uint32_t n, void* user_data)
+{
+    uint32_t i = 0;     /* Counter of reports */
+
+    (void)user_data;
+    for (i = 0; i < n; i++)
+    {
+        if (callback_function != NULL)
+        {
+            callback_function((status_enum_t)reports[i].status);
+        }
+    }
+}
+
 /**
  * @brief Check the validity of an account.
  *
@@ -57,15 +175,69 @@ void RegisterCallback(func func_add)
  * @param length The length of the account.
  */
 void Check_Account(int8_t* ptr, uint8_t length)
+{
+    /* Check the account without keeping its key */
+    Check_Account_Key(ptr, length, NULL);
+}
+
+/**
+ * @brief Check the validity of an account and pack it into a key.
+ *
+ * This function is used to check the validity of an account. The key of the account
+ * is built in the same pass over the characters.
+ *
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param key Output, the key of the account when it is CORRECT. May be NULL.
+ */
+void Check_Account_Key(int8_t* ptr, uint8_t length, uint64_t* key)
+{
+    /* Check the account without a context and keep the result for Get_Status(). */
+    current_status = Check_Account_Ctx(NULL, ptr, length, key);
+
+    /* Check if a callback function is registered and the current status is not CORRECT. */
+    if (callback_function != NULL && current_status != CORRECT)
+    {
+        /* Pass the current status to the callback function, at once or through the dispatcher. */
+        Report_Error(current_status, ptr, length, checked_accounts);
+    }
+    checked_accounts++;
+    Trace_Text(TRACE_CHECK, ptr, length, (int32_t)current_status);
+}
+
+/**
+ * @brief Check the validity of an account without touching any global state.
+ *
+ * This function is used to check the validity of an account from any thread. The status is
+ * returned instead of being stored for Get_Status(), and a rejected account is reported to the
+ * callback of the context instead of the registered callback function.
+ *
+ * @param ctx The context of the check, NULL to check without a callback.
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param key Output, the key of the account when it is CORRECT. May be NULL.
+ * @return The status of the account.
+ */
+status_enum_t Check_Account_Ctx(const check_context_t* ctx, const int8_t* ptr, uint8_t length, uint64_t* key)
 {
     int16_t i = 0;                      /* Initialize the counter variable. */
-    current_status = CORRECT;           /* Set the current status to CORRECT. */
+    uint64_t packed = 0;                /* Key of the account being built. */
+    uint32_t shift = ACCOUNT_KEY_TOP_SHIFT; /* Position of the current character in the key. */
+    status_enum_t status = CORRECT;     /* Set the status to CORRECT. */
+    uint64_t start = Stats_Start();     /* Start time of the check, for the statistics. */
+    const account_rules_t* rules = (ctx != NULL && ctx->rules != NULL)
+                                 ? ctx->rules : atomic_load_explicit(&active_rules, memory_order_acquire);  /* Rules of the check. */
 
+    /* A rule set builds the key in its own pass. */
+    if (rules != NULL)
+    {
+        status = Rules_Check(rules, ptr, length, &packed);
+    }
     /* Check if the length of the account is more than 10. */
-    if (length > 10)
+    else if (length > 10)
     {
-        /* Set the current status to LENGHT_INVALID. */
-        current_status = LENGHT_INVALID;
+        /* Set the status to LENGHT_INVALID. */
+        status = LENGHT_INVALID;
     }
     else
     {
@@ -75,22 +247,158 @@ void Check_Account(int8_t* ptr, uint8_t length)
             /* Check if the character is not a letter or a number. */
             if (!((ptr[i] >= 'a' && ptr[i] <= 'z') || (ptr[i] >= 'A' && ptr[i] <= 'Z') || (ptr[i] >= '1' && ptr[i] <= '9')))
             {
-                /* Set the current status to CHAR_INVALID. */
-                current_status = CHAR_INVALID;
+                /* Set the status to CHAR_INVALID. */
+                status = CHAR_INVALID;
                 /* Exit the loop. */
                 i = length;
             }
+            else
+            {
+                /* Place the character below the previous one in the key. */
+                packed |= (uint64_t)account_char_code[(uint8_t)ptr[i]] << shift;
+                shift -= ACCOUNT_KEY_BITS;
+            }
         }
     }
 
-    /* Check if a callback function is registered and the current status is not CORRECT. */
-    if (callback_function != NULL && current_status != CORRECT)
+    /* Hand the key out only for a correct account. */
+    if (key != NULL && status == CORRECT)
+    {
+        *key = packed;
+    }
+
+    /* Report a rejected account to the callback of the context. */
+    if (ctx != NULL && ctx->callback != NULL && status != CORRECT)
+    {
+        ctx->callback(status, ptr, length, ctx->user_data);
+    }
+
+    Stats_Count((stats_counter_t)(STATS_CHECK_CORRECT + status));
+    Stats_Stop(STATS_OP_CHECK, start);
+
+    return status;
+}
+
+/**
+ * @brief Count the results of a batch check in the statistics.
+ *
+ * @param out The status of each account.
+ * @param n The number of accounts.
+ */
+static void Count_Checks(const status_enum_t* out, size_t n)
+{
+#ifdef ACCOUNT_STATS
+    size_t i = 0;       /* Counter of accounts */
+
+    for (i = 0; i < n; i++)
+    {
+        Stats_Count((stats_counter_t)(STATS_CHECK_CORRECT + out[i]));
+    }
+#else
+    (void)out;
+    (void)n;
+#endif
+}
+
+/**
+ * @brief Check the validity of many accounts.
+ *
+ * This function gives the same result as calling Check_Account() on each account, but it
+ * checks the accounts with vector instructions when the CPU supports them.
+ * The callback function is called for each account that is not CORRECT, in order.
+ *
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+void Check_Accounts(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out)
+{
+    size_t i = 0;       /* Counter of accounts */
+    const account_rules_t* rules = atomic_load_explicit(&active_rules, memory_order_acquire);  /* Rules of the check */
+
+    /* Check the whole batch first */
+    if (rules != NULL)
+    {
+        Rules_Check_Batch(rules, ptrs, lens, n, out);
+    }
+    else
+    {
+        Check_Batch(ptrs, lens, n, out);
+    }
+    Count_Checks(out, n);
+
+    /* Then report the rejected accounts */
+    if (callback_function != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            if (out[i] != CORRECT)
+            {
+                Report_Error(out[i], ptrs[i], lens[i], checked_accounts + i);
+            }
+        }
+    }
+    checked_accounts += n;
+}
+
+/**
+ * @brief Check the validity of many accounts without touching any global state.
+ *
+ * This function is the batch form of Check_Account_Ctx(). Rejected accounts are reported
+ * to the callback of the context, in order.
+ *
+ * @param ctx The context of the check, NULL to check without a callback.
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+void Check_Accounts_Ctx(const check_context_t* ctx, const int8_t* const* ptrs, const uint8_t* lens, size_t n,
+                        status_enum_t* out)
+{
+    size_t i = 0;       /* Counter of accounts */
+    const account_rules_t* rules = (ctx != NULL && ctx->rules != NULL)
+                                 ? ctx->rules : atomic_load_explicit(&active_rules, memory_order_acquire);  /* Rules of the check */
+
+    /* Check the whole batch first */
+    if (rules != NULL)
+    {
+        Rules_Check_Batch(rules, ptrs, lens, n, out);
+    }
+    else
     {
-        /* Call the callback function with the current status. */
-        callback_function(current_status);
+        Check_Batch(ptrs, lens, n, out);
+    }
+    Count_Checks(out, n);
+
+    /* Then report the rejected accounts */
+    if (ctx != NULL && ctx->callback != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            if (out[i] != CORRECT)
+            {
+                ctx->callback(out[i], ptrs[i], lens[i], ctx->user_data);
+            }
+        }
     }
 }
 
+/**
+ * @brief Set the rules of the checks.
+ *
+ * Every later check without rules of its own uses them, on any thread. The rules must
+ * stay valid until they are replaced and no check can still be using them.
+ *
+ * @param rules The compiled rules (see account_rules.h), NULL for the built-in ones:
+ * at most 10 characters among a-z, A-Z and 1-9.
+ */
+void Set_Account_Rules(const account_rules_t* rules)
+{
+    atomic_store_explicit(&active_rules, rules, memory_order_release);
+}
+
 /**
  * @brief Display error message based on the status.
  *
@@ -111,7 +419,9 @@ void Show_Error(status_enum_t status)
         /* If the status is LENGHT_INVALID, display an error message about the length of the account. */
         case LENGHT_INVALID:
         {
-            printf("\nError: Length of account is more than 10.\n\n");
+            printf((atomic_load_explicit(&active_rules, memory_order_relaxed) == NULL)
+                   ? "\nError: Length of account is more than 10.\n\n"
+                   : "\nError: Length of account is not accepted.\n\n");
             printf("Please enter again . . .\n");
             break;
         }
@@ -123,6 +433,26 @@ void Show_Error(status_enum_t status)
             printf("Please enter again . . .\n");
             break;
         }
+        /* If the status is PREFIX_INVALID, display an error message about the required prefix. */
+        case PREFIX_INVALID:
+        {
+            printf("\nError: Account does not start with a required prefix.\n\n");
+            printf("Please enter again . . .\n");
+            break;
+        }
+        /* If the status is SEQUENCE_INVALID, display an error message about the forbidden sequence. */
+        case SEQUENCE_INVALID:
+        {
+            printf("\nError: Account contains a forbidden sequence.\n\n");
+            printf("Please enter again . . .\n");
+            break;
+        }
+        /* If the status is EXPIRED, display the account whose time to live ran out. */
+        case EXPIRED:
+        {
+            printf("\nAccount %s expired.\n", (expired_account != NULL) ? (const char*)expired_account : "");
+            break;
+        }
     }
 }
 
@@ -138,10 +468,37 @@ status_enum_t Get_Status(void)
     return current_status;
 }
 
+/**
+ * @brief Start a call on the live store.
+ *
+ * The call runs inside an epoch read section, so a store swapped out by another thread
+ * is not destroyed by Retire_Account_Store() before the call ends. Epoch_Enter() always
+ * protects the calling thread, also when every epoch slot is taken, so the store is
+ * never returned without that protection.
+ *
+ * @return The live store.
+ */
+static account_store_t* Enter_Store(void)
+{
+    Epoch_Enter();
+    return atomic_load_explicit(&live_store, memory_order_acquire);
+}
+
+/**
+ * @brief End a call on the live store.
+ */
+static void Leave_Store(void)
+{
+    Epoch_Exit();
+}
+
 /**
  * @brief Check if the account exists in the list.
  *
  * This function is used to check if the account exists in the list.
+ * The account is looked up in the sharded set of the keys, so the cost does not depend on the
+ * size of the list, behind a copy of the Bloom filter that rules out most absent accounts.
+ * Any number of threads may call it at once, without a lock, while one thread changes the list.
  *
  * @param account The account to be checked.
  * @return 1 if the account exists, 0 if not.
@@ -149,187 +506,953 @@ status_enum_t Get_Status(void)
 int32_t Is_Account_Exist(int8_t* account)
 {
     int32_t found = 0;          /* Initialize the variable to store the result of the search */
-    Node_t* current = head;     /* Initialize the current node to the head of the list */
+    uint64_t key = 0;           /* Key of the account */
 
-    /* Iterate through the list until the end is reached */
-    while(current != NULL)
+    /* An account that cannot be packed into a key cannot be in the list */
+    if (Account_Encode(account, (uint32_t)strlen((const char*)account), &key))
     {
-        /* If the account in the current node matches the given account, set the found flag to 1 */
-        if (strcmp(current->account, account) == 0)
-        {
-            found = 1;
-        }
-        /* Move to the next node in the list */
-        current = current->next;
+        found = Is_Account_Key_Exist(key);
+    }
+    else
+    {
+        Trace_Text(TRACE_EXISTS, account, strlen((const char*)account), found);
     }
     /* Return the result of the search */
     return found;
 }
 
+/**
+ * @brief Check if the account with the given key exists in the list.
+ *
+ * As Is_Account_Exist(), any number of threads may call it at once.
+ *
+ * @param key The key of the account to be checked.
+ * @return 1 if the account exists, 0 if not.
+ */
+int32_t Is_Account_Key_Exist(uint64_t key)
+{
+    account_store_t* store = Enter_Store();  /* The live store */
+    int32_t found = (Account_Store_Search_Shared(store, key) == 1) ? 1 : 0;  /* 1 if the store holds the key */
+
+    Leave_Store();
+    Trace_Key(TRACE_EXISTS, key, found);
+    return found;
+}
+
 /**
  * @brief Add an account to the list.
  *
  * This function is used to add an account to the list.
+ * The handle it returns finds the account again in O(1) until it is removed.
  *
  * @param new_account The new account to be added.
+ * @return The handle of the account, also for an account already in the list.
+ * ACCOUNT_HANDLE_NONE if the account is not valid or memory allocation failed.
  */
-void Add_Account(int8_t* new_account)
+account_handle_t Add_Account(int8_t* new_account)
 {
-    /* Allocate memory for the new node */
-    Node_t* newNode;
-    newNode = (Node_t *)malloc(sizeof(Node_t));
+    account_store_t* store = NULL;  /* The live store */
+    uint64_t key = 0;           /* Key of the new account */
+    account_handle_t handle = ACCOUNT_HANDLE_NONE;  /* Handle of the new account */
+    int32_t added = 0;          /* Result of the insertion */
 
-    /* Check if memory allocation is successful */
-    if (newNode == NULL)
+    /* Only a valid account can be packed into a key */
+    if (Account_Encode(new_account, (uint32_t)strlen((const char*)new_account), &key) == 0)
     {
-        /* If memory allocation failed, display an error message */
-        printf("Error: Memory allocation failed.\n");
+        printf("Error: Account is not valid.\n");
+        Trace_Text(TRACE_ADD, new_account, strlen((const char*)new_account), 0);
     }
     else
     {
-        /* If memory allocation is successful, copy the new account to the new node */
-        strcpy(newNode->account, new_account);
-        /* Set the next pointer of the new node to the current head of the list */
-        newNode->next = head;
-        /* Set the head of the list to the new node */
-        head = newNode;
+        store = Enter_Store();
+        added = Account_Store_Add_Handle(store, key, &handle);
+        Leave_Store();
+        Trace_Key(TRACE_ADD, key, added);
     }
+
+    return handle;
 }
 
 /**
- * @brief Remove an account from the list.
+ * @brief Add an account to the list for a limited time.
  *
- * This function is used to remove an account from the linked list of accounts
- * It iterates through the linked list of accounts and if the account is found, it is removed.
+ * The account is removed by the first call of Expire_Accounts() whose clock reaches
+ * its deadline. An account already in the list gets the new time to live.
  *
- * @param account The account to be removed.
- * @return 1 if the account is removed, 0 if not. -1 if the list is empty
+ * @param new_account The new account to be added.
+ * @param ttl The ticks from the clock of the list to the deadline, 0 for no deadline.
+ * @return The handle of the account, ACCOUNT_HANDLE_NONE if the account is not valid
+ * or memory allocation failed.
  */
-int32_t Remove_Account(int8_t* account)
+account_handle_t Add_Account_Ttl(int8_t* new_account, uint64_t ttl)
 {
-    Node_t* current = head;     /* Initialize the current node to the head of the list */
-    Node_t* pre = NULL;         /* Initialize the previous node to NULL */
-    int8_t is_Removed = 0;      /* Initialize the variable to store the result of the removal */
+    account_store_t* store = NULL;  /* The live store */
+    uint64_t key = 0;           /* Key of the new account */
+    account_handle_t handle = ACCOUNT_HANDLE_NONE;  /* Handle of the new account */
 
-    /* If the list is empty, set the is_Removed flag to -1 */
-    if (current == NULL)
+    /* Only a valid account can be packed into a key */
+    if (Account_Encode(new_account, (uint32_t)strlen((const char*)new_account), &key) == 0)
     {
-        is_Removed = -1;
+        printf("Error: Account is not valid.\n");
     }
     else
     {
-        /* Iterate through the list until the end is reached */
-        while (current != NULL)
+        store = Enter_Store();
+        if (Account_Store_Add_Handle(store, key, &handle) >= 0 && Account_Store_Set_Ttl(store, handle, ttl) < 0)
         {
-            /* If the account in the current node matches the given account, set the is_Removed flag to 1 */
-            if (strcmp(current->account, account) == 0)
-            {
-                is_Removed = 1;
-                /* If the previous node is NULL, set the head of the list to the next node */
-                if (pre == NULL)
-                {
-                    head = current->next;
-                }
-                else
-                {
-                    /* If the previous node is not NULL, set the next pointer of the previous node
-                    to the next node of the current node */
-                    pre->next = current->next;
-                }
-                /* Set the current node to NULL to exit loop */
-                current = NULL;
-            }
-            else
-            {
-                /* If the account in the current node does not match the given account,
-                move to the next node in the list */
-                pre = current;
-                current = current->next;
-            }
+            handle = ACCOUNT_HANDLE_NONE;
         }
+        Leave_Store();
     }
-    /* Return the result of the removal */
-    return is_Removed;
+
+    return handle;
 }
 
 /**
- * @brief Displays the list of accounts.
+ * @brief Report an expired account to the registered callback function, with EXPIRED.
  *
- * This function iterates through the linked list of accounts and displays each account.
- * If the list is empty, it prints a message indicating that there are no accounts to show.
+ * The account can be read with Get_Expired_Account() during the call.
+ *
+ * @param account The account, NUL terminated.
+ * @param user_data Not used.
+ * @return 1.
  */
-void Display_ListAccounts(void)
+static int32_t Deliver_Expired(const int8_t* account, void* user_data)
 {
-    Node_t* current = head;     /* Initialize the current node to the head of the list */
-    int32_t i = 1;              /* Counter for the number of accounts */
-
-    /* If the list is empty */
-    if (current == NULL)
-    {
-        /* Print a message indicating that there are no accounts to show */
-        printf("\nNo accounts to show!!!\n");
-    }
-    else
+    (void)user_data;
+    if (callback_function != NULL)
     {
-        /* Print a message indicating that the list of accounts is about to be displayed */
-        printf("\nLIST OF ACCOUNTS: \n");
-        /* Iterate through the list until the end is reached */
-        while (current != NULL)
-        {
-            /* Print the account number and the account name */
-            printf("%d. %s\n", i, current->account);
-            /* Increment the account counter */
-            i++;
-            /* Move to the next node in the list */
-            current = current->next;
-        }
+        expired_account = account;
+        callback_function(EXPIRED);
+        expired_account = NULL;
     }
+
+    return 1;
 }
 
 /**
- * @brief Searches for an account in the list.
+ * @brief Move the clock of the list forward and remove the accounts whose time to live ran out.
  *
- * This function iterates through the linked list of accounts and compares each account with the given account.
- * If a match is found, it sets the found flag to 1 and stops the search.
- * If the list is empty, it sets the found flag to -1.
+ * Each removed account is reported to the registered callback function with EXPIRED,
+ * in the calling thread and in order of its deadline. Scheduling and cancelling a deadline
+ * are O(1), and the clock skips the stretches without deadlines.
  *
- * @param account The account to search for.
- * @return The result of the search. -1 if the list is empty, 0 if the account is not found,
- * 1 if the account is found.
+ * @param now The new tick of the clock, ignored if it is not after the current one.
+ * @return The number of accounts removed.
  */
-int32_t Search_Account(int8_t* account)
+uint64_t Expire_Accounts(uint64_t now)
 {
-    Node_t* current = head;     /* Initialize the current node to the head of the list */
-    int32_t found = 0;          /* Flag to indicate if the account is found */
+    account_store_t* store = Enter_Store();  /* The live store */
+    uint64_t count = Account_Store_Expire(store, now, Deliver_Expired, NULL);  /* Number of accounts removed */
 
-    /* If the list is empty */
-    if (current == NULL)
+    Leave_Store();
+    return count;
+}
+
+/**
+ * @brief Add the account with the given key to the list.
+ *
+ * An account that is already in the list is not added again.
+ *
+ * @param key The key of the new account, as produced by Check_Account_Key().
+ * @return 1 if the account is added, 0 if it is already in the list, -1 if memory allocation failed.
+ */
+int32_t Add_Account_Key(uint64_t key)
+{
+    account_store_t* store = Enter_Store();  /* The live store */
+    int32_t result = Account_Store_Add(store, key); /* Result of the insertion */
+
+    Leave_Store();
+    Trace_Key(TRACE_ADD, key, result);
+    return result;
+}
+
+/**
+ * @brief Remove an account from the list.
+ *
+ * This function is used to remove an account from the slot array of accounts
+ * The account is looked up in the hash index and, if it is found, its slot is freed.
+ *
+ * @param account The account to be removed.
+ * @return 1 if the account is removed, 0 if not. -1 if the list is empty
+ */
+int32_t Remove_Account(int8_t* account)
+{
+    int32_t is_Removed = 0;     /* Result of the removal */
+    uint64_t key = 0;           /* Key of the account */
+
+    /* An account that cannot be packed into a key cannot be in the list */
+    if (Account_Encode(account, (uint32_t)strlen((const char*)account), &key))
     {
-        /* Set the found flag to -1 */
-        found = -1;
+        is_Removed = Remove_Account_Key(key);
     }
     else
     {
-        /* Iterate through the list until the end is reached */
-        while (current != NULL)
-        {
-            /* If the account in the current node matches the given account */
-            if (strcmp(current->account, account) == 0)
-            {
-                /* Set the found flag to 1 */
-                found = 1;
-                /* Exit loop */
-                current = NULL;
-            }
-            else
-            {
-                /* Move to the next node in the list */
-                current = current->next;
-            }
-        }
+        is_Removed = (Get_Account_Count() == 0U) ? -1 : 0;
+        Trace_Text(TRACE_REMOVE, account, strlen((const char*)account), is_Removed);
     }
-    /* Return the result of the search */
-    return found;
+    /* Return the result of the removal */
+    return is_Removed;
+}
+
+/**
+ * @brief Remove the account with the given key from the list.
+ *
+ * @param key The key of the account to be removed.
+ * @return 1 if the account is removed, 0 if not. -1 if the list is empty
+ */
+int32_t Remove_Account_Key(uint64_t key)
+{
+    account_store_t* store = Enter_Store();  /* The live store */
+    int32_t is_Removed = Account_Store_Remove(store, key);  /* Result of the removal */
+
+    Leave_Store();
+    Trace_Key(TRACE_REMOVE, key, is_Removed);
+    return is_Removed;
+}
+
+/**
+ * @brief Remove the account of a handle from the list.
+ *
+ * A handle belongs to the store that was live when it was given. Once its account is
+ * removed, or the list is emptied or loaded, the handle is stale and never names
+ * another account.
+ *
+ * @param handle The handle of the account, as returned by Add_Account().
+ * @return 1 if the account is removed, 0 if the handle is stale. -1 if the list is empty
+ */
+int32_t Remove_Account_Handle(account_handle_t handle)
+{
+    account_store_t* store = Enter_Store();                             /* The live store */
+    int32_t is_Removed = Account_Store_Remove_Handle(store, handle);    /* Result of the removal */
+
+    Leave_Store();
+    return is_Removed;
+}
+
+/**
+ * @brief Get the account of a handle.
+ *
+ * @param handle The handle of the account, as returned by Add_Account().
+ * @param account Output, the account, NUL terminated, ACCOUNT_MAX_LENGTH + 1 bytes.
+ * Left unchanged if the handle is stale.
+ * @return 1 if the handle names an account of the list, 0 if it is stale.
+ */
+int32_t Lookup_Account_Handle(account_handle_t handle, int8_t* account)
+{
+    account_store_t* store = Enter_Store();         /* The live store */
+    uint64_t key = 0;                               /* Key of the account */
+    int32_t found = Account_Store_Lookup(store, handle, &key);  /* 1 if the handle is not stale */
+
+    Leave_Store();
+    if (found)
+    {
+        Account_Decode(key, account);
+    }
+    return found;
+}
+
+/**
+ * @brief Pack a group of accounts into keys.
+ *
+ * @param accounts The accounts.
+ * @param count The number of accounts, at most ACCOUNT_BATCH_KEYS.
+ * @param keys Output, the key of each account, ACCOUNT_KEY_NONE for an account that is not valid.
+ */
+static void Encode_Accounts(int8_t* const* accounts, uint32_t count, uint64_t* keys)
+{
+    uint32_t i = 0;             /* Account counter */
+
+    for (i = 0; i < count; i++)
+    {
+        if (!Account_Encode(accounts[i], (uint32_t)strlen((const char*)accounts[i]), &keys[i]))
+        {
+            keys[i] = ACCOUNT_KEY_NONE;
+        }
+    }
+}
+
+/**
+ * @brief Remove many accounts from the list.
+ *
+ * The accounts are removed in order, as many calls to Remove_Account() would, but the
+ * cache misses of a group of accounts overlap. An account that is not valid is never found.
+ *
+ * @param accounts The accounts to be removed.
+ * @param count The number of accounts.
+ * @param results Output, the result of each removal, as Remove_Account(). May be NULL.
+ * @return The number of accounts removed.
+ */
+uint64_t Remove_Accounts(int8_t* const* accounts, uint64_t count, int32_t* results)
+{
+    uint64_t keys[ACCOUNT_BATCH_KEYS];                  /* Keys of the current group of accounts */
+    account_store_t* store = Enter_Store();             /* The live store */
+    uint64_t total = 0;                                 /* Accounts removed */
+    uint64_t first = 0;                                 /* First account of the current group */
+    uint32_t size = 0;                                  /* Accounts of the current group */
+
+    for (first = 0; first < count; first += size)
+    {
+        size = (count - first < ACCOUNT_BATCH_KEYS) ? (uint32_t)(count - first) : ACCOUNT_BATCH_KEYS;
+        Encode_Accounts(&accounts[first], size, keys);
+        total += Account_Store_Remove_Batch(store, keys, size, (results != NULL) ? &results[first] : NULL);
+    }
+    Leave_Store();
+
+    return total;
+}
+
+/**
+ * @brief Remove the accounts with the given keys from the list.
+ *
+ * @param keys The keys of the accounts to be removed.
+ * @param count The number of keys.
+ * @param results Output, the result of each removal, as Remove_Account_Key(). May be NULL.
+ * @return The number of accounts removed.
+ */
+uint64_t Remove_Account_Keys(const uint64_t* keys, uint64_t count, int32_t* results)
+{
+    account_store_t* store = Enter_Store();                                      /* The live store */
+    uint64_t total = Account_Store_Remove_Batch(store, keys, count, results);    /* Accounts removed */
+
+    Leave_Store();
+    return total;
+}
+
+/**
+ * @brief Displays the list of accounts.
+ *
+ * This function formats the accounts of the list into a large buffer and writes it
+ * at once, instead of calling printf() for each account.
+ * If the list is empty, it prints a message indicating that there are no accounts to show.
+ */
+void Display_ListAccounts(void)
+{
+    account_store_t* store = Enter_Store();         /* The live store */
+    export_status_t result = EXPORT_OK;             /* Result of the listing */
+
+    /* If the list is empty */
+    if (Account_Store_Count(store) == 0U)
+    {
+        /* Print a message indicating that there are no accounts to show */
+        printf("\nNo accounts to show!!!\n");
+    }
+    else
+    {
+        /* Print a message indicating that the list of accounts is about to be displayed */
+        printf("\nLIST OF ACCOUNTS: \n");
+        result = Export_Accounts(store, stdout, EXPORT_NUMBERED, 0, NULL);
+    }
+    Leave_Store();
+    if (result != EXPORT_OK)
+    {
+        printf("Error: %s.\n", Export_Status_Message(result));
+    }
+}
+
+/**
+ * @brief Displays the list of accounts in alphabetical order.
+ *
+ * The accounts are read from a view of the list, so the listing is not held up by
+ * and does not hold up the changes of the list. The ordered index is built on the first call.
+ * If the list is empty, it prints a message indicating that there are no accounts to show.
+ */
+void Display_Sorted_Accounts(void)
+{
+    account_view_t* view = NULL;                    /* The list as it is now */
+    export_status_t result = EXPORT_OK;             /* Result of the listing */
+
+    /* The menu thread changes the list, so it publishes the view itself */
+    if (Prepare_Accounts_View())
+    {
+        view = Pin_Accounts_View();
+    }
+
+    /* The failed allocation was already reported */
+    if (view == NULL)
+    {
+        result = EXPORT_OK;
+    }
+    /* If the list is empty */
+    else if (Account_View_Count(view) == 0U)
+    {
+        /* Print a message indicating that there are no accounts to show */
+        printf("\nNo accounts to show!!!\n");
+    }
+    else
+    {
+        printf("\nLIST OF ACCOUNTS IN ORDER: \n");
+        result = Export_View(view, stdout, EXPORT_NUMBERED, NULL);
+    }
+    Release_Accounts_View(view);
+    if (result != EXPORT_OK)
+    {
+        printf("Error: %s.\n", Export_Status_Message(result));
+    }
+}
+
+/**
+ * @brief Place a cursor before the first account of the list.
+ *
+ * In display order the list must not change until the last page is read. In
+ * alphabetical order the list may change between pages.
+ *
+ * @param cursor Output, the cursor.
+ * @param sorted 1 for alphabetical order, 0 for display order.
+ */
+void Open_Accounts_Cursor(Account_Cursor_t* cursor, int32_t sorted)
+{
+    account_store_t* store = Enter_Store();  /* The live store */
+
+    Account_Store_Open_Cursor(store, sorted, cursor);
+    Leave_Store();
+}
+
+/**
+ * @brief Read the next page of accounts of a cursor.
+ *
+ * @param cursor The cursor, moved past the accounts read.
+ * @param keys Output, the keys of the accounts. May be NULL.
+ * @param accounts Output, the text of the accounts, NUL terminated. May be NULL.
+ * @param max The largest number of accounts of the page.
+ * @return The number of accounts read, 0 once the cursor is past the last account,
+ * -1 if memory allocation failed or if another store was made live since the cursor was placed.
+ */
+int64_t Next_Accounts_Page(Account_Cursor_t* cursor, uint64_t* keys, int8_t (*accounts)[ACCOUNT_MAX_LENGTH + 1U],
+                           uint32_t max)
+{
+    account_store_t* store = Enter_Store();         /* The live store */
+    int64_t count = -1;                             /* Number of accounts read */
+
+    /* The records of a cursor in display order belong to the store it was placed on */
+    if (cursor->store == store)
+    {
+        count = Account_Store_Next_Page(store, cursor, keys, accounts, max);
+    }
+    Leave_Store();
+
+    return count;
+}
+
+/**
+ * @brief Build the ordered index of the list and publish it to the views.
+ *
+ * It must be called by the thread that changes the list. The index is built in O(n)
+ * on the first call, then every change of the list publishes its new version.
+ *
+ * @return 1 if views can be pinned, 0 if memory allocation failed.
+ */
+int32_t Prepare_Accounts_View(void)
+{
+    account_store_t* store = Enter_Store();                     /* The live store */
+    int32_t result = Account_Store_Prepare_Views(store);        /* Result of the publication */
+
+    Leave_Store();
+
+    return result;
+}
+
+/**
+ * @brief Pin a view of the list as it is now, from any thread, in O(1).
+ *
+ * The view can be read and released by any thread, without a lock, while the list
+ * keeps changing. If Prepare_Accounts_View() was not called yet, or if the list dropped
+ * its ordered index since, no view is pinned and the next change of the list publishes one.
+ *
+ * @return The view, NULL if no view is published yet or if memory allocation failed.
+ */
+account_view_t* Pin_Accounts_View(void)
+{
+    account_store_t* store = Enter_Store();                 /* The live store */
+    account_view_t* view = Account_Store_Pin_View(store);   /* The new view */
+
+    Leave_Store();
+
+    return view;
+}
+
+/**
+ * @brief Release a view of the list, from any thread.
+ *
+ * @param view The view, may be NULL.
+ */
+void Release_Accounts_View(account_view_t* view)
+{
+    Account_View_Release(view);
+}
+
+/**
+ * @brief Searches for the accounts starting with a prefix, in alphabetical order.
+ *
+ * The accounts with a prefix are one range of the ordered index, so only the
+ * matching accounts are read.
+ *
+ * @param prefix The prefix, an empty prefix matches every account.
+ * @param visit The function receiving the accounts, NULL to only count them.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit, -1 if the prefix has an invalid character or
+ * more than 10 characters, or if memory allocation failed.
+ */
+int64_t Search_Accounts_Prefix(const int8_t* prefix, account_visit_t visit, void* user_data)
+{
+    int64_t count = -1;                                     /* Number of accounts found */
+    uint32_t length = (uint32_t)strlen((const char*)prefix);    /* Length of the prefix */
+    uint64_t first = 0;                                     /* Key of the prefix, the smallest key of the range */
+    account_store_t* store = NULL;                          /* The live store */
+
+    if (Account_Encode(prefix, length, &first))
+    {
+        store = Enter_Store();
+        /* The accounts with the prefix may have any character after it */
+        count = Account_Store_Scan(store, first, first | ((1ULL << (ACCOUNT_KEY_TOP_SHIFT + ACCOUNT_KEY_BITS
+                                                                    - length * ACCOUNT_KEY_BITS)) - 1U),
+                                   visit, user_data);
+        Leave_Store();
+    }
+
+    return count;
+}
+
+/**
+ * @brief Searches for the accounts between two accounts, in alphabetical order.
+ *
+ * @param first The first account of the range, NULL to start with the smallest account.
+ * @param last The last account of the range, NULL to end with the largest account.
+ * @param visit The function receiving the accounts, NULL to only count them.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit, -1 if a bound is not a valid account or if
+ * memory allocation failed.
+ */
+int64_t Search_Accounts_Range(const int8_t* first, const int8_t* last, account_visit_t visit, void* user_data)
+{
+    int64_t count = -1;                         /* Number of accounts found */
+    uint64_t low = 0;                           /* Smallest key of the range */
+    uint64_t high = ACCOUNT_KEY_NONE - 1U;      /* Largest key of the range */
+    account_store_t* store = NULL;              /* The live store */
+
+    if ((first == NULL || Account_Encode(first, (uint32_t)strlen((const char*)first), &low))
+        && (last == NULL || Account_Encode(last, (uint32_t)strlen((const char*)last), &high)))
+    {
+        store = Enter_Store();
+        count = Account_Store_Scan(store, low, high, visit, user_data);
+        Leave_Store();
+    }
+
+    return count;
+}
+
+/**
+ * @brief Searches for an account in the list.
+ *
+ * This function looks up the given account in the sharded set of the keys.
+ * If a match is found, it sets the found flag to 1.
+ * If the list is empty, it sets the found flag to -1.
+ * Any number of threads may call it at once, without a lock, while one thread changes the list.
+ *
+ * @param account The account to search for.
+ * @return The result of the search. -1 if the list is empty, 0 if the account is not found,
+ * 1 if the account is found.
+ */
+int32_t Search_Account(int8_t* account)
+{
+    int32_t found = 0;          /* Flag to indicate if the account is found */
+    uint64_t key = 0;           /* Key of the account */
+    account_store_t* store = NULL;  /* The live store */
+
+    /* An account that cannot be packed into a key cannot be in the list */
+    if (Account_Encode(account, (uint32_t)strlen((const char*)account), &key))
+    {
+        found = Search_Account_Key(key);
+    }
+    else
+    {
+        /* No account has the key ACCOUNT_KEY_NONE, the search only tells if the list is empty */
+        store = Enter_Store();
+        found = Account_Store_Search_Shared(store, ACCOUNT_KEY_NONE);
+        Leave_Store();
+        Trace_Text(TRACE_SEARCH, account, strlen((const char*)account), found);
+    }
+    /* Return the result of the search */
+    return found;
+}
+
+/**
+ * @brief Searches for the account with the given key in the list.
+ *
+ * As Search_Account(), any number of threads may call it at once.
+ *
+ * @param key The key of the account to search for.
+ * @return The result of the search. -1 if the list is empty, 0 if the account is not found,
+ * 1 if the account is found.
+ */
+int32_t Search_Account_Key(uint64_t key)
+{
+    account_store_t* store = Enter_Store();                     /* The live store */
+    int32_t found = Account_Store_Search_Shared(store, key);    /* Flag to indicate if the account is found */
+
+    Leave_Store();
+    Trace_Key(TRACE_SEARCH, key, found);
+    return found;
+}
+
+/**
+ * @brief Searches for many accounts in the list.
+ *
+ * The accounts are looked up in groups whose cache misses overlap. An account that is
+ * not valid is never found.
+ *
+ * @param accounts The accounts to search for.
+ * @param count The number of accounts.
+ * @param results Output, the result of each search, as Search_Account(). May be NULL.
+ * @return The number of accounts found.
+ */
+uint64_t Search_Accounts(int8_t* const* accounts, uint64_t count, int32_t* results)
+{
+    uint64_t keys[ACCOUNT_BATCH_KEYS];                  /* Keys of the current group of accounts */
+    account_store_t* store = Enter_Store();             /* The live store */
+    uint64_t total = 0;                                 /* Accounts found */
+    uint64_t first = 0;                                 /* First account of the current group */
+    uint32_t size = 0;                                  /* Accounts of the current group */
+
+    for (first = 0; first < count; first += size)
+    {
+        size = (count - first < ACCOUNT_BATCH_KEYS) ? (uint32_t)(count - first) : ACCOUNT_BATCH_KEYS;
+        Encode_Accounts(&accounts[first], size, keys);
+        total += Account_Store_Search_Batch(store, keys, size, (results != NULL) ? &results[first] : NULL);
+    }
+    Leave_Store();
+
+    return total;
+}
+
+/**
+ * @brief Searches for the accounts with the given keys in the list.
+ *
+ * @param keys The keys of the accounts to search for.
+ * @param count The number of keys.
+ * @param results Output, the result of each search, as Search_Account_Key(). May be NULL.
+ * @return The number of accounts found.
+ */
+uint64_t Search_Account_Keys(const uint64_t* keys, uint64_t count, int32_t* results)
+{
+    account_store_t* store = Enter_Store();                                      /* The live store */
+    uint64_t total = Account_Store_Search_Batch(store, keys, count, results);    /* Accounts found */
+
+    Leave_Store();
+    return total;
+}
+
+/**
+ * @brief Get the number of accounts in the list.
+ *
+ * @return The number of accounts.
+ */
+uint64_t Get_Account_Count(void)
+{
+    account_store_t* store = Enter_Store();         /* The live store */
+    uint64_t count = Account_Store_Count(store);    /* Number of accounts */
+
+    Leave_Store();
+    return count;
+}
+
+/**
+ * @brief Get the usage statistics of the slot array.
+ *
+ * This function is used to get how many slots are live, how many are free
+ * and how many records are allocated.
+ *
+ * @param stats Output, the usage statistics.
+ */
+void Get_Pool_Stats(Pool_Stats_t* stats)
+{
+    account_store_t* store = Enter_Store();  /* The live store */
+
+    Account_Store_Pool_Stats(store, stats);
+    Leave_Store();
+}
+
+/**
+ * @brief Save the list of accounts to a snapshot file.
+ *
+ * The accounts are written in display order together with a prebuilt hash index,
+ * so the file can later be served by Load_Snapshot() without rebuilding anything.
+ *
+ * @param path The path of the snapshot file.
+ * @return SNAPSHOT_OK if the file is written, an error code if not.
+ */
+snapshot_status_t Save_Snapshot(const char* path)
+{
+    account_store_t* store = Enter_Store();                         /* The live store */
+    snapshot_status_t result = Account_Store_Save(store, path);     /* Result of the save */
+
+    Leave_Store();
+    return result;
+}
+
+/**
+ * @brief Replace the list of accounts with a snapshot file.
+ *
+ * The file is mapped into memory and searches are served from it directly, so loading
+ * does not depend on the number of accounts. The accounts are copied into the list
+ * the first time the list is changed.
+ *
+ * @param path The path of the snapshot file.
+ * @param verify 1 to check the checksum of the whole file, 0 to check the header only.
+ * @return SNAPSHOT_OK if the snapshot is loaded, an error code if not. On error the list is empty.
+ */
+snapshot_status_t Load_Snapshot(const char* path, int32_t verify)
+{
+    account_store_t* store = Enter_Store();                                 /* The live store */
+    snapshot_status_t result = Account_Store_Load(store, path, verify);     /* Result of the loading */
+
+    Leave_Store();
+    return result;
+}
+
+/**
+ * @brief Replay a journal over the list and log every later change to it.
+ *
+ * Call it after Load_Snapshot(). Every Add_Account and Remove_Account that changes the
+ * list is then appended to the journal and committed in groups. When the journal grows
+ * past its size limit it is folded into the snapshot file in the background.
+ * The journal belongs to the live store and stays with it when the store is swapped out.
+ *
+ * @param path The path of the journal file.
+ * @param snapshot_path The snapshot written by the compactions, NULL to never compact.
+ * @param config The settings of the journal.
+ * @return JOURNAL_OK if the journal is open, an error code if not.
+ */
+journal_status_t Open_Journal(const char* path, const char* snapshot_path, const Journal_Config_t* config)
+{
+    account_store_t* store = Enter_Store();  /* The live store */
+    journal_status_t result = Account_Store_Open_Journal(store, path, snapshot_path, config);  /* Result of the opening */
+
+    Leave_Store();
+    return result;
+}
+
+/**
+ * @brief Commit the pending changes and close the journal.
+ *
+ * @param reset 1 if the list was just saved to the snapshot file, which empties the journal.
+ * @return JOURNAL_OK if every change is on the disk, an error code if not.
+ */
+journal_status_t Close_Journal(int32_t reset)
+{
+    account_store_t* store = Enter_Store();                                /* The live store */
+    journal_status_t result = Account_Store_Close_Journal(store, reset);   /* Result of the closing */
+
+    Leave_Store();
+    return result;
+}
+
+/**
+ * @brief Start recording the operations on the list into a trace file.
+ *
+ * From now on every check of Check_Account_Key(), and every addition, removal, search
+ * and existence test of one account, is appended to the trace with its time and result,
+ * until Stop_Trace(). Handles and batches are not recorded. A trace already being
+ * recorded is finished first. While it is recorded, the list must be used from one
+ * thread only.
+ *
+ * @param path The path of the trace file, replaced if it exists.
+ * @return TRACE_OK if the trace is recorded, TRACE_IO_ERROR if the file cannot be created.
+ */
+trace_status_t Start_Trace(const char* path)
+{
+    trace_status_t status = TRACE_OK;   /* Result of the start */
+
+    Stop_Trace();
+    status = Trace_Create(&trace_writer, path);
+    if (status == TRACE_OK)
+    {
+        atomic_store_explicit(&active_trace, &trace_writer, memory_order_release);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Stop recording the operations and close the trace file.
+ *
+ * No other thread may be working on the list during the call.
+ *
+ * @return TRACE_OK if every record is in the file, TRACE_IO_ERROR if not.
+ */
+trace_status_t Stop_Trace(void)
+{
+    Trace_Writer_t* writer = atomic_exchange(&active_trace, NULL);    /* Trace being recorded */
+
+    return (writer != NULL) ? Trace_Finish(writer) : TRACE_OK;
+}
+
+/**
+ * @brief Get the counters of the journal.
+ *
+ * @param stats Output, the counters since the journal was opened.
+ */
+void Get_Journal_Stats(Journal_Stats_t* stats)
+{
+    account_store_t* store = Enter_Store();  /* The live store */
+
+    Account_Store_Journal_Stats(store, stats);
+    Leave_Store();
+}
+
+/**
+ * @brief Set the false-positive rate of the filter in front of the index.
+ *
+ * The filter is rebuilt at once from the accounts of the list.
+ *
+ * @param rate The rate at which a lookup of an absent account still probes the index,
+ * between 0 and 1. 0 turns the filter off.
+ */
+void Set_Bloom_Rate(double rate)
+{
+    account_store_t* store = Enter_Store();  /* The live store */
+
+    Account_Store_Set_Bloom_Rate(store, rate);
+    Leave_Store();
+}
+
+/**
+ * @brief Get the counters of the filter in front of the index.
+ *
+ * @param stats Output, the counters since the live store was created.
+ */
+void Get_Bloom_Stats(Bloom_Stats_t* stats)
+{
+    account_store_t* store = Enter_Store();  /* The live store */
+
+    Account_Store_Bloom_Stats(store, stats);
+    Leave_Store();
+}
+
+/**
+ * @brief Get the store the functions of the list work on.
+ *
+ * The store may be used with the functions of account_store.h by the thread that
+ * changes the list. It stays valid until it is swapped out and retired.
+ *
+ * @return The live store.
+ */
+account_store_t* Get_Account_Store(void)
+{
+    return atomic_load_explicit(&live_store, memory_order_acquire);
+}
+
+/**
+ * @brief Make a store live in place of the current one.
+ *
+ * The store is published with one atomic exchange, so it takes the same time whatever
+ * the size of the stores. A call of the list functions already running on another
+ * thread finishes on the old store, every later call works on the new one. Changes
+ * made to the old store after the new one was built are not carried over.
+ *
+ * @param store The new live store, built with the functions of account_store.h.
+ * @return The old store, to pass to Retire_Account_Store() once it is no longer needed.
+ */
+account_store_t* Swap_Account_Store(account_store_t* store)
+{
+    return atomic_exchange_explicit(&live_store, store, memory_order_acq_rel);
+}
+
+/**
+ * @brief Destroy a store swapped out by Swap_Account_Store().
+ *
+ * The function waits until no call of the list functions can still use the store, so
+ * it must not be called from inside one, from a visit function for example. The calls
+ * of every thread are waited for, also of the threads that found no epoch slot of
+ * their own.
+ *
+ * @param store The store, must not be live. May be NULL.
+ */
+void Retire_Account_Store(account_store_t* store)
+{
+    Epoch_Flush();
+    Account_Store_Destroy(store);
+}
+
+/**
+ * @brief Deliver the rejected accounts to the registered callback function from a thread of its own.
+ *
+ * Check_Account() and Check_Accounts() then only copy each rejected account into a ring and
+ * return; the callback function is called later, in batches, from the thread of the
+ * dispatcher (see account_dispatch.h). A summary made by DISPATCH_COALESCE calls it once.
+ * RegisterCallback() must not be called until Stop_Async_Errors().
+ *
+ * @param config The settings of the dispatcher, NULL for DISPATCH_BLOCK with the default sizes.
+ * @return 1 if the dispatcher is started, 0 if memory allocation or thread creation failed.
+ *         In that case the callback function is still called at once.
+ */
+int32_t Start_Async_Errors(const Dispatch_Config_t* config)
+{
+    Stop_Async_Errors();
+    return Dispatch_Start(&error_dispatcher, config, Deliver_Errors, NULL);
+}
+
+/**
+ * @brief Wait until the callback function was called for every account rejected so far.
+ */
+void Flush_Async_Errors(void)
+{
+    if (error_dispatcher.running != 0)
+    {
+        Dispatch_Flush(&error_dispatcher);
+    }
+}
+
+/**
+ * @brief Deliver the remaining rejected accounts and call the callback function at once again.
+ */
+void Stop_Async_Errors(void)
+{
+    Dispatch_Stop(&error_dispatcher);
+}
+
+/**
+ * @brief Get the counters of the asynchronous delivery of the rejected accounts.
+ *
+ * @param stats Output, the counters since the last Start_Async_Errors().
+ */
+void Get_Async_Error_Stats(Dispatch_Stats_t* stats)
+{
+    Dispatch_Get_Stats(&error_dispatcher, stats);
+}
+
+/**
+ * @brief Get the counters and latency histograms of the list.
+ *
+ * @param stats Output, the sums of every thread since the last Reset_Account_Stats(),
+ * and the number of accounts in the list. Everything but the number of accounts is 0
+ * when the instrumentation is not compiled in (see account_stats.h).
+ */
+void Get_Account_Stats(Stats_Snapshot_t* stats)
+{
+    Stats_Get(stats);
+    stats->accounts = Get_Account_Count();
+}
+
+/**
+ * @brief Start the counters and latency histograms of the list again from 0.
+ */
+void Reset_Account_Stats(void)
+{
+    Stats_Reset();
+}
+
+/**
+ * @brief Print the counters and latency histograms of the list.
+ *
+ * @param out The stream to print to.
+ */
+void Dump_Account_Stats(FILE* out)
+{
+    Stats_Snapshot_t stats;     /* The counters and histograms */
+
+    Get_Account_Stats(&stats);
+    Stats_Dump(&stats, out);
 }
 
 /**
@@ -337,13 +1460,22 @@ int32_t Search_Account(int8_t* account)
  *
  * This function prompting the user to press any key to continue.
  * It then clears the input buffer, waits for a key press, and clears the console screen.
+ * Outside Windows it waits for Enter and clears the screen with an ANSI escape sequence.
  */
 void clear_console(void)
 {
     printf("\n-------------------------------------------");
     printf("\nPress ANY key to Continue. . .");
+#ifdef _WIN32
     fflush(stdin);
     getch();
     system("cls");
+#else
+    /* The terminal delivers the input line by line, wait for Enter */
+    fflush(stdout);
+    getchar();
+    /* Clear the screen and move the cursor to the top left corner */
+    printf("\033[2J\033[H");
+#endif
 } /* EOF */
 
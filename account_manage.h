@@ -14,14 +14,27 @@
 /*******************************************************************************
  * Include
  ******************************************************************************/
+#include <stddef.h>         /* For size_t */
 #include <stdint.h>         /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
 #include <stdio.h>          /* Include standard input and output library for printf, printf, ... */
 #include <string.h>         /* For funtions such as strcpy(), strcmp(), NULL character */
 #include <stdlib.h>         /* For malloc() functions*/
+#include "account_snapshot.h"   /* For snapshot_status_t */
+#include "account_journal.h"    /* For journal_status_t, Journal_Config_t */
+#include "account_stats.h"      /* For Stats_Snapshot_t */
+#include "account_bloom.h"      /* For Bloom_Stats_t */
+#include "account_dispatch.h"   /* For Dispatch_Config_t, Dispatch_Stats_t */
+#include "account_key.h"        /* For ACCOUNT_MAX_LENGTH */
+#include "account_trace.h"      /* For trace_status_t */
 
 #ifndef ACCOUNT_MANAGE_H
 #define	ACCOUNT_MANAGE_H
 
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ACCOUNT_HANDLE_NONE     0U      /* A handle no account is given, never valid */
+
 /*******************************************************************************
  * Declarations
  ******************************************************************************/
@@ -34,19 +47,34 @@ typedef enum _statetype
 {
     CORRECT,            /* The account is correct. */
     CHAR_INVALID,       /* The account contains invalid characters. */
-    LENGHT_INVALID      /* The length of the account is invalid. */
+    LENGHT_INVALID,     /* The length of the account is invalid. */
+    PREFIX_INVALID,     /* The account does not start with a required prefix, see account_rules.h. */
+    SEQUENCE_INVALID,   /* The account contains a forbidden sequence, see account_rules.h. */
+    EXPIRED             /* The account was removed because its time to live ran out, see Expire_Accounts(). */
 } status_enum_t;
 
 /**
- * @brief Structure for a node in the linked list.
+ * @brief Type for a handle on an account of the list.
  *
- * This structure defines a node in the linked list.
+ * The low 32 bits are the slot of the account in the slot array of its store and the
+ * high 32 bits the generation of the slot. The slot gets a new generation when the
+ * account is removed, so a handle kept after that is seen as stale and never reaches
+ * the account that reuses the slot. A handle is only valid in the store that gave it.
  */
-typedef struct Node
+typedef uint64_t account_handle_t;
+
+/**
+ * @brief Structure for the usage statistics of the slot array.
+ *
+ * The accounts are kept in one array in the order they were added. A record is either
+ * live (holding an account) or free (removed and not yet reclaimed, or never used).
+ */
+typedef struct
 {
-    int8_t account[10];     /* The account stored in the node. */
-    struct Node* next;      /* Pointer to the next node in the list. */
-} Node_t;
+    uint32_t live;          /* Number of records holding an account. */
+    uint32_t free;          /* Number of records not holding one. */
+    uint32_t capacity;      /* Number of records allocated. */
+} Pool_Stats_t;
 
 /**
  * @brief Typedef for a function pointer.
@@ -56,6 +84,68 @@ typedef struct Node
  */
 typedef void (*func)(status_enum_t);
 
+/**
+ * @brief Typedef for the callback of a check context.
+ *
+ * This typedef is used to define a function pointer that receives the status of a rejected
+ * account, the account itself and the user data of the context.
+ */
+typedef void (*check_callback_t)(status_enum_t status, const int8_t* ptr, uint8_t length, void* user_data);
+
+/**
+ * @brief Type for a compiled set of validation rules, see account_rules.h.
+ */
+typedef struct Account_Rules account_rules_t;
+
+/**
+ * @brief Structure for the context of a check.
+ *
+ * A context replaces the global callback function and status, so checks that use
+ * different contexts can run at the same time from different threads.
+ */
+typedef struct
+{
+    check_callback_t callback;  /* Called for each rejected account, may be NULL. */
+    void* user_data;            /* Passed to the callback. */
+    const account_rules_t* rules;   /* Rules of the check, NULL for the rules set by Set_Account_Rules(). */
+} check_context_t;
+
+/**
+ * @brief Type for a store of accounts, see account_store.h.
+ *
+ * The functions of this file work on the live store, see Swap_Account_Store().
+ */
+typedef struct Account_Store account_store_t;
+
+/**
+ * @brief Type for a pinned view of a store, see Pin_Accounts_View().
+ *
+ * A view keeps the accounts of the store as they were when it was pinned.
+ */
+typedef struct Account_View account_view_t;
+
+/**
+ * @brief Structure for a position in the accounts of a store, read page by page.
+ */
+typedef struct
+{
+    uint32_t remaining;         /* Records of the slot array not read yet, in display order from the last one. */
+    uint64_t record;            /* Next record of a loaded snapshot, in display order. */
+    uint64_t next_key;          /* Smallest key of the next page, in alphabetical order. */
+    int32_t sorted;             /* Set for alphabetical order. */
+    int32_t done;               /* Set once the last account was read. */
+    const account_store_t* store;   /* Store the cursor was placed on. */
+} Account_Cursor_t;
+
+/**
+ * @brief Typedef for the function receiving the accounts of an ordered query.
+ *
+ * @param account The account, NUL terminated.
+ * @param user_data The pointer given to the query.
+ * @return 1 to receive the next account, 0 to stop the query.
+ */
+typedef int32_t (*account_visit_t)(const int8_t* account, void* user_data);
+
 /*******************************************************************************
  * Prototype
  ******************************************************************************/
@@ -68,6 +158,15 @@ typedef void (*func)(status_enum_t);
  */
 void RegisterCallback(func func_add);
 
+/**
+ * @brief Get the account whose expiry is being reported.
+ *
+ * This function is used by the callback function, while it is called with EXPIRED.
+ *
+ * @return The account, NUL terminated, NULL outside of an EXPIRED call.
+ */
+const int8_t* Get_Expired_Account(void);
+
 /**
  * @brief Check the validity of an account.
  *
@@ -78,6 +177,73 @@ void RegisterCallback(func func_add);
  */
 void Check_Account(int8_t* ptr, uint8_t length);
 
+/**
+ * @brief Check the validity of an account and pack it into a key.
+ *
+ * This function is used to check the validity of an account. The key of the account
+ * is built in the same pass over the characters.
+ *
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param key Output, the key of the account when it is CORRECT. May be NULL.
+ */
+void Check_Account_Key(int8_t* ptr, uint8_t length, uint64_t* key);
+
+/**
+ * @brief Check the validity of an account without touching any global state.
+ *
+ * This function is used to check the validity of an account from any thread. The status is
+ * returned instead of being stored for Get_Status(), and a rejected account is reported to the
+ * callback of the context instead of the registered callback function.
+ *
+ * @param ctx The context of the check, NULL to check without a callback.
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param key Output, the key of the account when it is CORRECT. May be NULL.
+ * @return The status of the account.
+ */
+status_enum_t Check_Account_Ctx(const check_context_t* ctx, const int8_t* ptr, uint8_t length, uint64_t* key);
+
+/**
+ * @brief Check the validity of many accounts.
+ *
+ * This function gives the same result as calling Check_Account() on each account, but it
+ * checks the accounts with vector instructions when the CPU supports them.
+ * The callback function is called for each account that is not CORRECT, in order.
+ *
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+void Check_Accounts(const int8_t* const* ptrs, const uint8_t* lens, size_t n, status_enum_t* out);
+
+/**
+ * @brief Check the validity of many accounts without touching any global state.
+ *
+ * This function is the batch form of Check_Account_Ctx(). Rejected accounts are reported
+ * to the callback of the context, in order.
+ *
+ * @param ctx The context of the check, NULL to check without a callback.
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+void Check_Accounts_Ctx(const check_context_t* ctx, const int8_t* const* ptrs, const uint8_t* lens, size_t n,
+                        status_enum_t* out);
+
+/**
+ * @brief Set the rules of the checks.
+ *
+ * Every later check without rules of its own uses them, on any thread. The rules must
+ * stay valid until they are replaced and no check can still be using them.
+ *
+ * @param rules The compiled rules (see account_rules.h), NULL for the built-in ones:
+ * at most 10 characters among a-z, A-Z and 1-9.
+ */
+void Set_Account_Rules(const account_rules_t* rules);
+
 /**
  * @brief Display error message based on the status.
  *
@@ -100,32 +266,136 @@ status_enum_t Get_Status(void);
  * @brief Check if the account exists in the list.
  *
  * This function is used to check if the account exists in the list.
+ * The account is looked up in the sharded set of the keys, so the cost does not depend on the
+ * size of the list, behind a copy of the Bloom filter that rules out most absent accounts.
+ * Any number of threads may call it at once, without a lock, while one thread changes the list.
  *
  * @param account The account to be checked.
  * @return 1 if the account exists, 0 if not.
  */
 int32_t Is_Account_Exist(int8_t* account);
 
+/**
+ * @brief Check if the account with the given key exists in the list.
+ *
+ * As Is_Account_Exist(), any number of threads may call it at once.
+ *
+ * @param key The key of the account to be checked.
+ * @return 1 if the account exists, 0 if not.
+ */
+int32_t Is_Account_Key_Exist(uint64_t key);
+
 /**
  * @brief Add an account to the list.
  *
  * This function is used to add an account to the list.
+ * The handle it returns finds the account again in O(1) until it is removed.
+ *
+ * @param new_account The new account to be added.
+ * @return The handle of the account, also for an account already in the list.
+ * ACCOUNT_HANDLE_NONE if the account is not valid or memory allocation failed.
+ */
+account_handle_t Add_Account(int8_t* new_account);
+
+/**
+ * @brief Add an account to the list for a limited time.
+ *
+ * The account is removed by the first call of Expire_Accounts() whose clock reaches
+ * its deadline. An account already in the list gets the new time to live.
  *
  * @param new_account The new account to be added.
+ * @param ttl The ticks from the clock of the list to the deadline, 0 for no deadline.
+ * @return The handle of the account, ACCOUNT_HANDLE_NONE if the account is not valid
+ * or memory allocation failed.
  */
-void Add_Account(int8_t* new_account);
+account_handle_t Add_Account_Ttl(int8_t* new_account, uint64_t ttl);
+
+/**
+ * @brief Move the clock of the list forward and remove the accounts whose time to live ran out.
+ *
+ * Each removed account is reported to the registered callback function with EXPIRED,
+ * in the calling thread and in order of its deadline. Scheduling and cancelling a deadline
+ * are O(1), and the clock skips the stretches without deadlines.
+ *
+ * @param now The new tick of the clock, ignored if it is not after the current one.
+ * @return The number of accounts removed.
+ */
+uint64_t Expire_Accounts(uint64_t now);
+
+/**
+ * @brief Add the account with the given key to the list.
+ *
+ * An account that is already in the list is not added again.
+ *
+ * @param key The key of the new account, as produced by Check_Account_Key().
+ * @return 1 if the account is added, 0 if it is already in the list, -1 if memory allocation failed.
+ */
+int32_t Add_Account_Key(uint64_t key);
 
 /**
  * @brief Remove an account from the list.
  *
- * This function is used to remove an account from the linked list of accounts
- * It iterates through the linked list of accounts and if the account is found, it is removed.
+ * This function is used to remove an account from the slot array of accounts
+ * The account is looked up in the hash index and, if it is found, its slot is freed.
  *
  * @param account The account to be removed.
  * @return 1 if the account is removed, 0 if not. -1 if the list is empty
  */
 int32_t Remove_Account(int8_t* account);
 
+/**
+ * @brief Remove the account of a handle from the list.
+ *
+ * A handle belongs to the store that was live when it was given. Once its account is
+ * removed, or the list is emptied or loaded, the handle is stale and never names
+ * another account.
+ *
+ * @param handle The handle of the account, as returned by Add_Account().
+ * @return 1 if the account is removed, 0 if the handle is stale. -1 if the list is empty
+ */
+int32_t Remove_Account_Handle(account_handle_t handle);
+
+/**
+ * @brief Get the account of a handle.
+ *
+ * @param handle The handle of the account, as returned by Add_Account().
+ * @param account Output, the account, NUL terminated, ACCOUNT_MAX_LENGTH + 1 bytes.
+ * Left unchanged if the handle is stale.
+ * @return 1 if the handle names an account of the list, 0 if it is stale.
+ */
+int32_t Lookup_Account_Handle(account_handle_t handle, int8_t* account);
+
+/**
+ * @brief Remove the account with the given key from the list.
+ *
+ * @param key The key of the account to be removed.
+ * @return 1 if the account is removed, 0 if not. -1 if the list is empty
+ */
+int32_t Remove_Account_Key(uint64_t key);
+
+/**
+ * @brief Remove many accounts from the list.
+ *
+ * The accounts are removed in order, as many calls to Remove_Account() would, but the
+ * cache misses of a group of accounts overlap. An account that is not valid is never found.
+ *
+ * @param accounts The accounts to be removed.
+ * @param count The number of accounts.
+ * @param results Output, the result of each removal, as Remove_Account(). May be NULL.
+ * @return The number of accounts removed.
+ */
+uint64_t Remove_Accounts(int8_t* const* accounts, uint64_t count, int32_t* results);
+
+/**
+ * @brief Remove the accounts with the given keys from the list.
+ *
+ * @param keys The keys of the accounts to be removed.
+ * @param count The number of keys.
+ * @param results Output, the result of each removal, as Remove_Account_Key(). May be NULL.
+ * @return The number of accounts removed.
+ */
+uint64_t Remove_Account_Keys(const uint64_t* keys, uint64_t count, int32_t* results);
+
 /**
  * @brief Displays the list of accounts.
  *
@@ -134,12 +404,99 @@ int32_t Remove_Account(int8_t* account);
  */
 void Display_ListAccounts(void);
 
+/**
+ * @brief Displays the list of accounts in alphabetical order.
+ *
+ * The accounts are read from the ordered index, which is built on the first call.
+ * If the list is empty, it prints a message indicating that there are no accounts to show.
+ */
+void Display_Sorted_Accounts(void);
+
+/**
+ * @brief Place a cursor before the first account of the list.
+ *
+ * In display order the list must not change until the last page is read. In
+ * alphabetical order the list may change between pages.
+ *
+ * @param cursor Output, the cursor.
+ * @param sorted 1 for alphabetical order, 0 for display order.
+ */
+void Open_Accounts_Cursor(Account_Cursor_t* cursor, int32_t sorted);
+
+/**
+ * @brief Read the next page of accounts of a cursor.
+ *
+ * @param cursor The cursor, moved past the accounts read.
+ * @param keys Output, the keys of the accounts. May be NULL.
+ * @param accounts Output, the text of the accounts, NUL terminated. May be NULL.
+ * @param max The largest number of accounts of the page.
+ * @return The number of accounts read, 0 once the cursor is past the last account,
+ * -1 if memory allocation failed or if another store was made live since the cursor was placed.
+ */
+int64_t Next_Accounts_Page(Account_Cursor_t* cursor, uint64_t* keys, int8_t (*accounts)[ACCOUNT_MAX_LENGTH + 1U],
+                           uint32_t max);
+
+/**
+ * @brief Build the ordered index of the list and publish it to the views.
+ *
+ * It must be called by the thread that changes the list. The index is built in O(n)
+ * on the first call, then every change of the list publishes its new version.
+ *
+ * @return 1 if views can be pinned, 0 if memory allocation failed.
+ */
+int32_t Prepare_Accounts_View(void);
+
+/**
+ * @brief Pin a view of the list as it is now, from any thread, in O(1).
+ *
+ * The view can be read and released by any thread, without a lock, while the list
+ * keeps changing. If Prepare_Accounts_View() was not called yet, or if the list dropped
+ * its ordered index since, no view is pinned and the next change of the list publishes one.
+ *
+ * @return The view, NULL if no view is published yet or if memory allocation failed.
+ */
+account_view_t* Pin_Accounts_View(void);
+
+/**
+ * @brief Release a view of the list, from any thread.
+ *
+ * @param view The view, may be NULL.
+ */
+void Release_Accounts_View(account_view_t* view);
+
+/**
+ * @brief Searches for the accounts starting with a prefix, in alphabetical order.
+ *
+ * The accounts with a prefix are one range of the ordered index, so only the
+ * matching accounts are read.
+ *
+ * @param prefix The prefix, an empty prefix matches every account.
+ * @param visit The function receiving the accounts, NULL to only count them.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit, -1 if the prefix has an invalid character or
+ * more than 10 characters, or if memory allocation failed.
+ */
+int64_t Search_Accounts_Prefix(const int8_t* prefix, account_visit_t visit, void* user_data);
+
+/**
+ * @brief Searches for the accounts between two accounts, in alphabetical order.
+ *
+ * @param first The first account of the range, NULL to start with the smallest account.
+ * @param last The last account of the range, NULL to end with the largest account.
+ * @param visit The function receiving the accounts, NULL to only count them.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit, -1 if a bound is not a valid account or if
+ * memory allocation failed.
+ */
+int64_t Search_Accounts_Range(const int8_t* first, const int8_t* last, account_visit_t visit, void* user_data);
+
 /**
  * @brief Searches for an account in the list.
  *
- * This function iterates through the linked list of accounts and compares each account with the given account.
- * If a match is found, it sets the found flag to 1 and stops the search.
+ * This function looks up the given account in the sharded set of the keys.
+ * If a match is found, it sets the found flag to 1.
  * If the list is empty, it sets the found flag to -1.
+ * Any number of threads may call it at once, without a lock, while one thread changes the list.
  *
  * @param account The account to search for.
  * @return The result of the search. -1 if the list is empty, 0 if the account is not found,
@@ -147,11 +504,244 @@ void Display_ListAccounts(void);
  */
 int32_t Search_Account(int8_t* account);
 
+/**
+ * @brief Searches for the account with the given key in the list.
+ *
+ * As Search_Account(), any number of threads may call it at once.
+ *
+ * @param key The key of the account to search for.
+ * @return The result of the search. -1 if the list is empty, 0 if the account is not found,
+ * 1 if the account is found.
+ */
+int32_t Search_Account_Key(uint64_t key);
+
+/**
+ * @brief Searches for many accounts in the list.
+ *
+ * The accounts are looked up in groups whose cache misses overlap. An account that is
+ * not valid is never found.
+ *
+ * @param accounts The accounts to search for.
+ * @param count The number of accounts.
+ * @param results Output, the result of each search, as Search_Account(). May be NULL.
+ * @return The number of accounts found.
+ */
+uint64_t Search_Accounts(int8_t* const* accounts, uint64_t count, int32_t* results);
+
+/**
+ * @brief Searches for the accounts with the given keys in the list.
+ *
+ * @param keys The keys of the accounts to search for.
+ * @param count The number of keys.
+ * @param results Output, the result of each search, as Search_Account_Key(). May be NULL.
+ * @return The number of accounts found.
+ */
+uint64_t Search_Account_Keys(const uint64_t* keys, uint64_t count, int32_t* results);
+
+/**
+ * @brief Get the number of accounts in the list.
+ *
+ * @return The number of accounts.
+ */
+uint64_t Get_Account_Count(void);
+
+/**
+ * @brief Get the usage statistics of the slot array.
+ *
+ * This function is used to get how many slots are live, how many are free
+ * and how many records are allocated.
+ *
+ * @param stats Output, the usage statistics.
+ */
+void Get_Pool_Stats(Pool_Stats_t* stats);
+
+/**
+ * @brief Save the list of accounts to a snapshot file.
+ *
+ * The accounts are written in display order together with a prebuilt hash index,
+ * so the file can later be served by Load_Snapshot() without rebuilding anything.
+ *
+ * @param path The path of the snapshot file.
+ * @return SNAPSHOT_OK if the file is written, an error code if not.
+ */
+snapshot_status_t Save_Snapshot(const char* path);
+
+/**
+ * @brief Replace the list of accounts with a snapshot file.
+ *
+ * The file is mapped into memory and searches are served from it directly, so loading
+ * does not depend on the number of accounts. The accounts are copied into the list
+ * the first time the list is changed.
+ *
+ * @param path The path of the snapshot file.
+ * @param verify 1 to check the checksum of the whole file, 0 to check the header only.
+ * @return SNAPSHOT_OK if the snapshot is loaded, an error code if not. On error the list is empty.
+ */
+snapshot_status_t Load_Snapshot(const char* path, int32_t verify);
+
+/**
+ * @brief Replay a journal over the list and log every later change to it.
+ *
+ * Call it after Load_Snapshot(). Every Add_Account and Remove_Account that changes the
+ * list is then appended to the journal and committed in groups. When the journal grows
+ * past its size limit it is folded into the snapshot file in the background.
+ * The journal belongs to the live store and stays with it when the store is swapped out.
+ *
+ * @param path The path of the journal file.
+ * @param snapshot_path The snapshot written by the compactions, NULL to never compact.
+ * @param config The settings of the journal.
+ * @return JOURNAL_OK if the journal is open, an error code if not.
+ */
+journal_status_t Open_Journal(const char* path, const char* snapshot_path, const Journal_Config_t* config);
+
+/**
+ * @brief Commit the pending changes and close the journal.
+ *
+ * @param reset 1 if the list was just saved to the snapshot file, which empties the journal.
+ * @return JOURNAL_OK if every change is on the disk, an error code if not.
+ */
+journal_status_t Close_Journal(int32_t reset);
+
+/**
+ * @brief Start recording the operations on the list into a trace file.
+ *
+ * From now on every check of Check_Account_Key(), and every addition, removal, search
+ * and existence test of one account, is appended to the trace with its time and result,
+ * until Stop_Trace(). Handles and batches are not recorded. A trace already being
+ * recorded is finished first. While it is recorded, the list must be used from one
+ * thread only.
+ *
+ * @param path The path of the trace file, replaced if it exists.
+ * @return TRACE_OK if the trace is recorded, TRACE_IO_ERROR if the file cannot be created.
+ */
+trace_status_t Start_Trace(const char* path);
+
+/**
+ * @brief Stop recording the operations and close the trace file.
+ *
+ * No other thread may be working on the list during the call.
+ *
+ * @return TRACE_OK if every record is in the file, TRACE_IO_ERROR if not.
+ */
+trace_status_t Stop_Trace(void);
+
+/**
+ * @brief Get the counters of the journal.
+ *
+ * @param stats Output, the counters since the journal was opened.
+ */
+void Get_Journal_Stats(Journal_Stats_t* stats);
+
+/**
+ * @brief Set the false-positive rate of the filter in front of the index.
+ *
+ * The filter is rebuilt at once from the accounts of the list.
+ *
+ * @param rate The rate at which a lookup of an absent account still probes the index,
+ * between 0 and 1. 0 turns the filter off.
+ */
+void Set_Bloom_Rate(double rate);
+
+/**
+ * @brief Get the counters of the filter in front of the index.
+ *
+ * @param stats Output, the counters since the live store was created.
+ */
+void Get_Bloom_Stats(Bloom_Stats_t* stats);
+
+/**
+ * @brief Get the store the functions of the list work on.
+ *
+ * The store may be used with the functions of account_store.h by the thread that
+ * changes the list. It stays valid until it is swapped out and retired.
+ *
+ * @return The live store.
+ */
+account_store_t* Get_Account_Store(void);
+
+/**
+ * @brief Make a store live in place of the current one.
+ *
+ * The store is published with one atomic exchange, so it takes the same time whatever
+ * the size of the stores. A call of the list functions already running on another
+ * thread finishes on the old store, every later call works on the new one. Changes
+ * made to the old store after the new one was built are not carried over.
+ *
+ * @param store The new live store, built with the functions of account_store.h.
+ * @return The old store, to pass to Retire_Account_Store() once it is no longer needed.
+ */
+account_store_t* Swap_Account_Store(account_store_t* store);
+
+/**
+ * @brief Destroy a store swapped out by Swap_Account_Store().
+ *
+ * The function waits until no call of the list functions can still use the store, so
+ * it must not be called from inside one, from a visit function for example. The calls
+ * of every thread are waited for, also of the threads that found no epoch slot of
+ * their own.
+ *
+ * @param store The store, must not be live. May be NULL.
+ */
+void Retire_Account_Store(account_store_t* store);
+
+/**
+ * @brief Deliver the rejected accounts to the registered callback function from a thread of its own.
+ *
+ * Check_Account() and Check_Accounts() then only copy each rejected account into a ring and
+ * return; the callback function is called later, in batches, from the thread of the
+ * dispatcher (see account_dispatch.h). A summary made by DISPATCH_COALESCE calls it once.
+ * RegisterCallback() must not be called until Stop_Async_Errors().
+ *
+ * @param config The settings of the dispatcher, NULL for DISPATCH_BLOCK with the default sizes.
+ * @return 1 if the dispatcher is started, 0 if memory allocation or thread creation failed.
+ *         In that case the callback function is still called at once.
+ */
+int32_t Start_Async_Errors(const Dispatch_Config_t* config);
+
+/**
+ * @brief Wait until the callback function was called for every account rejected so far.
+ */
+void Flush_Async_Errors(void);
+
+/**
+ * @brief Deliver the remaining rejected accounts and call the callback function at once again.
+ */
+void Stop_Async_Errors(void);
+
+/**
+ * @brief Get the counters of the asynchronous delivery of the rejected accounts.
+ *
+ * @param stats Output, the counters since the last Start_Async_Errors().
+ */
+void Get_Async_Error_Stats(Dispatch_Stats_t* stats);
+
+/**
+ * @brief Get the counters and latency histograms of the list.
+ *
+ * @param stats Output, the sums of every thread since the last Reset_Account_Stats(),
+ * and the number of accounts in the list. Everything but the number of accounts is 0
+ * when the instrumentation is not compiled in (see account_stats.h).
+ */
+void Get_Account_Stats(Stats_Snapshot_t* stats);
+
+/**
+ * @brief Start the counters and latency histograms of the list again from 0.
+ */
+void Reset_Account_Stats(void);
+
+/**
+ * @brief Print the counters and latency histograms of the list.
+ *
+ * @param out The stream to print to.
+ */
+void Dump_Account_Stats(FILE* out);
+
 /**
  * @brief Clears the console screen.
  *
  * This function prompting the user to press any key to continue.
  * It then clears the input buffer, waits for a key press, and clears the console screen.
+ * Outside Windows it waits for Enter and clears the screen with an ANSI escape sequence.
  */
 void clear_console(void);
 
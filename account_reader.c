@@ -0,0 +1,218 @@
+/**
+ * @file account_reader.c
+ * @brief This file contains the implementation of the buffered account reader.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdlib.h>             /* For malloc() */
+#include <string.h>             /* For memchr(), memmove() */
+#include "account_reader.h"     /* Include header file of this function file */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Read more bytes after the unread part of the chunk.
+ *
+ * The unread bytes are moved to the start of the chunk first.
+ *
+ * @param reader The reader.
+ */
+static void Reader_Fill(Account_Reader_t* reader)
+{
+    size_t count = 0;       /* Number of bytes read */
+
+    /* Move the unread bytes to the start of the chunk */
+    if (reader->start > 0U)
+    {
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->offset += reader->start;
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+
+    if (reader->interactive)
+    {
+        /* Read up to the end of the line the user typed */
+        if (fgets((char*)reader->buffer + reader->end, (int)(READER_CHUNK_SIZE + 1U - reader->end), reader->file) != NULL)
+        {
+            count = strlen((const char*)reader->buffer + reader->end);
+        }
+    }
+    else
+    {
+        /* Read as much as fits in the chunk */
+        count = fread(reader->buffer + reader->end, 1, READER_CHUNK_SIZE - reader->end, reader->file);
+    }
+
+    if (count == 0U)
+    {
+        reader->eof = 1;
+    }
+    reader->end += count;
+}
+
+/**
+ * @brief Hand out the bytes between first and last as a token.
+ *
+ * @param reader The reader.
+ * @param first The first byte of the token in the chunk.
+ * @param last The end of the token in the chunk.
+ * @param token Output, the token.
+ * @return 1 if the token is handed out, 0 if it is empty.
+ */
+static int32_t Reader_Emit(const Account_Reader_t* reader, size_t first, size_t last, Account_Token_t* token)
+{
+    /* Remove the carriage return of a "\r\n" end of line */
+    if (last > first && reader->buffer[last - 1U] == '\r')
+    {
+        last--;
+    }
+
+    token->ptr = reader->buffer + first;
+    token->length = last - first;
+    token->size = last - first;
+    token->offset = reader->offset + first;
+
+    return (last > first) ? 1 : 0;
+}
+
+/**
+ * @brief Skip a token that fills the whole chunk.
+ *
+ * Only the first bytes of the token are kept, the rest is read and dropped up to the
+ * end of the line.
+ *
+ * @param reader The reader, its chunk holds only the beginning of the token.
+ * @param token Output, the token.
+ */
+static void Reader_Skip_Long(Account_Reader_t* reader, Account_Token_t* token)
+{
+    const int8_t* newline = NULL;       /* End of the token */
+
+    /* Keep the first bytes of the token */
+    memcpy(reader->prefix, reader->buffer, READER_PREFIX_SIZE);
+    token->ptr = reader->prefix;
+    token->size = READER_PREFIX_SIZE;
+    token->offset = reader->offset;
+    token->length = 0;
+
+    /* Drop whole chunks until the end of the line */
+    while (newline == NULL)
+    {
+        token->length += reader->end - reader->start;
+        reader->start = reader->end;
+        Reader_Fill(reader);
+        newline = (const int8_t*)memchr(reader->buffer, '\n', reader->end);
+        if (newline == NULL && reader->eof)
+        {
+            token->length += reader->end;
+            reader->start = reader->end;
+            newline = reader->buffer + reader->end;
+        }
+    }
+
+    /* Drop the last part of the token and its end of line */
+    if (reader->start < reader->end)
+    {
+        token->length += (size_t)(newline - reader->buffer);
+        reader->start = (size_t)(newline - reader->buffer) + 1U;
+    }
+}
+
+/**
+ * @brief Prepare a reader for a file.
+ *
+ * An interactive reader reads one line at a time, so it never waits for more input than
+ * the user has typed. Otherwise the file is read in whole chunks and its own stdio
+ * buffering is turned off.
+ *
+ * @param reader The reader to prepare.
+ * @param file The file to read from.
+ * @param interactive 1 for a console, 0 for a file or a pipe.
+ * @return 1 if the reader is ready, 0 if memory allocation failed.
+ */
+int32_t Reader_Open(Account_Reader_t* reader, FILE* file, int32_t interactive)
+{
+    memset(reader, 0, sizeof(Account_Reader_t));
+    reader->file = file;
+    reader->interactive = interactive;
+    /* One extra byte for the NUL written by fgets() */
+    reader->buffer = (int8_t*)malloc(READER_CHUNK_SIZE + 1U);
+
+    /* The chunk is the only buffer needed between the file and the tokens */
+    if (!interactive)
+    {
+        setvbuf(file, NULL, _IONBF, 0);
+    }
+
+    return (reader->buffer != NULL) ? 1 : 0;
+}
+
+/**
+ * @brief Get the next token of the input.
+ *
+ * Tokens are the lines of the input without their end of line ("\n" or "\r\n").
+ * Empty lines are skipped.
+ *
+ * @param reader The reader.
+ * @param token Output, the next token.
+ * @return 1 if a token is handed out, 0 at the end of the input.
+ */
+int32_t Reader_Next(Account_Reader_t* reader, Account_Token_t* token)
+{
+    int32_t found = 0;              /* A token is handed out */
+    int32_t done = 0;               /* The input is exhausted */
+    const int8_t* newline = NULL;   /* End of the next line */
+    size_t first = 0;               /* Start of the next line */
+
+    while (!found && !done)
+    {
+        first = reader->start;
+        newline = (const int8_t*)memchr(reader->buffer + first, '\n', reader->end - first);
+
+        /* A whole line is in the chunk */
+        if (newline != NULL)
+        {
+            reader->start = (size_t)(newline - reader->buffer) + 1U;
+            found = Reader_Emit(reader, first, (size_t)(newline - reader->buffer), token);
+        }
+        /* The last line of the input has no end of line */
+        else if (reader->eof)
+        {
+            reader->start = reader->end;
+            found = Reader_Emit(reader, first, reader->end, token);
+            done = !found;
+        }
+        /* The line does not fit in the chunk */
+        else if (first == 0U && reader->end == READER_CHUNK_SIZE)
+        {
+            Reader_Skip_Long(reader, token);
+            found = 1;
+        }
+        else
+        {
+            Reader_Fill(reader);
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Release the memory of a reader.
+ *
+ * The file is not closed.
+ *
+ * @param reader The reader to release.
+ */
+void Reader_Close(Account_Reader_t* reader)
+{
+    free(reader->buffer);
+    reader->buffer = NULL;
+} /* EOF */
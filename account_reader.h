@@ -0,0 +1,100 @@
+/**
+ * @file account_reader.h
+ * @brief This file contains the declarations of the buffered account reader.
+ *
+ * The reader pulls large chunks from a file and splits them into newline-delimited tokens
+ * with memchr(). Each token is handed out as a pointer and a length into the chunk, so
+ * accounts reach Check_Account_Ctx() without being copied. A token longer than the chunk
+ * is skipped to its end of line and handed out with its real length, which makes it
+ * LENGHT_INVALID instead of overflowing a buffer.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stddef.h>         /* For size_t */
+#include <stdint.h>         /* Include standard integer types library for fixed-width integers */
+#include <stdio.h>          /* For FILE */
+
+#ifndef ACCOUNT_READER_H
+#define ACCOUNT_READER_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define READER_CHUNK_SIZE       (256U * 1024U)  /* Bytes read from the file at once */
+#define READER_PREFIX_SIZE      16U             /* Bytes kept from a token longer than a chunk */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for a token handed out by the reader.
+ *
+ * The bytes stay valid until the next call to Reader_Next().
+ */
+typedef struct
+{
+    const int8_t* ptr;      /* The first byte of the token, not NUL terminated. */
+    size_t length;          /* The length of the token. */
+    size_t size;            /* The number of bytes available at ptr, less than length for a token longer than a chunk. */
+    uint64_t offset;        /* The position of the token in the input. */
+} Account_Token_t;
+
+/**
+ * @brief Structure for the reader.
+ */
+typedef struct
+{
+    FILE* file;                             /* The file the tokens are read from. */
+    int8_t* buffer;                         /* The current chunk. */
+    size_t start;                           /* The first byte of the chunk not handed out yet. */
+    size_t end;                             /* The end of the valid bytes of the chunk. */
+    uint64_t offset;                        /* The position of buffer[0] in the input. */
+    int32_t interactive;                    /* Read one line at a time instead of whole chunks. */
+    int32_t eof;                            /* The end of the file has been reached. */
+    int8_t prefix[READER_PREFIX_SIZE];      /* The first bytes of a token longer than a chunk. */
+} Account_Reader_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Prepare a reader for a file.
+ *
+ * An interactive reader reads one line at a time, so it never waits for more input than
+ * the user has typed. Otherwise the file is read in whole chunks and its own stdio
+ * buffering is turned off.
+ *
+ * @param reader The reader to prepare.
+ * @param file The file to read from.
+ * @param interactive 1 for a console, 0 for a file or a pipe.
+ * @return 1 if the reader is ready, 0 if memory allocation failed.
+ */
+int32_t Reader_Open(Account_Reader_t* reader, FILE* file, int32_t interactive);
+
+/**
+ * @brief Get the next token of the input.
+ *
+ * Tokens are the lines of the input without their end of line ("\n" or "\r\n").
+ * Empty lines are skipped.
+ *
+ * @param reader The reader.
+ * @param token Output, the next token.
+ * @return 1 if a token is handed out, 0 at the end of the input.
+ */
+int32_t Reader_Next(Account_Reader_t* reader, Account_Token_t* token);
+
+/**
+ * @brief Release the memory of a reader.
+ *
+ * The file is not closed.
+ *
+ * @param reader The reader to release.
+ */
+void Reader_Close(Account_Reader_t* reader);
+
+#endif /* ACCOUNT_READER_H */
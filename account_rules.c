@@ -0,0 +1,875 @@
+/**
+ * @file account_rules.c
+ * @brief This file contains the implementation of the configurable validation rules.
+ *
+ * The compiler gives each character that appears in a prefix or a forbidden sequence a
+ * class of its own, all the other accepted characters one shared class, and every other
+ * byte the rejected class 0. It then builds a trie of the prefixes and an Aho-Corasick
+ * automaton of the forbidden sequences over the classes, and the DFA is their product,
+ * explored from the start state so only reachable states are kept. States 0 to 2 are
+ * absorbing and hold the first rule broken.
+ *
+ * Each row of the DFA is padded to a power of 2 classes and holds the rows of the next
+ * states, so a step is one load and one add.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "account_rules.h"      /* Include header file of this function file */
+#include "account_key.h"        /* For account_char_code and the layout of the keys */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define RULES_MAX_CLASSES       64U     /* The 62 characters of a key, the rejected class and the shared class */
+#define RULES_TRIE_NODES        (RULES_MAX_PATTERNS * ACCOUNT_MAX_LENGTH + 1U)  /* Nodes of a full trie */
+#define RULES_MAX_TOKENS        (RULES_MAX_PATTERNS + 1U)   /* Words of a directive */
+#define RULES_MAX_SPEC          (64U * 1024U)   /* Largest file of rules */
+#define RULES_DEAD_CHAR         0U      /* State of an account with a rejected character */
+#define RULES_DEAD_PREFIX       1U      /* State of an account without a required prefix */
+#define RULES_DEAD_SEQUENCE     2U      /* State of an account holding a forbidden sequence */
+#define RULES_DEAD_STATES       3U      /* Number of absorbing states */
+#define RULES_PREFIX_FAIL       (-1)    /* Prefix state of an account that cannot get a prefix any more */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for a compiled rule set.
+ */
+struct Account_Rules
+{
+    uint8_t class_of[256];      /* Class of every byte value. */
+    uint8_t length_status[256]; /* Status of every length, before the characters are read. */
+    uint32_t class_bits;        /* The row of a state is its number shifted by this. */
+    uint32_t classes;           /* Character classes in use. */
+    uint32_t states;            /* States of the DFA. */
+    uint32_t start;             /* Row of the start state. */
+    const uint32_t* delta;      /* Row of the next state, by row of the state plus class. */
+    const uint8_t* final;       /* Status of each state once the account is read. */
+};
+
+/**
+ * @brief Structure for the directives of a rule set, as parsed.
+ */
+typedef struct
+{
+    uint8_t accepted[256];      /* Set for the accepted characters. */
+    uint32_t min_length;        /* Shortest accepted account. */
+    uint32_t max_length;        /* Longest accepted account. */
+    int32_t charset_given;      /* Set once a charset directive replaced the default characters. */
+    uint32_t prefix_count;      /* Number of prefixes. */
+    uint32_t forbid_count;      /* Number of forbidden sequences. */
+    char prefix[RULES_MAX_PATTERNS][ACCOUNT_MAX_LENGTH + 1U];   /* Required prefixes, NUL terminated. */
+    char forbid[RULES_MAX_PATTERNS][ACCOUNT_MAX_LENGTH + 1U];   /* Forbidden sequences, NUL terminated. */
+} Rules_Spec_t;
+
+/**
+ * @brief Structure for a trie of patterns over the character classes.
+ */
+typedef struct
+{
+    int16_t next[RULES_TRIE_NODES][RULES_MAX_CLASSES];  /* Child of each node by class, -1 for none. */
+    int16_t fail[RULES_TRIE_NODES];     /* Longest proper suffix that is also a node, for Aho-Corasick. */
+    uint8_t terminal[RULES_TRIE_NODES]; /* Set when a pattern ends at the node. */
+    uint32_t nodes;                     /* Nodes in use, the root is node 0. */
+} Rules_Trie_t;
+
+/**
+ * @brief Structure for a word of a directive.
+ */
+typedef struct
+{
+    const char* ptr;            /* First character of the word. */
+    uint32_t length;            /* Length of the word. */
+} Rules_Token_t;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Check if a word is a given keyword.
+ *
+ * @param token The word.
+ * @param keyword The keyword, NUL terminated.
+ * @return 1 if they are equal, 0 if not.
+ */
+static int32_t Rules_Token_Is(const Rules_Token_t* token, const char* keyword)
+{
+    return (strlen(keyword) == token->length && memcmp(token->ptr, keyword, token->length) == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Read a decimal number at the start of a word.
+ *
+ * @param ptr The first character, moved past the digits.
+ * @param end The end of the word.
+ * @param value Output, the number.
+ * @return 1 if at least one digit was read and the number is small, 0 if not.
+ */
+static int32_t Rules_Parse_Number(const char** ptr, const char* end, uint32_t* value)
+{
+    int32_t valid = 0;          /* Set once a digit is read */
+
+    *value = 0;
+    while (*ptr < end && **ptr >= '0' && **ptr <= '9' && *value < 1000U)
+    {
+        *value = *value * 10U + (uint32_t)(**ptr - '0');
+        (*ptr)++;
+        valid = 1;
+    }
+
+    return (valid && *value < 1000U) ? 1 : 0;
+}
+
+/**
+ * @brief Apply the value of a length directive, "<max>" or "<min>-<max>".
+ *
+ * @param token The value.
+ * @param spec The directives, updated.
+ * @return 1 if the value is valid, 0 if not.
+ */
+static int32_t Rules_Parse_Length(const Rules_Token_t* token, Rules_Spec_t* spec)
+{
+    const char* ptr = token->ptr;                   /* Current character */
+    const char* end = token->ptr + token->length;   /* End of the value */
+    uint32_t first = 0;                             /* First number */
+    uint32_t second = 0;                            /* Second number, the first one when alone */
+    int32_t valid = Rules_Parse_Number(&ptr, end, &first);  /* Result of the parsing */
+
+    second = first;
+    if (valid && ptr < end && *ptr == '-')
+    {
+        ptr++;
+        valid = Rules_Parse_Number(&ptr, end, &second);
+    }
+    else
+    {
+        /* A single number is the largest length */
+        first = 0;
+    }
+
+    if (valid && ptr == end && first <= second && second <= ACCOUNT_MAX_LENGTH)
+    {
+        spec->min_length = first;
+        spec->max_length = second;
+    }
+    else
+    {
+        valid = 0;
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Apply the value of a charset directive, characters and ranges such as "a-z".
+ *
+ * @param token The value.
+ * @param spec The directives, updated.
+ * @return 1 if every character can be packed into a key, 0 if not.
+ */
+static int32_t Rules_Parse_Charset(const Rules_Token_t* token, Rules_Spec_t* spec)
+{
+    int32_t valid = 1;          /* Result of the parsing */
+    uint32_t i = 0;             /* Current character of the value */
+    uint8_t first = 0;          /* First character of the current range */
+    uint8_t last = 0;           /* Last character of the current range */
+    uint32_t c = 0;             /* Character counter within the range */
+
+    while (valid && i < token->length)
+    {
+        first = (uint8_t)token->ptr[i];
+        last = first;
+        if (i + 2U < token->length && token->ptr[i + 1U] == '-')
+        {
+            last = (uint8_t)token->ptr[i + 2U];
+            i += 2U;
+        }
+        i++;
+        valid = (first <= last) ? 1 : 0;
+        for (c = first; valid && c <= last; c++)
+        {
+            /* Only the characters of a key may be accepted */
+            valid = (account_char_code[c] != 0U) ? 1 : 0;
+            spec->accepted[c] = 1U;
+        }
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Apply one directive.
+ *
+ * @param tokens The words of the directive, the keyword first.
+ * @param count The number of words, at least 1.
+ * @param spec The directives, updated.
+ * @return 1 if the directive is valid, 0 if not.
+ */
+static int32_t Rules_Apply(const Rules_Token_t* tokens, uint32_t count, Rules_Spec_t* spec)
+{
+    int32_t valid = (count >= 2U) ? 1 : 0;      /* Result of the directive, every keyword takes a value */
+    uint32_t i = 0;                             /* Value counter */
+
+    if (!valid)
+    {
+        /* Nothing to apply */
+    }
+    else if (Rules_Token_Is(&tokens[0], "length"))
+    {
+        valid = (count == 2U) ? Rules_Parse_Length(&tokens[1], spec) : 0;
+    }
+    else if (Rules_Token_Is(&tokens[0], "charset"))
+    {
+        /* The first charset replaces the default characters */
+        if (!spec->charset_given)
+        {
+            memset(spec->accepted, 0, sizeof(spec->accepted));
+            spec->charset_given = 1;
+        }
+        for (i = 1; valid && i < count; i++)
+        {
+            valid = Rules_Parse_Charset(&tokens[i], spec);
+        }
+    }
+    else if (Rules_Token_Is(&tokens[0], "prefix") || Rules_Token_Is(&tokens[0], "forbid"))
+    {
+        for (i = 1; valid && i < count; i++)
+        {
+            valid = (tokens[i].length <= ACCOUNT_MAX_LENGTH) ? 1 : 0;
+            if (valid && tokens[0].ptr[0] == 'p')
+            {
+                valid = (spec->prefix_count < RULES_MAX_PATTERNS) ? 1 : 0;
+                if (valid)
+                {
+                    memcpy(spec->prefix[spec->prefix_count], tokens[i].ptr, tokens[i].length);
+                    spec->prefix[spec->prefix_count][tokens[i].length] = '\0';
+                    spec->prefix_count++;
+                }
+            }
+            else if (valid)
+            {
+                valid = (spec->forbid_count < RULES_MAX_PATTERNS) ? 1 : 0;
+                if (valid)
+                {
+                    memcpy(spec->forbid[spec->forbid_count], tokens[i].ptr, tokens[i].length);
+                    spec->forbid[spec->forbid_count][tokens[i].length] = '\0';
+                    spec->forbid_count++;
+                }
+            }
+        }
+    }
+    else
+    {
+        valid = 0;
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Check that every character of a pattern is accepted.
+ *
+ * A pattern with a rejected character could never be met.
+ *
+ * @param pattern The pattern, NUL terminated.
+ * @param spec The directives.
+ * @return 1 if every character is accepted, 0 if not.
+ */
+static int32_t Rules_Pattern_Accepted(const char* pattern, const Rules_Spec_t* spec)
+{
+    int32_t valid = 1;          /* Result of the check */
+    uint32_t i = 0;             /* Character counter */
+
+    for (i = 0; pattern[i] != '\0'; i++)
+    {
+        valid = (spec->accepted[(uint8_t)pattern[i]] != 0U) ? valid : 0;
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Parse the text of a rule set.
+ *
+ * @param text The text, NUL terminated.
+ * @param spec Output, the directives.
+ * @param line Output, the line of the first bad directive.
+ * @return RULES_OK if every directive is valid, RULES_BAD_SPEC if not.
+ */
+static rules_status_t Rules_Parse(const char* text, Rules_Spec_t* spec, uint32_t* line)
+{
+    rules_status_t result = RULES_OK;           /* Result of the parsing */
+    Rules_Token_t tokens[RULES_MAX_TOKENS];     /* Words of the current directive */
+    uint32_t count = 0;                         /* Words of the current directive */
+    int32_t too_many = 0;                       /* Set when the directive has too many words */
+    uint32_t number = 1;                        /* Line of the current directive */
+    const char* ptr = text;                     /* Current character */
+    const char* start = NULL;                   /* First character of the current word */
+    uint32_t c = 0;                             /* Character counter */
+
+    /* The defaults are the rules of Check_Account() */
+    memset(spec, 0, sizeof(Rules_Spec_t));
+    spec->max_length = ACCOUNT_MAX_LENGTH;
+    for (c = 0; c < 256U; c++)
+    {
+        spec->accepted[c] = ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '1' && c <= '9')) ? 1U : 0U;
+    }
+
+    while (result == RULES_OK)
+    {
+        /* Skip the blanks and the comments */
+        while (*ptr == ' ' || *ptr == '\t' || *ptr == '\r')
+        {
+            ptr++;
+        }
+        if (*ptr == '#')
+        {
+            while (*ptr != '\n' && *ptr != '\0')
+            {
+                ptr++;
+            }
+        }
+
+        /* The end of a directive */
+        if (*ptr == '\n' || *ptr == ';' || *ptr == '\0')
+        {
+            if (too_many || (count > 0U && Rules_Apply(tokens, count, spec) == 0))
+            {
+                result = RULES_BAD_SPEC;
+            }
+            else if (*ptr == '\0')
+            {
+                break;
+            }
+            else
+            {
+                number += (*ptr == '\n') ? 1U : 0U;
+                ptr++;
+                count = 0;
+            }
+        }
+        /* A word */
+        else
+        {
+            start = ptr;
+            while (*ptr != '\0' && *ptr != ' ' && *ptr != '\t' && *ptr != '\r' && *ptr != '\n' && *ptr != ';'
+                   && *ptr != '#')
+            {
+                ptr++;
+            }
+            if (count < RULES_MAX_TOKENS)
+            {
+                tokens[count].ptr = start;
+                tokens[count].length = (uint32_t)(ptr - start);
+                count++;
+            }
+            else
+            {
+                too_many = 1;
+            }
+        }
+    }
+
+    /* The patterns can only be checked once the characters are known */
+    for (c = 0; (result == RULES_OK) && (c < spec->prefix_count + spec->forbid_count); c++)
+    {
+        if (!Rules_Pattern_Accepted((c < spec->prefix_count) ? spec->prefix[c] : spec->forbid[c - spec->prefix_count],
+                                    spec))
+        {
+            result = RULES_BAD_SPEC;
+        }
+    }
+    *line = number;
+
+    return result;
+}
+
+/**
+ * @brief Add a pattern to a trie.
+ *
+ * @param trie The trie.
+ * @param pattern The pattern, NUL terminated.
+ * @param class_of The class of every byte value.
+ */
+static void Rules_Trie_Add(Rules_Trie_t* trie, const char* pattern, const uint8_t* class_of)
+{
+    uint32_t node = 0;          /* Current node */
+    uint32_t i = 0;             /* Character counter */
+    uint8_t c = 0;              /* Class of the current character */
+
+    for (i = 0; pattern[i] != '\0'; i++)
+    {
+        c = class_of[(uint8_t)pattern[i]];
+        if (trie->next[node][c] < 0)
+        {
+            trie->next[node][c] = (int16_t)trie->nodes;
+            trie->nodes++;
+        }
+        node = (uint32_t)trie->next[node][c];
+    }
+    trie->terminal[node] = 1U;
+}
+
+/**
+ * @brief Turn a trie into an Aho-Corasick automaton.
+ *
+ * Every missing child is replaced by the child of the longest suffix, so each node has a
+ * next node for every class, and a node is terminal when any of its suffixes is.
+ *
+ * @param trie The trie.
+ * @param classes The number of classes.
+ */
+static void Rules_Trie_Link(Rules_Trie_t* trie, uint32_t classes)
+{
+    int16_t queue[RULES_TRIE_NODES];    /* Nodes in breadth-first order */
+    uint32_t head = 0;                  /* Next node of the queue */
+    uint32_t tail = 0;                  /* End of the queue */
+    uint32_t node = 0;                  /* Current node */
+    int16_t child = 0;                  /* Child of the current node */
+    uint32_t c = 0;                     /* Class counter */
+
+    /* The children of the root fall back to the root */
+    for (c = 0; c < classes; c++)
+    {
+        child = trie->next[0][c];
+        if (child < 0)
+        {
+            trie->next[0][c] = 0;
+        }
+        else
+        {
+            trie->fail[child] = 0;
+            queue[tail++] = child;
+        }
+    }
+
+    /* A node is reached after its suffixes, which are shorter */
+    while (head < tail)
+    {
+        node = (uint32_t)queue[head++];
+        trie->terminal[node] |= trie->terminal[trie->fail[node]];
+        for (c = 0; c < classes; c++)
+        {
+            child = trie->next[node][c];
+            if (child < 0)
+            {
+                trie->next[node][c] = trie->next[trie->fail[node]][c];
+            }
+            else
+            {
+                trie->fail[child] = trie->next[trie->fail[node]][c];
+                queue[tail++] = child;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Find or create the state of a pair of prefix and sequence states.
+ *
+ * @param map The state of each pair, -1 until created.
+ * @param pair The pair, prefix state times the sequence nodes plus the sequence state.
+ * @param pairs Output, the pair of each state.
+ * @param states The number of states, incremented when one is created.
+ * @return The state, RULES_MAX_STATES if there is no room for a new one.
+ */
+static uint32_t Rules_State(int32_t* map, uint32_t pair, uint32_t* pairs, uint32_t* states)
+{
+    uint32_t state = RULES_MAX_STATES;      /* The state of the pair */
+
+    if (map[pair] >= 0)
+    {
+        state = (uint32_t)map[pair];
+    }
+    else if (*states < RULES_MAX_STATES)
+    {
+        state = *states;
+        map[pair] = (int32_t)state;
+        pairs[state] = pair;
+        (*states)++;
+    }
+
+    return state;
+}
+
+/**
+ * @brief Compile a rule set.
+ *
+ * @param spec The text of the rules, NUL terminated.
+ * @param rules Output, the compiled rules, to be released with Rules_Free().
+ * @param line Output, the line of the first bad directive for RULES_BAD_SPEC. May be NULL.
+ * @return RULES_OK if the rules are compiled, an error code if not.
+ */
+rules_status_t Rules_Compile(const char* spec, account_rules_t** rules, uint32_t* line)
+{
+    rules_status_t result = RULES_OK;   /* Result of the compilation */
+    Rules_Spec_t* parsed = (Rules_Spec_t*)malloc(sizeof(Rules_Spec_t));         /* Directives of the rules */
+    Rules_Trie_t* prefixes = (Rules_Trie_t*)malloc(sizeof(Rules_Trie_t));       /* Trie of the prefixes */
+    Rules_Trie_t* forbidden = (Rules_Trie_t*)malloc(sizeof(Rules_Trie_t));      /* Automaton of the sequences */
+    int32_t* map = NULL;                /* State of each pair of prefix and sequence states */
+    uint32_t* pairs = (uint32_t*)malloc(RULES_MAX_STATES * sizeof(uint32_t));   /* Pair of each state */
+    uint8_t class_of[256];              /* Class of every byte value */
+    uint32_t classes = 1;               /* Classes in use, class 0 rejects */
+    uint32_t class_bits = 0;            /* Rows are padded to 2^class_bits classes */
+    uint32_t done = 0;                  /* Prefix state of an account that has a prefix */
+    uint32_t states = RULES_DEAD_STATES;    /* States of the DFA */
+    uint32_t state = 0;                 /* Current state */
+    uint32_t target = 0;                /* Next state of the current state */
+    int32_t prefix = 0;                 /* Prefix state of the current or next state */
+    uint32_t sequence = 0;              /* Sequence state of the current or next state */
+    uint32_t bad_line = 0;              /* Line of the first bad directive */
+    uint32_t* delta = NULL;             /* Next state of each state and class, while the states are found */
+    struct Account_Rules* compiled = NULL;  /* The compiled rules */
+    uint32_t c = 0;                     /* Byte, class or pattern counter */
+
+    *rules = NULL;
+    if (parsed == NULL || prefixes == NULL || forbidden == NULL || pairs == NULL)
+    {
+        result = RULES_NO_MEMORY;
+    }
+    else
+    {
+        result = Rules_Parse(spec, parsed, &bad_line);
+    }
+
+    if (result == RULES_OK)
+    {
+        /* Each character of a pattern has a class of its own */
+        memset(class_of, 0, sizeof(class_of));
+        for (c = 0; c < parsed->prefix_count + parsed->forbid_count; c++)
+        {
+            const char* pattern = (c < parsed->prefix_count) ? parsed->prefix[c] : parsed->forbid[c - parsed->prefix_count];
+            uint32_t i = 0;     /* Character counter */
+
+            for (i = 0; pattern[i] != '\0'; i++)
+            {
+                if (class_of[(uint8_t)pattern[i]] == 0U)
+                {
+                    class_of[(uint8_t)pattern[i]] = (uint8_t)classes++;
+                }
+            }
+        }
+        /* The other accepted characters share one class */
+        for (c = 0; c < 256U; c++)
+        {
+            if (parsed->accepted[c] && class_of[c] == 0U)
+            {
+                class_of[c] = (uint8_t)classes;
+            }
+        }
+        classes++;
+        while ((1U << class_bits) < classes)
+        {
+            class_bits++;
+        }
+
+        /* Build the trie of the prefixes and the automaton of the sequences */
+        memset(prefixes, 0xFF, sizeof(prefixes->next));
+        memset(prefixes->terminal, 0, sizeof(prefixes->terminal));
+        prefixes->nodes = 1;
+        memset(forbidden, 0xFF, sizeof(forbidden->next));
+        memset(forbidden->terminal, 0, sizeof(forbidden->terminal));
+        forbidden->nodes = 1;
+        for (c = 0; c < parsed->prefix_count; c++)
+        {
+            Rules_Trie_Add(prefixes, parsed->prefix[c], class_of);
+        }
+        for (c = 0; c < parsed->forbid_count; c++)
+        {
+            Rules_Trie_Add(forbidden, parsed->forbid[c], class_of);
+        }
+        Rules_Trie_Link(forbidden, classes);
+        /* Without prefixes every account starts with one */
+        done = prefixes->nodes;
+
+        map = (int32_t*)malloc((size_t)(done + 1U) * forbidden->nodes * sizeof(int32_t));
+        delta = (uint32_t*)malloc(((size_t)RULES_MAX_STATES << class_bits) * sizeof(uint32_t));
+        if (map == NULL || delta == NULL)
+        {
+            result = RULES_NO_MEMORY;
+        }
+    }
+
+    if (result == RULES_OK)
+    {
+        memset(map, 0xFF, (size_t)(done + 1U) * forbidden->nodes * sizeof(int32_t));
+        Rules_State(map, ((parsed->prefix_count == 0U) ? done : 0U) * forbidden->nodes, pairs, &states);
+
+        /* The absorbing states stay where they are */
+        for (state = 0; state < RULES_DEAD_STATES; state++)
+        {
+            for (c = 0; c < (1U << class_bits); c++)
+            {
+                delta[(state << class_bits) + c] = state << class_bits;
+            }
+        }
+
+        /* Explore the states reachable from the start state */
+        for (state = RULES_DEAD_STATES; (state < states) && (result == RULES_OK); state++)
+        {
+            for (c = 0; (c < (1U << class_bits)) && (result == RULES_OK); c++)
+            {
+                prefix = (int32_t)(pairs[state] / forbidden->nodes);
+                sequence = pairs[state] % forbidden->nodes;
+                target = RULES_DEAD_CHAR;
+                if (c != 0U && c < classes)
+                {
+                    /* Follow the prefixes until one of them is complete */
+                    if ((uint32_t)prefix != done)
+                    {
+                        prefix = prefixes->next[prefix][c];
+                        prefix = (prefix >= 0 && prefixes->terminal[prefix]) ? (int32_t)done : prefix;
+                    }
+                    sequence = (uint32_t)forbidden->next[sequence][c];
+
+                    if (prefix == RULES_PREFIX_FAIL)
+                    {
+                        target = RULES_DEAD_PREFIX;
+                    }
+                    else if (forbidden->terminal[sequence])
+                    {
+                        target = RULES_DEAD_SEQUENCE;
+                    }
+                    else
+                    {
+                        target = Rules_State(map, (uint32_t)prefix * forbidden->nodes + sequence, pairs, &states);
+                        result = (target == RULES_MAX_STATES) ? RULES_TOO_LARGE : RULES_OK;
+                    }
+                }
+                delta[(state << class_bits) + c] = target << class_bits;
+            }
+        }
+    }
+
+    /* Copy the DFA into one block with the tables */
+    if (result == RULES_OK)
+    {
+        compiled = (struct Account_Rules*)malloc(sizeof(struct Account_Rules)
+                                                 + ((size_t)states << class_bits) * sizeof(uint32_t) + states);
+        if (compiled == NULL)
+        {
+            result = RULES_NO_MEMORY;
+        }
+    }
+    if (result == RULES_OK)
+    {
+        uint32_t* table = (uint32_t*)(compiled + 1);                    /* Rows of the DFA */
+        uint8_t* final = (uint8_t*)(table + ((size_t)states << class_bits));    /* Status of each state */
+
+        memcpy(compiled->class_of, class_of, sizeof(class_of));
+        for (c = 0; c < 256U; c++)
+        {
+            compiled->length_status[c] = (uint8_t)((c >= parsed->min_length && c <= parsed->max_length)
+                                                   ? CORRECT : LENGHT_INVALID);
+        }
+        memcpy(table, delta, ((size_t)states << class_bits) * sizeof(uint32_t));
+        final[RULES_DEAD_CHAR] = (uint8_t)CHAR_INVALID;
+        final[RULES_DEAD_PREFIX] = (uint8_t)PREFIX_INVALID;
+        final[RULES_DEAD_SEQUENCE] = (uint8_t)SEQUENCE_INVALID;
+        for (state = RULES_DEAD_STATES; state < states; state++)
+        {
+            /* An account that ends before a prefix is complete has none */
+            final[state] = (uint8_t)((pairs[state] / forbidden->nodes == done) ? CORRECT : PREFIX_INVALID);
+        }
+        compiled->class_bits = class_bits;
+        compiled->classes = classes;
+        compiled->states = states;
+        compiled->start = RULES_DEAD_STATES << class_bits;
+        compiled->delta = table;
+        compiled->final = final;
+        *rules = compiled;
+    }
+
+    if (line != NULL)
+    {
+        *line = (result == RULES_BAD_SPEC) ? bad_line : 0U;
+    }
+    free(parsed);
+    free(prefixes);
+    free(forbidden);
+    free(map);
+    free(pairs);
+    free(delta);
+
+    return result;
+}
+
+/**
+ * @brief Compile the rule set of a file.
+ *
+ * @param path The path of the file.
+ * @param rules Output, the compiled rules, to be released with Rules_Free().
+ * @param line Output, the line of the first bad directive for RULES_BAD_SPEC. May be NULL.
+ * @return RULES_OK if the rules are compiled, an error code if not.
+ */
+rules_status_t Rules_Load(const char* path, account_rules_t** rules, uint32_t* line)
+{
+    rules_status_t result = RULES_IO_ERROR;     /* Result of the loading */
+    FILE* file = fopen(path, "rb");             /* File of the rules */
+    char* text = (char*)malloc(RULES_MAX_SPEC + 1U);    /* Text of the rules */
+    size_t size = 0;                            /* Bytes of the file */
+
+    *rules = NULL;
+    if (text == NULL)
+    {
+        result = RULES_NO_MEMORY;
+    }
+    else if (file != NULL)
+    {
+        /* One byte more than the largest file tells a file that is too large */
+        size = fread(text, 1U, RULES_MAX_SPEC + 1U, file);
+        if (ferror(file))
+        {
+            result = RULES_IO_ERROR;
+        }
+        else if (size > RULES_MAX_SPEC)
+        {
+            result = RULES_TOO_LARGE;
+        }
+        else
+        {
+            text[size] = '\0';
+            result = Rules_Compile(text, rules, line);
+        }
+    }
+
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+    free(text);
+
+    return result;
+}
+
+/**
+ * @brief Check an account against a rule set and pack it into a key.
+ *
+ * The rules are only read, so several threads may check accounts with the same rules.
+ *
+ * @param rules The rules.
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param key Output, the key of the account when it is CORRECT. May be NULL.
+ * @return The status of the account.
+ */
+status_enum_t Rules_Check(const account_rules_t* rules, const int8_t* ptr, uint8_t length, uint64_t* key)
+{
+    status_enum_t status = (status_enum_t)rules->length_status[length];     /* Status of the account */
+    uint32_t count = (status == CORRECT) ? length : 0U;     /* Characters to read, none for a bad length */
+    uint32_t row = rules->start;                /* Row of the current state */
+    uint64_t packed = 0;                        /* Key of the account being built */
+    uint32_t shift = ACCOUNT_KEY_TOP_SHIFT;     /* Position of the current character in the key */
+    uint32_t i = 0;                             /* Counter of characters */
+    uint8_t c = 0;                              /* Current character */
+
+    /* Every character is one step of the DFA, whatever it is */
+    for (i = 0; i < count; i++)
+    {
+        c = (uint8_t)ptr[i];
+        row = rules->delta[row + rules->class_of[c]];
+        packed |= (uint64_t)account_char_code[c] << shift;
+        shift -= ACCOUNT_KEY_BITS;
+    }
+    status = (status == CORRECT) ? (status_enum_t)rules->final[row >> rules->class_bits] : status;
+
+    /* Hand the key out only for a correct account */
+    if (key != NULL && status == CORRECT)
+    {
+        *key = packed;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Check many accounts against a rule set.
+ *
+ * @param rules The rules.
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+void Rules_Check_Batch(const account_rules_t* rules, const int8_t* const* ptrs, const uint8_t* lens, size_t n,
+                       status_enum_t* out)
+{
+    size_t i = 0;       /* Counter of accounts */
+
+    for (i = 0; i < n; i++)
+    {
+        out[i] = Rules_Check(rules, ptrs[i], lens[i], NULL);
+    }
+}
+
+/**
+ * @brief Get the size of a compiled rule set.
+ *
+ * @param rules The rules.
+ * @param info Output, the size of the rules.
+ */
+void Rules_Get_Info(const account_rules_t* rules, Rules_Info_t* info)
+{
+    info->classes = rules->classes;
+    info->states = rules->states;
+    info->bytes = sizeof(struct Account_Rules) + ((size_t)rules->states << rules->class_bits) * sizeof(uint32_t)
+                + rules->states;
+}
+
+/**
+ * @brief Release a compiled rule set.
+ *
+ * @param rules The rules, may be NULL.
+ */
+void Rules_Free(account_rules_t* rules)
+{
+    free(rules);
+}
+
+/**
+ * @brief Get the message of a result of the rule compiler.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Rules_Status_Message(rules_status_t status)
+{
+    const char* message = "Unknown error";     /* Message of the result */
+
+    switch (status)
+    {
+        case RULES_OK:
+        {
+            message = "Success";
+            break;
+        }
+        case RULES_IO_ERROR:
+        {
+            message = "File cannot be read";
+            break;
+        }
+        case RULES_BAD_SPEC:
+        {
+            message = "Unknown directive or bad value";
+            break;
+        }
+        case RULES_TOO_LARGE:
+        {
+            message = "Rules are too large";
+            break;
+        }
+        case RULES_NO_MEMORY:
+        {
+            message = "Memory allocation failed";
+            break;
+        }
+    }
+
+    return message;
+} /* EOF */
@@ -0,0 +1,140 @@
+/**
+ * @file account_rules.h
+ * @brief This file contains the declarations of the configurable validation rules.
+ *
+ * A rule set is written as text, one directive per line or separated by ';', with
+ * '#' starting a comment:
+ *
+ *      length <min>-<max>          accepted lengths, at most 10 (default 0-10)
+ *      charset <ranges> ...        accepted characters, e.g. a-z A-Z 0-9 (default a-z A-Z 1-9)
+ *      prefix <text> ...           the account must start with one of them
+ *      forbid <text> ...           the account must not contain any of them
+ *
+ * Every accepted character must be a letter or a digit, so that accepted accounts can be
+ * packed into keys. The rules are compiled once into a 256-entry table of character
+ * classes and a DFA whose states track the required prefix and the forbidden sequences
+ * (Aho-Corasick). An account is then checked in one pass of table lookups, with no branch
+ * on its characters, and packed into its key in the same pass.
+ *
+ * The status of a rejected account is the first rule it breaks: LENGHT_INVALID before
+ * any character is read, then CHAR_INVALID, PREFIX_INVALID or SEQUENCE_INVALID at the
+ * first character that breaks a rule, and PREFIX_INVALID for an account shorter than
+ * every prefix.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stddef.h>             /* For size_t */
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include "account_manage.h"     /* For status_enum_t and account_rules_t */
+
+#ifndef ACCOUNT_RULES_H
+#define ACCOUNT_RULES_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define RULES_MAX_PATTERNS      16U     /* Largest number of prefixes, and of forbidden sequences */
+#define RULES_MAX_STATES        4096U   /* Largest number of states of a compiled rule set */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the results of the rule compiler.
+ */
+typedef enum
+{
+    RULES_OK,                   /* The rules are compiled. */
+    RULES_IO_ERROR,             /* The file of the rules cannot be read. */
+    RULES_BAD_SPEC,             /* A directive is unknown or has a bad value. */
+    RULES_TOO_LARGE,            /* The rules need more than RULES_MAX_STATES states. */
+    RULES_NO_MEMORY             /* Memory allocation failed. */
+} rules_status_t;
+
+/**
+ * @brief Structure for the size of a compiled rule set.
+ */
+typedef struct
+{
+    uint32_t classes;           /* Character classes, the columns of the DFA. */
+    uint32_t states;            /* States of the DFA. */
+    size_t bytes;               /* Memory of the compiled rules. */
+} Rules_Info_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Compile a rule set.
+ *
+ * @param spec The text of the rules, NUL terminated.
+ * @param rules Output, the compiled rules, to be released with Rules_Free().
+ * @param line Output, the line of the first bad directive for RULES_BAD_SPEC. May be NULL.
+ * @return RULES_OK if the rules are compiled, an error code if not.
+ */
+rules_status_t Rules_Compile(const char* spec, account_rules_t** rules, uint32_t* line);
+
+/**
+ * @brief Compile the rule set of a file.
+ *
+ * @param path The path of the file.
+ * @param rules Output, the compiled rules, to be released with Rules_Free().
+ * @param line Output, the line of the first bad directive for RULES_BAD_SPEC. May be NULL.
+ * @return RULES_OK if the rules are compiled, an error code if not.
+ */
+rules_status_t Rules_Load(const char* path, account_rules_t** rules, uint32_t* line);
+
+/**
+ * @brief Check an account against a rule set and pack it into a key.
+ *
+ * The rules are only read, so several threads may check accounts with the same rules.
+ *
+ * @param rules The rules.
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param key Output, the key of the account when it is CORRECT. May be NULL.
+ * @return The status of the account.
+ */
+status_enum_t Rules_Check(const account_rules_t* rules, const int8_t* ptr, uint8_t length, uint64_t* key);
+
+/**
+ * @brief Check many accounts against a rule set.
+ *
+ * @param rules The rules.
+ * @param ptrs The pointers to the accounts.
+ * @param lens The lengths of the accounts.
+ * @param n The number of accounts.
+ * @param out Output, the status of each account.
+ */
+void Rules_Check_Batch(const account_rules_t* rules, const int8_t* const* ptrs, const uint8_t* lens, size_t n,
+                       status_enum_t* out);
+
+/**
+ * @brief Get the size of a compiled rule set.
+ *
+ * @param rules The rules.
+ * @param info Output, the size of the rules.
+ */
+void Rules_Get_Info(const account_rules_t* rules, Rules_Info_t* info);
+
+/**
+ * @brief Release a compiled rule set.
+ *
+ * @param rules The rules, may be NULL.
+ */
+void Rules_Free(account_rules_t* rules);
+
+/**
+ * @brief Get the message of a result of the rule compiler.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Rules_Status_Message(rules_status_t status);
+
+#endif /* ACCOUNT_RULES_H */
@@ -0,0 +1,668 @@
+/**
+ * @file account_server.c
+ * @brief This file contains the implementation of the socket server of the account list.
+ *
+ * Every connection has a buffer of requests and a buffer of responses. A readable connection
+ * is read once, all the complete requests of the buffer are served and their responses are
+ * sent with one call. A connection whose responses are not taken by the client stops being
+ * read until they are, so a slow client cannot make the server buffer without limit.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#ifdef __linux__
+#define _GNU_SOURCE             /* For accept4() */
+#endif
+#include <stdlib.h>             /* For malloc(), free() */
+#include <string.h>             /* For memset(), memmove(), strlen() */
+#ifdef __linux__
+#include <errno.h>              /* For errno */
+#include <unistd.h>             /* For close(), read(), write(), unlink() */
+#include <sys/epoll.h>          /* For the event loop */
+#include <sys/eventfd.h>        /* For the event of Server_Stop() */
+#include <sys/socket.h>         /* For the sockets */
+#include <sys/un.h>             /* For struct sockaddr_un */
+#include <sys/stat.h>           /* For lstat() */
+#include <netinet/in.h>         /* For struct sockaddr_in */
+#include <netinet/tcp.h>        /* For TCP_NODELAY */
+#include <arpa/inet.h>          /* For htonl(), htons() */
+#endif
+#include "account_manage.h"     /* For the operations on the list */
+#include "account_server.h"     /* Include header file of this function file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SERVER_EVENTS           64      /* Events taken from the loop at once */
+#define SERVER_BACKLOG          128     /* Connections waiting to be accepted */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for an open connection.
+ */
+typedef struct Server_Client
+{
+    int fd;                                 /* Socket of the connection. */
+    uint32_t events;                        /* Events the loop watches for the connection. */
+    uint32_t in_used;                       /* Bytes of requests in input. */
+    uint32_t out_start;                     /* First byte of output not sent yet. */
+    uint32_t out_end;                       /* End of the responses in output. */
+    int32_t ended;                          /* Set once the client sent its last request. */
+    struct Server_Client* next;             /* Next open connection. */
+    struct Server_Client* prev;             /* Previous open connection. */
+    uint8_t input[SERVER_INPUT_SIZE];       /* Requests read and not served yet. */
+    uint8_t output[SERVER_OUTPUT_SIZE];     /* Responses not sent yet. */
+} Server_Client_t;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+#ifdef __linux__
+/**
+ * @brief Serve one request and write its response.
+ *
+ * @param op The op of the request.
+ * @param account The account of the request.
+ * @param length The length of the account, smaller than SERVER_MAX_REQUEST.
+ * @param response Output, the SERVER_RESPONSE_SIZE bytes of the response.
+ */
+static void Server_Handle(uint8_t op, const int8_t* account, uint32_t length, uint8_t* response)
+{
+    uint64_t key = 0;               /* Key of the account */
+    status_enum_t status;           /* Status of the account */
+    server_result_t result = SERVER_NO; /* Result of the request */
+    int32_t added = 0;              /* Result of adding the account */
+
+    status = Check_Account_Ctx(NULL, account, (uint8_t)length, &key);
+    switch (op)
+    {
+        case SERVER_CHECK:
+        {
+            result = (status == CORRECT) ? SERVER_YES : SERVER_NO;
+            break;
+        }
+        case SERVER_ADD:
+        {
+            if (status == CORRECT)
+            {
+                added = Add_Account_Key(key);
+                result = (added < 0) ? SERVER_FAILED : (server_result_t)added;
+            }
+            break;
+        }
+        case SERVER_REMOVE:
+        {
+            result = (status == CORRECT && Remove_Account_Key(key) == 1) ? SERVER_YES : SERVER_NO;
+            break;
+        }
+        case SERVER_SEARCH:
+        {
+            result = (status == CORRECT && Is_Account_Key_Exist(key) == 1) ? SERVER_YES : SERVER_NO;
+            break;
+        }
+        default:
+        {
+            status = CORRECT;
+            result = SERVER_BAD_REQUEST;
+            break;
+        }
+    }
+
+    response[0] = (uint8_t)(SERVER_RESPONSE_SIZE - SERVER_HEADER_SIZE);
+    response[1] = 0;
+    response[2] = 0;
+    response[3] = 0;
+    response[4] = op;
+    response[5] = (uint8_t)status;
+    response[6] = (uint8_t)result;
+}
+
+/**
+ * @brief Serve the complete requests read from a connection, as long as their responses fit.
+ *
+ * @param server The server.
+ * @param client The connection.
+ * @return 1 if the requests are served, 0 if a length is out of range.
+ */
+static int32_t Server_Process(Server_t* server, Server_Client_t* client)
+{
+    uint32_t position = 0;      /* First byte of the current request */
+    uint32_t length = 0;        /* Length of the current request */
+    int32_t valid = 1;          /* Cleared by a length out of range */
+    int32_t partial = 0;        /* Set once the current request is not complete */
+    const uint8_t* request;     /* Current request */
+
+    /* Move the responses not sent yet to the front */
+    if (client->out_start > 0U)
+    {
+        memmove(client->output, &client->output[client->out_start], client->out_end - client->out_start);
+        client->out_end -= client->out_start;
+        client->out_start = 0;
+    }
+
+    while (valid && (partial == 0) && (client->in_used - position >= SERVER_HEADER_SIZE)
+           && (SERVER_OUTPUT_SIZE - client->out_end >= SERVER_RESPONSE_SIZE))
+    {
+        request = &client->input[position];
+        length = (uint32_t)request[0] | ((uint32_t)request[1] << 8) | ((uint32_t)request[2] << 16)
+                 | ((uint32_t)request[3] << 24);
+        if (length == 0U || length > SERVER_MAX_REQUEST)
+        {
+            valid = 0;
+            server->stats.protocol_errors++;
+        }
+        else if (client->in_used - position < SERVER_HEADER_SIZE + length)
+        {
+            partial = 1;
+        }
+        else
+        {
+            Server_Handle(request[SERVER_HEADER_SIZE], (const int8_t*)&request[SERVER_HEADER_SIZE + 1U], length - 1U,
+                          &client->output[client->out_end]);
+            client->out_end += SERVER_RESPONSE_SIZE;
+            position += SERVER_HEADER_SIZE + length;
+            server->stats.requests++;
+        }
+    }
+
+    /* Keep the rest of the requests for the next read */
+    memmove(client->input, &client->input[position], client->in_used - position);
+    client->in_used -= position;
+
+    return valid;
+}
+
+/**
+ * @brief Send the responses waiting for a connection, as far as the socket takes them.
+ *
+ * @param client The connection.
+ * @return 1 if the connection is still usable, 0 if it failed.
+ */
+static int32_t Server_Send(Server_Client_t* client)
+{
+    ssize_t sent = 0;           /* Bytes taken by the socket */
+    int32_t usable = 1;         /* Cleared by an error of the socket */
+    int32_t full = 0;           /* Set once the socket takes no more bytes */
+
+    while (usable && (full == 0) && (client->out_start < client->out_end))
+    {
+        sent = send(client->fd, &client->output[client->out_start], client->out_end - client->out_start, MSG_NOSIGNAL);
+        if (sent > 0)
+        {
+            client->out_start += (uint32_t)sent;
+        }
+        else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            full = 1;
+        }
+        else if (sent < 0 && errno != EINTR)
+        {
+            usable = 0;
+        }
+    }
+
+    return usable;
+}
+
+/**
+ * @brief Close a connection and release it.
+ *
+ * @param server The server.
+ * @param client The connection.
+ */
+static void Server_Drop(Server_t* server, Server_Client_t* client)
+{
+    close(client->fd);
+    if (client->prev != NULL)
+    {
+        client->prev->next = client->next;
+    }
+    else
+    {
+        server->clients = client->next;
+    }
+    if (client->next != NULL)
+    {
+        client->next->prev = client->prev;
+    }
+    server->client_count--;
+    free(client);
+}
+
+/**
+ * @brief Read and serve the requests of a connection and send their responses.
+ *
+ * @param server The server.
+ * @param client The connection.
+ * @param events The events of the loop for the connection.
+ */
+static void Server_Serve(Server_t* server, Server_Client_t* client, uint32_t events)
+{
+    struct epoll_event event;   /* New events watched for the connection */
+    ssize_t received = 0;       /* Bytes read */
+    int32_t usable = 1;         /* Cleared once the connection must be closed */
+    int32_t serving = 1;        /* Set while another pass may serve requests */
+    uint64_t served = 0;        /* Requests served by the server before the current pass */
+
+    /* A hang-up still lets the last requests be read */
+    if ((events & EPOLLERR) || ((events & EPOLLHUP) && !(events & EPOLLIN)))
+    {
+        usable = 0;
+    }
+    if (usable && (events & EPOLLOUT))
+    {
+        usable = Server_Send(client);
+    }
+    if (usable && (events & EPOLLIN) && client->ended == 0)
+    {
+        received = recv(client->fd, &client->input[client->in_used], SERVER_INPUT_SIZE - client->in_used, 0);
+        if (received > 0)
+        {
+            client->in_used += (uint32_t)received;
+            server->stats.reads++;
+        }
+        else if (received == 0)
+        {
+            client->ended = 1;
+        }
+        else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            usable = 0;
+        }
+    }
+
+    /* Requests left by a full output are served once it drained. After its last request
+    the client sends nothing more, so the passes go on while the socket takes the responses. */
+    while (usable && serving)
+    {
+        served = server->stats.requests;
+        usable = Server_Process(server, client);
+        if (usable)
+        {
+            usable = Server_Send(client);
+        }
+        serving = (client->ended && client->out_start == client->out_end && server->stats.requests != served) ? 1 : 0;
+    }
+
+    /* The responses to the last requests are sent before the connection is closed */
+    if (usable == 0 || (client->ended && client->out_start == client->out_end))
+    {
+        Server_Drop(server, client);
+    }
+    else
+    {
+        /* Read only while a response fits and the client did not end, write only while responses wait */
+        event.events = (SERVER_OUTPUT_SIZE - (client->out_end - client->out_start) >= SERVER_RESPONSE_SIZE
+                         && client->in_used < SERVER_INPUT_SIZE && client->ended == 0) ? (uint32_t)EPOLLIN : 0U;
+        event.events |= (client->out_start < client->out_end) ? (uint32_t)EPOLLOUT : 0U;
+        event.data.ptr = client;
+        if (event.events != client->events)
+        {
+            client->events = event.events;
+            epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, client->fd, &event);
+        }
+    }
+}
+
+/**
+ * @brief Accept the connections waiting on a socket.
+ *
+ * @param server The server.
+ * @param listen_fd The listening socket.
+ */
+static void Server_Accept(Server_t* server, int listen_fd)
+{
+    struct epoll_event event;           /* Events watched for a new connection */
+    Server_Client_t* client = NULL;     /* New connection */
+    int fd = 0;                         /* Socket of the new connection */
+    int one = 1;                        /* Value of TCP_NODELAY */
+
+    fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    while (fd >= 0)
+    {
+        client = (server->client_count < SERVER_MAX_CLIENTS) ? (Server_Client_t*)malloc(sizeof(Server_Client_t)) : NULL;
+        if (client == NULL)
+        {
+            close(fd);
+            server->stats.rejected++;
+        }
+        else
+        {
+            /* Small responses are sent at once instead of waiting for more */
+            if (listen_fd == server->tcp_fd)
+            {
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            }
+            client->fd = fd;
+            client->events = EPOLLIN;
+            client->in_used = 0;
+            client->out_start = 0;
+            client->out_end = 0;
+            client->ended = 0;
+            client->prev = NULL;
+            client->next = server->clients;
+            event.events = EPOLLIN;
+            event.data.ptr = client;
+            if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+            {
+                close(fd);
+                free(client);
+                server->stats.rejected++;
+            }
+            else
+            {
+                if (server->clients != NULL)
+                {
+                    server->clients->prev = client;
+                }
+                server->clients = client;
+                server->client_count++;
+                server->stats.connections++;
+            }
+        }
+        fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    }
+}
+
+/**
+ * @brief Add a socket to the loop.
+ *
+ * @param server The server.
+ * @param fd The socket.
+ * @param tag The pointer the loop gives back for the socket.
+ * @return 1 if the socket is in the loop, 0 if not.
+ */
+static int32_t Server_Watch(Server_t* server, int fd, void* tag)
+{
+    struct epoll_event event;   /* Events watched for the socket */
+
+    event.events = EPOLLIN;
+    event.data.ptr = tag;
+
+    return (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Create the Unix domain socket of a server.
+ *
+ * @param server The server.
+ * @param path The path of the socket.
+ * @return SERVER_OK if the socket is listening, an error code if not.
+ */
+static server_status_t Server_Listen_Unix(Server_t* server, const char* path)
+{
+    struct sockaddr_un address;             /* Address of the socket */
+    struct stat status;                     /* File found at the path */
+    server_status_t result = SERVER_OK;     /* Result of the creation */
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    server->unix_path = (char*)malloc(strlen(path) + 1U);
+    if (server->unix_path == NULL)
+    {
+        result = SERVER_NO_MEMORY;
+    }
+    else if (strlen(path) >= sizeof(address.sun_path))
+    {
+        result = SERVER_IO_ERROR;
+    }
+    else
+    {
+        strcpy(server->unix_path, path);
+        strcpy(address.sun_path, path);
+        /* Only a socket left by an earlier server is removed, a mistyped path keeps its file */
+        if (lstat(path, &status) == 0 && S_ISSOCK(status.st_mode))
+        {
+            unlink(path);
+        }
+        server->unix_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        /* Without a bound socket the path is not the server's, so Server_Close() must leave it */
+        if ((server->unix_fd >= 0) && (bind(server->unix_fd, (struct sockaddr*)&address, sizeof(address)) != 0))
+        {
+            close(server->unix_fd);
+            server->unix_fd = -1;
+        }
+        if ((server->unix_fd < 0) || (listen(server->unix_fd, SERVER_BACKLOG) != 0)
+            || (Server_Watch(server, server->unix_fd, &server->unix_fd) == 0))
+        {
+            result = SERVER_IO_ERROR;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Create the TCP socket of a server on the loopback interface.
+ *
+ * @param server The server.
+ * @param port The port.
+ * @return SERVER_OK if the socket is listening, an error code if not.
+ */
+static server_status_t Server_Listen_Tcp(Server_t* server, uint16_t port)
+{
+    struct sockaddr_in address;             /* Address of the socket */
+    server_status_t result = SERVER_OK;     /* Result of the creation */
+    int one = 1;                            /* Value of SO_REUSEADDR */
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    server->tcp_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if ((server->tcp_fd < 0) || (setsockopt(server->tcp_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0)
+        || (bind(server->tcp_fd, (struct sockaddr*)&address, sizeof(address)) != 0)
+        || (listen(server->tcp_fd, SERVER_BACKLOG) != 0) || (Server_Watch(server, server->tcp_fd, &server->tcp_fd) == 0))
+    {
+        result = SERVER_IO_ERROR;
+    }
+
+    return result;
+}
+#endif
+
+/**
+ * @brief Create the sockets of a server.
+ *
+ * A socket left at the path of the Unix domain socket is removed first. Any other file
+ * there is kept and makes the opening fail.
+ *
+ * @param server The server, closed.
+ * @param config The settings of the server, at least one socket must be given.
+ * @return SERVER_OK if the server is listening, an error code if not. On error the server is closed.
+ */
+server_status_t Server_Open(Server_t* server, const Server_Config_t* config)
+{
+    server_status_t result = SERVER_UNSUPPORTED;    /* Result of the opening */
+
+    memset(server, 0, sizeof(Server_t));
+#ifdef __linux__
+    server->open = 1;
+    server->unix_fd = -1;
+    server->tcp_fd = -1;
+    server->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    server->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    result = ((server->wake_fd < 0) || (server->epoll_fd < 0) || (Server_Watch(server, server->wake_fd, &server->wake_fd) == 0)
+              || (config->unix_path == NULL && config->tcp_port == 0U)) ? SERVER_IO_ERROR : SERVER_OK;
+    if (result == SERVER_OK && config->unix_path != NULL)
+    {
+        result = Server_Listen_Unix(server, config->unix_path);
+    }
+    if (result == SERVER_OK && config->tcp_port != 0U)
+    {
+        result = Server_Listen_Tcp(server, config->tcp_port);
+    }
+    if (result != SERVER_OK)
+    {
+        Server_Close(server);
+    }
+#else
+    (void)config;
+#endif
+
+    return result;
+}
+
+/**
+ * @brief Serve the connections until Server_Stop() is called.
+ *
+ * @param server The server, open.
+ * @return SERVER_OK once stopped, SERVER_IO_ERROR if the event loop failed.
+ */
+server_status_t Server_Run(Server_t* server)
+{
+    server_status_t result = SERVER_UNSUPPORTED;    /* Result of the loop */
+#ifdef __linux__
+    struct epoll_event events[SERVER_EVENTS];       /* Events taken from the loop */
+    uint64_t wakes = 0;                             /* Value of the event of Server_Stop() */
+    int count = 0;                                  /* Number of events taken */
+    int i = 0;                                      /* Event counter */
+    int32_t running = 1;                            /* Cleared by Server_Stop() or an error */
+
+    result = SERVER_OK;
+    while (running)
+    {
+        count = epoll_wait(server->epoll_fd, events, SERVER_EVENTS, -1);
+        if (count < 0 && errno != EINTR)
+        {
+            result = SERVER_IO_ERROR;
+            running = 0;
+        }
+        for (i = 0; i < count; i++)
+        {
+            if (events[i].data.ptr == &server->wake_fd)
+            {
+                if (read(server->wake_fd, &wakes, sizeof(wakes)) == (ssize_t)sizeof(wakes))
+                {
+                    running = 0;
+                }
+            }
+            else if (events[i].data.ptr == &server->unix_fd)
+            {
+                Server_Accept(server, server->unix_fd);
+            }
+            else if (events[i].data.ptr == &server->tcp_fd)
+            {
+                Server_Accept(server, server->tcp_fd);
+            }
+            else
+            {
+                Server_Serve(server, (Server_Client_t*)events[i].data.ptr, events[i].events);
+            }
+        }
+    }
+#else
+    (void)server;
+#endif
+
+    return result;
+}
+
+/**
+ * @brief Ask Server_Run() to return.
+ *
+ * It may be called from another thread or from a signal handler.
+ *
+ * @param server The server, open.
+ */
+void Server_Stop(Server_t* server)
+{
+#ifdef __linux__
+    uint64_t one = 1;           /* Value added to the event */
+    ssize_t written = 0;        /* Result of the write, an event that is already set is enough */
+
+    if (server->open)
+    {
+        written = write(server->wake_fd, &one, sizeof(one));
+        (void)written;
+    }
+#else
+    (void)server;
+#endif
+}
+
+/**
+ * @brief Close the connections and the sockets of a server.
+ *
+ * Nothing is done for a closed server.
+ *
+ * @param server The server.
+ */
+void Server_Close(Server_t* server)
+{
+#ifdef __linux__
+    if (server->open)
+    {
+        while (server->clients != NULL)
+        {
+            Server_Drop(server, server->clients);
+        }
+        if (server->unix_fd >= 0)
+        {
+            close(server->unix_fd);
+            unlink(server->unix_path);
+        }
+        if (server->tcp_fd >= 0)
+        {
+            close(server->tcp_fd);
+        }
+        if (server->wake_fd >= 0)
+        {
+            close(server->wake_fd);
+        }
+        if (server->epoll_fd >= 0)
+        {
+            close(server->epoll_fd);
+        }
+        free(server->unix_path);
+        server->unix_path = NULL;
+        server->open = 0;
+    }
+#else
+    (void)server;
+#endif
+}
+
+/**
+ * @brief Get the message of a result of the server functions.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Server_Status_Message(server_status_t status)
+{
+    const char* message = "Unknown error";     /* Message of the result */
+
+    switch (status)
+    {
+        case SERVER_OK:
+        {
+            message = "Success";
+            break;
+        }
+        case SERVER_IO_ERROR:
+        {
+            message = "Socket cannot be created, bound or listened on";
+            break;
+        }
+        case SERVER_NO_MEMORY:
+        {
+            message = "Memory allocation failed";
+            break;
+        }
+        case SERVER_UNSUPPORTED:
+        {
+            message = "Server is only available on Linux";
+            break;
+        }
+    }
+
+    return message;
+} /* EOF */
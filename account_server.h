@@ -0,0 +1,173 @@
+/**
+ * @file account_server.h
+ * @brief This file contains the declarations of the socket server of the account list.
+ *
+ * The server lets other programs check, add, remove and search accounts without driving
+ * the menu. It listens on a Unix domain socket and, optionally, on a TCP port of the
+ * loopback interface, and serves every connection from one thread with an epoll loop.
+ * The list is only touched by that thread.
+ *
+ * Protocol, all integers little endian:
+ *
+ *      request:   uint32_t length     number of bytes after this field, 1 to SERVER_MAX_REQUEST
+ *                 uint8_t  op         server_op_t
+ *                 uint8_t  account[length - 1]
+ *
+ *      response:  uint32_t length     always 3
+ *                 uint8_t  op         op of the request
+ *                 uint8_t  status     status_enum_t of the account, CORRECT for an unknown op
+ *                 uint8_t  result     server_result_t
+ *
+ * A client may send many requests without waiting (pipelining). The responses come in the
+ * order of the requests; those of the requests read together are written together. A
+ * request with a length out of range closes the connection.
+ *
+ * The server is only available on Linux, Server_Open() fails elsewhere.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+
+#ifndef ACCOUNT_SERVER_H
+#define ACCOUNT_SERVER_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SERVER_HEADER_SIZE      4U              /* Size of the length of a message */
+#define SERVER_MAX_REQUEST      256U            /* Largest length of a request */
+#define SERVER_RESPONSE_SIZE    7U              /* Size of a response, length included */
+#define SERVER_MAX_CLIENTS      1024U           /* Connections served at once */
+#define SERVER_INPUT_SIZE       (16U * 1024U)   /* Bytes of requests read at once from a connection */
+#define SERVER_OUTPUT_SIZE      (32U * 1024U)   /* Bytes of responses waiting for a connection */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the operations of a request.
+ */
+typedef enum
+{
+    SERVER_CHECK = 'C',         /* Check the account. */
+    SERVER_ADD = 'A',           /* Add the account. */
+    SERVER_REMOVE = 'R',        /* Remove the account. */
+    SERVER_SEARCH = 'S'         /* Search the account. */
+} server_op_t;
+
+/**
+ * @brief Enumeration for the result of a request.
+ */
+typedef enum
+{
+    SERVER_NO = 0,              /* Invalid account, already in the list, not removed or not found. */
+    SERVER_YES = 1,             /* Valid account, added, removed or found. */
+    SERVER_FAILED = 2,          /* Memory allocation failed. */
+    SERVER_BAD_REQUEST = 3      /* Unknown op. */
+} server_result_t;
+
+/**
+ * @brief Enumeration for the results of the server functions.
+ */
+typedef enum
+{
+    SERVER_OK,                  /* The operation succeeded. */
+    SERVER_IO_ERROR,            /* A socket cannot be created, bound or listened on. */
+    SERVER_NO_MEMORY,           /* Memory allocation failed. */
+    SERVER_UNSUPPORTED          /* The server is not available on this system. */
+} server_status_t;
+
+/**
+ * @brief Structure for the settings of a server.
+ */
+typedef struct
+{
+    const char* unix_path;      /* Path of the Unix domain socket, NULL for none. */
+    uint16_t tcp_port;          /* TCP port on 127.0.0.1, 0 for none. */
+} Server_Config_t;
+
+/**
+ * @brief Structure for the counters of a server.
+ */
+typedef struct
+{
+    uint64_t connections;       /* Connections accepted. */
+    uint64_t rejected;          /* Connections closed at once because SERVER_MAX_CLIENTS were open. */
+    uint64_t requests;          /* Requests served. */
+    uint64_t reads;             /* Reads of requests, each one answered by one batch of responses. */
+    uint64_t protocol_errors;   /* Connections closed for a length out of range. */
+} Server_Stats_t;
+
+/**
+ * @brief Structure for a server.
+ *
+ * A zero-initialized structure is a closed server.
+ */
+typedef struct
+{
+    int32_t open;                       /* Set while the sockets exist. */
+    int epoll_fd;                       /* The event loop. */
+    int unix_fd;                        /* Unix domain socket, -1 if not used. */
+    int tcp_fd;                         /* TCP socket, -1 if not used. */
+    int wake_fd;                        /* Event written by Server_Stop(). */
+    char* unix_path;                    /* Path of the Unix domain socket, removed by Server_Close(). */
+    struct Server_Client* clients;      /* Open connections. */
+    uint32_t client_count;              /* Number of open connections. */
+    Server_Stats_t stats;               /* Counters of the server. */
+} Server_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Create the sockets of a server.
+ *
+ * A socket left at the path of the Unix domain socket is removed first. Any other file
+ * there is kept and makes the opening fail.
+ *
+ * @param server The server, closed.
+ * @param config The settings of the server, at least one socket must be given.
+ * @return SERVER_OK if the server is listening, an error code if not. On error the server is closed.
+ */
+server_status_t Server_Open(Server_t* server, const Server_Config_t* config);
+
+/**
+ * @brief Serve the connections until Server_Stop() is called.
+ *
+ * @param server The server, open.
+ * @return SERVER_OK once stopped, SERVER_IO_ERROR if the event loop failed.
+ */
+server_status_t Server_Run(Server_t* server);
+
+/**
+ * @brief Ask Server_Run() to return.
+ *
+ * It may be called from another thread or from a signal handler.
+ *
+ * @param server The server, open.
+ */
+void Server_Stop(Server_t* server);
+
+/**
+ * @brief Close the connections and the sockets of a server.
+ *
+ * Nothing is done for a closed server.
+ *
+ * @param server The server.
+ */
+void Server_Close(Server_t* server);
+
+/**
+ * @brief Get the message of a result of the server functions.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Server_Status_Message(server_status_t status);
+
+#endif /* ACCOUNT_SERVER_H */
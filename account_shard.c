@@ -0,0 +1,410 @@
+/**
+ * @file account_shard.c
+ * @brief This file contains the implementation of the sharded concurrent account store.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdlib.h>             /* For calloc(), malloc(), free() */
+#include "account_key.h"        /* For Account_Key_Hash(), ACCOUNT_KEY_NONE */
+#include "account_epoch.h"      /* For the reclamation of the old tables */
+#include "account_shard.h"      /* Include header file of this function file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SHARD_EMPTY             0U                  /* Value of an empty slot, a slot holds its key plus one */
+#define SHARD_TOMBSTONE         ACCOUNT_KEY_NONE    /* Value of a removed entry */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Select the shard of a key.
+ *
+ * The top bits of the hash select the shard and the low bits the slot, so the keys
+ * of a shard are still spread over its whole table.
+ *
+ * @param store The store.
+ * @param hash The hash of the key.
+ * @return The shard of the key.
+ */
+static Shard_t* Shard_Of(Shard_Store_t* store, uint64_t hash)
+{
+    return &store->shards[hash >> (64U - SHARD_BITS)];
+}
+
+/**
+ * @brief Look for a key in a table.
+ *
+ * Every slot is read with an atomic load, so the table may be changed by a writer
+ * at the same time.
+ *
+ * @param table The table, may be NULL.
+ * @param value The key plus one.
+ * @param hash The hash of the key.
+ * @return 1 if the key is in the table, 0 if not.
+ */
+static int32_t Shard_Table_Find(Shard_Table_t* table, uint64_t value, uint64_t hash)
+{
+    int32_t found = 0;          /* Result of the search */
+    int32_t searching = 1;      /* Cleared when an empty slot ends the probe sequence */
+    uint64_t i = 0;             /* Current slot */
+    uint64_t slot = 0;          /* Key of the current slot */
+
+    if (table == NULL)
+    {
+        searching = 0;
+    }
+    else
+    {
+        i = hash & table->mask;
+    }
+
+    /* A table is never full, so an empty slot always ends the probe sequence */
+    while (searching)
+    {
+        slot = atomic_load_explicit(&table->slots[i], memory_order_acquire);
+        if (slot == value)
+        {
+            found = 1;
+            searching = 0;
+        }
+        else if (slot == SHARD_EMPTY)
+        {
+            searching = 0;
+        }
+        i = (i + 1U) & table->mask;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Build a table holding the live entries of another one.
+ *
+ * The lock of the shard must be held.
+ *
+ * @param old The table to copy, may be NULL.
+ * @param slots The number of slots of the new table, a power of 2.
+ * @return The new table, NULL if memory allocation failed.
+ */
+static Shard_Table_t* Shard_Table_Build(Shard_Table_t* old, uint64_t slots)
+{
+    Shard_Table_t* table;       /* The new table */
+    uint64_t i = 0;             /* Slot counter of the old table */
+    uint64_t j = 0;             /* Slot of an entry in the new table */
+    uint64_t value = 0;         /* Key plus one of the current entry */
+
+    /* calloc() leaves every slot empty */
+    table = (Shard_Table_t*)calloc(1U, sizeof(Shard_Table_t) + (size_t)slots * sizeof(uint64_t));
+    if (table != NULL)
+    {
+        table->mask = slots - 1U;
+        for (i = 0; (old != NULL) && (i <= old->mask); i++)
+        {
+            value = atomic_load_explicit(&old->slots[i], memory_order_relaxed);
+            if (value != SHARD_EMPTY && value != SHARD_TOMBSTONE)
+            {
+                j = Account_Key_Hash(value - 1U) & table->mask;
+                while (atomic_load_explicit(&table->slots[j], memory_order_relaxed) != SHARD_EMPTY)
+                {
+                    j = (j + 1U) & table->mask;
+                }
+                atomic_store_explicit(&table->slots[j], value, memory_order_relaxed);
+                table->used++;
+            }
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief Initialize an empty store.
+ *
+ * @param store The store.
+ */
+void Shard_Store_Init(Shard_Store_t* store)
+{
+    uint32_t i = 0;             /* Shard counter */
+
+    for (i = 0; i < SHARD_COUNT; i++)
+    {
+        pthread_mutex_init(&store->shards[i].lock, NULL);
+        atomic_init(&store->shards[i].table, NULL);
+        atomic_init(&store->shards[i].count, 0U);
+    }
+    store->memory = NULL;
+}
+
+/**
+ * @brief Release all the memory of a store.
+ *
+ * No other thread may use the store during or after this call.
+ *
+ * @param store The store.
+ */
+void Shard_Store_Destroy(Shard_Store_t* store)
+{
+    uint32_t i = 0;             /* Shard counter */
+
+    /* Free the tables replaced by earlier inserts */
+    Epoch_Flush();
+
+    for (i = 0; i < SHARD_COUNT; i++)
+    {
+        free(atomic_load(&store->shards[i].table));
+        atomic_store(&store->shards[i].table, NULL);
+        atomic_store(&store->shards[i].count, 0U);
+        pthread_mutex_destroy(&store->shards[i].lock);
+    }
+}
+
+/**
+ * @brief Allocate and initialize an empty store.
+ *
+ * @return The store, NULL if memory allocation failed.
+ */
+Shard_Store_t* Shard_Store_Create(void)
+{
+    Shard_Store_t* store = NULL;    /* The new store */
+    void* memory = NULL;            /* Memory block of the store */
+
+    /* Allocate one extra cache line so the shards can be aligned */
+    memory = malloc(sizeof(Shard_Store_t) + SHARD_CACHE_LINE);
+    if (memory != NULL)
+    {
+        store = (Shard_Store_t*)(((uintptr_t)memory + SHARD_CACHE_LINE - 1U) & ~(uintptr_t)(SHARD_CACHE_LINE - 1U));
+        Shard_Store_Init(store);
+        store->memory = memory;
+    }
+
+    return store;
+}
+
+/**
+ * @brief Release a store made by Shard_Store_Create() and all its memory.
+ *
+ * Unlike Shard_Store_Destroy() it does not wait for the readers, so once the store
+ * can no longer be reached it can be handed to Epoch_Retire().
+ *
+ * @param store The store, a Shard_Store_t*. May be NULL.
+ */
+void Shard_Store_Free(void* store)
+{
+    Shard_Store_t* shards = (Shard_Store_t*)store;  /* The store */
+    uint32_t i = 0;                                 /* Shard counter */
+
+    if (shards != NULL)
+    {
+        /* The tables replaced earlier were handed to Epoch_Retire() already */
+        for (i = 0; i < SHARD_COUNT; i++)
+        {
+            free(atomic_load(&shards->shards[i].table));
+            pthread_mutex_destroy(&shards->shards[i].lock);
+        }
+        free(shards->memory);
+    }
+}
+
+/**
+ * @brief Check if an account is in the store, without taking any lock.
+ *
+ * Any number of threads may call it at once, also while other threads write.
+ *
+ * @param store The store.
+ * @param key The key of the account, ACCOUNT_KEY_NONE is never in the store.
+ * @return 1 if the account is in the store, 0 if not.
+ */
+int32_t Shard_Contains(Shard_Store_t* store, uint64_t key)
+{
+    int32_t found = 0;                          /* Result of the search */
+    uint64_t hash = Account_Key_Hash(key);      /* Hash of the key */
+    Shard_t* shard = Shard_Of(store, hash);     /* Shard of the key */
+
+    if (key == ACCOUNT_KEY_NONE)
+    {
+        found = 0;
+    }
+    else
+    {
+        /* The table cannot be freed before Epoch_Exit() */
+        Epoch_Enter();
+        found = Shard_Table_Find(atomic_load_explicit(&shard->table, memory_order_acquire), key + 1U, hash);
+        Epoch_Exit();
+    }
+
+    return found;
+}
+
+/**
+ * @brief Add an account to the store.
+ *
+ * @param store The store.
+ * @param key The key of the account, as produced by Check_Account_Key(). ACCOUNT_KEY_NONE is
+ * never added.
+ * @return 1 if the account is added, 0 if it is already in the store or is ACCOUNT_KEY_NONE,
+ * -1 if memory allocation failed.
+ */
+int32_t Shard_Insert(Shard_Store_t* store, uint64_t key)
+{
+    int32_t result = (key != ACCOUNT_KEY_NONE) ? 1 : 0;    /* Result of the insertion */
+    int32_t searching = 1;                      /* Cleared at the end of the probe sequence */
+    uint64_t hash = Account_Key_Hash(key);      /* Hash of the key */
+    Shard_t* shard = Shard_Of(store, hash);     /* Shard of the key */
+    Shard_Table_t* table = NULL;                /* Current table of the shard */
+    Shard_Table_t* grown = NULL;                /* Table replacing the current one */
+    uint64_t slots = SHARD_MIN_SLOTS;           /* Number of slots of a new table */
+    uint64_t free_slot = UINT64_MAX;            /* First empty or removed slot of the probe sequence */
+    uint64_t slot = 0;                          /* Key of the current slot */
+    uint64_t i = 0;                             /* Current slot */
+
+    pthread_mutex_lock(&shard->lock);
+    table = atomic_load_explicit(&shard->table, memory_order_relaxed);
+
+    /* Rebuild when live entries and tombstones fill three quarters of the slots */
+    if (result == 1 && (table == NULL || (table->used + table->tombstones + 1U) * 4U > (table->mask + 1U) * 3U))
+    {
+        if (table != NULL)
+        {
+            /* Double the table if live entries fill half of it, otherwise only drop the tombstones */
+            slots = table->mask + 1U;
+            if ((table->used + 1U) * 2U > slots)
+            {
+                slots *= 2U;
+            }
+        }
+        grown = Shard_Table_Build(table, slots);
+        if (grown == NULL)
+        {
+            result = -1;
+        }
+        else
+        {
+            /* Readers move to the new table, the old one is freed once they have left it */
+            atomic_store_explicit(&shard->table, grown, memory_order_release);
+            if (table != NULL)
+            {
+                Epoch_Retire(table, free);
+            }
+            table = grown;
+        }
+    }
+
+    if (result == 1)
+    {
+        i = hash & table->mask;
+        while (searching)
+        {
+            slot = atomic_load_explicit(&table->slots[i], memory_order_relaxed);
+            if (slot == key + 1U)
+            {
+                result = 0;
+                searching = 0;
+            }
+            else
+            {
+                /* Remember the first slot the key can take */
+                if ((slot == SHARD_TOMBSTONE || slot == SHARD_EMPTY) && free_slot == UINT64_MAX)
+                {
+                    free_slot = i;
+                }
+                searching = (slot != SHARD_EMPTY);
+            }
+            i = (i + 1U) & table->mask;
+        }
+    }
+
+    if (result == 1)
+    {
+        if (atomic_load_explicit(&table->slots[free_slot], memory_order_relaxed) == SHARD_TOMBSTONE)
+        {
+            table->tombstones--;
+        }
+        table->used++;
+        /* Publish the key last, readers see either no entry or the whole entry */
+        atomic_store_explicit(&table->slots[free_slot], key + 1U, memory_order_release);
+        atomic_fetch_add_explicit(&shard->count, 1U, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    return result;
+}
+
+/**
+ * @brief Remove an account from the store.
+ *
+ * @param store The store.
+ * @param key The key of the account.
+ * @return 1 if the account is removed, 0 if it is not in the store.
+ */
+int32_t Shard_Remove(Shard_Store_t* store, uint64_t key)
+{
+    int32_t result = 0;                         /* Result of the removal */
+    int32_t searching = 1;                      /* Cleared at the end of the probe sequence */
+    uint64_t hash = Account_Key_Hash(key);      /* Hash of the key */
+    Shard_t* shard = Shard_Of(store, hash);     /* Shard of the key */
+    Shard_Table_t* table = NULL;                /* Current table of the shard */
+    uint64_t slot = 0;                          /* Key of the current slot */
+    uint64_t i = 0;                             /* Current slot */
+
+    pthread_mutex_lock(&shard->lock);
+    table = atomic_load_explicit(&shard->table, memory_order_relaxed);
+    if (table == NULL || key == ACCOUNT_KEY_NONE)
+    {
+        searching = 0;
+    }
+    else
+    {
+        i = hash & table->mask;
+    }
+
+    while (searching)
+    {
+        slot = atomic_load_explicit(&table->slots[i], memory_order_relaxed);
+        if (slot == key + 1U)
+        {
+            /* Keep the probe sequence intact for the entries placed after this one */
+            atomic_store_explicit(&table->slots[i], SHARD_TOMBSTONE, memory_order_release);
+            table->used--;
+            table->tombstones++;
+            atomic_fetch_sub_explicit(&shard->count, 1U, memory_order_relaxed);
+            result = 1;
+            searching = 0;
+        }
+        else if (slot == SHARD_EMPTY)
+        {
+            searching = 0;
+        }
+        i = (i + 1U) & table->mask;
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    return result;
+}
+
+/**
+ * @brief Count the accounts of the store.
+ *
+ * The result is exact only when no other thread writes.
+ *
+ * @param store The store.
+ * @return The number of accounts.
+ */
+uint64_t Shard_Count(Shard_Store_t* store)
+{
+    uint64_t count = 0;         /* Sum of the shards */
+    uint32_t i = 0;             /* Shard counter */
+
+    for (i = 0; i < SHARD_COUNT; i++)
+    {
+        count += atomic_load_explicit(&store->shards[i].count, memory_order_relaxed);
+    }
+
+    return count;
+} /* EOF */
@@ -0,0 +1,149 @@
+/**
+ * @file account_shard.h
+ * @brief This file contains the declarations of the sharded concurrent account store.
+ *
+ * The store spreads the accounts over SHARD_COUNT shards chosen by the hash of the key.
+ * Each shard is an open-addressing table of keys. Lookups take no lock: they read the
+ * table of the shard inside an epoch read section (see account_epoch.h) and compare
+ * the keys with atomic loads. Writers take the lock of their shard only, so writers
+ * of different shards do not wait for each other. A table that must grow is rebuilt
+ * beside the old one, published with one atomic store, and the old table is freed
+ * once no reader can see it.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include <stdatomic.h>          /* For the slots shared with the readers */
+#include <pthread.h>            /* For the locks of the shards */
+
+#ifndef ACCOUNT_SHARD_H
+#define ACCOUNT_SHARD_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SHARD_BITS              6U                  /* Number of bits of the hash that select the shard */
+#define SHARD_COUNT             (1U << SHARD_BITS)  /* Number of shards */
+#define SHARD_MIN_SLOTS         64U                 /* Slots of the table of a shard on first insert */
+#define SHARD_CACHE_LINE        64U                 /* Each shard starts on its own cache line */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for the table of a shard.
+ *
+ * A slot holds the key of its entry plus one, so an empty slot holds 0 and the key 0
+ * of the empty account can be stored. A removed entry holds ACCOUNT_KEY_NONE, which no
+ * key plus one reaches since the keys use 60 bits.
+ */
+typedef struct
+{
+    uint64_t mask;              /* Number of slots minus one, the number of slots is a power of 2. */
+    uint64_t used;              /* Number of live entries, changed under the lock of the shard. */
+    uint64_t tombstones;        /* Number of removed entries, changed under the lock of the shard. */
+    _Atomic uint64_t slots[];   /* Keys of the entries. */
+} Shard_Table_t;
+
+/**
+ * @brief Structure for a shard.
+ */
+typedef struct
+{
+    _Alignas(SHARD_CACHE_LINE) pthread_mutex_t lock;    /* Taken by the writers of the shard. */
+    Shard_Table_t* _Atomic table;                       /* Current table, NULL before the first insert. */
+    _Atomic uint64_t count;                             /* Number of accounts in the shard. */
+} Shard_t;
+
+/**
+ * @brief Structure for the sharded store.
+ */
+typedef struct
+{
+    Shard_t shards[SHARD_COUNT];    /* The shards, selected by the top bits of the hash of a key. */
+    void* memory;                   /* Memory block returned by malloc() for Shard_Store_Create(), NULL otherwise. */
+} Shard_Store_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Initialize an empty store.
+ *
+ * @param store The store.
+ */
+void Shard_Store_Init(Shard_Store_t* store);
+
+/**
+ * @brief Release all the memory of a store.
+ *
+ * No other thread may use the store during or after this call.
+ *
+ * @param store The store.
+ */
+void Shard_Store_Destroy(Shard_Store_t* store);
+
+/**
+ * @brief Allocate and initialize an empty store.
+ *
+ * @return The store, NULL if memory allocation failed.
+ */
+Shard_Store_t* Shard_Store_Create(void);
+
+/**
+ * @brief Release a store made by Shard_Store_Create() and all its memory.
+ *
+ * Unlike Shard_Store_Destroy() it does not wait for the readers, so once the store
+ * can no longer be reached it can be handed to Epoch_Retire().
+ *
+ * @param store The store, a Shard_Store_t*. May be NULL.
+ */
+void Shard_Store_Free(void* store);
+
+/**
+ * @brief Check if an account is in the store, without taking any lock.
+ *
+ * Any number of threads may call it at once, also while other threads write.
+ *
+ * @param store The store.
+ * @param key The key of the account, ACCOUNT_KEY_NONE is never in the store.
+ * @return 1 if the account is in the store, 0 if not.
+ */
+int32_t Shard_Contains(Shard_Store_t* store, uint64_t key);
+
+/**
+ * @brief Add an account to the store.
+ *
+ * @param store The store.
+ * @param key The key of the account, as produced by Check_Account_Key(). ACCOUNT_KEY_NONE is
+ * never added.
+ * @return 1 if the account is added, 0 if it is already in the store or is ACCOUNT_KEY_NONE,
+ * -1 if memory allocation failed.
+ */
+int32_t Shard_Insert(Shard_Store_t* store, uint64_t key);
+
+/**
+ * @brief Remove an account from the store.
+ *
+ * @param store The store.
+ * @param key The key of the account.
+ * @return 1 if the account is removed, 0 if it is not in the store.
+ */
+int32_t Shard_Remove(Shard_Store_t* store, uint64_t key);
+
+/**
+ * @brief Count the accounts of the store.
+ *
+ * The result is exact only when no other thread writes.
+ *
+ * @param store The store.
+ * @return The number of accounts.
+ */
+uint64_t Shard_Count(Shard_Store_t* store);
+
+#endif /* ACCOUNT_SHARD_H */
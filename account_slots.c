@@ -0,0 +1,292 @@
+/**
+ * @file account_slots.c
+ * @brief This file contains the implementation of the slot array holding the accounts of a store.
+ *
+ * The three arrays share one memory block, the keys first so they start on a 16-byte
+ * boundary and the slots last so they stay 8-byte aligned. Every slot gets a new generation from the same counter each time it is
+ * handed out again, so no two handles of an array are ever equal.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "account_slots.h"      /* Include header file of this function file */
+#include "account_key.h"        /* For ACCOUNT_KEY_NONE */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SLOTS_ALIGNMENT         16U     /* Alignment of the arrays */
+#define SLOTS_RECORD_BYTES      (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(Slot_t))  /* Bytes of a record and its slot */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Take the next generation of the array.
+ *
+ * 0 is skipped, so ACCOUNT_HANDLE_NONE never matches a slot.
+ *
+ * @param map The array.
+ * @return The generation.
+ */
+static uint32_t Slots_Next_Generation(Slot_Map_t* map)
+{
+    map->newest_generation = (map->newest_generation == UINT32_MAX) ? 1U : map->newest_generation + 1U;
+    return map->newest_generation;
+}
+
+/**
+ * @brief Move the arrays into a larger memory block.
+ *
+ * @param map The array.
+ * @param count The number of records the arrays must hold.
+ * @return 1 if the arrays can hold them, 0 if memory allocation failed.
+ */
+static int32_t Slots_Grow(Slot_Map_t* map, uint64_t count)
+{
+    int32_t result = 1;         /* Result of the growth */
+    uint64_t capacity = (map->capacity == 0U) ? SLOTS_MIN_CAPACITY : map->capacity;  /* New capacity */
+    void* memory = NULL;        /* Memory block of the new arrays */
+    uint64_t* keys = NULL;      /* New array of the keys */
+
+    while (capacity < count)
+    {
+        capacity *= 2U;
+    }
+    if (capacity > SLOTS_MAX_CAPACITY || capacity > (SIZE_MAX - SLOTS_ALIGNMENT) / SLOTS_RECORD_BYTES)
+    {
+        result = 0;
+    }
+    else if (capacity > map->capacity)
+    {
+        /* Allocate a little more so the keys can be aligned */
+        memory = malloc((size_t)capacity * SLOTS_RECORD_BYTES + SLOTS_ALIGNMENT);
+        if (memory == NULL)
+        {
+            result = 0;
+        }
+        else
+        {
+            keys = (uint64_t*)(((uintptr_t)memory + SLOTS_ALIGNMENT - 1U) & ~(uintptr_t)(SLOTS_ALIGNMENT - 1U));
+            if (map->memory != NULL)
+            {
+                memcpy(keys, map->keys, (size_t)map->records * sizeof(uint64_t));
+                memcpy(keys + capacity, map->owner, (size_t)map->records * sizeof(uint32_t));
+                /* The capacity is a power of two, the slots are 8-byte aligned */
+                memcpy((uint32_t*)(keys + capacity) + capacity, map->slot, (size_t)map->slots * sizeof(Slot_t));
+            }
+            free(map->memory);
+            map->memory = memory;
+            map->keys = keys;
+            map->owner = (uint32_t*)(keys + capacity);
+            map->slot = (Slot_t*)(map->owner + capacity);
+            map->capacity = (uint32_t)capacity;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Move the live records down over the removed ones, keeping their order.
+ *
+ * @param map The array.
+ */
+static void Slots_Compact(Slot_Map_t* map)
+{
+    uint32_t next = 0;          /* Next place of a live record */
+    uint32_t r = 0;             /* Record counter */
+
+    for (r = 0; r < map->records; r++)
+    {
+        if (map->keys[r] != ACCOUNT_KEY_NONE)
+        {
+            map->keys[next] = map->keys[r];
+            map->owner[next] = map->owner[r];
+            /* The handles name the slot, only the slot has to follow the record */
+            map->slot[map->owner[next]].place = next;
+            next++;
+        }
+    }
+    map->records = next;
+}
+
+/**
+ * @brief Append an account to the array.
+ *
+ * @param map The array.
+ * @param key The key of the account.
+ * @param handle Output, the handle of the account.
+ * @return 1 if the account is added, 0 if memory allocation failed.
+ */
+int32_t Slots_Add(Slot_Map_t* map, uint64_t key, account_handle_t* handle)
+{
+    int32_t result = 1;         /* Result of the addition */
+    uint32_t slot = 0;          /* Slot of the account */
+
+    /* A full array is compacted rather than grown when an eighth of it is removed records */
+    if (map->records == map->capacity && map->records - map->live >= map->capacity / 8U && map->live < map->records)
+    {
+        Slots_Compact(map);
+    }
+    else if (map->records == map->capacity)
+    {
+        result = Slots_Grow(map, (uint64_t)map->records + 1U);
+    }
+
+    if (result == 1)
+    {
+        /* A free slot already has its new generation */
+        if (map->free_slot != 0U)
+        {
+            slot = map->free_slot - 1U;
+            map->free_slot = map->slot[slot].place;
+        }
+        else
+        {
+            slot = map->slots;
+            map->slots++;
+            map->slot[slot].generation = Slots_Next_Generation(map);
+        }
+        map->keys[map->records] = key;
+        map->owner[map->records] = slot;
+        map->slot[slot].place = map->records;
+        map->records++;
+        map->live++;
+        *handle = ((uint64_t)map->slot[slot].generation << 32) | slot;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Remove the account of a handle from the array.
+ *
+ * @param map The array.
+ * @param handle The handle of the account.
+ * @return The key of the account, ACCOUNT_KEY_NONE if the handle is stale.
+ */
+uint64_t Slots_Remove(Slot_Map_t* map, account_handle_t handle)
+{
+    uint64_t key = Slots_Get(map, handle);  /* Key of the account */
+    uint32_t slot = (uint32_t)handle;       /* Slot of the account */
+
+    if (key != ACCOUNT_KEY_NONE)
+    {
+        map->keys[map->slot[slot].place] = ACCOUNT_KEY_NONE;
+        /* The new generation makes every copy of the handle stale */
+        map->slot[slot].generation = Slots_Next_Generation(map);
+        map->slot[slot].place = map->free_slot;
+        map->free_slot = slot + 1U;
+        map->live--;
+
+        /* Removed records at the end are dropped at once, the others once they outnumber the live ones */
+        while (map->records > 0U && map->keys[map->records - 1U] == ACCOUNT_KEY_NONE)
+        {
+            map->records--;
+        }
+        if (map->records - map->live >= SLOTS_MIN_COMPACT && map->records - map->live > map->live)
+        {
+            Slots_Compact(map);
+        }
+    }
+
+    return key;
+}
+
+/**
+ * @brief Get the key of the account of a handle.
+ *
+ * @param map The array.
+ * @param handle The handle of the account.
+ * @return The key of the account, ACCOUNT_KEY_NONE if the handle is stale.
+ */
+uint64_t Slots_Get(const Slot_Map_t* map, account_handle_t handle)
+{
+    uint64_t key = ACCOUNT_KEY_NONE;        /* Key of the account */
+    uint32_t slot = (uint32_t)handle;       /* Slot of the account */
+
+    if (slot < map->slots && map->slot[slot].generation == (uint32_t)(handle >> 32))
+    {
+        key = map->keys[map->slot[slot].place];
+    }
+
+    return key;
+}
+
+/**
+ * @brief Start loading the slot of a handle, or its record, into the cache.
+ *
+ * A batch first prefetches the slots of all its handles, then their records, which
+ * can only be found once the slot is in the cache.
+ *
+ * @param map The array.
+ * @param handle The handle of an account about to be removed, may be ACCOUNT_HANDLE_NONE.
+ * @param record 0 for the slot, 1 for the record.
+ */
+void Slots_Prefetch(const Slot_Map_t* map, account_handle_t handle, int32_t record)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    uint32_t slot = (uint32_t)handle;       /* Slot of the account */
+
+    if (slot < map->slots && record == 0)
+    {
+        __builtin_prefetch(&map->slot[slot], 1, 1);
+    }
+    else if (slot < map->slots && map->slot[slot].place < map->records)
+    {
+        __builtin_prefetch(&map->keys[map->slot[slot].place], 1, 1);
+    }
+#else
+    (void)map;
+    (void)handle;
+    (void)record;
+#endif
+}
+
+/**
+ * @brief Make room in the array for a number of accounts.
+ *
+ * @param map The array.
+ * @param count The number of accounts the array will hold.
+ * @return 1 if the array can hold them, 0 if memory allocation failed.
+ */
+int32_t Slots_Reserve(Slot_Map_t* map, uint32_t count)
+{
+    /* The removed records still in the array take room as well */
+    return Slots_Grow(map, (uint64_t)count + (map->records - map->live));
+}
+
+/**
+ * @brief Get the usage statistics of the array.
+ *
+ * @param map The array.
+ * @param stats Output, the usage statistics.
+ */
+void Slots_Get_Stats(const Slot_Map_t* map, Pool_Stats_t* stats)
+{
+    stats->live = map->live;
+    stats->free = map->capacity - map->live;
+    stats->capacity = map->capacity;
+}
+
+/**
+ * @brief Release the memory of the array.
+ *
+ * Every handle of the array becomes stale, and the handles given afterwards never
+ * match one given before. The array is left empty and can be reused.
+ *
+ * @param map The array.
+ */
+void Slots_Destroy(Slot_Map_t* map)
+{
+    uint32_t newest = map->newest_generation;   /* Generations go on from here */
+
+    free(map->memory);
+    memset(map, 0, sizeof(Slot_Map_t));
+    map->newest_generation = newest;
+} /* EOF */
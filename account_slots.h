@@ -0,0 +1,138 @@
+/**
+ * @file account_slots.h
+ * @brief This file contains the declarations of the slot array holding the accounts of a store.
+ *
+ * The accounts are kept as structure of arrays: the keys in one 16-byte aligned array in
+ * the order they were added, the slot of each record next to it, and the record and
+ * generation of each slot side by side in a third array, so checking a handle loads a
+ * single cache line before the key. A handle names a slot, so it stays valid
+ * when the records move, and carries the generation of the slot, so a handle of a
+ * removed account is rejected in O(1).
+ *
+ * A removed record keeps its place with ACCOUNT_KEY_NONE as key until the removed
+ * records outnumber the live ones, or the array is full and an eighth of it is removed
+ * records; the live records are then moved down in order, so a full scan always reads
+ * a mostly live, contiguous array and churn does not grow it.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include "account_manage.h"     /* For account_handle_t and Pool_Stats_t */
+
+#ifndef ACCOUNT_SLOTS_H
+#define ACCOUNT_SLOTS_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SLOTS_MIN_CAPACITY      1024U   /* Records allocated with the first account */
+#define SLOTS_MAX_CAPACITY      (1U << 31)  /* Largest number of records */
+#define SLOTS_MIN_COMPACT       64U     /* Removed records kept before the array is compacted */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for a slot of the slot array.
+ */
+typedef struct
+{
+    uint32_t place;             /* Record of the slot in use, next free slot plus one of a free one. */
+    uint32_t generation;        /* Generation of the slot. */
+} Slot_t;
+
+/**
+ * @brief Structure for the slot array.
+ *
+ * A zero-initialized structure is a valid empty array.
+ */
+typedef struct
+{
+    void* memory;               /* Memory block returned by malloc(), holding every array. */
+    uint64_t* keys;             /* Key of each record in order of addition, ACCOUNT_KEY_NONE once removed. */
+    uint32_t* owner;            /* Slot of each record. */
+    Slot_t* slot;               /* Record and generation of each slot. */
+    uint32_t records;           /* Records in use, live or removed. */
+    uint32_t live;              /* Records holding an account. */
+    uint32_t slots;             /* Slots handed out so far. */
+    uint32_t capacity;          /* Records, and slots, the arrays can hold. */
+    uint32_t free_slot;         /* First free slot plus one, 0 if none. */
+    uint32_t newest_generation; /* Last generation given to a slot, kept when the array is emptied. */
+} Slot_Map_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Append an account to the array.
+ *
+ * @param map The array.
+ * @param key The key of the account.
+ * @param handle Output, the handle of the account.
+ * @return 1 if the account is added, 0 if memory allocation failed.
+ */
+int32_t Slots_Add(Slot_Map_t* map, uint64_t key, account_handle_t* handle);
+
+/**
+ * @brief Remove the account of a handle from the array.
+ *
+ * @param map The array.
+ * @param handle The handle of the account.
+ * @return The key of the account, ACCOUNT_KEY_NONE if the handle is stale.
+ */
+uint64_t Slots_Remove(Slot_Map_t* map, account_handle_t handle);
+
+/**
+ * @brief Get the key of the account of a handle.
+ *
+ * @param map The array.
+ * @param handle The handle of the account.
+ * @return The key of the account, ACCOUNT_KEY_NONE if the handle is stale.
+ */
+uint64_t Slots_Get(const Slot_Map_t* map, account_handle_t handle);
+
+/**
+ * @brief Start loading the slot of a handle, or its record, into the cache.
+ *
+ * A batch first prefetches the slots of all its handles, then their records, which
+ * can only be found once the slot is in the cache.
+ *
+ * @param map The array.
+ * @param handle The handle of an account about to be removed, may be ACCOUNT_HANDLE_NONE.
+ * @param record 0 for the slot, 1 for the record.
+ */
+void Slots_Prefetch(const Slot_Map_t* map, account_handle_t handle, int32_t record);
+
+/**
+ * @brief Make room in the array for a number of accounts.
+ *
+ * @param map The array.
+ * @param count The number of accounts the array will hold.
+ * @return 1 if the array can hold them, 0 if memory allocation failed.
+ */
+int32_t Slots_Reserve(Slot_Map_t* map, uint32_t count);
+
+/**
+ * @brief Get the usage statistics of the array.
+ *
+ * @param map The array.
+ * @param stats Output, the usage statistics.
+ */
+void Slots_Get_Stats(const Slot_Map_t* map, Pool_Stats_t* stats);
+
+/**
+ * @brief Release the memory of the array.
+ *
+ * Every handle of the array becomes stale, and the handles given afterwards never
+ * match one given before. The array is left empty and can be reused.
+ *
+ * @param map The array.
+ */
+void Slots_Destroy(Slot_Map_t* map);
+
+#endif /* ACCOUNT_SLOTS_H */
@@ -0,0 +1,459 @@
+/**
+ * @file account_snapshot.c
+ * @brief This file contains the implementation of the on-disk snapshot of the account list.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdio.h>              /* For fopen(), fwrite(), rename() */
+#include <stdlib.h>             /* For malloc(), calloc() */
+#include <string.h>             /* For memcmp(), memcpy() */
+#include <stddef.h>             /* For offsetof() */
+#ifdef _WIN32
+#include <windows.h>            /* For CreateFileMapping(), MapViewOfFile() */
+#include <io.h>                 /* For _commit() */
+#else
+#include <fcntl.h>              /* For open() */
+#include <sys/mman.h>           /* For mmap() */
+#include <sys/stat.h>           /* For fstat() */
+#include <unistd.h>             /* For close(), fsync() */
+#endif
+#include "account_key.h"        /* For Account_Key_Hash() */
+#include "account_snapshot.h"   /* Include header file of this function file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SNAPSHOT_MIN_SLOTS      16U                     /* Smallest index, keeps its size a multiple of 8 bytes */
+#define SNAPSHOT_MAX_SLOTS      (1ULL << 32)            /* Largest index, its slots hold 32-bit positions */
+#define SNAPSHOT_SEED           0x9E3779B97F4A7C15ULL   /* Initial value of the checksums */
+#define SNAPSHOT_PRIME          0x100000001B3ULL        /* Multiplier of the checksums */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Compute the checksum of a block of 8-byte words.
+ *
+ * Four independent lanes are updated in turn so that the multiplications overlap,
+ * which keeps the checksum close to memory speed.
+ *
+ * @param data The block, its size is a multiple of 8 bytes.
+ * @param size The size of the block in bytes.
+ * @param seed The checksum of the previous block, SNAPSHOT_SEED for the first one.
+ * @return The checksum of the block.
+ */
+static uint64_t Snapshot_Checksum(const void* data, size_t size, uint64_t seed)
+{
+    const uint8_t* bytes = (const uint8_t*)data;    /* Current word */
+    uint64_t lane[4] = { seed, seed + 1U, seed + 2U, seed + 3U };
+    uint64_t word = 0;                              /* Value of the current word */
+    size_t words = size / 8U;                       /* Number of words */
+    size_t i = 0;                                   /* Counter of words */
+
+    for (i = 0; i < words; i++)
+    {
+        memcpy(&word, bytes + i * 8U, 8U);
+        lane[i & 3U] = (lane[i & 3U] ^ word) * SNAPSHOT_PRIME;
+    }
+
+    return Account_Key_Hash(lane[0] ^ (lane[1] << 1) ^ (lane[2] << 2) ^ (lane[3] << 3) ^ size);
+}
+
+/**
+ * @brief Compute the checksum of a header.
+ *
+ * @param header The header.
+ * @return The checksum of every field before header_checksum.
+ */
+static uint64_t Snapshot_Header_Checksum(const Snapshot_Header_t* header)
+{
+    return Snapshot_Checksum(header, offsetof(Snapshot_Header_t, header_checksum), SNAPSHOT_SEED);
+}
+
+/**
+ * @brief Force the written content of a file to the disk.
+ *
+ * @param file The file, already flushed.
+ * @return 0 on success, -1 on error.
+ */
+static int32_t Snapshot_Sync(FILE* file)
+{
+#ifdef _WIN32
+    return (_commit(_fileno(file)) == 0) ? 0 : -1;
+#else
+    return (fsync(fileno(file)) == 0) ? 0 : -1;
+#endif
+}
+
+/**
+ * @brief Write a snapshot file.
+ *
+ * The file is written under a temporary name, forced to the disk and renamed once
+ * complete, so an existing snapshot is never left half written.
+ *
+ * @param path The path of the snapshot file.
+ * @param keys The keys of the accounts in display order.
+ * @param count The number of keys.
+ * @return SNAPSHOT_OK if the file is written, an error code if not.
+ */
+snapshot_status_t Snapshot_Write(const char* path, const uint64_t* keys, uint64_t count)
+{
+    snapshot_status_t result = SNAPSHOT_OK;     /* Result of the write */
+    Snapshot_Header_t header;                   /* Header of the file */
+    uint64_t slots = SNAPSHOT_MIN_SLOTS;        /* Number of index slots */
+    uint32_t* index = NULL;                     /* Hash index over the keys */
+    char* temporary = NULL;                     /* Path the file is written to */
+    FILE* file = NULL;                          /* The file being written */
+    uint64_t slot = 0;                          /* Current index slot */
+    uint64_t i = 0;                             /* Counter of keys */
+
+    /* Keep the index at most three quarters full */
+    while (slots * 3U < count * 4U)
+    {
+        slots *= 2U;
+    }
+
+    /* Positions are stored in 32 bits */
+    if (count >= UINT32_MAX)
+    {
+        result = SNAPSHOT_BAD_FORMAT;
+    }
+    else
+    {
+        index = (uint32_t*)calloc((size_t)slots, sizeof(uint32_t));
+        temporary = (char*)malloc(strlen(path) + 5U);
+        if (index == NULL || temporary == NULL)
+        {
+            result = SNAPSHOT_NO_MEMORY;
+        }
+    }
+
+    if (result == SNAPSHOT_OK)
+    {
+        /* Build the index with linear probing */
+        for (i = 0; i < count; i++)
+        {
+            slot = Account_Key_Hash(keys[i]) & (slots - 1U);
+            while (index[slot] != 0U)
+            {
+                slot = (slot + 1U) & (slots - 1U);
+            }
+            index[slot] = (uint32_t)(i + 1U);
+        }
+
+        /* Fill the header */
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.header_size = (uint32_t)sizeof(Snapshot_Header_t);
+        header.count = count;
+        header.index_slots = slots;
+        header.data_checksum = Snapshot_Checksum(index, (size_t)slots * sizeof(uint32_t),
+                                                 Snapshot_Checksum(keys, (size_t)count * sizeof(uint64_t), SNAPSHOT_SEED));
+        header.header_checksum = Snapshot_Header_Checksum(&header);
+
+        /* Write the whole file under the temporary name */
+        strcpy(temporary, path);
+        strcat(temporary, ".tmp");
+        file = fopen(temporary, "wb");
+        if (file == NULL)
+        {
+            result = SNAPSHOT_IO_ERROR;
+        }
+        else
+        {
+            if ((fwrite(&header, sizeof(header), 1, file) != 1U)
+                || (count > 0U && fwrite(keys, sizeof(uint64_t), (size_t)count, file) != (size_t)count)
+                || (fwrite(index, sizeof(uint32_t), (size_t)slots, file) != (size_t)slots)
+                || (fflush(file) != 0) || (Snapshot_Sync(file) != 0))
+            {
+                result = SNAPSHOT_IO_ERROR;
+            }
+            if (fclose(file) != 0)
+            {
+                result = SNAPSHOT_IO_ERROR;
+            }
+
+            /* Replace the previous snapshot */
+            if (result == SNAPSHOT_OK)
+            {
+#ifdef _WIN32
+                remove(path);
+#endif
+                if (rename(temporary, path) != 0)
+                {
+                    result = SNAPSHOT_IO_ERROR;
+                }
+            }
+            if (result != SNAPSHOT_OK)
+            {
+                remove(temporary);
+            }
+        }
+    }
+
+    free(index);
+    free(temporary);
+
+    return result;
+}
+
+/**
+ * @brief Map a whole file read-only.
+ *
+ * @param path The path of the file.
+ * @param size Output, the size of the file.
+ * @return The start of the mapping, NULL if the file cannot be mapped.
+ */
+static void* Snapshot_Map(const char* path, size_t* size)
+{
+    void* base = NULL;      /* Start of the mapping */
+#ifdef _WIN32
+    HANDLE file;            /* The file */
+    HANDLE mapping;         /* The mapping object of the file */
+    LARGE_INTEGER length;   /* Size of the file */
+
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        if (GetFileSizeEx(file, &length) && length.QuadPart > 0)
+        {
+            mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping != NULL)
+            {
+                base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                *size = (size_t)length.QuadPart;
+                /* The view keeps the mapping alive */
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = open(path, O_RDONLY);  /* The file */
+    struct stat info;               /* Size of the file */
+
+    if (fd >= 0)
+    {
+        if (fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED)
+            {
+                base = NULL;
+            }
+            *size = (size_t)info.st_size;
+        }
+        /* The mapping keeps the file alive */
+        close(fd);
+    }
+#endif
+
+    return base;
+}
+
+/**
+ * @brief Unmap a mapping made by Snapshot_Map().
+ *
+ * @param base The start of the mapping.
+ * @param size The size of the mapping.
+ */
+static void Snapshot_Unmap(void* base, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, size);
+#endif
+}
+
+/**
+ * @brief Map a snapshot file into memory.
+ *
+ * The header is always checked. The checksum of the records and of the index is only
+ * checked when verify is set, because it reads the whole file.
+ *
+ * @param snapshot Output, the open snapshot.
+ * @param path The path of the snapshot file.
+ * @param verify 1 to check the checksum of the whole file, 0 to check the header only.
+ * @return SNAPSHOT_OK if the snapshot is open, an error code if not.
+ */
+snapshot_status_t Snapshot_Open(Snapshot_t* snapshot, const char* path, int32_t verify)
+{
+    snapshot_status_t result = SNAPSHOT_OK;     /* Result of the opening */
+    const Snapshot_Header_t* header = NULL;     /* Header of the file */
+    size_t size = 0;                            /* Size of the file */
+    void* base = Snapshot_Map(path, &size);     /* Start of the mapping */
+    uint64_t checksum = 0;                      /* Checksum of the records and of the index */
+
+    memset(snapshot, 0, sizeof(Snapshot_t));
+
+    if (base == NULL)
+    {
+        result = SNAPSHOT_IO_ERROR;
+    }
+    else if (size < sizeof(Snapshot_Header_t))
+    {
+        result = SNAPSHOT_BAD_FORMAT;
+    }
+    else
+    {
+        header = (const Snapshot_Header_t*)base;
+        /* Check the identity and the integrity of the header */
+        if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0
+            || header->header_size != sizeof(Snapshot_Header_t)
+            || header->header_checksum != Snapshot_Header_Checksum(header))
+        {
+            result = SNAPSHOT_BAD_FORMAT;
+        }
+        else if (header->version != SNAPSHOT_VERSION)
+        {
+            result = SNAPSHOT_BAD_VERSION;
+        }
+        /* Check that the sizes agree with the file. The counts are bounded first, so the
+        products below cannot wrap around whatever the header holds. */
+        else if (header->count >= UINT32_MAX || header->index_slots < SNAPSHOT_MIN_SLOTS
+                 || header->index_slots > SNAPSHOT_MAX_SLOTS
+                 || header->index_slots > ((uint64_t)size - sizeof(Snapshot_Header_t)) / sizeof(uint32_t)
+                 || (header->index_slots & (header->index_slots - 1U)) != 0U
+                 || header->index_slots * 3U < header->count * 4U
+                 || (uint64_t)size - sizeof(Snapshot_Header_t)
+                    != header->count * sizeof(uint64_t) + header->index_slots * sizeof(uint32_t))
+        {
+            result = SNAPSHOT_BAD_FORMAT;
+        }
+        else
+        {
+            snapshot->records = (const uint64_t*)(header + 1);
+            snapshot->count = header->count;
+            snapshot->index = (const uint32_t*)(snapshot->records + header->count);
+            snapshot->index_mask = header->index_slots - 1U;
+
+            /* Check the content of the file */
+            if (verify)
+            {
+                checksum = Snapshot_Checksum(snapshot->records, (size_t)header->count * sizeof(uint64_t), SNAPSHOT_SEED);
+                checksum = Snapshot_Checksum(snapshot->index, (size_t)header->index_slots * sizeof(uint32_t), checksum);
+                if (checksum != header->data_checksum)
+                {
+                    result = SNAPSHOT_BAD_CHECKSUM;
+                }
+            }
+        }
+    }
+
+    if (result == SNAPSHOT_OK)
+    {
+        snapshot->base = base;
+        snapshot->size = size;
+    }
+    else
+    {
+        if (base != NULL)
+        {
+            Snapshot_Unmap(base, size);
+        }
+        memset(snapshot, 0, sizeof(Snapshot_t));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Check if a key is in an open snapshot.
+ *
+ * @param snapshot The open snapshot.
+ * @param key The key to look for.
+ * @return 1 if the key is in the snapshot, 0 if not.
+ */
+int32_t Snapshot_Contains(const Snapshot_t* snapshot, uint64_t key)
+{
+    int32_t found = 0;              /* Result of the search */
+    uint64_t slot = 0;              /* Current index slot */
+    uint64_t probes = 0;            /* Number of slots probed */
+    uint32_t position = 0;          /* Position + 1 of the record of the slot */
+
+    if (snapshot->base != NULL)
+    {
+        slot = Account_Key_Hash(key) & snapshot->index_mask;
+        position = snapshot->index[slot];
+        /* Probe until the key or an empty slot is found. The bounds only matter for a
+        corrupted index, which is not checked unless the snapshot was verified. */
+        while (position != 0U && position <= snapshot->count && probes <= snapshot->index_mask && found == 0)
+        {
+            found = (snapshot->records[position - 1U] == key);
+            slot = (slot + 1U) & snapshot->index_mask;
+            position = snapshot->index[slot];
+            probes++;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Get a message describing a result of the snapshot functions.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Snapshot_Status_Message(snapshot_status_t status)
+{
+    const char* message = "Unknown error";     /* Message of the result */
+
+    switch (status)
+    {
+        case SNAPSHOT_OK:
+        {
+            message = "Success";
+            break;
+        }
+        case SNAPSHOT_IO_ERROR:
+        {
+            message = "File cannot be opened, mapped or written";
+            break;
+        }
+        case SNAPSHOT_BAD_FORMAT:
+        {
+            message = "File is not a snapshot or is truncated";
+            break;
+        }
+        case SNAPSHOT_BAD_VERSION:
+        {
+            message = "Snapshot was written by another version";
+            break;
+        }
+        case SNAPSHOT_BAD_CHECKSUM:
+        {
+            message = "Snapshot is corrupted";
+            break;
+        }
+        case SNAPSHOT_NO_MEMORY:
+        {
+            message = "Memory allocation failed";
+            break;
+        }
+    }
+
+    return message;
+}
+
+/**
+ * @brief Unmap a snapshot.
+ *
+ * @param snapshot The snapshot to close.
+ */
+void Snapshot_Close(Snapshot_t* snapshot)
+{
+    if (snapshot->base != NULL)
+    {
+        Snapshot_Unmap(snapshot->base, snapshot->size);
+    }
+    memset(snapshot, 0, sizeof(Snapshot_t));
+} /* EOF */
@@ -0,0 +1,133 @@
+/**
+ * @file account_snapshot.h
+ * @brief This file contains the declarations of the on-disk snapshot of the account list.
+ *
+ * A snapshot file holds a header, the keys of the accounts in display order as a
+ * fixed-width array, and a prebuilt open-addressing hash index over that array.
+ * The file is mapped into memory when it is opened, so lookups are served straight
+ * from the mapping and opening does not depend on the number of accounts.
+ *
+ * File layout (native byte order):
+ *
+ *      Snapshot_Header_t            header
+ *      uint64_t records[count]      keys in display order
+ *      uint32_t index[index_slots]  position + 1 of a record, 0 for an empty slot
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stddef.h>         /* For size_t */
+#include <stdint.h>         /* Include standard integer types library for fixed-width integers */
+
+#ifndef ACCOUNT_SNAPSHOT_H
+#define ACCOUNT_SNAPSHOT_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SNAPSHOT_MAGIC          "ACCTSNAP"  /* First 8 bytes of a snapshot file */
+#define SNAPSHOT_VERSION        1U          /* Version of the file layout */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the results of the snapshot functions.
+ */
+typedef enum
+{
+    SNAPSHOT_OK,                /* The operation succeeded. */
+    SNAPSHOT_IO_ERROR,          /* The file cannot be opened, mapped or written. */
+    SNAPSHOT_BAD_FORMAT,        /* The file is not a snapshot or is truncated. */
+    SNAPSHOT_BAD_VERSION,       /* The file was written with another layout version. */
+    SNAPSHOT_BAD_CHECKSUM,      /* The content of the file is corrupted. */
+    SNAPSHOT_NO_MEMORY          /* Memory allocation failed. */
+} snapshot_status_t;
+
+/**
+ * @brief Structure for the header of a snapshot file.
+ */
+typedef struct
+{
+    uint8_t magic[8];           /* SNAPSHOT_MAGIC. */
+    uint32_t version;           /* SNAPSHOT_VERSION. */
+    uint32_t header_size;       /* sizeof(Snapshot_Header_t). */
+    uint64_t count;             /* Number of records. */
+    uint64_t index_slots;       /* Number of index slots, a power of 2. */
+    uint64_t data_checksum;     /* Checksum of the records and of the index. */
+    uint64_t header_checksum;   /* Checksum of the fields above. */
+} Snapshot_Header_t;
+
+/**
+ * @brief Structure for an open snapshot.
+ *
+ * A zero-initialized structure is a closed snapshot.
+ */
+typedef struct
+{
+    const uint64_t* records;    /* Keys of the accounts in display order. */
+    uint64_t count;             /* Number of records. */
+    const uint32_t* index;      /* Hash index over the records. */
+    uint64_t index_mask;        /* Number of index slots minus one. */
+    void* base;                 /* Start of the mapping, NULL if the snapshot is closed. */
+    size_t size;                /* Size of the mapping. */
+} Snapshot_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Write a snapshot file.
+ *
+ * The file is written under a temporary name, forced to the disk and renamed once
+ * complete, so an existing snapshot is never left half written.
+ *
+ * @param path The path of the snapshot file.
+ * @param keys The keys of the accounts in display order.
+ * @param count The number of keys.
+ * @return SNAPSHOT_OK if the file is written, an error code if not.
+ */
+snapshot_status_t Snapshot_Write(const char* path, const uint64_t* keys, uint64_t count);
+
+/**
+ * @brief Map a snapshot file into memory.
+ *
+ * The header is always checked. The checksum of the records and of the index is only
+ * checked when verify is set, because it reads the whole file.
+ *
+ * @param snapshot Output, the open snapshot.
+ * @param path The path of the snapshot file.
+ * @param verify 1 to check the checksum of the whole file, 0 to check the header only.
+ * @return SNAPSHOT_OK if the snapshot is open, an error code if not.
+ */
+snapshot_status_t Snapshot_Open(Snapshot_t* snapshot, const char* path, int32_t verify);
+
+/**
+ * @brief Check if a key is in an open snapshot.
+ *
+ * @param snapshot The open snapshot.
+ * @param key The key to look for.
+ * @return 1 if the key is in the snapshot, 0 if not.
+ */
+int32_t Snapshot_Contains(const Snapshot_t* snapshot, uint64_t key);
+
+/**
+ * @brief Get a message describing a result of the snapshot functions.
+ *
+ * @param status The result.
+ * @return The message.
+ */
+const char* Snapshot_Status_Message(snapshot_status_t status);
+
+/**
+ * @brief Unmap a snapshot.
+ *
+ * @param snapshot The snapshot to close.
+ */
+void Snapshot_Close(Snapshot_t* snapshot);
+
+#endif /* ACCOUNT_SNAPSHOT_H */
@@ -0,0 +1,297 @@
+/**
+ * @file account_stats.c
+ * @brief This file contains the implementation of the instrumentation of the account list.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <string.h>             /* For memset() */
+#include "account_stats.h"      /* Include header file of this function file */
+#ifdef ACCOUNT_STATS
+#include <stdlib.h>             /* For calloc(), free() */
+#include <pthread.h>            /* For the lock of the list of threads and the end of a thread */
+#ifdef _WIN32
+#include <windows.h>            /* For QueryPerformanceCounter() */
+#else
+#include <time.h>               /* For clock_gettime() */
+#endif
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+#ifdef ACCOUNT_STATS
+_Thread_local Stats_Block_t* stats_self = NULL;                 /* Block of the calling thread */
+static Stats_Block_t* stats_blocks = NULL;                      /* Blocks of the running threads */
+static Stats_Snapshot_t stats_ended;                            /* Sums of the threads that ended */
+static Stats_Snapshot_t stats_base;                             /* Sums at the last Stats_Reset() */
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;  /* Protects the variables above */
+static pthread_once_t stats_once = PTHREAD_ONCE_INIT;           /* Creates the key once */
+static pthread_key_t stats_key;                                 /* Calls Stats_Thread_End() when a thread ends */
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+#ifdef ACCOUNT_STATS
+/**
+ * @brief Add the counters and histograms of a block to sums. The lock must be held.
+ *
+ * @param sums The sums.
+ * @param block The block.
+ */
+static void Stats_Add_Block(Stats_Snapshot_t* sums, Stats_Block_t* block)
+{
+    uint32_t i = 0;             /* Counter or operation counter */
+    uint32_t b = 0;             /* Bucket counter */
+
+    for (i = 0; i < STATS_COUNTERS; i++)
+    {
+        sums->counters[i] += atomic_load_explicit(&block->counters[i], memory_order_relaxed);
+    }
+    for (i = 0; i < STATS_OPS; i++)
+    {
+        sums->total_ns[i] += atomic_load_explicit(&block->total_ns[i], memory_order_relaxed);
+        for (b = 0; b < STATS_BUCKETS; b++)
+        {
+            sums->histogram[i][b] += atomic_load_explicit(&block->histogram[i][b], memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Sum the running threads and the threads that ended. The lock must be held.
+ *
+ * @param sums Output, the sums.
+ */
+static void Stats_Sum_Locked(Stats_Snapshot_t* sums)
+{
+    Stats_Block_t* block = stats_blocks;    /* Current block */
+
+    *sums = stats_ended;
+    while (block != NULL)
+    {
+        Stats_Add_Block(sums, block);
+        block = block->next;
+    }
+}
+
+/**
+ * @brief Fold the block of an ending thread into the sums of the threads that ended.
+ *
+ * @param data The block.
+ */
+static void Stats_Thread_End(void* data)
+{
+    Stats_Block_t* block = (Stats_Block_t*)data;    /* Block of the ending thread */
+    Stats_Block_t** link = &stats_blocks;           /* Link to the current block */
+
+    pthread_mutex_lock(&stats_lock);
+    Stats_Add_Block(&stats_ended, block);
+    while (*link != block)
+    {
+        link = &(*link)->next;
+    }
+    *link = block->next;
+    pthread_mutex_unlock(&stats_lock);
+    free(block);
+}
+
+/**
+ * @brief Create the key that reports the end of a thread.
+ */
+static void Stats_Create_Key(void)
+{
+    pthread_key_create(&stats_key, Stats_Thread_End);
+}
+
+/**
+ * @brief Give the calling thread its block of counters.
+ *
+ * The block is folded into the totals and freed when the thread ends.
+ *
+ * @return The block, NULL if memory allocation failed.
+ */
+Stats_Block_t* Stats_Register(void)
+{
+    Stats_Block_t* block = (Stats_Block_t*)calloc(1U, sizeof(Stats_Block_t));
+
+    if (block != NULL)
+    {
+        pthread_once(&stats_once, Stats_Create_Key);
+        pthread_setspecific(stats_key, block);
+        pthread_mutex_lock(&stats_lock);
+        block->next = stats_blocks;
+        stats_blocks = block;
+        pthread_mutex_unlock(&stats_lock);
+        stats_self = block;
+    }
+
+    return block;
+}
+
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return The time in ns.
+ */
+uint64_t Stats_Now(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;     /* Ticks of the performance counter per second */
+    LARGE_INTEGER counter;              /* Current value of the performance counter */
+
+    if (frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;                /* Current time */
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+#endif
+
+/**
+ * @brief Sum the counters and histograms of every thread since the last Stats_Reset().
+ *
+ * @param stats Output, the sums. Everything is 0 when the instrumentation is not compiled in.
+ */
+void Stats_Get(Stats_Snapshot_t* stats)
+{
+#ifdef ACCOUNT_STATS
+    uint32_t i = 0;             /* Counter or operation counter */
+    uint32_t b = 0;             /* Bucket counter */
+
+    pthread_mutex_lock(&stats_lock);
+    Stats_Sum_Locked(stats);
+    /* Counters only grow, so the sums never drop below the base */
+    for (i = 0; i < STATS_COUNTERS; i++)
+    {
+        stats->counters[i] -= stats_base.counters[i];
+    }
+    for (i = 0; i < STATS_OPS; i++)
+    {
+        stats->total_ns[i] -= stats_base.total_ns[i];
+        for (b = 0; b < STATS_BUCKETS; b++)
+        {
+            stats->histogram[i][b] -= stats_base.histogram[i][b];
+        }
+    }
+    pthread_mutex_unlock(&stats_lock);
+    stats->enabled = 1;
+#else
+    memset(stats, 0, sizeof(Stats_Snapshot_t));
+#endif
+}
+
+/**
+ * @brief Start counting again from 0.
+ */
+void Stats_Reset(void)
+{
+#ifdef ACCOUNT_STATS
+    /* The blocks belong to their threads, so only the base moves */
+    pthread_mutex_lock(&stats_lock);
+    Stats_Sum_Locked(&stats_base);
+    pthread_mutex_unlock(&stats_lock);
+#endif
+}
+
+/**
+ * @brief Find the bucket a percentile of the times of an operation falls in.
+ *
+ * @param stats The sums.
+ * @param op The operation.
+ * @param count The number of times of the operation, not 0.
+ * @param percent The percentile.
+ * @return The upper bound of the bucket in ns.
+ */
+static uint64_t Stats_Percentile(const Stats_Snapshot_t* stats, stats_op_t op, uint64_t count, uint32_t percent)
+{
+    uint64_t rank = (count * percent + 99U) / 100U;    /* Number of times at or below the percentile */
+    uint64_t seen = 0;                                  /* Number of times in the buckets passed */
+    uint32_t b = 0;                                     /* Bucket counter */
+
+    seen = stats->histogram[op][0];
+    while (seen < rank && b < STATS_BUCKETS - 1U)
+    {
+        b++;
+        seen += stats->histogram[op][b];
+    }
+
+    return 1ULL << b;
+}
+
+/**
+ * @brief Print the counters and histograms.
+ *
+ * For each operation the count, the mean and the 50th, 90th and 99th percentiles are
+ * printed, followed by the non-empty buckets. A percentile is the upper bound of the
+ * bucket it falls in.
+ *
+ * @param stats The sums to print.
+ * @param out The stream to print to.
+ */
+void Stats_Dump(const Stats_Snapshot_t* stats, FILE* out)
+{
+    static const char* const counter_names[STATS_COUNTERS] =
+    {
+        "Checked CORRECT", "Checked CHAR_INVALID", "Checked LENGHT_INVALID", "Checked PREFIX_INVALID",
+        "Checked SEQUENCE_INVALID", "Added", "Duplicates", "Removed", "Remove misses", "Search hits", "Search misses",
+        "Expired"
+    };
+    static const char* const op_names[STATS_OPS] = { "check", "add", "remove", "search" };
+    uint64_t count = 0;         /* Number of times of the current operation */
+    uint32_t i = 0;             /* Counter or operation counter */
+    uint32_t b = 0;             /* Bucket counter */
+
+    if (stats->enabled == 0)
+    {
+        fprintf(out, "Statistics are not compiled in, build with ACCOUNT_STATS defined.\n");
+    }
+    else
+    {
+        fprintf(out, "%-24s %llu\n", "Accounts", (unsigned long long)stats->accounts);
+        for (i = 0; i < STATS_COUNTERS; i++)
+        {
+            fprintf(out, "%-24s %llu\n", counter_names[i], (unsigned long long)stats->counters[i]);
+        }
+
+        fprintf(out, "\n%-8s %12s %10s %10s %10s %10s\n", "op", "count", "mean ns", "p50 <ns", "p90 <ns", "p99 <ns");
+        for (i = 0; i < STATS_OPS; i++)
+        {
+            count = 0;
+            for (b = 0; b < STATS_BUCKETS; b++)
+            {
+                count += stats->histogram[i][b];
+            }
+            if (count > 0U)
+            {
+                fprintf(out, "%-8s %12llu %10.1f %10llu %10llu %10llu\n", op_names[i], (unsigned long long)count,
+                        (double)stats->total_ns[i] / (double)count,
+                        (unsigned long long)Stats_Percentile(stats, (stats_op_t)i, count, 50U),
+                        (unsigned long long)Stats_Percentile(stats, (stats_op_t)i, count, 90U),
+                        (unsigned long long)Stats_Percentile(stats, (stats_op_t)i, count, 99U));
+                /* One line per non-empty bucket, the last bucket has no upper bound */
+                for (b = 0; b < STATS_BUCKETS; b++)
+                {
+                    if (stats->histogram[i][b] > 0U)
+                    {
+                        fprintf(out, "    %s %10llu ns: %llu\n", (b == STATS_BUCKETS - 1U) ? ">=" : "< ",
+                                (unsigned long long)((b == STATS_BUCKETS - 1U) ? (1ULL << (b - 1U)) : (1ULL << b)),
+                                (unsigned long long)stats->histogram[i][b]);
+                    }
+                }
+            }
+        }
+    }
+} /* EOF */
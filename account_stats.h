@@ -0,0 +1,227 @@
+/**
+ * @file account_stats.h
+ * @brief This file contains the declarations of the instrumentation of the account list.
+ *
+ * The list counts its operations and records their latency in histograms with one
+ * bucket per power of 2 nanoseconds. Each thread writes to its own block of counters,
+ * so counting takes no lock and no thread invalidates the cache lines of another one.
+ * Stats_Get() sums the blocks of every thread.
+ *
+ * The instrumentation is compiled in only when ACCOUNT_STATS is defined. Otherwise the
+ * hooks below are empty inline functions, so they cost nothing and the list runs
+ * exactly as without them.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include <stdio.h>              /* For FILE */
+#ifdef ACCOUNT_STATS
+#include <stdatomic.h>          /* For the counters read by other threads */
+#endif
+
+#ifndef ACCOUNT_STATS_H
+#define ACCOUNT_STATS_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define STATS_BUCKETS           32U     /* Bucket b holds the times of 2^(b-1) to 2^b - 1 ns, the last one every longer time */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the counters.
+ *
+ * The first five counters follow the order of status_enum_t, so the counter of a
+ * check is STATS_CHECK_CORRECT + status.
+ */
+typedef enum
+{
+    STATS_CHECK_CORRECT,        /* Accounts checked CORRECT. */
+    STATS_CHECK_CHAR_INVALID,   /* Accounts checked CHAR_INVALID. */
+    STATS_CHECK_LENGHT_INVALID, /* Accounts checked LENGHT_INVALID. */
+    STATS_CHECK_PREFIX_INVALID, /* Accounts checked PREFIX_INVALID. */
+    STATS_CHECK_SEQUENCE_INVALID,   /* Accounts checked SEQUENCE_INVALID. */
+    STATS_ADDED,                /* Accounts added. */
+    STATS_DUPLICATES,           /* Accounts not added because they are already in the list. */
+    STATS_REMOVE_HITS,          /* Accounts removed. */
+    STATS_REMOVE_MISSES,        /* Removals of accounts that are not in the list. */
+    STATS_SEARCH_HITS,          /* Searches that found the account. */
+    STATS_SEARCH_MISSES,        /* Searches that did not find the account. */
+    STATS_EXPIRED,              /* Accounts removed because their time to live ran out. */
+    STATS_COUNTERS              /* Number of counters. */
+} stats_counter_t;
+
+/**
+ * @brief Enumeration for the timed operations.
+ */
+typedef enum
+{
+    STATS_OP_CHECK,             /* Check of one account. */
+    STATS_OP_ADD,               /* Add of one account. */
+    STATS_OP_REMOVE,            /* Removal of one account. */
+    STATS_OP_SEARCH,            /* Search of one account. */
+    STATS_OPS                   /* Number of timed operations. */
+} stats_op_t;
+
+/**
+ * @brief Structure for the sums of the counters and histograms of every thread.
+ */
+typedef struct
+{
+    int32_t enabled;                                /* 1 if the instrumentation is compiled in, 0 if not. */
+    uint64_t accounts;                              /* Number of accounts in the list, filled by Get_Account_Stats(). */
+    uint64_t counters[STATS_COUNTERS];              /* The counters. */
+    uint64_t total_ns[STATS_OPS];                   /* Sum of the times of each operation. */
+    uint64_t histogram[STATS_OPS][STATS_BUCKETS];   /* Number of times of each operation in each bucket. */
+} Stats_Snapshot_t;
+
+#ifdef ACCOUNT_STATS
+/**
+ * @brief Structure for the counters and histograms of one thread.
+ *
+ * Only the owning thread writes the block, other threads only read it.
+ */
+typedef struct Stats_Block
+{
+    _Atomic uint64_t counters[STATS_COUNTERS];              /* The counters. */
+    _Atomic uint64_t total_ns[STATS_OPS];                   /* Sum of the times of each operation. */
+    _Atomic uint64_t histogram[STATS_OPS][STATS_BUCKETS];   /* Number of times in each bucket. */
+    struct Stats_Block* next;                               /* Next block of the list of threads. */
+} Stats_Block_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+extern _Thread_local Stats_Block_t* stats_self;     /* Block of the calling thread, NULL before its first count */
+#endif
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+#ifdef ACCOUNT_STATS
+/**
+ * @brief Give the calling thread its block of counters.
+ *
+ * The block is folded into the totals and freed when the thread ends.
+ *
+ * @return The block, NULL if memory allocation failed.
+ */
+Stats_Block_t* Stats_Register(void);
+
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return The time in ns.
+ */
+uint64_t Stats_Now(void);
+#endif
+
+/**
+ * @brief Sum the counters and histograms of every thread since the last Stats_Reset().
+ *
+ * @param stats Output, the sums. Everything is 0 when the instrumentation is not compiled in.
+ */
+void Stats_Get(Stats_Snapshot_t* stats);
+
+/**
+ * @brief Start counting again from 0.
+ */
+void Stats_Reset(void);
+
+/**
+ * @brief Print the counters and histograms.
+ *
+ * For each operation the count, the mean and the 50th, 90th and 99th percentiles are
+ * printed, followed by the non-empty buckets. A percentile is the upper bound of the
+ * bucket it falls in.
+ *
+ * @param stats The sums to print.
+ * @param out The stream to print to.
+ */
+void Stats_Dump(const Stats_Snapshot_t* stats, FILE* out);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Add one to a counter of the calling thread.
+ *
+ * @param counter The counter.
+ */
+static inline void Stats_Count(stats_counter_t counter)
+{
+#ifdef ACCOUNT_STATS
+    Stats_Block_t* block = (stats_self != NULL) ? stats_self : Stats_Register();
+
+    /* Only this thread writes the block, a plain load and store is enough */
+    if (block != NULL)
+    {
+        atomic_store_explicit(&block->counters[counter],
+                              atomic_load_explicit(&block->counters[counter], memory_order_relaxed) + 1U,
+                              memory_order_relaxed);
+    }
+#else
+    (void)counter;
+#endif
+}
+
+/**
+ * @brief Start timing an operation.
+ *
+ * @return The start time to give to Stats_Stop(), 0 when the instrumentation is not compiled in.
+ */
+static inline uint64_t Stats_Start(void)
+{
+#ifdef ACCOUNT_STATS
+    return Stats_Now();
+#else
+    return 0U;
+#endif
+}
+
+/**
+ * @brief Record the time of an operation in the histogram of the calling thread.
+ *
+ * @param op The operation.
+ * @param start The time returned by Stats_Start().
+ */
+static inline void Stats_Stop(stats_op_t op, uint64_t start)
+{
+#ifdef ACCOUNT_STATS
+    Stats_Block_t* block = (stats_self != NULL) ? stats_self : Stats_Register();
+    uint64_t elapsed = Stats_Now() - start;     /* Time of the operation */
+    uint32_t bucket = 0;                        /* Bucket of the time */
+
+    if (block != NULL)
+    {
+        /* The bucket is the number of significant bits of the time */
+#if defined(__GNUC__) || defined(__clang__)
+        bucket = (elapsed == 0U) ? 0U : (64U - (uint32_t)__builtin_clzll(elapsed));
+#else
+        while ((elapsed >> bucket) != 0U)
+        {
+            bucket++;
+        }
+#endif
+        bucket = (bucket < STATS_BUCKETS) ? bucket : (STATS_BUCKETS - 1U);
+        atomic_store_explicit(&block->histogram[op][bucket],
+                              atomic_load_explicit(&block->histogram[op][bucket], memory_order_relaxed) + 1U,
+                              memory_order_relaxed);
+        atomic_store_explicit(&block->total_ns[op],
+                              atomic_load_explicit(&block->total_ns[op], memory_order_relaxed) + elapsed,
+                              memory_order_relaxed);
+    }
+#else
+    (void)op;
+    (void)start;
+#endif
+}
+
+#endif /* ACCOUNT_STATS_H */
@@ -0,0 +1,1804 @@
+/**
+ * @file account_store.c
+ * @brief This file contains the implementation of the stores of accounts.
+ *
+ * Each store keeps its accounts in a contiguous slot array, found through a hash index
+ * with a Bloom filter in front of it. A loaded snapshot is served from its
+ * mapping until the store changes, and the ordered index is only built for the first
+ * ordered query or view. A view pins a copy-on-write version of the ordered index, so
+ * it can be pinned and read from another thread while the store keeps changing. The keys of the
+ * slot array are also kept in a sharded set, which serves the searches of any number
+ * of threads without a lock while one thread changes the store.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "account_store.h"      /* Include header file of this function file */
+#include "account_index.h"      /* For the hash index of the accounts */
+#include "account_slots.h"      /* For the slot array of the accounts */
+#include "account_key.h"        /* For the packed keys of the accounts */
+#include "account_stats.h"      /* For the counters and latency histograms */
+#include "account_bloom.h"      /* For the filter of the absent accounts */
+#include "account_btree.h"      /* For the ordered index of the accounts */
+#include "account_timer.h"      /* For the expiry of the accounts */
+#include "account_shard.h"      /* For the keys shared with the concurrent searches */
+#include "account_epoch.h"      /* For the read sections of the concurrent searches */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define STORE_BATCH_GROUP       16U     /* Accounts of a batch whose cache lines are loaded together */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for a store of accounts.
+ *
+ * The slot array and a loaded snapshot are never both in use. The slot array holds the
+ * accounts in order of addition, so the display order, newest first, reads it backwards.
+ * The fields read by Account_Store_Search_Shared() are only changed with atomic stores,
+ * and the blocks they point to are freed once no read section can see them.
+ */
+struct Account_Store
+{
+    Slot_Map_t slots;           /* Slot array of the accounts. */
+    Account_Index_t index;      /* Looks up the handles of the accounts by key. */
+    Snapshot_t base;            /* Loaded snapshot, served until the store changes. */
+    Journal_t journal;          /* Log of the changes of the store. */
+    Bloom_t bloom;              /* Answers most lookups of absent accounts without the index. */
+    double bloom_rate;          /* Sizes the filter, 0 turns the filter off. */
+    Btree_t order;              /* Lists the accounts in order. */
+    int32_t order_ready;        /* Set when order holds every account. */
+    Timer_Wheel_t expiry;       /* Deadlines of the accounts given a time to live. */
+    uint32_t* expiry_timer;     /* Timer of each slot of the slot array, TIMER_NONE if none. */
+    uint32_t expiry_slots;      /* Slots expiry_timer can hold. */
+    int32_t allocated;          /* Set when the store was allocated by Account_Store_Create(). */
+    Shard_Store_t* _Atomic members;     /* Keys of the slot array, NULL before the first addition. */
+    Snapshot_t* _Atomic shared_base;    /* Copy of base for the concurrent searches, NULL if none is loaded. */
+    _Atomic uint64_t shared_count;      /* Accounts the concurrent searches can find. */
+    _Atomic int32_t view_wanted;        /* Set by a pin that found the ordered index not published. */
+    Bloom_t* _Atomic shared_bloom;      /* Copy of bloom for the concurrent searches, NULL if it is not built. */
+    _Atomic uint64_t shared_queries;    /* Concurrent searches that asked the filter. */
+    _Atomic uint64_t shared_negatives;  /* Concurrent searches the filter answered alone. */
+    _Atomic uint64_t shared_false_positives;    /* Concurrent searches the filter let through for an absent account. */
+};
+
+/**
+ * @brief Structure for the work of Account_Store_Expire().
+ */
+typedef struct
+{
+    account_store_t* store;     /* The store. */
+    account_visit_t visit;      /* The function receiving the expired accounts, may be NULL. */
+    void* user_data;            /* Passed to visit. */
+    uint64_t removed;           /* Number of accounts removed. */
+} Store_Expiry_t;
+
+/**
+ * @brief Structure for a pinned view of a store.
+ *
+ * No change of the store made after the view was pinned reaches it.
+ */
+struct Account_View
+{
+    Btree_t order;              /* Version of the ordered index, sharing its nodes with the store. */
+};
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+account_store_t default_account_store = { .bloom_rate = BLOOM_DEFAULT_RATE };  /* Store that is live when the program starts */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Check if a store has no account.
+ *
+ * @param store The store.
+ * @return 1 if the slot array and the loaded snapshot are both empty, 0 if not.
+ */
+static int32_t Store_Is_Empty(const account_store_t* store)
+{
+    return (store->slots.live == 0U && store->base.count == 0U) ? 1 : 0;
+}
+
+/**
+ * @brief Check if the slot array or the loaded snapshot of a store holds a key.
+ *
+ * The index is only probed when the filter cannot rule the account out.
+ *
+ * @param store The store.
+ * @param key The key of the account.
+ * @return 1 if the account is in the store, 0 if not.
+ */
+static int32_t Store_Contains(account_store_t* store, uint64_t key)
+{
+    int32_t found = Snapshot_Contains(&store->base, key);       /* Result of the search */
+
+    if (found == 0 && Bloom_May_Contain(&store->bloom, key))
+    {
+        found = (Index_Find(&store->index, key) != ACCOUNT_HANDLE_NONE) ? 1 : 0;
+        /* The filter let an absent account through */
+        if (found == 0 && store->bloom.blocks != NULL)
+        {
+            store->bloom.stats.false_positives++;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Read the slot array of a store backwards, in display order.
+ *
+ * The removed records are skipped.
+ *
+ * @param store The store.
+ * @param remaining The records not read yet, moved past the account read.
+ * @param key Output, the key of the account.
+ * @return 1 if an account is read, 0 once the records run out.
+ */
+static int32_t Store_Previous_Key(const account_store_t* store, uint32_t* remaining, uint64_t* key)
+{
+    int32_t found = 0;          /* Set once an account is read */
+
+    while (*remaining > 0U && found == 0)
+    {
+        (*remaining)--;
+        *key = store->slots.keys[*remaining];
+        found = (*key != ACCOUNT_KEY_NONE) ? 1 : 0;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Free a copy of a filter made for the concurrent searches, with the blocks of the filter.
+ *
+ * @param block The copy, a Bloom_t*.
+ */
+static void Store_Free_Bloom(void* block)
+{
+    Bloom_Free((Bloom_t*)block);
+    free(block);
+}
+
+/**
+ * @brief Release the filter of a store.
+ *
+ * While the concurrent searches may still test the filter, its blocks are only freed
+ * once no read section can see them. The counters are kept.
+ *
+ * @param store The store.
+ */
+static void Store_Drop_Bloom(account_store_t* store)
+{
+    Bloom_t* shared = atomic_exchange(&store->shared_bloom, NULL);  /* Copy tested by the concurrent searches */
+
+    if (shared != NULL)
+    {
+        Epoch_Retire(shared, Store_Free_Bloom);
+        /* The blocks now belong to the copy */
+        store->bloom.memory = NULL;
+    }
+    Bloom_Free(&store->bloom);
+}
+
+/**
+ * @brief Build the filter of a store again from the accounts of its slot array.
+ *
+ * The new filter is handed to the concurrent searches once it holds every account.
+ * If memory allocation fails the filter stays off until the store is emptied, which
+ * only costs the lookups their shortcut.
+ *
+ * @param store The store.
+ * @param capacity The number of accounts the filter is built for.
+ */
+static void Store_Build_Bloom(account_store_t* store, uint64_t capacity)
+{
+    Bloom_t* shared = NULL;     /* Copy for the concurrent searches */
+    uint32_t r = 0;             /* Record counter */
+
+    Store_Drop_Bloom(store);
+    if (store->bloom_rate > 0.0 && Bloom_Build(&store->bloom, capacity, store->bloom_rate))
+    {
+        for (r = 0; r < store->slots.records; r++)
+        {
+            if (store->slots.keys[r] != ACCOUNT_KEY_NONE)
+            {
+                Bloom_Add(&store->bloom, store->slots.keys[r]);
+            }
+        }
+        /* Without a copy the concurrent searches go without the filter */
+        shared = (Bloom_t*)malloc(sizeof(Bloom_t));
+        if (shared != NULL)
+        {
+            *shared = store->bloom;
+            atomic_store_explicit(&store->shared_bloom, shared, memory_order_release);
+        }
+    }
+}
+
+/**
+ * @brief Build the filter of a store again from the accounts of its slot array.
+ *
+ * The filter is sized for twice the accounts of the store, so it can absorb as many
+ * additions before the next build.
+ *
+ * @param store The store.
+ */
+static void Store_Refresh_Bloom(account_store_t* store)
+{
+    Store_Build_Bloom(store, 2U * (uint64_t)store->slots.live);
+}
+
+/**
+ * @brief Add a key to the set of a store the concurrent searches read.
+ *
+ * The set is allocated with the first key.
+ *
+ * @param store The store.
+ * @param key The key of the new account.
+ * @return 1 if the key is in the set, 0 if memory allocation failed.
+ */
+static int32_t Store_Share(account_store_t* store, uint64_t key)
+{
+    int32_t shared = -1;        /* Result of the insertion into the set */
+    Shard_Store_t* members = atomic_load_explicit(&store->members, memory_order_relaxed);  /* The set */
+
+    if (members == NULL)
+    {
+        members = Shard_Store_Create();
+        /* Publish the set once it is initialized */
+        atomic_store_explicit(&store->members, members, memory_order_release);
+    }
+    if (members != NULL)
+    {
+        shared = Shard_Insert(members, key);
+    }
+    if (shared == 1)
+    {
+        atomic_fetch_add_explicit(&store->shared_count, 1U, memory_order_relaxed);
+    }
+
+    return (shared >= 0) ? 1 : 0;
+}
+
+/**
+ * @brief Close a copy of a snapshot made for the concurrent searches and free it.
+ *
+ * @param block The copy, a Snapshot_t*.
+ */
+static void Store_Free_Base(void* block)
+{
+    Snapshot_Close((Snapshot_t*)block);
+    free(block);
+}
+
+/**
+ * @brief Close the loaded snapshot of a store.
+ *
+ * While the concurrent searches may still read the snapshot, its mapping is only
+ * released once no read section can see it.
+ *
+ * @param store The store.
+ */
+static void Store_Drop_Base(account_store_t* store)
+{
+    Snapshot_t* shared = atomic_exchange(&store->shared_base, NULL);   /* Copy read by the concurrent searches */
+
+    if (shared != NULL)
+    {
+        atomic_fetch_sub_explicit(&store->shared_count, shared->count, memory_order_relaxed);
+        Epoch_Retire(shared, Store_Free_Base);
+        /* The mapping now belongs to the copy */
+        memset(&store->base, 0, sizeof(store->base));
+    }
+    else
+    {
+        Snapshot_Close(&store->base);
+    }
+}
+
+/**
+ * @brief Append a key to the slot array of a store.
+ *
+ * @param store The store.
+ * @param key The key of the new account.
+ * @param handle Output, the handle of the new account. May be NULL.
+ * @return 1 if the account is added, 0 if memory allocation failed.
+ */
+static int32_t Store_Insert(account_store_t* store, uint64_t key, account_handle_t* handle)
+{
+    int32_t result = 0;                             /* Result of the insertion */
+    account_handle_t added = ACCOUNT_HANDLE_NONE;   /* Handle of the new account */
+
+    /* Check if memory allocation is successful */
+    if (Slots_Add(&store->slots, key, &added))
+    {
+        /* Register the handle in the hash index */
+        if (Index_Insert(&store->index, key, added) == 0)
+        {
+            /* If the index could not grow, drop the account */
+            Slots_Remove(&store->slots, added);
+        }
+        else
+        {
+            /* Build the filter with the first account unless room was reserved, then rebuild it once it is full */
+            if ((store->slots.live == 1U && store->bloom.blocks == NULL) || Bloom_Should_Rebuild(&store->bloom))
+            {
+                Store_Refresh_Bloom(store);
+            }
+            else
+            {
+                Bloom_Add(&store->bloom, key);
+            }
+
+            /* Let the concurrent searches find the account, after the filter let it through */
+            if (Store_Share(store, key) == 0)
+            {
+                Index_Remove(&store->index, key);
+                Slots_Remove(&store->slots, added);
+            }
+            else
+            {
+                if (handle != NULL)
+                {
+                    *handle = added;
+                }
+                result = 1;
+
+                /* Keep the ordered index up to date once it is built, drop it if it cannot grow */
+                if (store->order_ready && Btree_Insert(&store->order, key) < 0)
+                {
+                    Btree_Free(&store->order);
+                    store->order_ready = 0;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Copy the accounts of the loaded snapshot of a store into its slot array.
+ *
+ * A loaded snapshot is served straight from its mapping until the store changes for
+ * the first time. This function is called right before that change. If the copy fails
+ * part of the way, the records already copied are taken out again, so the store keeps
+ * serving the snapshot alone and a later call starts over.
+ *
+ * @param store The store.
+ * @return 1 if the store can be changed, 0 if memory allocation failed.
+ */
+static int32_t Store_Materialize(account_store_t* store)
+{
+    int32_t result = 1;                     /* Result of the copy */
+    uint64_t i = store->base.count;         /* Counter of records */
+    account_handle_t handle = ACCOUNT_HANDLE_NONE;  /* Handle of a record taken out */
+
+    /* Size the slot array and the index at once, then append from the last record, which keeps the display order */
+    if (i > 0U)
+    {
+        result = (i <= UINT32_MAX && Slots_Reserve(&store->slots, (uint32_t)i)
+                  && Index_Reserve(&store->index, (uint32_t)i)) ? 1 : 0;
+    }
+    while (i > 0U && result == 1)
+    {
+        i--;
+        result = Store_Insert(store, store->base.records[i], NULL);
+    }
+
+    if (result == 1)
+    {
+        Store_Drop_Base(store);
+    }
+    /* Records i + 1 to the last one were copied, the last copied is at the end of the slot array */
+    while (result == 0 && i + 1U < store->base.count)
+    {
+        i++;
+        handle = Index_Remove(&store->index, store->base.records[i]);
+        if (Shard_Remove(atomic_load_explicit(&store->members, memory_order_relaxed), store->base.records[i]) == 1)
+        {
+            atomic_fetch_sub_explicit(&store->shared_count, 1U, memory_order_relaxed);
+        }
+        Slots_Remove(&store->slots, handle);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Get the handle of an account of a store.
+ *
+ * An account of a loaded snapshot has no handle yet, so the snapshot is copied into the
+ * slot array first.
+ *
+ * @param store The store.
+ * @param key The key of the account.
+ * @return The handle of the account, ACCOUNT_HANDLE_NONE if it is not in the store or
+ * memory allocation failed.
+ */
+static account_handle_t Store_Find(account_store_t* store, uint64_t key)
+{
+    account_handle_t handle = ACCOUNT_HANDLE_NONE;  /* Handle of the account */
+
+    if (Snapshot_Contains(&store->base, key) && Store_Materialize(store) == 0)
+    {
+        printf("Error: Memory allocation failed.\n");
+    }
+    else if (Bloom_May_Contain(&store->bloom, key))
+    {
+        handle = Index_Find(&store->index, key);
+    }
+
+    return handle;
+}
+
+/**
+ * @brief Remove every account of a store and release all the memory of its slot array.
+ *
+ * The handles given before stay stale, the slot array keeps counting its generations.
+ *
+ * @param store The store.
+ */
+static void Store_Clear(account_store_t* store)
+{
+    Shard_Store_t* members = atomic_exchange(&store->members, NULL);   /* Set read by the concurrent searches */
+
+    if (members != NULL)
+    {
+        Epoch_Retire(members, Shard_Store_Free);
+    }
+    Store_Drop_Base(store);
+    atomic_store(&store->shared_count, 0U);
+    Slots_Destroy(&store->slots);
+    Index_Free(&store->index);
+    Store_Drop_Bloom(store);
+    Btree_Free(&store->order);
+    store->order_ready = 0;
+    /* The slots are handed out again from the first one, the deadlines go with them */
+    Timer_Destroy(&store->expiry);
+    free(store->expiry_timer);
+    store->expiry_timer = NULL;
+    store->expiry_slots = 0;
+}
+
+/**
+ * @brief Build the ordered index of a store, unless it is already built.
+ *
+ * The index is only built for the first ordered query, so the programs that never
+ * ask for one do not pay for it. From then on every change of the store updates it.
+ *
+ * @param store The store.
+ * @return 1 if the ordered index holds every account, 0 if memory allocation failed.
+ */
+static int32_t Store_Order(account_store_t* store)
+{
+    uint64_t* keys = NULL;      /* Keys of the store */
+    uint64_t count = 0;         /* Number of keys */
+    uint64_t i = 0;             /* Key counter */
+
+    if (store->order_ready == 0 && Account_Store_Keys(store, &keys, &count))
+    {
+        store->order_ready = 1;
+        for (i = 0; (i < count) && store->order_ready; i++)
+        {
+            if (Btree_Insert(&store->order, keys[i]) < 0)
+            {
+                Btree_Free(&store->order);
+                store->order_ready = 0;
+            }
+        }
+        free(keys);
+    }
+
+    return store->order_ready;
+}
+
+/**
+ * @brief Build the ordered index of a store if a view was asked for and publish it.
+ *
+ * It runs after each change, in the thread changing the store, so the pins of the other
+ * threads never build the index themselves.
+ *
+ * @param store The store.
+ */
+static void Store_Serve_Views(account_store_t* store)
+{
+    if (atomic_load_explicit(&store->view_wanted, memory_order_relaxed))
+    {
+        atomic_store_explicit(&store->view_wanted, 0, memory_order_relaxed);
+        Account_Store_Prepare_Views(store);
+    }
+}
+
+/**
+ * @brief Give the keys of an ordered index that lie in a range to a function, in order.
+ *
+ * Only the leaves of the range are read.
+ *
+ * @param order The ordered index, or a version of it.
+ * @param first The smallest key of the range.
+ * @param last The largest key of the range.
+ * @param visit The function receiving the accounts, NULL to only count them.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit.
+ */
+static int64_t Store_Scan_Order(const Btree_t* order, uint64_t first, uint64_t last, account_visit_t visit,
+                                void* user_data)
+{
+    int64_t count = 0;          /* Number of accounts given to visit */
+    int32_t scanning = 1;       /* Cleared when visit stops the query */
+    Btree_Cursor_t cursor;      /* Position in the ordered index */
+    uint64_t key = 0;           /* Key of the current account */
+    int8_t account[ACCOUNT_MAX_LENGTH + 1U];    /* Text of the current account */
+
+    Btree_Seek(order, first, &cursor);
+    while (scanning && Btree_Next(&cursor, &key) && key <= last)
+    {
+        Account_Decode(key, account);
+        count++;
+        scanning = (visit == NULL) ? 1 : visit(account, user_data);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Cancel the deadline of an account, if it has one.
+ *
+ * @param store The store.
+ * @param handle The handle of the account.
+ */
+static void Store_Cancel_Expiry(account_store_t* store, account_handle_t handle)
+{
+    uint32_t slot = (uint32_t)handle;   /* Slot of the account */
+
+    if (slot < store->expiry_slots && store->expiry_timer[slot] != TIMER_NONE)
+    {
+        Timer_Cancel(&store->expiry, store->expiry_timer[slot]);
+        store->expiry_timer[slot] = TIMER_NONE;
+    }
+}
+
+/**
+ * @brief Remove an account whose deadline is reached.
+ *
+ * @param payload The handle of the account.
+ * @param user_data The work of Account_Store_Expire().
+ */
+static void Store_Expire_Account(uint64_t payload, void* user_data)
+{
+    Store_Expiry_t* expiry = (Store_Expiry_t*)user_data;   /* Work of the expiry */
+    account_store_t* store = expiry->store;                 /* The store */
+    uint64_t key = Slots_Get(&store->slots, payload);       /* Key of the account */
+    int8_t account[ACCOUNT_MAX_LENGTH + 1U];                /* Text of the account */
+
+    /* The timer is gone, the removal must not cancel it */
+    store->expiry_timer[(uint32_t)payload] = TIMER_NONE;
+    if (key != ACCOUNT_KEY_NONE && Account_Store_Remove(store, key) == 1)
+    {
+        Stats_Count(STATS_EXPIRED);
+        expiry->removed++;
+        if (expiry->visit != NULL)
+        {
+            Account_Decode(key, account);
+            expiry->visit(account, expiry->user_data);
+        }
+    }
+}
+
+/**
+ * @brief Append a change of a store to its journal, if a journal is open.
+ *
+ * @param store The store.
+ * @param op The change.
+ * @param key The key of the account.
+ */
+static void Store_Log(account_store_t* store, journal_op_t op, uint64_t key)
+{
+    uint64_t* keys = NULL;      /* Keys of the store for a compaction */
+    uint64_t count = 0;         /* Number of keys */
+
+    if (store->journal.file != NULL)
+    {
+        if (Journal_Append(&store->journal, op, key) != JOURNAL_OK)
+        {
+            printf("Error: Cannot write the journal.\n");
+        }
+        /* Fold the journal into the snapshot once it is large enough */
+        else if (Journal_Should_Compact(&store->journal) && Account_Store_Keys(store, &keys, &count))
+        {
+            Journal_Compact(&store->journal, keys, count);
+        }
+    }
+}
+
+/**
+ * @brief Apply a record of the journal to a store.
+ *
+ * The journal is not open yet while it is replayed, so nothing is logged again.
+ *
+ * @param op The change.
+ * @param key The key of the account.
+ * @param user_data The store.
+ */
+static void Store_Replay(journal_op_t op, uint64_t key, void* user_data)
+{
+    account_store_t* store = (account_store_t*)user_data;  /* The store */
+
+    /* A record may already be in the snapshot, Account_Store_Add() skips it */
+    if (op == JOURNAL_ADD)
+    {
+        Account_Store_Add(store, key);
+    }
+    else
+    {
+        Account_Store_Remove(store, key);
+    }
+}
+
+/**
+ * @brief Create an empty store.
+ *
+ * @return The store, NULL if memory allocation failed.
+ */
+account_store_t* Account_Store_Create(void)
+{
+    account_store_t* store = (account_store_t*)calloc(1U, sizeof(account_store_t));   /* The new store */
+
+    if (store != NULL)
+    {
+        store->bloom_rate = BLOOM_DEFAULT_RATE;
+        store->allocated = 1;
+    }
+
+    return store;
+}
+
+/**
+ * @brief Close the journal of a store and release all its memory.
+ *
+ * The journal is closed without being reset. The default store is only emptied.
+ *
+ * @param store The store, may be NULL.
+ */
+void Account_Store_Destroy(account_store_t* store)
+{
+    if (store != NULL)
+    {
+        Journal_Close(&store->journal, 0);
+        Store_Clear(store);
+        if (store->allocated)
+        {
+            free(store);
+        }
+    }
+}
+
+/**
+ * @brief Add an account to a store.
+ *
+ * An account that is already in the store is not added again.
+ *
+ * @param store The store.
+ * @param key The key of the new account, as produced by Check_Account_Key().
+ * @return 1 if the account is added, 0 if it is already in the store, -1 if memory allocation failed.
+ */
+int32_t Account_Store_Add(account_store_t* store, uint64_t key)
+{
+    return Account_Store_Add_Handle(store, key, NULL);
+}
+
+/**
+ * @brief Add an account to a store and get its handle.
+ *
+ * An account that is already in the store is not added again, its handle is given instead.
+ *
+ * @param store The store.
+ * @param key The key of the new account, as produced by Check_Account_Key().
+ * @param handle Output, the handle of the account, ACCOUNT_HANDLE_NONE if memory allocation
+ * failed. May be NULL.
+ * @return 1 if the account is added, 0 if it is already in the store, -1 if memory allocation failed.
+ */
+int32_t Account_Store_Add_Handle(account_store_t* store, uint64_t key, account_handle_t* handle)
+{
+    int32_t result = 0;                 /* Result of the insertion */
+    uint64_t start = Stats_Start();     /* Start time of the insertion */
+
+    if (handle != NULL)
+    {
+        *handle = ACCOUNT_HANDLE_NONE;
+    }
+
+    /* The index expects a new key, so look for the account first */
+    if (Store_Contains(store, key))
+    {
+        Stats_Count(STATS_DUPLICATES);
+        if (handle != NULL)
+        {
+            *handle = Store_Find(store, key);
+        }
+    }
+    /* Copy a loaded snapshot into the slot array before changing it, then append the new account */
+    else if (Store_Materialize(store) == 0 || Store_Insert(store, key, handle) == 0)
+    {
+        /* If memory allocation failed, display an error message */
+        printf("Error: Memory allocation failed.\n");
+        result = -1;
+    }
+    else
+    {
+        Store_Log(store, JOURNAL_ADD, key);
+        Stats_Count(STATS_ADDED);
+        Store_Serve_Views(store);
+        result = 1;
+    }
+    Stats_Stop(STATS_OP_ADD, start);
+
+    return result;
+}
+
+/**
+ * @brief Make room in a store for a number of new accounts.
+ *
+ * The slot array, the hash index and the filter are sized at once for the accounts of
+ * the store plus the new ones, so adding them does not grow or rebuild any of them.
+ * Nothing is reserved for a store that still serves a loaded snapshot.
+ *
+ * @param store The store.
+ * @param count The number of accounts about to be added.
+ * @return 1 if the room is made, 0 if memory allocation failed. The store is usable anyway.
+ */
+int32_t Account_Store_Reserve(account_store_t* store, uint64_t count)
+{
+    int32_t result = 1;                                         /* Result of the reservation */
+    uint64_t total = (uint64_t)store->slots.live + count;   /* Accounts of the store once added */
+
+    if (store->base.count == 0U && count > 0U)
+    {
+        result = (total <= UINT32_MAX) ? Index_Reserve(&store->index, (uint32_t)total) : 0;
+        result = (result == 1 && Slots_Reserve(&store->slots, (uint32_t)total)) ? 1 : 0;
+        /* The filter built with the first account would be far too small */
+        if (total > store->bloom.capacity)
+        {
+            Store_Build_Bloom(store, total);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Remove an account from a store.
+ *
+ * @param store The store.
+ * @param key The key of the account to be removed.
+ * @return 1 if the account is removed, 0 if not. -1 if the store is empty
+ */
+int32_t Account_Store_Remove(account_store_t* store, uint64_t key)
+{
+    account_handle_t handle = ACCOUNT_HANDLE_NONE;  /* Handle of the account to remove */
+    int8_t is_Removed = 0;      /* Initialize the variable to store the result of the removal */
+    uint64_t start = Stats_Start(); /* Start time of the removal */
+
+    /* If the store is empty, set the is_Removed flag to -1 */
+    if (Store_Is_Empty(store))
+    {
+        is_Removed = -1;
+    }
+    /* Copy a loaded snapshot into the slot array before changing it */
+    else if (Snapshot_Contains(&store->base, key) && Store_Materialize(store) == 0)
+    {
+        printf("Error: Memory allocation failed.\n");
+    }
+    else
+    {
+        /* Take the handle of the account out of the index */
+        handle = Index_Remove(&store->index, key);
+        if (handle != ACCOUNT_HANDLE_NONE)
+        {
+            is_Removed = 1;
+            /* Hide the account from the concurrent searches first */
+            if (Shard_Remove(atomic_load_explicit(&store->members, memory_order_relaxed), key) == 1)
+            {
+                atomic_fetch_sub_explicit(&store->shared_count, 1U, memory_order_relaxed);
+            }
+            Store_Cancel_Expiry(store, handle);
+            /* Free the slot, which makes every copy of the handle stale */
+            Slots_Remove(&store->slots, handle);
+            /* Drop the ordered index if its copies cannot be allocated */
+            if (store->order_ready && Btree_Remove(&store->order, key) < 0)
+            {
+                Btree_Free(&store->order);
+                store->order_ready = 0;
+            }
+            Store_Log(store, JOURNAL_REMOVE, key);
+
+            /* Once the store is empty, give the memory of the slot array and the index back to the system */
+            if (store->slots.live == 0U)
+            {
+                Store_Clear(store);
+            }
+            /* The filter keeps the bits of the removed account until it is rebuilt */
+            else
+            {
+                store->bloom.removed++;
+                if (Bloom_Should_Rebuild(&store->bloom))
+                {
+                    Store_Refresh_Bloom(store);
+                }
+            }
+            Store_Serve_Views(store);
+        }
+    }
+    Stats_Count((is_Removed == 1) ? STATS_REMOVE_HITS : STATS_REMOVE_MISSES);
+    Stats_Stop(STATS_OP_REMOVE, start);
+    /* Return the result of the removal */
+    return is_Removed;
+}
+
+/**
+ * @brief Remove the account of a handle from a store.
+ *
+ * The slot array finds the account without any search, the removal is then the one of
+ * Account_Store_Remove().
+ *
+ * @param store The store.
+ * @param handle The handle of the account, as given by Account_Store_Add_Handle().
+ * @return 1 if the account is removed, 0 if the handle is stale. -1 if the store is empty
+ */
+int32_t Account_Store_Remove_Handle(account_store_t* store, account_handle_t handle)
+{
+    int32_t result = 0;                                 /* Result of the removal */
+    uint64_t key = Slots_Get(&store->slots, handle);    /* Key of the account */
+
+    if (key != ACCOUNT_KEY_NONE)
+    {
+        result = Account_Store_Remove(store, key);
+    }
+    else
+    {
+        result = Store_Is_Empty(store) ? -1 : 0;
+        Stats_Count(STATS_REMOVE_MISSES);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Search for an account in a store.
+ *
+ * @param store The store.
+ * @param key The key of the account to search for.
+ * @return The result of the search. -1 if the store is empty, 0 if the account is not found,
+ * 1 if the account is found.
+ */
+int32_t Account_Store_Search(account_store_t* store, uint64_t key)
+{
+    int32_t found = 0;          /* Flag to indicate if the account is found */
+    uint64_t start = Stats_Start(); /* Start time of the search */
+
+    /* If the store is empty */
+    if (Store_Is_Empty(store))
+    {
+        /* Set the found flag to -1 */
+        found = -1;
+    }
+    /* If the snapshot or the index holds the account */
+    else if (Store_Contains(store, key))
+    {
+        /* Set the found flag to 1 */
+        found = 1;
+    }
+    Stats_Count((found == 1) ? STATS_SEARCH_HITS : STATS_SEARCH_MISSES);
+    Stats_Stop(STATS_OP_SEARCH, start);
+    /* Return the result of the search */
+    return found;
+}
+
+/**
+ * @brief Search for an account in a store without taking any lock.
+ *
+ * Any number of threads may call it at once, also while one thread changes the store.
+ * The search reads the copy of the loaded snapshot, the copy of the filter and the
+ * sharded set of the keys inside a read section. The filter answers most searches of
+ * absent accounts without the set; its counters are kept apart from those of the
+ * owner (see Bloom_Stats_t).
+ *
+ * @param store The store.
+ * @param key The key of the account to search for.
+ * @return The result of the search, as Account_Store_Search().
+ */
+int32_t Account_Store_Search_Shared(account_store_t* store, uint64_t key)
+{
+    int32_t found = 0;                  /* Result of the search */
+    uint64_t start = Stats_Start();     /* Start time of the search */
+    Snapshot_t* base = NULL;            /* The loaded snapshot */
+    Shard_Store_t* members = NULL;      /* Keys of the slot array */
+    Bloom_t* bloom = NULL;              /* Filter of the keys of the slot array */
+    int32_t maybe = 1;                  /* Cleared when the filter rules the account out */
+
+    /* None of the blocks can be freed before Epoch_Exit() */
+    Epoch_Enter();
+    base = atomic_load_explicit(&store->shared_base, memory_order_acquire);
+    members = atomic_load_explicit(&store->members, memory_order_acquire);
+    bloom = atomic_load_explicit(&store->shared_bloom, memory_order_acquire);
+    if (base != NULL && Snapshot_Contains(base, key))
+    {
+        found = 1;
+    }
+    else if (members != NULL)
+    {
+        /* The filter takes an account before the set, so it never rules out one the set holds */
+        if (bloom != NULL)
+        {
+            maybe = Bloom_Test(bloom, key);
+            atomic_fetch_add_explicit(&store->shared_queries, 1U, memory_order_relaxed);
+        }
+        found = (maybe && Shard_Contains(members, key)) ? 1 : 0;
+        if (bloom != NULL && found == 0)
+        {
+            atomic_fetch_add_explicit(maybe ? &store->shared_false_positives : &store->shared_negatives, 1U,
+                                      memory_order_relaxed);
+        }
+    }
+    if (found == 0 && atomic_load_explicit(&store->shared_count, memory_order_relaxed) == 0U)
+    {
+        found = -1;
+    }
+    Epoch_Exit();
+    Stats_Count((found == 1) ? STATS_SEARCH_HITS : STATS_SEARCH_MISSES);
+    Stats_Stop(STATS_OP_SEARCH, start);
+
+    return found;
+}
+
+/**
+ * @brief Remove many accounts from a store.
+ *
+ * The accounts are removed one after the other, in groups whose index buckets, slots
+ * and records are loaded into the cache together before the first removal of the
+ * group. Each result is the one Account_Store_Remove() would give at that point, so an
+ * account listed twice is removed once and the accounts after the last one removed
+ * find the store empty.
+ *
+ * @param store The store.
+ * @param keys The keys of the accounts, ACCOUNT_KEY_NONE for an account that is never found.
+ * @param count The number of keys.
+ * @param results Output, the result of each removal, as Account_Store_Remove(). May be NULL.
+ * @return The number of accounts removed.
+ */
+uint64_t Account_Store_Remove_Batch(account_store_t* store, const uint64_t* keys, uint64_t count, int32_t* results)
+{
+    account_handle_t handles[STORE_BATCH_GROUP];    /* Handles of the accounts of the current group */
+    uint64_t removed = 0;               /* Accounts removed */
+    uint64_t first = 0;                 /* First account of the current group */
+    uint32_t size = 0;                  /* Accounts of the current group */
+    uint32_t i = 0;                     /* Account counter within the group */
+    int32_t result = 0;                 /* Result of the current removal */
+
+    for (first = 0; first < count; first += size)
+    {
+        size = (count - first < STORE_BATCH_GROUP) ? (uint32_t)(count - first) : STORE_BATCH_GROUP;
+
+        /* Load the buckets of the group, then its slots, then the records the removals clear */
+        for (i = 0; i < size; i++)
+        {
+            Index_Prefetch(&store->index, keys[first + i]);
+        }
+        for (i = 0; i < size; i++)
+        {
+            handles[i] = Index_Find(&store->index, keys[first + i]);
+            Slots_Prefetch(&store->slots, handles[i], 0);
+        }
+        for (i = 0; i < size; i++)
+        {
+            Slots_Prefetch(&store->slots, handles[i], 1);
+        }
+
+        /* Every line is in the cache or on its way, remove the accounts in order */
+        for (i = 0; i < size; i++)
+        {
+            result = Account_Store_Remove(store, keys[first + i]);
+            removed += (result == 1) ? 1U : 0U;
+            if (results != NULL)
+            {
+                results[first + i] = result;
+            }
+        }
+    }
+
+    return removed;
+}
+
+/**
+ * @brief Search for many accounts in a store.
+ *
+ * The filter blocks of a group of accounts are loaded into the cache together, then
+ * the index buckets of the accounts the filter lets through, then the accounts are
+ * looked up.
+ *
+ * @param store The store.
+ * @param keys The keys of the accounts, ACCOUNT_KEY_NONE for an account that is never found.
+ * @param count The number of keys.
+ * @param results Output, the result of each search, as Account_Store_Search(). May be NULL.
+ * @return The number of accounts found.
+ */
+uint64_t Account_Store_Search_Batch(account_store_t* store, const uint64_t* keys, uint64_t count, int32_t* results)
+{
+    int32_t maybe[STORE_BATCH_GROUP] = { 0 };   /* Set for the accounts of the group the index must be probed for */
+    int32_t empty = Store_Is_Empty(store);  /* Set when every search gives -1 */
+    uint64_t found = 0;                 /* Accounts found */
+    uint64_t first = 0;                 /* First account of the current group */
+    uint64_t start = 0;                 /* Start time of the current search */
+    uint32_t size = 0;                  /* Accounts of the current group */
+    uint32_t i = 0;                     /* Account counter within the group */
+    int32_t result = 0;                 /* Result of the current search */
+
+    for (first = 0; first < count; first += size)
+    {
+        size = (count - first < STORE_BATCH_GROUP) ? (uint32_t)(count - first) : STORE_BATCH_GROUP;
+
+        /* Load the filter blocks of the group */
+        for (i = 0; (i < size) && !empty; i++)
+        {
+            Bloom_Prefetch(&store->bloom, keys[first + i]);
+        }
+        /* Rule out the accounts the filter has never seen, and load the buckets of the others */
+        for (i = 0; (i < size) && !empty; i++)
+        {
+            maybe[i] = 0;
+            if (Snapshot_Contains(&store->base, keys[first + i]))
+            {
+                maybe[i] = 2;
+            }
+            else if (Bloom_May_Contain(&store->bloom, keys[first + i]))
+            {
+                maybe[i] = 1;
+                Index_Prefetch(&store->index, keys[first + i]);
+            }
+        }
+        /* Probe the index for the accounts left */
+        for (i = 0; i < size; i++)
+        {
+            start = Stats_Start();
+            result = -1;
+            if (!empty)
+            {
+                result = (maybe[i] == 2) ? 1 : 0;
+                if (maybe[i] == 1)
+                {
+                    result = (Index_Find(&store->index, keys[first + i]) != ACCOUNT_HANDLE_NONE) ? 1 : 0;
+                    /* The filter let an absent account through */
+                    if (result == 0 && store->bloom.blocks != NULL)
+                    {
+                        store->bloom.stats.false_positives++;
+                    }
+                }
+            }
+            found += (result == 1) ? 1U : 0U;
+            if (results != NULL)
+            {
+                results[first + i] = result;
+            }
+            Stats_Count((result == 1) ? STATS_SEARCH_HITS : STATS_SEARCH_MISSES);
+            Stats_Stop(STATS_OP_SEARCH, start);
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Check if an account is in a store.
+ *
+ * @param store The store.
+ * @param key The key of the account.
+ * @return 1 if the account is in the store, 0 if not.
+ */
+int32_t Account_Store_Contains(account_store_t* store, uint64_t key)
+{
+    uint64_t start = Stats_Start();                 /* Start time of the search */
+    int32_t found = Store_Contains(store, key);     /* 1 if the index or the loaded snapshot holds the key */
+
+    Stats_Count(found ? STATS_SEARCH_HITS : STATS_SEARCH_MISSES);
+    Stats_Stop(STATS_OP_SEARCH, start);
+
+    return found;
+}
+
+/**
+ * @brief Get the handle of an account of a store.
+ *
+ * A loaded snapshot is copied into the slot array first, as its accounts have no handle.
+ *
+ * @param store The store.
+ * @param key The key of the account.
+ * @return The handle of the account, ACCOUNT_HANDLE_NONE if it is not in the store or
+ * memory allocation failed.
+ */
+account_handle_t Account_Store_Find(account_store_t* store, uint64_t key)
+{
+    uint64_t start = Stats_Start();                     /* Start time of the search */
+    account_handle_t handle = Store_Find(store, key);   /* Handle of the account */
+
+    Stats_Count((handle != ACCOUNT_HANDLE_NONE) ? STATS_SEARCH_HITS : STATS_SEARCH_MISSES);
+    Stats_Stop(STATS_OP_SEARCH, start);
+
+    return handle;
+}
+
+/**
+ * @brief Get the key of the account of a handle.
+ *
+ * @param store The store.
+ * @param handle The handle of the account.
+ * @param key Output, the key of the account. Left unchanged if the handle is stale.
+ * @return 1 if the handle names an account of the store, 0 if it is stale.
+ */
+int32_t Account_Store_Lookup(const account_store_t* store, account_handle_t handle, uint64_t* key)
+{
+    uint64_t found = Slots_Get(&store->slots, handle);  /* Key of the account */
+
+    if (found != ACCOUNT_KEY_NONE)
+    {
+        *key = found;
+    }
+
+    return (found != ACCOUNT_KEY_NONE) ? 1 : 0;
+}
+
+/**
+ * @brief Get the number of accounts of a store.
+ *
+ * @param store The store.
+ * @return The number of accounts.
+ */
+uint64_t Account_Store_Count(const account_store_t* store)
+{
+    return (uint64_t)store->slots.live + store->base.count;
+}
+
+/**
+ * @brief Give every account of a store to a function, in display order.
+ *
+ * @param store The store.
+ * @param visit The function receiving the accounts.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit.
+ */
+int64_t Account_Store_Iterate(account_store_t* store, account_visit_t visit, void* user_data)
+{
+    int64_t count = 0;              /* Number of accounts given to visit */
+    int32_t visiting = 1;           /* Cleared when visit stops the iteration */
+    uint64_t r = 0;                 /* Counter for the records of a loaded snapshot */
+    uint32_t s = store->slots.records;  /* Records of the slot array not read yet */
+    uint64_t key = 0;               /* Key of the current account */
+    int8_t account[ACCOUNT_MAX_LENGTH + 1U];    /* Text of the current account */
+
+    /* A loaded snapshot keeps its records in display order */
+    for (r = 0; visiting && r < store->base.count; r++)
+    {
+        Account_Decode(store->base.records[r], account);
+        count++;
+        visiting = visit(account, user_data);
+    }
+    while (visiting && Store_Previous_Key(store, &s, &key))
+    {
+        Account_Decode(key, account);
+        count++;
+        visiting = visit(account, user_data);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Give the accounts of a store whose keys lie in a range to a function, in order.
+ *
+ * The ordered index of the store is built on the first call.
+ *
+ * @param store The store.
+ * @param first The smallest key of the range.
+ * @param last The largest key of the range.
+ * @param visit The function receiving the accounts, NULL to only count them.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit, -1 if memory allocation failed.
+ */
+int64_t Account_Store_Scan(account_store_t* store, uint64_t first, uint64_t last, account_visit_t visit,
+                           void* user_data)
+{
+    int64_t count = -1;         /* Number of accounts given to visit */
+
+    if (Store_Order(store) == 0)
+    {
+        printf("Error: Memory allocation failed.\n");
+    }
+    else
+    {
+        count = Store_Scan_Order(&store->order, first, last, visit, user_data);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Place a cursor before the first account of a store.
+ *
+ * In display order the store must not change until the last page is read. In
+ * alphabetical order each page starts after the last account of the previous one, so
+ * the store may change between pages: the accounts added after the cursor show up, the
+ * removed ones do not.
+ *
+ * @param store The store.
+ * @param sorted 1 for alphabetical order, 0 for display order.
+ * @param cursor Output, the cursor.
+ */
+void Account_Store_Open_Cursor(const account_store_t* store, int32_t sorted, Account_Cursor_t* cursor)
+{
+    cursor->remaining = store->slots.records;
+    cursor->record = 0;
+    cursor->next_key = 0;
+    cursor->sorted = sorted;
+    cursor->done = 0;
+    cursor->store = store;
+}
+
+/**
+ * @brief Read the next page of accounts of a cursor.
+ *
+ * The ordered index of the store is built by the first page in alphabetical order.
+ *
+ * @param store The store the cursor was placed on.
+ * @param cursor The cursor, moved past the accounts read.
+ * @param keys Output, the keys of the accounts. May be NULL.
+ * @param accounts Output, the text of the accounts, NUL terminated. May be NULL.
+ * @param max The largest number of accounts of the page.
+ * @return The number of accounts read, 0 once the cursor is past the last account,
+ * -1 if memory allocation failed.
+ */
+int64_t Account_Store_Next_Page(account_store_t* store, Account_Cursor_t* cursor, uint64_t* keys,
+                                int8_t (*accounts)[ACCOUNT_MAX_LENGTH + 1U], uint32_t max)
+{
+    int64_t count = 0;          /* Number of accounts read */
+    uint64_t key = 0;           /* Key of the current account */
+    int32_t reading = 1;        /* Cleared when the page is full or the accounts run out */
+    Btree_Cursor_t position;    /* Position in the ordered index */
+
+    if (cursor->done || max == 0U)
+    {
+        reading = 0;
+    }
+    else if (cursor->sorted && Store_Order(store) == 0)
+    {
+        count = -1;
+        reading = 0;
+    }
+    else if (cursor->sorted)
+    {
+        /* Seek past the previous page, the tree may have changed since */
+        Btree_Seek(&store->order, cursor->next_key, &position);
+    }
+
+    while (reading)
+    {
+        /* Take the next key in the order of the cursor, the slot array and the snapshot are never both in use */
+        if (cursor->sorted)
+        {
+            reading = Btree_Next(&position, &key);
+        }
+        else if (cursor->record < store->base.count)
+        {
+            key = store->base.records[cursor->record];
+            cursor->record++;
+        }
+        else if (Store_Previous_Key(store, &cursor->remaining, &key) == 0)
+        {
+            reading = 0;
+        }
+
+        if (reading)
+        {
+            if (keys != NULL)
+            {
+                keys[count] = key;
+            }
+            if (accounts != NULL)
+            {
+                Account_Decode(key, accounts[count]);
+            }
+            count++;
+            /* The largest key has no successor */
+            cursor->next_key = key + 1U;
+            cursor->done = (cursor->sorted && cursor->next_key == 0U) ? 1 : 0;
+            reading = ((uint64_t)count < max && !cursor->done) ? 1 : 0;
+        }
+        else
+        {
+            cursor->done = 1;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Collect the keys of every account of a store in display order.
+ *
+ * @param store The store.
+ * @param keys Output, a malloc() block holding the keys.
+ * @param count Output, the number of keys.
+ * @return 1 if the keys are collected, 0 if memory allocation failed.
+ */
+int32_t Account_Store_Keys(const account_store_t* store, uint64_t** keys, uint64_t* count)
+{
+    uint64_t n = 0;                 /* Number of keys collected */
+    uint32_t s = store->slots.records;  /* Records of the slot array not read yet */
+
+    *keys = (uint64_t*)malloc(((size_t)store->slots.live + (size_t)store->base.count + 1U) * sizeof(uint64_t));
+    if (*keys != NULL)
+    {
+        /* The slot array and the snapshot are never both in use */
+        while (Store_Previous_Key(store, &s, &(*keys)[n]))
+        {
+            n++;
+        }
+        if (store->base.count > 0U)
+        {
+            memcpy(*keys + n, store->base.records, (size_t)store->base.count * sizeof(uint64_t));
+            n += store->base.count;
+        }
+    }
+    *count = n;
+
+    return (*keys != NULL) ? 1 : 0;
+}
+
+/**
+ * @brief Save the accounts of a store to a snapshot file.
+ *
+ * @param store The store.
+ * @param path The path of the snapshot file.
+ * @return SNAPSHOT_OK if the file is written, an error code if not.
+ */
+snapshot_status_t Account_Store_Save(account_store_t* store, const char* path)
+{
+    snapshot_status_t result = SNAPSHOT_OK;     /* Result of the save */
+    uint64_t* keys = NULL;                      /* Keys of the store in display order */
+    uint64_t count = 0;                         /* Number of keys */
+
+    /* A compaction may be writing the same file */
+    Journal_Wait(&store->journal);
+
+    /* A store that was not changed since it was loaded is its snapshot */
+    if (store->base.base != NULL)
+    {
+        result = Snapshot_Write(path, store->base.records, store->base.count);
+    }
+    else if (Account_Store_Keys(store, &keys, &count) == 0)
+    {
+        result = SNAPSHOT_NO_MEMORY;
+    }
+    else
+    {
+        result = Snapshot_Write(path, keys, count);
+        free(keys);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Replace the accounts of a store with a snapshot file.
+ *
+ * The file is mapped into memory and searches are served from it directly. The accounts
+ * are copied into the slot array of the store the first time the store is changed.
+ *
+ * @param store The store.
+ * @param path The path of the snapshot file.
+ * @param verify 1 to check the checksum of the whole file, 0 to check the header only.
+ * @return SNAPSHOT_OK if the snapshot is loaded, an error code if not. On error the store is empty.
+ */
+snapshot_status_t Account_Store_Load(account_store_t* store, const char* path, int32_t verify)
+{
+    snapshot_status_t result;   /* Result of the loading */
+    Snapshot_t* shared = NULL;  /* Copy of the snapshot for the concurrent searches */
+
+    /* Drop the current accounts, then map the file */
+    Store_Clear(store);
+    result = Snapshot_Open(&store->base, path, verify);
+    if (result == SNAPSHOT_OK)
+    {
+        shared = (Snapshot_t*)malloc(sizeof(Snapshot_t));
+        if (shared == NULL)
+        {
+            Snapshot_Close(&store->base);
+            result = SNAPSHOT_NO_MEMORY;
+        }
+        else
+        {
+            *shared = store->base;
+            atomic_store_explicit(&store->shared_count, shared->count, memory_order_relaxed);
+            atomic_store_explicit(&store->shared_base, shared, memory_order_release);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Replay a journal over a store and log every later change of the store to it.
+ *
+ * @param store The store.
+ * @param path The path of the journal file.
+ * @param snapshot_path The snapshot written by the compactions, NULL to never compact.
+ * @param config The settings of the journal.
+ * @return JOURNAL_OK if the journal is open, an error code if not.
+ */
+journal_status_t Account_Store_Open_Journal(account_store_t* store, const char* path, const char* snapshot_path,
+                                            const Journal_Config_t* config)
+{
+    journal_status_t result;    /* Result of the opening */
+    uint64_t* keys = NULL;      /* Keys of the store for a compaction */
+    uint64_t count = 0;         /* Number of keys */
+
+    result = Journal_Open(&store->journal, path, snapshot_path, config, Store_Replay, store);
+
+    /* An old journal left by an interrupted compaction is folded into the snapshot now */
+    if (result == JOURNAL_OK && store->journal.old_pending && snapshot_path != NULL)
+    {
+        result = Account_Store_Keys(store, &keys, &count) ? Journal_Compact(&store->journal, keys, count)
+                                                          : JOURNAL_NO_MEMORY;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Commit the pending changes of a store and close its journal.
+ *
+ * @param store The store.
+ * @param reset 1 if the store was just saved to the snapshot file, which empties the journal.
+ * @return JOURNAL_OK if every change is on the disk, an error code if not.
+ */
+journal_status_t Account_Store_Close_Journal(account_store_t* store, int32_t reset)
+{
+    return Journal_Close(&store->journal, reset);
+}
+
+/**
+ * @brief Get the counters of the journal of a store.
+ *
+ * @param store The store.
+ * @param stats Output, the counters since the journal was opened.
+ */
+void Account_Store_Journal_Stats(account_store_t* store, Journal_Stats_t* stats)
+{
+    Journal_Get_Stats(&store->journal, stats);
+}
+
+/**
+ * @brief Give an account of a store a time to live.
+ *
+ * The account is removed by the first call of Account_Store_Expire() that moves the
+ * clock of the store to its deadline or past it. A new time to live replaces the
+ * previous one. The deadlines are kept in memory only: they are not journaled nor
+ * saved in snapshots, and loading a snapshot drops them.
+ *
+ * @param store The store.
+ * @param handle The handle of the account.
+ * @param ttl The ticks from the clock of the store to the deadline, 0 to keep the account.
+ * @return 1 if the time to live is set, 0 if the handle is stale, -1 if memory allocation failed.
+ */
+int32_t Account_Store_Set_Ttl(account_store_t* store, account_handle_t handle, uint64_t ttl)
+{
+    int32_t result = 0;                 /* Result of the call */
+    uint32_t slot = (uint32_t)handle;   /* Slot of the account */
+    uint32_t* timers = NULL;            /* Larger array of the timers of the slots */
+    uint32_t id = TIMER_NONE;           /* Timer of the account */
+
+    if (Slots_Get(&store->slots, handle) != ACCOUNT_KEY_NONE)
+    {
+        result = 1;
+        Store_Cancel_Expiry(store, handle);
+        /* The slot array may have grown since the last time to live */
+        if (ttl > 0U && slot >= store->expiry_slots)
+        {
+            timers = (uint32_t*)realloc(store->expiry_timer, (size_t)store->slots.capacity * sizeof(uint32_t));
+            if (timers == NULL)
+            {
+                result = -1;
+            }
+            else
+            {
+                memset(&timers[store->expiry_slots], 0,
+                       (size_t)(store->slots.capacity - store->expiry_slots) * sizeof(uint32_t));
+                store->expiry_timer = timers;
+                store->expiry_slots = store->slots.capacity;
+            }
+        }
+        if (ttl > 0U && result == 1)
+        {
+            /* A deadline past the end of time never comes */
+            id = Timer_Schedule(&store->expiry, (ttl > UINT64_MAX - store->expiry.now) ? UINT64_MAX :
+                                store->expiry.now + ttl, handle);
+            store->expiry_timer[slot] = id;
+            result = (id == TIMER_NONE) ? -1 : 1;
+        }
+    }
+    if (result < 0)
+    {
+        printf("Error: Memory allocation failed.\n");
+    }
+
+    return result;
+}
+
+/**
+ * @brief Move the clock of a store forward and remove the accounts whose deadline is reached.
+ *
+ * The accounts are removed as by Account_Store_Remove(), in order of their deadline.
+ *
+ * @param store The store.
+ * @param now The new tick of the clock, ignored if it is not after the current one.
+ * @param visit The function receiving the removed accounts, may be NULL. Its result is ignored.
+ * @param user_data Passed to visit.
+ * @return The number of accounts removed.
+ */
+uint64_t Account_Store_Expire(account_store_t* store, uint64_t now, account_visit_t visit, void* user_data)
+{
+    Store_Expiry_t expiry;      /* Work of the expiry */
+
+    expiry.store = store;
+    expiry.visit = visit;
+    expiry.user_data = user_data;
+    expiry.removed = 0;
+    Timer_Advance(&store->expiry, now, Store_Expire_Account, &expiry);
+
+    return expiry.removed;
+}
+
+/**
+ * @brief Get the clock of a store.
+ *
+ * @param store The store.
+ * @return The last tick given to Account_Store_Expire(), 0 before the first call.
+ */
+uint64_t Account_Store_Clock(const account_store_t* store)
+{
+    return store->expiry.now;
+}
+
+/**
+ * @brief Build the ordered index of a store and publish it to the views.
+ *
+ * It must be called where the store is changed, in the same thread or under the same
+ * lock. The index is built in O(n) on the first call; from then on every change of the
+ * store publishes its new version, until the index is dropped by a failed allocation
+ * or by emptying or loading the store.
+ *
+ * @param store The store.
+ * @return 1 if views can be pinned, 0 if memory allocation failed.
+ */
+int32_t Account_Store_Prepare_Views(account_store_t* store)
+{
+    int32_t result = (Store_Order(store) && Btree_Publish(&store->order)) ? 1 : 0;    /* Result of the publication */
+
+    if (result == 0)
+    {
+        printf("Error: Memory allocation failed.\n");
+    }
+
+    return result;
+}
+
+/**
+ * @brief Pin a view of the accounts of a store as they are now, from any thread, in O(1).
+ *
+ * The view is the last version of the ordered index published by Account_Store_Prepare_Views()
+ * or by the changes after it, so it can be pinned, read and released by any thread without
+ * a lock while the store keeps changing. The next change of the store copies the few nodes
+ * of the ordered index the view shares on its path. A store that may be destroyed meanwhile
+ * must be pinned inside a read section (see account_epoch.h).
+ *
+ * If the index is not published, no view is pinned and the next change of the store
+ * builds and publishes it, in the thread changing the store.
+ *
+ * @param store The store.
+ * @return The view, NULL if the ordered index is not published or if memory allocation failed.
+ */
+account_view_t* Account_Store_Pin_View(account_store_t* store)
+{
+    account_view_t* view = (account_view_t*)malloc(sizeof(account_view_t));    /* The new view */
+
+    if (view == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+    }
+    else if (Btree_Pin(&store->order, &view->order) == 0)
+    {
+        /* Ask the thread changing the store for the index */
+        atomic_store_explicit(&store->view_wanted, 1, memory_order_relaxed);
+        free(view);
+        view = NULL;
+    }
+
+    return view;
+}
+
+/**
+ * @brief Release a view, from any thread.
+ *
+ * The nodes of the ordered index that only the view still refers to are freed.
+ *
+ * @param view The view, may be NULL.
+ */
+void Account_View_Release(account_view_t* view)
+{
+    if (view != NULL)
+    {
+        Btree_Free(&view->order);
+        free(view);
+    }
+}
+
+/**
+ * @brief Get the number of accounts of a view.
+ *
+ * @param view The view.
+ * @return The number of accounts of the store when the view was pinned.
+ */
+uint64_t Account_View_Count(const account_view_t* view)
+{
+    return view->order.count;
+}
+
+/**
+ * @brief Check if an account is in a view.
+ *
+ * @param view The view.
+ * @param key The key of the account.
+ * @return 1 if the account was in the store when the view was pinned, 0 if not.
+ */
+int32_t Account_View_Contains(const account_view_t* view, uint64_t key)
+{
+    Btree_Cursor_t cursor;      /* Position of the key in the view */
+    uint64_t found = 0;         /* First key not smaller than the key */
+
+    Btree_Seek(&view->order, key, &cursor);
+
+    return (Btree_Next(&cursor, &found) && found == key) ? 1 : 0;
+}
+
+/**
+ * @brief Give the accounts of a view whose keys lie in a range to a function, in order.
+ *
+ * @param view The view.
+ * @param first The smallest key of the range.
+ * @param last The largest key of the range.
+ * @param visit The function receiving the accounts, NULL to only count them.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit.
+ */
+int64_t Account_View_Scan(const account_view_t* view, uint64_t first, uint64_t last, account_visit_t visit,
+                          void* user_data)
+{
+    return Store_Scan_Order(&view->order, first, last, visit, user_data);
+}
+
+/**
+ * @brief Place a cursor before the first account of a view, in alphabetical order.
+ *
+ * @param view The view.
+ * @param cursor Output, the cursor.
+ */
+void Account_View_Open_Cursor(const account_view_t* view, Account_Cursor_t* cursor)
+{
+    (void)view;
+    cursor->remaining = 0;
+    cursor->record = 0;
+    cursor->next_key = 0;
+    cursor->sorted = 1;
+    cursor->done = 0;
+    cursor->store = NULL;
+}
+
+/**
+ * @brief Read the next page of accounts of a cursor placed on a view.
+ *
+ * @param view The view the cursor was placed on.
+ * @param cursor The cursor, moved past the accounts read.
+ * @param keys Output, the keys of the accounts. May be NULL.
+ * @param accounts Output, the text of the accounts, NUL terminated. May be NULL.
+ * @param max The largest number of accounts of the page.
+ * @return The number of accounts read, 0 once the cursor is past the last account.
+ */
+int64_t Account_View_Next_Page(const account_view_t* view, Account_Cursor_t* cursor, uint64_t* keys,
+                               int8_t (*accounts)[ACCOUNT_MAX_LENGTH + 1U], uint32_t max)
+{
+    int64_t count = 0;          /* Number of accounts read */
+    uint64_t key = 0;           /* Key of the current account */
+    Btree_Cursor_t position;    /* Position in the version of the ordered index */
+
+    if (cursor->done == 0 && max > 0U)
+    {
+        /* The view never changes, the seek finds the place the previous page ended */
+        Btree_Seek(&view->order, cursor->next_key, &position);
+        while ((uint64_t)count < max && cursor->done == 0)
+        {
+            if (Btree_Next(&position, &key))
+            {
+                if (keys != NULL)
+                {
+                    keys[count] = key;
+                }
+                if (accounts != NULL)
+                {
+                    Account_Decode(key, accounts[count]);
+                }
+                count++;
+                /* The largest key has no successor */
+                cursor->next_key = key + 1U;
+                cursor->done = (cursor->next_key == 0U) ? 1 : 0;
+            }
+            else
+            {
+                cursor->done = 1;
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Set the false-positive rate of the filter of a store.
+ *
+ * The filter is rebuilt at once from the accounts of the store.
+ *
+ * @param store The store.
+ * @param rate The rate at which a lookup of an absent account still probes the index,
+ * between 0 and 1. 0 turns the filter off.
+ */
+void Account_Store_Set_Bloom_Rate(account_store_t* store, double rate)
+{
+    store->bloom_rate = (rate > 0.0 && rate < 1.0) ? rate : 0.0;
+    if (store->slots.live > 0U)
+    {
+        Store_Refresh_Bloom(store);
+    }
+}
+
+/**
+ * @brief Get the counters of the filter of a store.
+ *
+ * @param store The store.
+ * @param stats Output, the counters since the store was created.
+ */
+void Account_Store_Bloom_Stats(const account_store_t* store, Bloom_Stats_t* stats)
+{
+    *stats = store->bloom.stats;
+    stats->shared_queries = atomic_load_explicit(&store->shared_queries, memory_order_relaxed);
+    stats->shared_negatives = atomic_load_explicit(&store->shared_negatives, memory_order_relaxed);
+    stats->shared_false_positives = atomic_load_explicit(&store->shared_false_positives, memory_order_relaxed);
+}
+
+/**
+ * @brief Get the usage statistics of the slot array of a store.
+ *
+ * @param store The store.
+ * @param stats Output, the usage statistics.
+ */
+void Account_Store_Pool_Stats(const account_store_t* store, Pool_Stats_t* stats)
+{
+    Slots_Get_Stats(&store->slots, stats);
+} /* EOF */
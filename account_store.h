@@ -0,0 +1,472 @@
+/**
+ * @file account_store.h
+ * @brief This file contains the declarations of the stores of accounts.
+ *
+ * A store holds everything a list of accounts needs: the slot array of the accounts,
+ * the hash index, the filter in front of it, the ordered index, a loaded snapshot and
+ * a journal. Stores do not share any state, so a program can keep as many as it needs,
+ * one per tenant or per class for example, and fill a new one while another is served.
+ *
+ * A store is changed by one thread at a time. Account_Store_Search_Shared() may be
+ * called by any number of other threads meanwhile, every other function only by the
+ * thread that changes the store. The functions of account_manage.h work on the live
+ * store, which Swap_Account_Store() replaces.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include "account_manage.h"     /* For account_store_t, Account_Cursor_t, account_visit_t and Pool_Stats_t */
+
+#ifndef ACCOUNT_STORE_H
+#define ACCOUNT_STORE_H
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+extern account_store_t default_account_store;   /* Store that is live when the program starts */
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Create an empty store.
+ *
+ * @return The store, NULL if memory allocation failed.
+ */
+account_store_t* Account_Store_Create(void);
+
+/**
+ * @brief Close the journal of a store and release all its memory.
+ *
+ * The journal is closed without being reset. The default store is only emptied.
+ *
+ * @param store The store, may be NULL.
+ */
+void Account_Store_Destroy(account_store_t* store);
+
+/**
+ * @brief Add an account to a store.
+ *
+ * An account that is already in the store is not added again.
+ *
+ * @param store The store.
+ * @param key The key of the new account, as produced by Check_Account_Key().
+ * @return 1 if the account is added, 0 if it is already in the store, -1 if memory allocation failed.
+ */
+int32_t Account_Store_Add(account_store_t* store, uint64_t key);
+
+/**
+ * @brief Add an account to a store and get its handle.
+ *
+ * An account that is already in the store is not added again, its handle is given instead.
+ *
+ * @param store The store.
+ * @param key The key of the new account, as produced by Check_Account_Key().
+ * @param handle Output, the handle of the account, ACCOUNT_HANDLE_NONE if memory allocation
+ * failed. May be NULL.
+ * @return 1 if the account is added, 0 if it is already in the store, -1 if memory allocation failed.
+ */
+int32_t Account_Store_Add_Handle(account_store_t* store, uint64_t key, account_handle_t* handle);
+
+/**
+ * @brief Make room in a store for a number of new accounts.
+ *
+ * The slot array, the hash index and the filter are sized at once for the accounts of
+ * the store plus the new ones, so adding them does not grow or rebuild any of them.
+ * Nothing is reserved for a store that still serves a loaded snapshot.
+ *
+ * @param store The store.
+ * @param count The number of accounts about to be added.
+ * @return 1 if the room is made, 0 if memory allocation failed. The store is usable anyway.
+ */
+int32_t Account_Store_Reserve(account_store_t* store, uint64_t count);
+
+/**
+ * @brief Remove an account from a store.
+ *
+ * @param store The store.
+ * @param key The key of the account to be removed.
+ * @return 1 if the account is removed, 0 if not. -1 if the store is empty
+ */
+int32_t Account_Store_Remove(account_store_t* store, uint64_t key);
+
+/**
+ * @brief Remove the account of a handle from a store.
+ *
+ * The slot array finds the account without any search, the removal is then the one of
+ * Account_Store_Remove().
+ *
+ * @param store The store.
+ * @param handle The handle of the account, as given by Account_Store_Add_Handle().
+ * @return 1 if the account is removed, 0 if the handle is stale. -1 if the store is empty
+ */
+int32_t Account_Store_Remove_Handle(account_store_t* store, account_handle_t handle);
+
+/**
+ * @brief Search for an account in a store.
+ *
+ * @param store The store.
+ * @param key The key of the account to search for.
+ * @return The result of the search. -1 if the store is empty, 0 if the account is not found,
+ * 1 if the account is found.
+ */
+int32_t Account_Store_Search(account_store_t* store, uint64_t key);
+
+/**
+ * @brief Search for an account in a store without taking any lock.
+ *
+ * Any number of threads may call it at once, also while one thread changes the store.
+ * The search reads the copy of the loaded snapshot, the copy of the filter and the
+ * sharded set of the keys inside a read section. The filter answers most searches of
+ * absent accounts without the set; its counters are kept apart from those of the
+ * owner (see Bloom_Stats_t).
+ *
+ * @param store The store.
+ * @param key The key of the account to search for.
+ * @return The result of the search, as Account_Store_Search().
+ */
+int32_t Account_Store_Search_Shared(account_store_t* store, uint64_t key);
+
+/**
+ * @brief Remove many accounts from a store.
+ *
+ * The accounts are removed one after the other, in groups whose index buckets, slots
+ * and records are loaded into the cache together before the first removal of the
+ * group. Each result is the one Account_Store_Remove() would give at that point, so an
+ * account listed twice is removed once and the accounts after the last one removed
+ * find the store empty.
+ *
+ * @param store The store.
+ * @param keys The keys of the accounts, ACCOUNT_KEY_NONE for an account that is never found.
+ * @param count The number of keys.
+ * @param results Output, the result of each removal, as Account_Store_Remove(). May be NULL.
+ * @return The number of accounts removed.
+ */
+uint64_t Account_Store_Remove_Batch(account_store_t* store, const uint64_t* keys, uint64_t count, int32_t* results);
+
+/**
+ * @brief Search for many accounts in a store.
+ *
+ * The filter blocks of a group of accounts are loaded into the cache together, then
+ * the index buckets of the accounts the filter lets through, then the accounts are
+ * looked up.
+ *
+ * @param store The store.
+ * @param keys The keys of the accounts, ACCOUNT_KEY_NONE for an account that is never found.
+ * @param count The number of keys.
+ * @param results Output, the result of each search, as Account_Store_Search(). May be NULL.
+ * @return The number of accounts found.
+ */
+uint64_t Account_Store_Search_Batch(account_store_t* store, const uint64_t* keys, uint64_t count, int32_t* results);
+
+/**
+ * @brief Check if an account is in a store.
+ *
+ * @param store The store.
+ * @param key The key of the account.
+ * @return 1 if the account is in the store, 0 if not.
+ */
+int32_t Account_Store_Contains(account_store_t* store, uint64_t key);
+
+/**
+ * @brief Get the handle of an account of a store.
+ *
+ * A loaded snapshot is copied into the slot array first, as its accounts have no handle.
+ *
+ * @param store The store.
+ * @param key The key of the account.
+ * @return The handle of the account, ACCOUNT_HANDLE_NONE if it is not in the store or
+ * memory allocation failed.
+ */
+account_handle_t Account_Store_Find(account_store_t* store, uint64_t key);
+
+/**
+ * @brief Get the key of the account of a handle.
+ *
+ * @param store The store.
+ * @param handle The handle of the account.
+ * @param key Output, the key of the account. Left unchanged if the handle is stale.
+ * @return 1 if the handle names an account of the store, 0 if it is stale.
+ */
+int32_t Account_Store_Lookup(const account_store_t* store, account_handle_t handle, uint64_t* key);
+
+/**
+ * @brief Get the number of accounts of a store.
+ *
+ * @param store The store.
+ * @return The number of accounts.
+ */
+uint64_t Account_Store_Count(const account_store_t* store);
+
+/**
+ * @brief Give every account of a store to a function, in display order.
+ *
+ * @param store The store.
+ * @param visit The function receiving the accounts.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit.
+ */
+int64_t Account_Store_Iterate(account_store_t* store, account_visit_t visit, void* user_data);
+
+/**
+ * @brief Give the accounts of a store whose keys lie in a range to a function, in order.
+ *
+ * The ordered index of the store is built on the first call.
+ *
+ * @param store The store.
+ * @param first The smallest key of the range.
+ * @param last The largest key of the range.
+ * @param visit The function receiving the accounts, NULL to only count them.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit, -1 if memory allocation failed.
+ */
+int64_t Account_Store_Scan(account_store_t* store, uint64_t first, uint64_t last, account_visit_t visit,
+                           void* user_data);
+
+/**
+ * @brief Place a cursor before the first account of a store.
+ *
+ * In display order the store must not change until the last page is read. In
+ * alphabetical order each page starts after the last account of the previous one, so
+ * the store may change between pages: the accounts added after the cursor show up, the
+ * removed ones do not.
+ *
+ * @param store The store.
+ * @param sorted 1 for alphabetical order, 0 for display order.
+ * @param cursor Output, the cursor.
+ */
+void Account_Store_Open_Cursor(const account_store_t* store, int32_t sorted, Account_Cursor_t* cursor);
+
+/**
+ * @brief Read the next page of accounts of a cursor.
+ *
+ * The ordered index of the store is built by the first page in alphabetical order.
+ *
+ * @param store The store the cursor was placed on.
+ * @param cursor The cursor, moved past the accounts read.
+ * @param keys Output, the keys of the accounts. May be NULL.
+ * @param accounts Output, the text of the accounts, NUL terminated. May be NULL.
+ * @param max The largest number of accounts of the page.
+ * @return The number of accounts read, 0 once the cursor is past the last account,
+ * -1 if memory allocation failed.
+ */
+int64_t Account_Store_Next_Page(account_store_t* store, Account_Cursor_t* cursor, uint64_t* keys,
+                                int8_t (*accounts)[ACCOUNT_MAX_LENGTH + 1U], uint32_t max);
+
+/**
+ * @brief Collect the keys of every account of a store in display order.
+ *
+ * @param store The store.
+ * @param keys Output, a malloc() block holding the keys.
+ * @param count Output, the number of keys.
+ * @return 1 if the keys are collected, 0 if memory allocation failed.
+ */
+int32_t Account_Store_Keys(const account_store_t* store, uint64_t** keys, uint64_t* count);
+
+/**
+ * @brief Save the accounts of a store to a snapshot file.
+ *
+ * @param store The store.
+ * @param path The path of the snapshot file.
+ * @return SNAPSHOT_OK if the file is written, an error code if not.
+ */
+snapshot_status_t Account_Store_Save(account_store_t* store, const char* path);
+
+/**
+ * @brief Replace the accounts of a store with a snapshot file.
+ *
+ * The file is mapped into memory and searches are served from it directly. The accounts
+ * are copied into the slot array of the store the first time the store is changed.
+ *
+ * @param store The store.
+ * @param path The path of the snapshot file.
+ * @param verify 1 to check the checksum of the whole file, 0 to check the header only.
+ * @return SNAPSHOT_OK if the snapshot is loaded, an error code if not. On error the store is empty.
+ */
+snapshot_status_t Account_Store_Load(account_store_t* store, const char* path, int32_t verify);
+
+/**
+ * @brief Replay a journal over a store and log every later change of the store to it.
+ *
+ * @param store The store.
+ * @param path The path of the journal file.
+ * @param snapshot_path The snapshot written by the compactions, NULL to never compact.
+ * @param config The settings of the journal.
+ * @return JOURNAL_OK if the journal is open, an error code if not.
+ */
+journal_status_t Account_Store_Open_Journal(account_store_t* store, const char* path, const char* snapshot_path,
+                                            const Journal_Config_t* config);
+
+/**
+ * @brief Commit the pending changes of a store and close its journal.
+ *
+ * @param store The store.
+ * @param reset 1 if the store was just saved to the snapshot file, which empties the journal.
+ * @return JOURNAL_OK if every change is on the disk, an error code if not.
+ */
+journal_status_t Account_Store_Close_Journal(account_store_t* store, int32_t reset);
+
+/**
+ * @brief Get the counters of the journal of a store.
+ *
+ * @param store The store.
+ * @param stats Output, the counters since the journal was opened.
+ */
+void Account_Store_Journal_Stats(account_store_t* store, Journal_Stats_t* stats);
+
+/**
+ * @brief Give an account of a store a time to live.
+ *
+ * The account is removed by the first call of Account_Store_Expire() that moves the
+ * clock of the store to its deadline or past it. A new time to live replaces the
+ * previous one. The deadlines are kept in memory only: they are not journaled nor
+ * saved in snapshots, and loading a snapshot drops them.
+ *
+ * @param store The store.
+ * @param handle The handle of the account.
+ * @param ttl The ticks from the clock of the store to the deadline, 0 to keep the account.
+ * @return 1 if the time to live is set, 0 if the handle is stale, -1 if memory allocation failed.
+ */
+int32_t Account_Store_Set_Ttl(account_store_t* store, account_handle_t handle, uint64_t ttl);
+
+/**
+ * @brief Move the clock of a store forward and remove the accounts whose deadline is reached.
+ *
+ * The accounts are removed as by Account_Store_Remove(), in order of their deadline.
+ *
+ * @param store The store.
+ * @param now The new tick of the clock, ignored if it is not after the current one.
+ * @param visit The function receiving the removed accounts, may be NULL. Its result is ignored.
+ * @param user_data Passed to visit.
+ * @return The number of accounts removed.
+ */
+uint64_t Account_Store_Expire(account_store_t* store, uint64_t now, account_visit_t visit, void* user_data);
+
+/**
+ * @brief Get the clock of a store.
+ *
+ * @param store The store.
+ * @return The last tick given to Account_Store_Expire(), 0 before the first call.
+ */
+uint64_t Account_Store_Clock(const account_store_t* store);
+
+/**
+ * @brief Build the ordered index of a store and publish it to the views.
+ *
+ * It must be called where the store is changed, in the same thread or under the same
+ * lock. The index is built in O(n) on the first call; from then on every change of the
+ * store publishes its new version, until the index is dropped by a failed allocation
+ * or by emptying or loading the store.
+ *
+ * @param store The store.
+ * @return 1 if views can be pinned, 0 if memory allocation failed.
+ */
+int32_t Account_Store_Prepare_Views(account_store_t* store);
+
+/**
+ * @brief Pin a view of the accounts of a store as they are now, from any thread, in O(1).
+ *
+ * The view is the last version of the ordered index published by Account_Store_Prepare_Views()
+ * or by the changes after it, so it can be pinned, read and released by any thread without
+ * a lock while the store keeps changing. A store that may be destroyed meanwhile must be
+ * pinned inside a read section (see account_epoch.h).
+ *
+ * If the index is not published, no view is pinned and the next change of the store
+ * builds and publishes it, in the thread changing the store.
+ *
+ * @param store The store.
+ * @return The view, NULL if the ordered index is not published or if memory allocation failed.
+ */
+account_view_t* Account_Store_Pin_View(account_store_t* store);
+
+/**
+ * @brief Release a view, from any thread.
+ *
+ * @param view The view, may be NULL.
+ */
+void Account_View_Release(account_view_t* view);
+
+/**
+ * @brief Get the number of accounts of a view.
+ *
+ * @param view The view.
+ * @return The number of accounts of the store when the view was pinned.
+ */
+uint64_t Account_View_Count(const account_view_t* view);
+
+/**
+ * @brief Check if an account is in a view.
+ *
+ * @param view The view.
+ * @param key The key of the account.
+ * @return 1 if the account was in the store when the view was pinned, 0 if not.
+ */
+int32_t Account_View_Contains(const account_view_t* view, uint64_t key);
+
+/**
+ * @brief Give the accounts of a view whose keys lie in a range to a function, in order.
+ *
+ * @param view The view.
+ * @param first The smallest key of the range.
+ * @param last The largest key of the range.
+ * @param visit The function receiving the accounts, NULL to only count them.
+ * @param user_data Passed to visit.
+ * @return The number of accounts given to visit.
+ */
+int64_t Account_View_Scan(const account_view_t* view, uint64_t first, uint64_t last, account_visit_t visit,
+                          void* user_data);
+
+/**
+ * @brief Place a cursor before the first account of a view, in alphabetical order.
+ *
+ * @param view The view.
+ * @param cursor Output, the cursor.
+ */
+void Account_View_Open_Cursor(const account_view_t* view, Account_Cursor_t* cursor);
+
+/**
+ * @brief Read the next page of accounts of a cursor placed on a view.
+ *
+ * @param view The view the cursor was placed on.
+ * @param cursor The cursor, moved past the accounts read.
+ * @param keys Output, the keys of the accounts. May be NULL.
+ * @param accounts Output, the text of the accounts, NUL terminated. May be NULL.
+ * @param max The largest number of accounts of the page.
+ * @return The number of accounts read, 0 once the cursor is past the last account.
+ */
+int64_t Account_View_Next_Page(const account_view_t* view, Account_Cursor_t* cursor, uint64_t* keys,
+                               int8_t (*accounts)[ACCOUNT_MAX_LENGTH + 1U], uint32_t max);
+
+/**
+ * @brief Set the false-positive rate of the filter of a store.
+ *
+ * The filter is rebuilt at once from the accounts of the store.
+ *
+ * @param store The store.
+ * @param rate The rate at which a lookup of an absent account still probes the index,
+ * between 0 and 1. 0 turns the filter off.
+ */
+void Account_Store_Set_Bloom_Rate(account_store_t* store, double rate);
+
+/**
+ * @brief Get the counters of the filter of a store.
+ *
+ * @param store The store.
+ * @param stats Output, the counters since the store was created.
+ */
+void Account_Store_Bloom_Stats(const account_store_t* store, Bloom_Stats_t* stats);
+
+/**
+ * @brief Get the usage statistics of the slot array of a store.
+ *
+ * @param store The store.
+ * @param stats Output, the usage statistics.
+ */
+void Account_Store_Pool_Stats(const account_store_t* store, Pool_Stats_t* stats);
+
+#endif /* ACCOUNT_STORE_H */
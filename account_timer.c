@@ -0,0 +1,351 @@
+/**
+ * @file account_timer.c
+ * @brief This file contains the implementation of the hierarchical timer wheel behind the expiry of the accounts.
+ *
+ * A timer goes to the level of the highest 8-bit digit in which its deadline differs
+ * from the clock, in the slot given by that digit of the deadline. The clock reaches the
+ * start of that slot before the deadline, and from there the deadline differs from the
+ * clock in a lower digit only, so moving the timer down puts it in a lower level.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "account_timer.h"      /* Include header file of this function file */
+#include <stdlib.h>             /* For realloc() and free() */
+#include <string.h>             /* For memset() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define TIMER_OVERFLOW          (TIMER_BUCKETS - 1U)    /* Bucket of the deadlines beyond the highest level */
+#define TIMER_MAX_CAPACITY      (1U << 31)              /* Largest number of timers */
+#define TIMER_SLOT_MASK         (TIMER_SLOTS - 1U)      /* Slot of a digit of the clock */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Find the bucket of a deadline, for the current tick of the clock.
+ *
+ * @param wheel The wheel.
+ * @param deadline The deadline, after the current tick.
+ * @return The bucket of the deadline.
+ */
+static uint32_t Timer_Bucket(const Timer_Wheel_t* wheel, uint64_t deadline)
+{
+    uint64_t differ = deadline ^ wheel->now;    /* Bits in which the deadline differs from the clock */
+    uint32_t level = 0;                         /* Level of the deadline */
+    uint32_t bucket = TIMER_OVERFLOW;           /* Bucket of the deadline */
+
+    while (level < TIMER_LEVELS && (differ >> (TIMER_SLOT_BITS * (level + 1U))) != 0U)
+    {
+        level++;
+    }
+    if (level < TIMER_LEVELS)
+    {
+        bucket = level * TIMER_SLOTS + (uint32_t)((deadline >> (TIMER_SLOT_BITS * level)) & TIMER_SLOT_MASK);
+    }
+
+    return bucket;
+}
+
+/**
+ * @brief Put a timer at the head of the bucket of its deadline.
+ *
+ * @param wheel The wheel.
+ * @param id The id of the timer.
+ */
+static void Timer_Link(Timer_Wheel_t* wheel, uint32_t id)
+{
+    Timer_t* timer = &wheel->timer[id - 1U];                /* The timer */
+    uint32_t bucket = Timer_Bucket(wheel, timer->deadline); /* Bucket of the timer */
+
+    timer->bucket = bucket + 1U;
+    timer->prev = TIMER_NONE;
+    timer->next = wheel->head[bucket];
+    if (timer->next != TIMER_NONE)
+    {
+        wheel->timer[timer->next - 1U].prev = id;
+    }
+    wheel->head[bucket] = id;
+    if (bucket < TIMER_SLOTS)
+    {
+        wheel->occupied[bucket >> 6] |= 1ULL << (bucket & 63U);
+    }
+}
+
+/**
+ * @brief Take a timer out of its bucket.
+ *
+ * @param wheel The wheel.
+ * @param id The id of the timer.
+ */
+static void Timer_Unlink(Timer_Wheel_t* wheel, uint32_t id)
+{
+    Timer_t* timer = &wheel->timer[id - 1U];    /* The timer */
+    uint32_t bucket = timer->bucket - 1U;       /* Bucket of the timer */
+
+    if (timer->prev != TIMER_NONE)
+    {
+        wheel->timer[timer->prev - 1U].next = timer->next;
+    }
+    else
+    {
+        wheel->head[bucket] = timer->next;
+    }
+    if (timer->next != TIMER_NONE)
+    {
+        wheel->timer[timer->next - 1U].prev = timer->prev;
+    }
+    if (bucket < TIMER_SLOTS && wheel->head[bucket] == TIMER_NONE)
+    {
+        wheel->occupied[bucket >> 6] &= ~(1ULL << (bucket & 63U));
+    }
+}
+
+/**
+ * @brief Put an unlinked timer on the free list.
+ *
+ * @param wheel The wheel.
+ * @param id The id of the timer.
+ */
+static void Timer_Release(Timer_Wheel_t* wheel, uint32_t id)
+{
+    wheel->timer[id - 1U].bucket = 0U;
+    wheel->timer[id - 1U].next = wheel->free_timer;
+    wheel->free_timer = id;
+    wheel->pending--;
+}
+
+/**
+ * @brief Double the array of the timers.
+ *
+ * @param wheel The wheel.
+ * @return 1 if the array has room for one more timer, 0 if memory allocation failed.
+ */
+static int32_t Timer_Grow(Timer_Wheel_t* wheel)
+{
+    int32_t result = 0;         /* Result of the growth */
+    uint64_t capacity = (wheel->capacity == 0U) ? TIMER_MIN_CAPACITY : 2U * (uint64_t)wheel->capacity;   /* New capacity */
+    Timer_t* timer = NULL;      /* The larger array */
+
+    if (capacity <= TIMER_MAX_CAPACITY)
+    {
+        timer = (Timer_t*)realloc(wheel->timer, (size_t)capacity * sizeof(Timer_t));
+        if (timer != NULL)
+        {
+            wheel->timer = timer;
+            wheel->capacity = (uint32_t)capacity;
+            result = 1;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Move the timers of a bucket to the buckets of their deadline for the current tick.
+ *
+ * The bucket is emptied first, so a timer still too far away for the levels can go
+ * back to the overflow list.
+ *
+ * @param wheel The wheel.
+ * @param bucket The bucket.
+ */
+static void Timer_Cascade(Timer_Wheel_t* wheel, uint32_t bucket)
+{
+    uint32_t id = wheel->head[bucket];  /* Timer being moved */
+    uint32_t next = TIMER_NONE;         /* Next timer of the bucket */
+
+    wheel->head[bucket] = TIMER_NONE;
+    while (id != TIMER_NONE)
+    {
+        next = wheel->timer[id - 1U].next;
+        Timer_Link(wheel, id);
+        id = next;
+    }
+}
+
+/**
+ * @brief Find the first slot of level 0 holding a timer, from a slot on.
+ *
+ * @param wheel The wheel.
+ * @param slot The first slot to look at.
+ * @return The slot, TIMER_SLOTS if no slot from there holds a timer.
+ */
+static uint32_t Timer_Next_Occupied(const Timer_Wheel_t* wheel, uint32_t slot)
+{
+    uint32_t word = slot >> 6;                              /* Word of the bitmap */
+    uint64_t bits = wheel->occupied[word] & (~0ULL << (slot & 63U));   /* Occupied slots of the word from slot on */
+    uint32_t found = 0;                                     /* Bit of the first occupied slot */
+
+    while (bits == 0U && word + 1U < TIMER_SLOTS / 64U)
+    {
+        word++;
+        bits = wheel->occupied[word];
+    }
+    if (bits == 0U)
+    {
+        found = TIMER_SLOTS - word * 64U;
+    }
+    else
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        found = (uint32_t)__builtin_ctzll(bits);
+#else
+        while (((bits >> found) & 1U) == 0U)
+        {
+            found++;
+        }
+#endif
+    }
+
+    return word * 64U + found;
+}
+
+/**
+ * @brief Schedule a timer.
+ *
+ * A deadline that is already reached fires at the next tick.
+ *
+ * @param wheel The wheel.
+ * @param deadline The tick at which the timer fires.
+ * @param payload The value given back when the timer fires.
+ * @return The id of the timer, TIMER_NONE if memory allocation failed.
+ */
+uint32_t Timer_Schedule(Timer_Wheel_t* wheel, uint64_t deadline, uint64_t payload)
+{
+    uint32_t id = TIMER_NONE;   /* Id of the new timer */
+
+    /* Reuse a free timer, or take the next one of the array */
+    if (wheel->free_timer != TIMER_NONE)
+    {
+        id = wheel->free_timer;
+        wheel->free_timer = wheel->timer[id - 1U].next;
+    }
+    else if (wheel->used < wheel->capacity || Timer_Grow(wheel))
+    {
+        wheel->used++;
+        id = wheel->used;
+    }
+
+    if (id != TIMER_NONE)
+    {
+        wheel->timer[id - 1U].deadline = (deadline > wheel->now) ? deadline : wheel->now + 1U;
+        wheel->timer[id - 1U].payload = payload;
+        Timer_Link(wheel, id);
+        wheel->pending++;
+    }
+
+    return id;
+}
+
+/**
+ * @brief Cancel a timer that has not fired yet.
+ *
+ * The id must be one given by Timer_Schedule() whose timer has neither fired nor
+ * been cancelled, ids are reused.
+ *
+ * @param wheel The wheel.
+ * @param id The id of the timer.
+ */
+void Timer_Cancel(Timer_Wheel_t* wheel, uint32_t id)
+{
+    if (id != TIMER_NONE && id <= wheel->used && wheel->timer[id - 1U].bucket != 0U)
+    {
+        Timer_Unlink(wheel, id);
+        Timer_Release(wheel, id);
+    }
+}
+
+/**
+ * @brief Move the clock of the wheel forward and fire the timers that are due.
+ *
+ * The timers fire in order of their deadline, those of the same tick in no set order.
+ * The ticks without timers are skipped 256 at a time.
+ *
+ * @param wheel The wheel.
+ * @param now The new tick of the clock, ignored if it is not after the current one.
+ * @param fire The function receiving the timers that fire.
+ * @param user_data Passed to fire.
+ * @return The number of timers fired.
+ */
+uint64_t Timer_Advance(Timer_Wheel_t* wheel, uint64_t now, timer_fire_t fire, void* user_data)
+{
+    uint64_t fired = 0;         /* Number of timers fired */
+    uint64_t tick = 0;          /* Next tick of the clock */
+    uint32_t slot = 0;          /* Slot of level 0 of the next tick */
+    uint32_t next = 0;          /* Next slot of level 0 holding a timer */
+    uint32_t level = 0;         /* Level counter */
+    uint32_t id = TIMER_NONE;   /* Timer firing */
+    uint64_t payload = 0;       /* Payload of the timer firing */
+
+    while (wheel->now < now)
+    {
+        tick = wheel->now + 1U;
+        slot = (uint32_t)tick & TIMER_SLOT_MASK;
+        if (wheel->pending == 0U)
+        {
+            wheel->now = now;
+        }
+        /* Within the span of level 0, go straight to the tick before the next slot holding a timer */
+        else if (slot != 0U && (next = Timer_Next_Occupied(wheel, slot)) != slot)
+        {
+            tick += (uint64_t)(next - slot) - 1U;
+            wheel->now = (tick < now) ? tick : now;
+        }
+        else
+        {
+            wheel->now = tick;
+            /* At the start of a span, move down the timers of the higher levels whose slot starts here */
+            if (slot == 0U)
+            {
+                if ((tick & UINT32_MAX) == 0U)
+                {
+                    Timer_Cascade(wheel, TIMER_OVERFLOW);
+                }
+                for (level = TIMER_LEVELS - 1U; level > 0U; level--)
+                {
+                    if ((tick & ((1ULL << (TIMER_SLOT_BITS * level)) - 1U)) == 0U)
+                    {
+                        Timer_Cascade(wheel, level * TIMER_SLOTS +
+                                      (uint32_t)((tick >> (TIMER_SLOT_BITS * level)) & TIMER_SLOT_MASK));
+                    }
+                }
+            }
+            /* Take the timers one at a time, fire may cancel the others */
+            while (wheel->head[slot] != TIMER_NONE)
+            {
+                id = wheel->head[slot];
+                payload = wheel->timer[id - 1U].payload;
+                Timer_Unlink(wheel, id);
+                Timer_Release(wheel, id);
+                fired++;
+                fire(payload, user_data);
+            }
+        }
+    }
+
+    return fired;
+}
+
+/**
+ * @brief Release the memory of the wheel.
+ *
+ * Every pending timer is dropped without firing. The clock keeps its tick, so the
+ * wheel can be reused.
+ *
+ * @param wheel The wheel.
+ */
+void Timer_Destroy(Timer_Wheel_t* wheel)
+{
+    uint64_t now = wheel->now;  /* Tick of the clock */
+
+    free(wheel->timer);
+    memset(wheel, 0, sizeof(Timer_Wheel_t));
+    wheel->now = now;
+} /* EOF */
@@ -0,0 +1,131 @@
+/**
+ * @file account_timer.h
+ * @brief This file contains the declarations of the hierarchical timer wheel behind the expiry of the accounts.
+ *
+ * Time is counted in ticks, whose length is chosen by the caller. The wheel has four
+ * levels of 256 slots: level 0 holds the timers of the next 256 ticks one slot per tick,
+ * and each higher level covers 256 times the span of the one below. A timer is put in
+ * the lowest level whose span still reaches its deadline, so scheduling and cancelling
+ * are O(1). When the clock enters the span of a slot of a higher level, the timers of
+ * that slot are moved down, so each timer is moved at most four times before it fires.
+ * Deadlines more than 2^32 ticks away wait in an overflow list until the clock gets
+ * close enough.
+ *
+ * The timers live in one array and are linked by index, so the wheel holds no pointer
+ * into its own memory and grows with a single realloc().
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+
+#ifndef ACCOUNT_TIMER_H
+#define ACCOUNT_TIMER_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define TIMER_NONE              0U      /* A timer id no timer is given, never valid */
+#define TIMER_LEVELS            4U      /* Levels of the wheel */
+#define TIMER_SLOT_BITS         8U      /* Bits of the clock covered by a level */
+#define TIMER_SLOTS             (1U << TIMER_SLOT_BITS)     /* Slots of a level */
+#define TIMER_BUCKETS           (TIMER_LEVELS * TIMER_SLOTS + 1U)   /* Slots of every level and the overflow list */
+#define TIMER_MIN_CAPACITY      1024U   /* Timers allocated with the first one */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for a timer of the wheel.
+ */
+typedef struct
+{
+    uint64_t deadline;          /* Tick at which the timer fires. */
+    uint64_t payload;           /* Value given back when the timer fires. */
+    uint32_t next;              /* Id of the next timer of the bucket, or of the free list. */
+    uint32_t prev;              /* Id of the previous timer of the bucket, TIMER_NONE for the first one. */
+    uint32_t bucket;            /* Bucket of the timer plus one, 0 when the timer is free. */
+} Timer_t;
+
+/**
+ * @brief Structure for the timer wheel.
+ *
+ * A zero-initialized structure is a valid empty wheel whose clock is at tick 0.
+ */
+typedef struct
+{
+    Timer_t* timer;             /* Timer of each id minus one. */
+    uint32_t capacity;          /* Timers the array can hold. */
+    uint32_t used;              /* Timers handed out so far, free or not. */
+    uint32_t pending;           /* Timers waiting to fire. */
+    uint32_t free_timer;        /* Id of the first free timer, TIMER_NONE if none. */
+    uint64_t now;               /* Last tick the wheel has reached. */
+    uint32_t head[TIMER_BUCKETS];   /* Id of the first timer of each bucket. */
+    uint64_t occupied[TIMER_SLOTS / 64U];   /* Bit of each slot of level 0 holding a timer. */
+} Timer_Wheel_t;
+
+/**
+ * @brief Typedef for the function receiving the timers that fire.
+ *
+ * The function may schedule and cancel timers of the wheel.
+ *
+ * @param payload The payload of the timer.
+ * @param user_data The pointer given to Timer_Advance().
+ */
+typedef void (*timer_fire_t)(uint64_t payload, void* user_data);
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Schedule a timer.
+ *
+ * A deadline that is already reached fires at the next tick.
+ *
+ * @param wheel The wheel.
+ * @param deadline The tick at which the timer fires.
+ * @param payload The value given back when the timer fires.
+ * @return The id of the timer, TIMER_NONE if memory allocation failed.
+ */
+uint32_t Timer_Schedule(Timer_Wheel_t* wheel, uint64_t deadline, uint64_t payload);
+
+/**
+ * @brief Cancel a timer that has not fired yet.
+ *
+ * The id must be one given by Timer_Schedule() whose timer has neither fired nor
+ * been cancelled, ids are reused.
+ *
+ * @param wheel The wheel.
+ * @param id The id of the timer.
+ */
+void Timer_Cancel(Timer_Wheel_t* wheel, uint32_t id);
+
+/**
+ * @brief Move the clock of the wheel forward and fire the timers that are due.
+ *
+ * The timers fire in order of their deadline, those of the same tick in no set order.
+ * The ticks without timers are skipped 256 at a time.
+ *
+ * @param wheel The wheel.
+ * @param now The new tick of the clock, ignored if it is not after the current one.
+ * @param fire The function receiving the timers that fire.
+ * @param user_data Passed to fire.
+ * @return The number of timers fired.
+ */
+uint64_t Timer_Advance(Timer_Wheel_t* wheel, uint64_t now, timer_fire_t fire, void* user_data);
+
+/**
+ * @brief Release the memory of the wheel.
+ *
+ * Every pending timer is dropped without firing. The clock keeps its tick, so the
+ * wheel can be reused.
+ *
+ * @param wheel The wheel.
+ */
+void Timer_Destroy(Timer_Wheel_t* wheel);
+
+#endif /* ACCOUNT_TIMER_H */
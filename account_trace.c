@@ -0,0 +1,303 @@
+/**
+ * @file account_trace.c
+ * @brief This file contains the implementation of the operation traces of the account list.
+ *
+ * The records are written through the buffer of the file, so recording an operation
+ * costs a clock read and a short copy under the lock, not a system call.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "account_trace.h"      /* Include header file of this function file */
+#include <string.h>             /* For memcmp() */
+#ifdef _WIN32
+#include <windows.h>            /* For QueryPerformanceCounter() */
+#else
+#include <time.h>               /* For clock_gettime() */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define TRACE_BUFFER_SIZE       (64U * 1024U)   /* Buffer of a trace file */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return The time in ns.
+ */
+static uint64_t Trace_Now(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;     /* Ticks of the performance counter per second */
+    LARGE_INTEGER counter;              /* Current value of the performance counter */
+
+    if (frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;                /* Current time */
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Check if a byte is a known operation.
+ *
+ * @param op The byte.
+ * @return 1 if the byte is a trace_op_t, 0 if not.
+ */
+static int32_t Trace_Is_Op(int32_t op)
+{
+    return (op == TRACE_CHECK || op == TRACE_ADD || op == TRACE_REMOVE || op == TRACE_SEARCH ||
+            op == TRACE_EXISTS) ? 1 : 0;
+}
+
+/**
+ * @brief Create a trace file and start its clock.
+ *
+ * @param writer Output, the trace.
+ * @param path The path of the trace file, replaced if it exists.
+ * @return TRACE_OK if the trace is created, TRACE_IO_ERROR if not.
+ */
+trace_status_t Trace_Create(Trace_Writer_t* writer, const char* path)
+{
+    trace_status_t status = TRACE_OK;   /* Result of the creation */
+
+    writer->file = fopen(path, "wb");
+    writer->last_ns = 0;
+    writer->records = 0;
+    writer->failed = 0;
+    if (writer->file == NULL)
+    {
+        status = TRACE_IO_ERROR;
+    }
+    else if (setvbuf(writer->file, NULL, _IOFBF, TRACE_BUFFER_SIZE) != 0 ||
+             fwrite(TRACE_MAGIC, 1U, TRACE_HEADER_SIZE, writer->file) != TRACE_HEADER_SIZE)
+    {
+        fclose(writer->file);
+        writer->file = NULL;
+        status = TRACE_IO_ERROR;
+    }
+    else
+    {
+        pthread_mutex_init(&writer->lock, NULL);
+        writer->start_ns = Trace_Now();
+    }
+
+    return status;
+}
+
+/**
+ * @brief Append a record to a trace, timed now.
+ *
+ * @param writer The trace.
+ * @param op The operation.
+ * @param account The account, as given to the operation.
+ * @param length The length of the account.
+ * @param result The result of the operation.
+ */
+void Trace_Write(Trace_Writer_t* writer, trace_op_t op, const int8_t* account, uint8_t length, int32_t result)
+{
+    uint8_t record[3U + TRACE_MAX_DELTA_BYTES]; /* Op, delta, result and length of the record */
+    uint32_t used = 0;          /* Bytes of record in use */
+    uint64_t now = 0;           /* Time of the record since the start */
+    uint64_t delta = 0;         /* Time since the previous record */
+
+    pthread_mutex_lock(&writer->lock);
+    /* The clock is read under the lock, so the records are in time order */
+    now = Trace_Now() - writer->start_ns;
+    delta = (now > writer->last_ns) ? now - writer->last_ns : 0U;
+    writer->last_ns += delta;
+
+    record[used++] = (uint8_t)op;
+    do
+    {
+        record[used] = (uint8_t)(delta & 0x7FU);
+        delta >>= 7;
+        record[used] |= (delta != 0U) ? 0x80U : 0U;
+        used++;
+    } while (delta != 0U);
+    record[used++] = (uint8_t)(int8_t)result;
+    record[used++] = length;
+
+    if (fwrite(record, 1U, used, writer->file) != used ||
+        fwrite(account, 1U, length, writer->file) != length)
+    {
+        writer->failed = 1;
+    }
+    writer->records++;
+    pthread_mutex_unlock(&writer->lock);
+}
+
+/**
+ * @brief Write the buffered records of a trace and close it.
+ *
+ * @param writer The trace.
+ * @return TRACE_OK if every record is in the file, TRACE_IO_ERROR if not.
+ */
+trace_status_t Trace_Finish(Trace_Writer_t* writer)
+{
+    trace_status_t status = TRACE_OK;   /* Result of the close */
+
+    if (writer->file != NULL)
+    {
+        status = (fclose(writer->file) != 0 || writer->failed) ? TRACE_IO_ERROR : TRACE_OK;
+        writer->file = NULL;
+        pthread_mutex_destroy(&writer->lock);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Open a trace file for reading.
+ *
+ * @param reader Output, the trace.
+ * @param path The path of the trace file.
+ * @return TRACE_OK if the trace is open, an error code if not.
+ */
+trace_status_t Trace_Open(Trace_Reader_t* reader, const char* path)
+{
+    trace_status_t status = TRACE_OK;   /* Result of the opening */
+    uint8_t magic[TRACE_HEADER_SIZE];   /* First bytes of the file */
+
+    reader->file = fopen(path, "rb");
+    reader->time_ns = 0;
+    reader->records = 0;
+    if (reader->file == NULL)
+    {
+        status = TRACE_IO_ERROR;
+    }
+    else if (setvbuf(reader->file, NULL, _IOFBF, TRACE_BUFFER_SIZE) != 0 ||
+             fread(magic, 1U, TRACE_HEADER_SIZE, reader->file) != TRACE_HEADER_SIZE ||
+             memcmp(magic, TRACE_MAGIC, TRACE_HEADER_SIZE) != 0)
+    {
+        fclose(reader->file);
+        reader->file = NULL;
+        status = TRACE_BAD_FORMAT;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Read the next record of a trace.
+ *
+ * @param reader The trace.
+ * @param record Output, the record.
+ * @return 1 if a record is read, 0 at the end of the trace, -1 if the record is cut short or unknown.
+ */
+int32_t Trace_Read(Trace_Reader_t* reader, Trace_Record_t* record)
+{
+    int32_t result = 1;         /* Result of the read */
+    int32_t byte = getc(reader->file);  /* Current byte of the record */
+    uint64_t delta = 0;         /* Time since the previous record */
+    uint32_t shift = 0;         /* Position of the next 7 bits of the delta */
+    int32_t more = 1;           /* Set while the delta has more bytes */
+
+    if (byte == EOF)
+    {
+        result = 0;
+    }
+    else if (Trace_Is_Op(byte) == 0)
+    {
+        result = -1;
+    }
+    else
+    {
+        record->op = (trace_op_t)byte;
+        while (more && result == 1)
+        {
+            byte = getc(reader->file);
+            if (byte == EOF || shift >= 64U)
+            {
+                result = -1;
+            }
+            else
+            {
+                delta |= (uint64_t)(byte & 0x7F) << shift;
+                shift += 7U;
+                more = ((byte & 0x80) != 0) ? 1 : 0;
+            }
+        }
+        if (result == 1)
+        {
+            byte = getc(reader->file);
+            record->result = (int32_t)(int8_t)(uint8_t)byte;
+            byte = (byte == EOF) ? EOF : getc(reader->file);
+            record->length = (uint8_t)byte;
+            if (byte == EOF || fread(record->account, 1U, record->length, reader->file) != record->length)
+            {
+                result = -1;
+            }
+            else
+            {
+                record->account[record->length] = 0;
+                reader->time_ns += delta;
+                record->time_ns = reader->time_ns;
+                reader->records++;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Close a trace being read.
+ *
+ * @param reader The trace.
+ */
+void Trace_Close(Trace_Reader_t* reader)
+{
+    if (reader->file != NULL)
+    {
+        fclose(reader->file);
+        reader->file = NULL;
+    }
+}
+
+/**
+ * @brief Get a message describing a result of the trace functions.
+ *
+ * @param status The result.
+ * @return A constant string describing the result.
+ */
+const char* Trace_Status_Message(trace_status_t status)
+{
+    const char* message = "Unknown error";     /* Message of the result */
+
+    switch (status)
+    {
+        case TRACE_OK:
+        {
+            message = "Success";
+            break;
+        }
+        case TRACE_IO_ERROR:
+        {
+            message = "File cannot be opened, read or written";
+            break;
+        }
+        case TRACE_BAD_FORMAT:
+        {
+            message = "File is not a trace";
+            break;
+        }
+    }
+
+    return message;
+} /* EOF */
@@ -0,0 +1,169 @@
+/**
+ * @file account_trace.h
+ * @brief This file contains the declarations of the operation traces of the account list.
+ *
+ * A trace records the checks, additions, removals and searches made on the list, with
+ * the time of each one, so a real session can be replayed later at full speed or with
+ * its original pacing. The account is kept as it was given, so the invalid input of a
+ * session is replayed too.
+ *
+ * File layout:
+ *
+ *      uint8_t magic[8]                TRACE_MAGIC
+ *      records, each one:
+ *          uint8_t op                  trace_op_t
+ *          varint delta                ns since the previous record, 7 bits per byte, low bits first
+ *          uint8_t result              result of the operation, as a signed byte
+ *          uint8_t length              length of the account
+ *          uint8_t account[length]     the account, as given
+ *
+ * A record of a 10-character account made within 2 ms of the previous one takes 16 bytes.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>             /* Include standard integer types library for fixed-width integers */
+#include <stdio.h>              /* For FILE */
+#include <pthread.h>            /* For the lock of a trace being written */
+
+#ifndef ACCOUNT_TRACE_H
+#define ACCOUNT_TRACE_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define TRACE_MAGIC             "ACCTTRCE"  /* First 8 bytes of a trace file */
+#define TRACE_HEADER_SIZE       8U          /* Size of the magic */
+#define TRACE_MAX_DELTA_BYTES   10U         /* Longest varint of a 64-bit delta */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the operations stored in a trace.
+ */
+typedef enum
+{
+    TRACE_CHECK = 'C',          /* Check_Account_Key(), the result is the status. */
+    TRACE_ADD = 'A',            /* Add_Account() or Add_Account_Key(). */
+    TRACE_REMOVE = 'R',         /* Remove_Account() or Remove_Account_Key(). */
+    TRACE_SEARCH = 'S',         /* Search_Account() or Search_Account_Key(). */
+    TRACE_EXISTS = 'E'          /* Is_Account_Exist() or Is_Account_Key_Exist(). */
+} trace_op_t;
+
+/**
+ * @brief Enumeration for the results of the trace functions.
+ */
+typedef enum
+{
+    TRACE_OK,                   /* The operation succeeded. */
+    TRACE_IO_ERROR,             /* The file cannot be opened, read or written. */
+    TRACE_BAD_FORMAT            /* The file is not a trace. */
+} trace_status_t;
+
+/**
+ * @brief Structure for a record of a trace.
+ */
+typedef struct
+{
+    trace_op_t op;              /* The operation. */
+    int32_t result;             /* The result of the operation when it was recorded. */
+    uint64_t time_ns;           /* Time of the operation since the trace started. */
+    uint8_t length;             /* Length of the account. */
+    int8_t account[UINT8_MAX + 1U];     /* The account, NUL terminated. */
+} Trace_Record_t;
+
+/**
+ * @brief Structure for a trace being written.
+ *
+ * Records can be written from any thread.
+ */
+typedef struct
+{
+    FILE* file;                 /* Trace file. */
+    uint64_t start_ns;          /* Time the trace started. */
+    uint64_t last_ns;           /* Time of the last record, since the start. */
+    uint64_t records;           /* Number of records written. */
+    int32_t failed;             /* Set once a record could not be written. */
+    pthread_mutex_t lock;       /* Orders the records of different threads. */
+} Trace_Writer_t;
+
+/**
+ * @brief Structure for a trace being read.
+ */
+typedef struct
+{
+    FILE* file;                 /* Trace file. */
+    uint64_t time_ns;           /* Time of the last record read. */
+    uint64_t records;           /* Number of records read. */
+} Trace_Reader_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief Create a trace file and start its clock.
+ *
+ * @param writer Output, the trace.
+ * @param path The path of the trace file, replaced if it exists.
+ * @return TRACE_OK if the trace is created, TRACE_IO_ERROR if not.
+ */
+trace_status_t Trace_Create(Trace_Writer_t* writer, const char* path);
+
+/**
+ * @brief Append a record to a trace, timed now.
+ *
+ * @param writer The trace.
+ * @param op The operation.
+ * @param account The account, as given to the operation.
+ * @param length The length of the account.
+ * @param result The result of the operation.
+ */
+void Trace_Write(Trace_Writer_t* writer, trace_op_t op, const int8_t* account, uint8_t length, int32_t result);
+
+/**
+ * @brief Write the buffered records of a trace and close it.
+ *
+ * @param writer The trace.
+ * @return TRACE_OK if every record is in the file, TRACE_IO_ERROR if not.
+ */
+trace_status_t Trace_Finish(Trace_Writer_t* writer);
+
+/**
+ * @brief Open a trace file for reading.
+ *
+ * @param reader Output, the trace.
+ * @param path The path of the trace file.
+ * @return TRACE_OK if the trace is open, an error code if not.
+ */
+trace_status_t Trace_Open(Trace_Reader_t* reader, const char* path);
+
+/**
+ * @brief Read the next record of a trace.
+ *
+ * @param reader The trace.
+ * @param record Output, the record.
+ * @return 1 if a record is read, 0 at the end of the trace, -1 if the record is cut short or unknown.
+ */
+int32_t Trace_Read(Trace_Reader_t* reader, Trace_Record_t* record);
+
+/**
+ * @brief Close a trace being read.
+ *
+ * @param reader The trace.
+ */
+void Trace_Close(Trace_Reader_t* reader);
+
+/**
+ * @brief Get a message describing a result of the trace functions.
+ *
+ * @param status The result.
+ * @return A constant string describing the result.
+ */
+const char* Trace_Status_Message(trace_status_t status);
+
+#endif /* ACCOUNT_TRACE_H */
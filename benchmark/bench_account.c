@@ -0,0 +1,631 @@
+/**
+ * @file bench_account.c
+ * @brief This file contains the microbenchmark of every entry point of account_manage.c.
+ *
+ * For each list size the program measures, with the list built by Add_Account:
+ * - Add_Account of new accounts, from an empty list up to the size,
+ * - Is_Account_Exist and Search_Account with 100%, 50% and 0% hits,
+ * - Display_ListAccounts (the output goes to the null device), per account shown,
+ * - Remove_Account of missing accounts, then of every account in a scattered order.
+ * Check_Account does not depend on the list, it is measured once with 0%, 10% and
+ * 50% invalid accounts, half of them with an invalid character and half too long.
+ *
+ * Every operation is timed on its own (every n-th one when there are more than
+ * MAX_SAMPLES), the cost of reading the clock is subtracted, and the mean, the
+ * percentiles and the worst time are reported. When the program is linked with
+ * --wrap=malloc,calloc,realloc (see benchmark/CMakeLists.txt) the allocations of the
+ * store are counted as well.
+ *
+ * Usage: bench_account [--sizes 1000,10000,...] [--lookups n] [--format text|csv|json] [--out file]
+ *        (default sizes 10^3 to 10^7, 1000000 lookups, text on the standard output)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* The functions under test */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+#ifdef _WIN32
+#include <io.h>                 /* For _dup() */
+#else
+#include <unistd.h>             /* For dup() */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define MAX_SIZES       16U         /* Largest number of list sizes */
+#define MAX_SAMPLES     1000000U    /* Largest number of timed operations of one measurement */
+#define SCATTER_PRIME   1000003U    /* Step of the scattered order, prime to every power of 10 */
+#ifdef _WIN32
+#define NULL_DEVICE     "NUL"
+#else
+#define NULL_DEVICE     "/dev/null"
+#endif
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the output formats.
+ */
+typedef enum
+{
+    FORMAT_TEXT,                /* Aligned table for reading. */
+    FORMAT_CSV,                 /* One header line, then one line per measurement. */
+    FORMAT_JSON                 /* One array of objects. */
+} format_t;
+
+/**
+ * @brief Structure for the input of the measured operations.
+ */
+typedef struct
+{
+    uint64_t size;              /* Number of accounts in the list. */
+    uint32_t percent;           /* Percentage of hits, or of invalid accounts for Check_Account. */
+    uint64_t seed;              /* State of the random generator. */
+    int8_t account[16];         /* Account prepared for the next operation. */
+    uint8_t length;             /* Length of the prepared account. */
+} Bench_Input_t;
+
+/**
+ * @brief Type for the functions preparing an operation, not timed.
+ *
+ * @param input The input of the operation.
+ * @param i The number of the operation.
+ */
+typedef void (*prepare_t)(Bench_Input_t* input, uint64_t i);
+
+/**
+ * @brief Type for the functions running an operation, timed.
+ *
+ * @param input The input of the operation.
+ */
+typedef void (*run_t)(Bench_Input_t* input);
+
+/**
+ * @brief Structure for the result of one measurement.
+ */
+typedef struct
+{
+    const char* operation;      /* Name of the function measured. */
+    const char* variant;        /* Input mix. */
+    uint64_t size;              /* Number of accounts in the list. */
+    uint64_t ops;               /* Number of operations. */
+    double mean;                /* Mean time of an operation in ns. */
+    double p50;                 /* Median time in ns. */
+    double p90;                 /* 90th percentile in ns. */
+    double p99;                 /* 99th percentile in ns. */
+    double p999;                /* 99.9th percentile in ns. */
+    double max;                 /* Worst time in ns. */
+    double allocs;              /* Allocations per operation, negative if not counted. */
+    double bytes;               /* Bytes allocated per operation, negative if not counted. */
+} Bench_Result_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint64_t* samples = NULL;        /* Times of the timed operations */
+static uint64_t clock_cost = 0;         /* Time of reading the clock twice */
+static uint64_t alloc_calls = 0;        /* Allocations made since the start */
+static uint64_t alloc_bytes = 0;        /* Bytes allocated since the start */
+static FILE* report = NULL;             /* Stream of the results */
+static format_t format = FORMAT_TEXT;   /* Format of the results */
+static uint32_t results = 0;            /* Number of results written */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+#ifdef BENCH_COUNT_ALLOCS
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* block, size_t size);
+
+/**
+ * @brief Count an allocation, then call malloc().
+ *
+ * @param size The size of the block.
+ * @return The block.
+ */
+void* __wrap_malloc(size_t size)
+{
+    alloc_calls++;
+    alloc_bytes += size;
+    return __real_malloc(size);
+}
+
+/**
+ * @brief Count an allocation, then call calloc().
+ *
+ * @param count The number of elements.
+ * @param size The size of an element.
+ * @return The block.
+ */
+void* __wrap_calloc(size_t count, size_t size)
+{
+    alloc_calls++;
+    alloc_bytes += count * size;
+    return __real_calloc(count, size);
+}
+
+/**
+ * @brief Count an allocation, then call realloc().
+ *
+ * @param block The block to resize.
+ * @param size The new size of the block.
+ * @return The resized block.
+ */
+void* __wrap_realloc(void* block, size_t size)
+{
+    alloc_calls++;
+    alloc_bytes += size;
+    return __real_realloc(block, size);
+}
+#endif
+
+/**
+ * @brief Compare two times for qsort().
+ *
+ * @param a The first time.
+ * @param b The second time.
+ * @return A negative, zero or positive value as a is smaller, equal or larger.
+ */
+static int Compare_Times(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Measure the cost of reading the clock twice.
+ *
+ * @return The median of many empty measurements in ns.
+ */
+static uint64_t Measure_Clock(void)
+{
+    uint64_t t[1001];           /* Empty measurements */
+    uint64_t start = 0;         /* Start of a measurement */
+    uint32_t i = 0;             /* Measurement counter */
+
+    for (i = 0; i < 1001U; i++)
+    {
+        start = Bench_Now_Ns();
+        t[i] = Bench_Now_Ns() - start;
+    }
+    qsort(t, 1001U, sizeof(uint64_t), Compare_Times);
+
+    return t[500];
+}
+
+/**
+ * @brief Read a percentile of the sorted samples.
+ *
+ * @param count The number of samples.
+ * @param percent The percentile.
+ * @param scale The number of items one sample covers.
+ * @return The percentile in ns per item.
+ */
+static double Percentile(uint64_t count, double percent, uint64_t scale)
+{
+    uint64_t rank = (uint64_t)(percent / 100.0 * (double)(count - 1U) + 0.5);
+
+    return (double)samples[rank] / (double)scale;
+}
+
+/**
+ * @brief Write one result in the selected format.
+ *
+ * @param result The result.
+ */
+static void Write_Result(const Bench_Result_t* result)
+{
+    switch (format)
+    {
+        case FORMAT_CSV:
+        {
+            if (results == 0U)
+            {
+                fprintf(report, "operation,variant,size,ops,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,"
+                                "allocs_per_op,bytes_per_op\n");
+            }
+            fprintf(report, "%s,%s,%llu,%llu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.4f,%.2f\n",
+                    result->operation, result->variant, (unsigned long long)result->size,
+                    (unsigned long long)result->ops, result->mean, result->p50, result->p90, result->p99,
+                    result->p999, result->max, result->allocs, result->bytes);
+            break;
+        }
+        case FORMAT_JSON:
+        {
+            fprintf(report, "%s\n  {\"operation\": \"%s\", \"variant\": \"%s\", \"size\": %llu, \"ops\": %llu, "
+                            "\"mean_ns\": %.1f, \"p50_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, "
+                            "\"p999_ns\": %.1f, \"max_ns\": %.1f, \"allocs_per_op\": %.4f, \"bytes_per_op\": %.2f}",
+                    (results == 0U) ? "[" : ",", result->operation, result->variant,
+                    (unsigned long long)result->size, (unsigned long long)result->ops, result->mean,
+                    result->p50, result->p90, result->p99, result->p999, result->max, result->allocs,
+                    result->bytes);
+            break;
+        }
+        default:
+        {
+            if (results == 0U)
+            {
+                fprintf(report, "%-20s %-10s %9s %9s %9s %9s %9s %9s %9s %11s %9s %9s\n", "operation", "variant",
+                        "size", "ops", "mean ns", "p50", "p90", "p99", "p99.9", "max", "allocs/op", "bytes/op");
+            }
+            fprintf(report, "%-20s %-10s %9llu %9llu %9.1f %9.1f %9.1f %9.1f %9.1f %11.1f %9.4f %9.2f\n",
+                    result->operation, result->variant, (unsigned long long)result->size,
+                    (unsigned long long)result->ops, result->mean, result->p50, result->p90, result->p99,
+                    result->p999, result->max, result->allocs, result->bytes);
+            break;
+        }
+    }
+    fflush(report);
+    results++;
+}
+
+/**
+ * @brief Time a series of operations and write the result.
+ *
+ * @param operation The name of the function measured.
+ * @param variant The input mix.
+ * @param input The input of the operations.
+ * @param ops The number of operations.
+ * @param scale The number of items one operation covers, the times are divided by it.
+ * @param prepare The function preparing an operation.
+ * @param run The function running an operation.
+ */
+static void Measure(const char* operation, const char* variant, Bench_Input_t* input, uint64_t ops,
+                    uint64_t scale, prepare_t prepare, run_t run)
+{
+    Bench_Result_t result;                              /* Result of the measurement */
+    uint64_t stride = (ops + MAX_SAMPLES - 1U) / MAX_SAMPLES;  /* Operations per timed operation */
+    uint64_t count = 0;                                 /* Number of timed operations */
+    uint64_t total = 0;                                 /* Sum of the timed operations */
+    uint64_t calls = alloc_calls;                       /* Allocations before the measurement */
+    uint64_t bytes = alloc_bytes;                       /* Bytes allocated before the measurement */
+    uint64_t start = 0;                                 /* Start of the timed operation */
+    uint64_t elapsed = 0;                               /* Time of the timed operation */
+    uint64_t i = 0;                                     /* Operation counter */
+
+    for (i = 0; i < ops; i++)
+    {
+        prepare(input, i);
+        if (i % stride == 0U)
+        {
+            start = Bench_Now_Ns();
+            run(input);
+            elapsed = Bench_Now_Ns() - start;
+            samples[count] = (elapsed > clock_cost) ? (elapsed - clock_cost) : 0U;
+            total += samples[count];
+            count++;
+        }
+        else
+        {
+            run(input);
+        }
+    }
+    qsort(samples, (size_t)count, sizeof(uint64_t), Compare_Times);
+
+    result.operation = operation;
+    result.variant = variant;
+    result.size = input->size;
+    result.ops = ops;
+    result.mean = (double)total / (double)count / (double)scale;
+    result.p50 = Percentile(count, 50.0, scale);
+    result.p90 = Percentile(count, 90.0, scale);
+    result.p99 = Percentile(count, 99.0, scale);
+    result.p999 = Percentile(count, 99.9, scale);
+    result.max = (double)samples[count - 1U] / (double)scale;
+#ifdef BENCH_COUNT_ALLOCS
+    result.allocs = (double)(alloc_calls - calls) / (double)ops;
+    result.bytes = (double)(alloc_bytes - bytes) / (double)ops;
+#else
+    (void)calls;
+    (void)bytes;
+    result.allocs = -1.0;
+    result.bytes = -1.0;
+#endif
+    Write_Result(&result);
+}
+
+/**
+ * @brief Prepare the i-th new account.
+ *
+ * @param input The input of the operation.
+ * @param i The number of the operation.
+ */
+static void Prepare_New(Bench_Input_t* input, uint64_t i)
+{
+    Bench_Make_Account(i, input->account);
+}
+
+/**
+ * @brief Prepare an account of the list in a scattered order.
+ *
+ * @param input The input of the operation.
+ * @param i The number of the operation.
+ */
+static void Prepare_Scattered(Bench_Input_t* input, uint64_t i)
+{
+    Bench_Make_Account((i * SCATTER_PRIME) % input->size, input->account);
+}
+
+/**
+ * @brief Prepare a random account, in the list with the chance given by percent.
+ *
+ * @param input The input of the operation.
+ * @param i The number of the operation.
+ */
+static void Prepare_Lookup(Bench_Input_t* input, uint64_t i)
+{
+    uint64_t r = Bench_Random(&input->seed);    /* Random value */
+
+    (void)i;
+    /* Accounts 0 to size - 1 are in the list, the next ones are not */
+    Bench_Make_Account(((r % 100U) < input->percent) ? ((r >> 8) % input->size)
+                                                      : (input->size + (r >> 8) % input->size),
+                       input->account);
+}
+
+/**
+ * @brief Prepare an account to check, invalid with the chance given by percent.
+ *
+ * @param input The input of the operation.
+ * @param i The number of the operation.
+ */
+static void Prepare_Check(Bench_Input_t* input, uint64_t i)
+{
+    uint64_t r = Bench_Random(&input->seed);    /* Random value */
+
+    Bench_Make_Account(i, input->account);
+    if ((r % 100U) < input->percent)
+    {
+        if ((r >> 8) & 1U)
+        {
+            /* An invalid character at a random place */
+            input->account[(r >> 9) % strlen((const char*)input->account)] = '#';
+        }
+        else
+        {
+            /* Too long by one to four characters */
+            memcpy(input->account, "abcdefghijklmn", 15U);
+            input->account[11U + (r >> 9) % 4U] = '\0';
+        }
+    }
+    input->length = (uint8_t)strlen((const char*)input->account);
+}
+
+/**
+ * @brief Prepare nothing, for the operations without input.
+ *
+ * @param input The input of the operation.
+ * @param i The number of the operation.
+ */
+static void Prepare_None(Bench_Input_t* input, uint64_t i)
+{
+    (void)input;
+    (void)i;
+}
+
+/**
+ * @brief Run Check_Account on the prepared account.
+ *
+ * @param input The input of the operation.
+ */
+static void Run_Check(Bench_Input_t* input)
+{
+    Check_Account(input->account, input->length);
+}
+
+/**
+ * @brief Run Add_Account on the prepared account.
+ *
+ * @param input The input of the operation.
+ */
+static void Run_Add(Bench_Input_t* input)
+{
+    Add_Account(input->account);
+}
+
+/**
+ * @brief Run Is_Account_Exist on the prepared account.
+ *
+ * @param input The input of the operation.
+ */
+static void Run_Exist(Bench_Input_t* input)
+{
+    input->length = (uint8_t)Is_Account_Exist(input->account);
+}
+
+/**
+ * @brief Run Search_Account on the prepared account.
+ *
+ * @param input The input of the operation.
+ */
+static void Run_Search(Bench_Input_t* input)
+{
+    input->length = (uint8_t)Search_Account(input->account);
+}
+
+/**
+ * @brief Run Remove_Account on the prepared account.
+ *
+ * @param input The input of the operation.
+ */
+static void Run_Remove(Bench_Input_t* input)
+{
+    input->length = (uint8_t)Remove_Account(input->account);
+}
+
+/**
+ * @brief Run Display_ListAccounts.
+ *
+ * @param input The input of the operation.
+ */
+static void Run_Display(Bench_Input_t* input)
+{
+    (void)input;
+    Display_ListAccounts();
+    fflush(stdout);
+}
+
+/**
+ * @brief Measure every entry point with one list size.
+ *
+ * @param size The number of accounts in the list.
+ * @param lookups The number of lookups of each lookup measurement.
+ */
+static void Run_Size(uint64_t size, uint64_t lookups)
+{
+    static const uint32_t hits[] = { 100U, 50U, 0U };
+    static const char* const hit_names[] = { "hit100", "hit50", "hit0" };
+    Bench_Input_t input;        /* Input of the operations */
+    uint64_t displays = 0;      /* Calls of Display_ListAccounts */
+    uint32_t j = 0;             /* Variant counter */
+
+    memset(&input, 0, sizeof(input));
+    input.size = size;
+    input.seed = 88172645463325252ULL + size;
+
+    Measure("Add_Account", "new", &input, size, 1U, Prepare_New, Run_Add);
+
+    for (j = 0; j < 3U; j++)
+    {
+        input.percent = hits[j];
+        Measure("Is_Account_Exist", hit_names[j], &input, lookups, 1U, Prepare_Lookup, Run_Exist);
+    }
+    for (j = 0; j < 3U; j++)
+    {
+        input.percent = hits[j];
+        Measure("Search_Account", hit_names[j], &input, lookups, 1U, Prepare_Lookup, Run_Search);
+    }
+
+    /* Show about a million accounts in total, at least once; times are per account */
+    displays = (size >= 1000000U) ? 1U : (1000000U / size);
+    displays = (displays > 100U) ? 100U : displays;
+    Measure("Display_ListAccounts", "per_acct", &input, displays, size, Prepare_None, Run_Display);
+
+    input.percent = 0U;
+    Measure("Remove_Account", "miss", &input, lookups, 1U, Prepare_Lookup, Run_Remove);
+    Measure("Remove_Account", "hit", &input, size, 1U, Prepare_Scattered, Run_Remove);
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage at the top of this file.
+ * @return 0 if the benchmark completes, 1 if the arguments are not valid.
+ */
+int main(int argc, char** argv)
+{
+    static const uint32_t invalid[] = { 0U, 10U, 50U };
+    static const char* const invalid_names[] = { "valid100", "invalid10", "invalid50" };
+    uint64_t sizes[MAX_SIZES] = { 1000U, 10000U, 100000U, 1000000U, 10000000U };
+    uint32_t size_count = 5U;           /* Number of list sizes */
+    uint64_t lookups = 1000000U;        /* Operations of each lookup measurement */
+    const char* out = NULL;             /* File of the results, NULL for the standard output */
+    char* next = NULL;                  /* Parser position in the list of sizes */
+    Bench_Input_t input;                /* Input of the Check_Account measurements */
+    int32_t usage = 0;                  /* Set when the arguments are not valid */
+    int32_t arg = 1;                    /* Argument counter */
+    uint32_t j = 0;                     /* Size and variant counter */
+
+    /* Read the options, each one takes a value */
+    for (arg = 1; (arg < argc) && (usage == 0); arg += 2)
+    {
+        if (arg + 1 >= argc)
+        {
+            usage = 1;
+        }
+        else if (strcmp(argv[arg], "--sizes") == 0)
+        {
+            size_count = 0;
+            next = argv[arg + 1];
+            while (*next != '\0' && size_count < MAX_SIZES)
+            {
+                sizes[size_count] = strtoull(next, &next, 10);
+                usage |= (sizes[size_count] == 0U);
+                size_count++;
+                next += (*next == ',') ? 1 : 0;
+            }
+        }
+        else if (strcmp(argv[arg], "--lookups") == 0)
+        {
+            lookups = strtoull(argv[arg + 1], NULL, 10);
+            usage |= (lookups == 0U);
+        }
+        else if (strcmp(argv[arg], "--format") == 0)
+        {
+            format = (strcmp(argv[arg + 1], "csv") == 0) ? FORMAT_CSV
+                   : ((strcmp(argv[arg + 1], "json") == 0) ? FORMAT_JSON : FORMAT_TEXT);
+        }
+        else if (strcmp(argv[arg], "--out") == 0)
+        {
+            out = argv[arg + 1];
+        }
+        else
+        {
+            usage = 1;
+        }
+    }
+    if (usage)
+    {
+        printf("Usage: %s [--sizes 1000,10000,...] [--lookups n] [--format text|csv|json] [--out file]\n",
+               argv[0]);
+        return 1;
+    }
+
+    /* Keep the results apart from what the store prints, which goes to the null device */
+    fflush(stdout);
+#ifdef _WIN32
+    report = (out != NULL) ? fopen(out, "w") : _fdopen(_dup(_fileno(stdout)), "w");
+#else
+    report = (out != NULL) ? fopen(out, "w") : fdopen(dup(fileno(stdout)), "w");
+#endif
+    samples = (uint64_t*)malloc(MAX_SAMPLES * sizeof(uint64_t));
+    if (report == NULL || samples == NULL || freopen(NULL_DEVICE, "w", stdout) == NULL)
+    {
+        fprintf(stderr, "Error: Cannot open the output.\n");
+        return 1;
+    }
+    clock_cost = Measure_Clock();
+
+    /* Check_Account does not depend on the list */
+    memset(&input, 0, sizeof(input));
+    input.seed = 0x2545F4914F6CDD1DULL;
+    for (j = 0; j < 3U; j++)
+    {
+        input.percent = invalid[j];
+        Measure("Check_Account", invalid_names[j], &input, lookups, 1U, Prepare_Check, Run_Check);
+    }
+
+    for (j = 0; j < size_count; j++)
+    {
+        Run_Size(sizes[j], lookups);
+    }
+
+    if (format == FORMAT_JSON)
+    {
+        fprintf(report, "\n]\n");
+    }
+    else if (format == FORMAT_TEXT)
+    {
+        fprintf(report, "\nClock cost %llu ns subtracted from every time.%s\n", (unsigned long long)clock_cost,
+#ifdef BENCH_COUNT_ALLOCS
+                ""
+#else
+                " Allocations are not counted in this build (-1)."
+#endif
+                );
+    }
+    fclose(report);
+    free(samples);
+
+    return 0;
+} /* EOF */
@@ -0,0 +1,146 @@
+/**
+ * @file bench_batch.c
+ * @brief This file contains the benchmark of the batch removals and searches.
+ *
+ * The program fills two stores with the same accounts in random order, then draws a
+ * batch of targets, half of them in the stores and half not, and times:
+ * - one Account_Store_Search() per target against Account_Store_Search_Batch(),
+ * - one Account_Store_Remove() per target against Account_Store_Remove_Batch(),
+ * each removal run on its own store, and checks that both give the same results.
+ *
+ * Usage: bench_batch [number_of_accounts [number_of_targets]]
+ *        (default 2000000 and 100000)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* For Check_Account_Ctx() */
+#include "../account_store.h"   /* The batch functions under test */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Get the key of the account with the given number.
+ *
+ * @param n The number of the account.
+ * @return The key of the account.
+ */
+static uint64_t Bench_Key(uint64_t n)
+{
+    int8_t account[16];         /* Text of the account */
+    uint64_t key = 0;           /* Key of the account */
+
+    Bench_Make_Account(n, account);
+    Check_Account_Ctx(NULL, account, (uint8_t)strlen((const char*)account), &key);
+
+    return key;
+}
+
+/**
+ * @brief Print the time of a run and the speed up of the batch over the single calls.
+ *
+ * @param name The name of the run.
+ * @param single The time of the single calls in nanoseconds.
+ * @param batch The time of the batch call in nanoseconds.
+ * @param count The number of targets.
+ * @param same 1 if both runs gave the same results.
+ */
+static void Bench_Report(const char* name, uint64_t single, uint64_t batch, uint64_t count, int32_t same)
+{
+    printf("%-7s single %8.1f ns/account, batch %8.1f ns/account, x%.2f%s\n", name,
+           (double)single / (double)count, (double)batch / (double)count, (double)single / (double)batch,
+           same ? "" : " (results differ)");
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage at the top of this file.
+ * @return 0 if the benchmark completes, 1 if memory allocation failed.
+ */
+int main(int argc, char** argv)
+{
+    uint64_t count = (argc > 1) ? strtoull(argv[1], NULL, 10) : 2000000U;     /* Accounts of the stores */
+    uint64_t targets = (argc > 2) ? strtoull(argv[2], NULL, 10) : 100000U;    /* Accounts of the batch */
+    uint64_t seed = 88172645463325252ULL;   /* State of the random generator */
+    account_store_t* first = Account_Store_Create();    /* Store of the single calls */
+    account_store_t* second = Account_Store_Create();   /* Store of the batch calls */
+    uint64_t* order = (uint64_t*)malloc((size_t)count * sizeof(uint64_t));      /* Accounts in insertion order */
+    uint64_t* keys = (uint64_t*)malloc((size_t)targets * sizeof(uint64_t));     /* Keys of the targets */
+    int32_t* single = (int32_t*)malloc((size_t)targets * sizeof(int32_t));      /* Results of the single calls */
+    int32_t* batch = (int32_t*)malloc((size_t)targets * sizeof(int32_t));       /* Results of the batch call */
+    uint64_t start = 0;                     /* Start time of a run */
+    uint64_t single_ns = 0;                 /* Time of the single calls */
+    uint64_t batch_ns = 0;                  /* Time of the batch call */
+    uint64_t swap = 0;                      /* Account being shuffled */
+    uint64_t j = 0;                         /* Position the account is shuffled to */
+    uint64_t i = 0;                         /* Account counter */
+
+    if (first == NULL || second == NULL || order == NULL || keys == NULL || single == NULL || batch == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+
+    /* Add the accounts in random order, so the nodes of the list are spread over the pool */
+    for (i = 0; i < count; i++)
+    {
+        order[i] = i;
+    }
+    for (i = count; i > 1U; i--)
+    {
+        j = Bench_Random(&seed) % i;
+        swap = order[i - 1U];
+        order[i - 1U] = order[j];
+        order[j] = swap;
+    }
+    for (i = 0; i < count; i++)
+    {
+        Account_Store_Add(first, Bench_Key(order[i]));
+        Account_Store_Add(second, Bench_Key(order[i]));
+    }
+    /* Half of the targets are in the stores, the others are the accounts after them */
+    for (i = 0; i < targets; i++)
+    {
+        keys[i] = Bench_Key((Bench_Random(&seed) % count) + (((i & 1U) != 0U) ? count : 0U));
+    }
+    printf("%llu accounts, %llu targets\n", (unsigned long long)count, (unsigned long long)targets);
+
+    start = Bench_Now_Ns();
+    for (i = 0; i < targets; i++)
+    {
+        single[i] = Account_Store_Search(first, keys[i]);
+    }
+    single_ns = Bench_Now_Ns() - start;
+    start = Bench_Now_Ns();
+    Account_Store_Search_Batch(second, keys, targets, batch);
+    batch_ns = Bench_Now_Ns() - start;
+    Bench_Report("search", single_ns, batch_ns, targets, memcmp(single, batch, (size_t)targets * sizeof(int32_t)) == 0);
+
+    start = Bench_Now_Ns();
+    for (i = 0; i < targets; i++)
+    {
+        single[i] = Account_Store_Remove(first, keys[i]);
+    }
+    single_ns = Bench_Now_Ns() - start;
+    start = Bench_Now_Ns();
+    Account_Store_Remove_Batch(second, keys, targets, batch);
+    batch_ns = Bench_Now_Ns() - start;
+    Bench_Report("remove", single_ns, batch_ns, targets, memcmp(single, batch, (size_t)targets * sizeof(int32_t)) == 0);
+
+    Account_Store_Destroy(first);
+    Account_Store_Destroy(second);
+    free(order);
+    free(keys);
+    free(single);
+    free(batch);
+
+    return 0;
+} /* EOF */
@@ -0,0 +1,148 @@
+/**
+ * @file bench_bloom.c
+ * @brief This file contains the benchmark of the Bloom filter in front of the hash index.
+ *
+ * The list is filled with distinct accounts, then for each false-positive rate (0 turns
+ * the filter off) the program looks up accounts that are not in the list and accounts
+ * that are, in random order, and prints the time per lookup and the share of the absent
+ * accounts the filter ruled out. The same lookups are then made through Is_Account_Key_Exist(),
+ * which any thread may call and whose filter counters are kept apart. A last run removes
+ * half of the accounts and looks up the removed ones, which shows the filter recovering
+ * through its rebuilds.
+ *
+ * Usage: bench_bloom [number_of_accounts] [lookups]
+ *        (default 1000000 and 4000000)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* The store under test */
+#include "../account_store.h"   /* For Account_Store_Contains(), which goes through the filter */
+#include "../account_key.h"     /* For Account_Encode() */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint64_t* keys = NULL;           /* Keys of accounts 0 to 2 * count - 1, the first half is in the list */
+static uint64_t count = 1000000U;       /* Accounts in the list */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Look up random accounts, with the store and with the public lookup, and print
+ * the time per lookup and the filter counters.
+ *
+ * @param name The name of the run.
+ * @param first The first account that may be looked up.
+ * @param range The number of accounts that may be looked up, from first on.
+ * @param lookups The number of lookups.
+ */
+static void Run(const char* name, uint64_t first, uint64_t range, uint64_t lookups)
+{
+    Bloom_Stats_t before;           /* Counters of the filter before the run */
+    Bloom_Stats_t after;            /* Counters of the filter after the run */
+    uint64_t seed = 88172645463325252ULL;   /* State of the random generator */
+    uint64_t hits = 0;              /* Accounts found */
+    uint64_t start = 0;             /* Start time of the run */
+    uint64_t elapsed = 0;           /* Time of the run */
+    uint64_t shared = 0;            /* Time of the public lookups */
+    uint64_t shared_hits = 0;       /* Accounts found by the public lookups */
+    uint64_t i = 0;                 /* Lookup counter */
+
+    Get_Bloom_Stats(&before);
+    start = Bench_Now_Ns();
+    for (i = 0; i < lookups; i++)
+    {
+        hits += (uint64_t)Account_Store_Contains(Get_Account_Store(), keys[first + Bench_Random(&seed) % range]);
+    }
+    elapsed = Bench_Now_Ns() - start;
+    /* The same accounts again, through the lookup of the concurrent searches */
+    seed = 88172645463325252ULL;
+    start = Bench_Now_Ns();
+    for (i = 0; i < lookups; i++)
+    {
+        shared_hits += (uint64_t)Is_Account_Key_Exist(keys[first + Bench_Random(&seed) % range]);
+    }
+    shared = Bench_Now_Ns() - start;
+    Get_Bloom_Stats(&after);
+
+    printf("%-24s %7.1f ns/lookup %6.1f%% hits %6.2f%% ruled out %7.3f%% false positives %3llu rebuilds"
+           " | public %7.1f ns/lookup %6.2f%% ruled out%s\n",
+           name, (double)elapsed / (double)lookups, 100.0 * (double)hits / (double)lookups,
+           100.0 * (double)(after.negatives - before.negatives) / (double)lookups,
+           100.0 * (double)(after.false_positives - before.false_positives) / (double)lookups,
+           (unsigned long long)after.rebuilds, (double)shared / (double)lookups,
+           100.0 * (double)(after.shared_negatives - before.shared_negatives) / (double)lookups,
+           (shared_hits == hits) ? "" : " mismatch");
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage at the top of this file.
+ * @return 0 if the benchmark completes, 1 if memory allocation failed.
+ */
+int main(int argc, char** argv)
+{
+    static const double rates[] = { 0.0, 0.05, 0.01, 0.001 };
+    uint64_t lookups = 4000000U;    /* Lookups of each run */
+    int8_t account[16];             /* Text of the current account */
+    char name[32];                  /* Name of the current run */
+    uint64_t i = 0;                 /* Account counter */
+    uint32_t r = 0;                 /* Rate counter */
+
+    if (argc > 1)
+    {
+        count = strtoull(argv[1], NULL, 10);
+    }
+    if (argc > 2)
+    {
+        lookups = strtoull(argv[2], NULL, 10);
+    }
+
+    keys = (uint64_t*)malloc((size_t)(2U * count) * sizeof(uint64_t));
+    if (keys == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+    for (i = 0; i < 2U * count; i++)
+    {
+        Bench_Make_Account(i, account);
+        Account_Encode(account, (uint32_t)strlen((const char*)account), &keys[i]);
+    }
+    for (i = 0; i < count; i++)
+    {
+        Add_Account_Key(keys[i]);
+    }
+    printf("%llu accounts in the list, %llu lookups per run\n", (unsigned long long)count,
+           (unsigned long long)lookups);
+
+    for (r = 0; r < sizeof(rates) / sizeof(rates[0]); r++)
+    {
+        Set_Bloom_Rate(rates[r]);
+        snprintf(name, sizeof(name), "absent, rate %g", rates[r]);
+        Run(name, count, count, lookups);
+        snprintf(name, sizeof(name), "present, rate %g", rates[r]);
+        Run(name, 0U, count, lookups);
+    }
+
+    /* Removed accounts keep their bits until the filter is rebuilt */
+    Set_Bloom_Rate(BLOOM_DEFAULT_RATE);
+    for (i = 0; i < count / 2U; i++)
+    {
+        Remove_Account_Key(keys[i]);
+    }
+    Run("removed, rate 0.01", 0U, count / 2U, lookups);
+
+    free(keys);
+
+    return 0;
+} /* EOF */
@@ -0,0 +1,233 @@
+/**
+ * @file bench_check.c
+ * @brief This file contains the benchmark of the account validators.
+ *
+ * The program builds a mix of valid accounts, accounts with invalid characters and
+ * accounts that are too long. It checks that every kernel of the batch validator gives
+ * the same status as Check_Account() and prints the throughput of each one in GB/s.
+ * Finally the accounts are split between worker threads that each call
+ * Check_Account_Ctx() with their own context, without any lock.
+ *
+ * Usage: bench_check [number_of_accounts [number_of_threads]]   (default 1000000 4)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* For Check_Account() and Check_Accounts() */
+#include "../account_check.h"   /* For the kernels of the batch validator */
+#include "bench_common.h"       /* For Bench_Now_Ns() and Bench_Random() */
+#include <pthread.h>            /* For the worker threads */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ROUNDS      20U         /* Number of times each validator runs over the inputs */
+#define MAX_THREADS 64U         /* Maximum number of worker threads */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for the work of one worker thread.
+ */
+typedef struct
+{
+    const int8_t* const* ptrs;  /* The pointers to the accounts of the worker. */
+    const uint8_t* lens;        /* The lengths of the accounts of the worker. */
+    size_t count;               /* The number of accounts of the worker. */
+    uint64_t rejected;          /* Output, the number of rejected accounts. */
+} Worker_t;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Print the throughput of a validator.
+ *
+ * @param name The name of the validator.
+ * @param bytes The number of bytes checked in one round.
+ * @param count The number of accounts checked in one round.
+ * @param elapsed The elapsed time of all rounds in nanoseconds.
+ */
+static void Report(const char* name, uint64_t bytes, uint64_t count, uint64_t elapsed)
+{
+    printf("%-16s %8.3f GB/s %10.2f ns/account\n", name,
+           (double)bytes * ROUNDS / (double)elapsed, (double)elapsed / ((double)count * ROUNDS));
+}
+
+/**
+ * @brief Count a rejected account, callback of the worker contexts.
+ *
+ * @param status The status of the account.
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @param user_data The worker that checked the account.
+ */
+static void Count_Rejected(status_enum_t status, const int8_t* ptr, uint8_t length, void* user_data)
+{
+    (void)status;
+    (void)ptr;
+    (void)length;
+    ((Worker_t*)user_data)->rejected++;
+}
+
+/**
+ * @brief Check the accounts of one worker.
+ *
+ * @param arg The worker.
+ * @return NULL.
+ */
+static void* Worker_Run(void* arg)
+{
+    Worker_t* worker = (Worker_t*)arg;
+    check_context_t ctx = { Count_Rejected, worker, NULL };     /* Context owned by this thread */
+    uint32_t round = 0;                                 /* Counter of rounds */
+    size_t i = 0;                                       /* Counter of accounts */
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        for (i = 0; i < worker->count; i++)
+        {
+            Check_Account_Ctx(&ctx, worker->ptrs[i], worker->lens[i], NULL);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, argv[1] is the number of accounts.
+ * @return 0 if every kernel matches Check_Account(), 1 if not.
+ */
+int main(int argc, char** argv)
+{
+    static const char chars[] = "abcxyzABCXYZ123789_0-#";    /* Mostly valid characters */
+    static const check_kernel_t kernels[] = { CHECK_KERNEL_SCALAR, CHECK_KERNEL_SSE2, CHECK_KERNEL_AVX2 };
+    size_t count = 1000000U;            /* Number of accounts */
+    uint32_t threads = 4U;              /* Number of worker threads */
+    pthread_t thread[MAX_THREADS];      /* Worker threads */
+    Worker_t worker[MAX_THREADS];       /* Work of each thread */
+    uint64_t rejected = 0;              /* Rejected accounts of all rounds */
+    uint64_t seed = 88172645463325252ULL;
+    uint64_t bytes = 0;                 /* Total length of the accounts */
+    uint64_t start = 0;                 /* Start time of a measurement */
+    int8_t* text = NULL;                /* Storage of the accounts, 16 bytes each */
+    const int8_t** ptrs = NULL;         /* Pointers to the accounts */
+    uint8_t* lens = NULL;               /* Lengths of the accounts */
+    status_enum_t* expected = NULL;     /* Results of Check_Account() */
+    status_enum_t* out = NULL;          /* Results of the batch validator */
+    int32_t result = 0;                 /* Exit code */
+    size_t i = 0;                       /* Counter of accounts */
+    uint32_t j = 0;                     /* Counter of characters, rounds and kernels */
+
+    if (argc > 1)
+    {
+        count = (size_t)strtoull(argv[1], NULL, 10);
+    }
+    if (argc > 2)
+    {
+        threads = (uint32_t)strtoul(argv[2], NULL, 10);
+        threads = (threads == 0U) ? 1U : ((threads > MAX_THREADS) ? MAX_THREADS : threads);
+    }
+
+    text = (int8_t*)malloc(count * 16U);
+    ptrs = (const int8_t**)malloc(count * sizeof(*ptrs));
+    lens = (uint8_t*)malloc(count);
+    expected = (status_enum_t*)malloc(count * sizeof(status_enum_t));
+    out = (status_enum_t*)malloc(count * sizeof(status_enum_t));
+    if (text == NULL || ptrs == NULL || lens == NULL || expected == NULL || out == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+
+    /* Build the accounts: lengths 1 to 12, one character in 22 is invalid */
+    for (i = 0; i < count; i++)
+    {
+        lens[i] = (uint8_t)(1U + Bench_Random(&seed) % 12U);
+        ptrs[i] = &text[i * 16U];
+        for (j = 0; j < lens[i]; j++)
+        {
+            text[i * 16U + j] = (int8_t)chars[(j == 0U) ? (Bench_Random(&seed) % (sizeof(chars) - 1U))
+                                                        : (Bench_Random(&seed) % 18U)];
+        }
+        bytes += lens[i];
+    }
+    printf("Accounts: %llu, bytes: %llu\n\n", (unsigned long long)count, (unsigned long long)bytes);
+
+    /* Reference: one call to Check_Account() per account */
+    start = Bench_Now_Ns();
+    for (j = 0; j < ROUNDS; j++)
+    {
+        for (i = 0; i < count; i++)
+        {
+            Check_Account((int8_t*)ptrs[i], lens[i]);
+            expected[i] = Get_Status();
+        }
+    }
+    Report("Check_Account", bytes, count, Bench_Now_Ns() - start);
+    for (i = 0; i < count; i++)
+    {
+        rejected += (expected[i] != CORRECT) ? ROUNDS : 0U;
+    }
+
+    /* Every kernel the CPU supports */
+    for (j = 0; j < sizeof(kernels) / sizeof(kernels[0]); j++)
+    {
+        uint32_t round = 0;
+
+        if (Check_Batch_Set_Kernel(kernels[j]))
+        {
+            memset(out, 0xFF, count * sizeof(status_enum_t));
+            start = Bench_Now_Ns();
+            for (round = 0; round < ROUNDS; round++)
+            {
+                Check_Accounts(ptrs, lens, count, out);
+            }
+            Report(Check_Batch_Kernel_Name(), bytes, count, Bench_Now_Ns() - start);
+
+            if (memcmp(out, expected, count * sizeof(status_enum_t)) != 0)
+            {
+                printf("Error: kernel %s differs from Check_Account()\n", Check_Batch_Kernel_Name());
+                result = 1;
+            }
+        }
+    }
+
+    /* Worker threads, each with its own context */
+    start = Bench_Now_Ns();
+    for (j = 0; j < threads; j++)
+    {
+        worker[j].ptrs = &ptrs[count * j / threads];
+        worker[j].lens = &lens[count * j / threads];
+        worker[j].count = count * (j + 1U) / threads - count * j / threads;
+        worker[j].rejected = 0;
+        pthread_create(&thread[j], NULL, Worker_Run, &worker[j]);
+    }
+    for (j = 0; j < threads; j++)
+    {
+        pthread_join(thread[j], NULL);
+        rejected -= worker[j].rejected;
+    }
+    printf("\n%u threads:\n", threads);
+    Report("Check_Account_Ctx", bytes, count, Bench_Now_Ns() - start);
+    if (rejected != 0U)
+    {
+        printf("Error: worker threads rejected a different number of accounts\n");
+        result = 1;
+    }
+
+    free(text);
+    free(ptrs);
+    free(lens);
+    free(expected);
+    free(out);
+
+    return result;
+} /* EOF */
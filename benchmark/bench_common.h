@@ -0,0 +1,92 @@
+/**
+ * @file bench_common.h
+ * @brief This file contains the helpers shared by the benchmark programs.
+ *
+ * It provides a monotonic clock with nanosecond resolution and a generator of
+ * distinct, valid accounts.
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>         /* Include standard integer types library for fixed-width integers */
+#ifdef _WIN32
+#include <windows.h>        /* For QueryPerformanceCounter() */
+#else
+#include <time.h>           /* For clock_gettime() */
+#endif
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return The current time in nanoseconds.
+ */
+static inline uint64_t Bench_Now_Ns(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter;      /* Current value of the performance counter */
+    LARGE_INTEGER frequency;    /* Ticks of the performance counter per second */
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;        /* Current time */
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Build the n-th account of a sequence of distinct, valid accounts.
+ *
+ * The number is written in base 61 with the characters accepted by Check_Account,
+ * so different numbers always give different accounts.
+ *
+ * @param n The position of the account in the sequence.
+ * @param account Output buffer of at least 11 bytes.
+ */
+static inline void Bench_Make_Account(uint64_t n, int8_t* account)
+{
+    static const char digits[] = "123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    int32_t i = 0;              /* Number of characters written */
+
+    /* Write the digits from the least significant one */
+    do
+    {
+        account[i] = (int8_t)digits[n % 61U];
+        n /= 61U;
+        i++;
+    }
+    while (n != 0U && i < 10);
+    account[i] = '\0';
+}
+
+/**
+ * @brief Return the next value of a xorshift64 pseudo-random generator.
+ *
+ * @param state The state of the generator, must not be 0.
+ * @return The next pseudo-random value.
+ */
+static inline uint64_t Bench_Random(uint64_t* state)
+{
+    uint64_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+#endif /* BENCH_COMMON_H */
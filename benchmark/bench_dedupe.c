@@ -0,0 +1,131 @@
+/**
+ * @file bench_dedupe.c
+ * @brief This file contains the benchmark of the parallel import of large files.
+ *
+ * The program builds in memory a file of accounts drawn from a set half as large as the
+ * file, so about 40% of the valid accounts repeat earlier ones, with 5% invalid accounts.
+ * It then imports the file into an empty store:
+ * - one account at a time, checking and adding each one as the --import option does,
+ * - with Dedupe_Import_Buffer() and 1, 2, 4, ... threads up to the given number,
+ * and prints the time of each stage and the accounts imported per second.
+ *
+ * Usage: bench_dedupe [number_of_accounts [max_threads]]
+ *        (default 10000000 and the number of processors)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* For Check_Account_Ctx() */
+#include "../account_store.h"   /* For the stores the file is imported into */
+#include "../account_dedupe.h"  /* The import under test */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Import a file one account at a time.
+ *
+ * @param data The file.
+ * @param size The size of the file.
+ * @return The number of accounts added.
+ */
+static uint64_t Import_Sequential(const int8_t* data, size_t size)
+{
+    account_store_t* store = Account_Store_Create();    /* Store the file is imported into */
+    const int8_t* line = data;                          /* Current line */
+    const int8_t* newline = NULL;                       /* End of the current line */
+    uint64_t key = 0;                                   /* Key of the current account */
+    uint64_t added = 0;                                 /* Accounts added */
+
+    while (store != NULL && line < data + size)
+    {
+        newline = (const int8_t*)memchr(line, '\n', (size_t)(data + size - line));
+        if (Check_Account_Ctx(NULL, line, (uint8_t)(newline - line), &key) == CORRECT)
+        {
+            added += (Account_Store_Add(store, key) == 1) ? 1U : 0U;
+        }
+        line = newline + 1;
+    }
+    Account_Store_Destroy(store);
+
+    return added;
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage at the top of this file.
+ * @return 0 if the benchmark completes, 1 if memory allocation failed.
+ */
+int main(int argc, char** argv)
+{
+    uint64_t count = (argc > 1) ? strtoull(argv[1], NULL, 10) : 10000000U;     /* Accounts of the file */
+    uint32_t max_threads = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 10) : Dedupe_Processors();
+    uint64_t seed = 88172645463325252ULL;   /* State of the random generator */
+    int8_t* data = NULL;                    /* The file */
+    size_t size = 0;                        /* Size of the file */
+    uint64_t random = 0;                    /* Current random value */
+    uint64_t start = 0;                     /* Start time of a run */
+    uint64_t added = 0;                     /* Accounts added by a run */
+    double elapsed = 0.0;                   /* Duration of a run in seconds */
+    Dedupe_Config_t config = { 1U, 0 };     /* Settings of the parallel import */
+    Dedupe_Stats_t stats;                   /* Results of the parallel import */
+    account_store_t* store = NULL;          /* Store of the parallel import */
+    uint64_t i = 0;                         /* Account counter */
+
+    /* Accounts have at most 10 characters and a newline */
+    data = (int8_t*)malloc((size_t)count * 12U);
+    if (data == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        random = Bench_Random(&seed);
+        Bench_Make_Account((random >> 8) % (count / 2U + 1U), &data[size]);
+        /* Spoil 5% of the accounts */
+        if (random % 20U == 0U)
+        {
+            data[size] = '_';
+        }
+        size += strlen((const char*)&data[size]);
+        data[size++] = '\n';
+    }
+    printf("%llu accounts, %.1f MB\n", (unsigned long long)count, (double)size / 1e6);
+
+    start = Bench_Now_Ns();
+    added = Import_Sequential(data, size);
+    elapsed = (double)(Bench_Now_Ns() - start) / 1e9;
+    printf("sequential  %8.3f s %10.0f accounts/s, %llu added\n", elapsed, (double)count / elapsed,
+           (unsigned long long)added);
+
+    for (config.threads = 1U; config.threads <= max_threads; config.threads *= 2U)
+    {
+        store = Account_Store_Create();
+        start = Bench_Now_Ns();
+        if (store == NULL || Dedupe_Import_Buffer(store, data, size, &config, &stats, NULL, NULL) != DEDUPE_OK)
+        {
+            printf("Error: Memory allocation failed.\n");
+        }
+        else
+        {
+            elapsed = (double)(Bench_Now_Ns() - start) / 1e9;
+            printf("%2u threads  %8.3f s %10.0f accounts/s, %llu added, %llu duplicates in the file"
+                   " (check %.3f s, partition %.3f s, dedupe %.3f s, merge %.3f s)\n",
+                   stats.threads, elapsed, (double)count / elapsed, (unsigned long long)stats.added,
+                   (unsigned long long)stats.batch_duplicates, (double)stats.check_ns / 1e9,
+                   (double)stats.partition_ns / 1e9, (double)stats.dedupe_ns / 1e9, (double)stats.merge_ns / 1e9);
+        }
+        Account_Store_Destroy(store);
+    }
+    free(data);
+
+    return 0;
+} /* EOF */
@@ -0,0 +1,150 @@
+/**
+ * @file bench_dispatch.c
+ * @brief This file contains the benchmark of the asynchronous delivery of rejected accounts.
+ *
+ * The program checks a mix of valid and invalid accounts with Check_Account(). The registered
+ * callback function prints two lines per rejected account like Show_Error(), to a file that
+ * is flushed after each line as a console is. Each run prints the time spent in the checks,
+ * the time until the last rejected account was delivered and the counters of the dispatcher:
+ * - sync: the callback function is called at once,
+ * - block, drop, coalesce: it is called from the thread of the dispatcher with that policy.
+ *
+ * Usage: bench_dispatch [number_of_accounts [percent_invalid [output_file]]]
+ *        (default 1000000, 20 and /dev/null)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* For Check_Account() and Start_Async_Errors() */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static FILE* sink = NULL;       /* File the error messages are printed to */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Print the error message of a rejected account like Show_Error().
+ *
+ * @param status The status of the account.
+ */
+static void Print_Error(status_enum_t status)
+{
+    fprintf(sink, "\nError: %s.\n\n", (status == LENGHT_INVALID) ? "Length of account is more than 10"
+                                                                 : "Account has invalid characters");
+    fflush(sink);
+    fprintf(sink, "Please enter again . . .\n");
+    fflush(sink);
+}
+
+/**
+ * @brief Check every account and print the times and counters of the run.
+ *
+ * @param name The name of the run.
+ * @param config The settings of the dispatcher, NULL to call the callback function at once.
+ * @param accounts The accounts, 16 bytes each.
+ * @param lens The lengths of the accounts.
+ * @param count The number of accounts.
+ */
+static void Run(const char* name, const Dispatch_Config_t* config, int8_t* accounts, const uint8_t* lens,
+                uint64_t count)
+{
+    Dispatch_Stats_t stats;     /* Counters of the dispatcher */
+    uint64_t start = 0;         /* Start time of the run */
+    uint64_t checked = 0;       /* Time of the checks */
+    uint64_t i = 0;             /* Account counter */
+
+    if (config != NULL && Start_Async_Errors(config) == 0)
+    {
+        printf("Error: Memory allocation failed.\n");
+    }
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        Check_Account(&accounts[i * 16U], lens[i]);
+    }
+    checked = Bench_Now_Ns() - start;
+    Flush_Async_Errors();
+    Stop_Async_Errors();
+    Get_Async_Error_Stats(&stats);
+
+    printf("%-9s %7.1f ns/check %8.1f ms until delivered %9llu delivered %9llu dropped %9llu coalesced %7llu blocked\n",
+           name, (double)checked / (double)count, (double)(Bench_Now_Ns() - start) / 1e6,
+           (unsigned long long)((config != NULL) ? stats.delivered : 0U), (unsigned long long)stats.dropped,
+           (unsigned long long)stats.coalesced, (unsigned long long)stats.blocked);
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage at the top of this file.
+ * @return 0 if the benchmark completes, 1 if the output file cannot be opened or memory allocation failed.
+ */
+int main(int argc, char** argv)
+{
+    Dispatch_Config_t config = { DISPATCH_BLOCK, DISPATCH_DEFAULT_CAPACITY, DISPATCH_DEFAULT_BATCH };
+    uint64_t count = 1000000U;      /* Accounts checked */
+    uint64_t invalid = 20U;         /* Percentage of invalid accounts */
+    uint64_t seed = 88172645463325252ULL;   /* State of the random generator */
+    int8_t* accounts = NULL;        /* The accounts, 16 bytes each */
+    uint8_t* lens = NULL;           /* The lengths of the accounts */
+    uint64_t i = 0;                 /* Account counter */
+    int32_t result = 0;             /* Exit code */
+
+    if (argc > 1)
+    {
+        count = strtoull(argv[1], NULL, 10);
+    }
+    if (argc > 2)
+    {
+        invalid = strtoull(argv[2], NULL, 10);
+    }
+    sink = fopen((argc > 3) ? argv[3] : "/dev/null", "w");
+    accounts = (int8_t*)malloc((size_t)count * 16U);
+    lens = (uint8_t*)malloc((size_t)count);
+
+    if (sink == NULL || accounts == NULL || lens == NULL)
+    {
+        printf("Error: Cannot open the output file or allocate the accounts.\n");
+        result = 1;
+    }
+    else
+    {
+        /* Spoil the first character of the invalid accounts */
+        for (i = 0; i < count; i++)
+        {
+            Bench_Make_Account(i, &accounts[i * 16U]);
+            lens[i] = (uint8_t)strlen((const char*)&accounts[i * 16U]);
+            if (Bench_Random(&seed) % 100U < invalid)
+            {
+                accounts[i * 16U] = '_';
+            }
+        }
+        RegisterCallback(Print_Error);
+        printf("%llu accounts, %llu%% invalid\n", (unsigned long long)count, (unsigned long long)invalid);
+
+        Run("sync", NULL, accounts, lens, count);
+        Run("block", &config, accounts, lens, count);
+        config.policy = DISPATCH_DROP;
+        Run("drop", &config, accounts, lens, count);
+        config.policy = DISPATCH_COALESCE;
+        Run("coalesce", &config, accounts, lens, count);
+    }
+
+    if (sink != NULL)
+    {
+        fclose(sink);
+    }
+    free(accounts);
+    free(lens);
+
+    return result;
+} /* EOF */
@@ -0,0 +1,192 @@
+/**
+ * @file bench_expiry.c
+ * @brief This file contains the benchmark of the expiry of the accounts.
+ *
+ * The timer wheel is measured alone first: millions of timers are scheduled with random
+ * deadlines, half of them are moved to a new deadline (cancel and schedule), then the
+ * clock goes forward one tick at a time until every timer has fired.
+ * The same is then done on a store: the accounts are added and given a random time to
+ * live, half of them get a new one, and Account_Store_Expire() removes them tick by
+ * tick. For reference, the time of one pass over an array of deadlines is printed,
+ * which is what a job looking for the expired accounts would pay at every tick.
+ *
+ * Usage: bench_expiry [number_of_accounts] [horizon_in_ticks]
+ *        (default 2000000 and 1000000)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_store.h"   /* The store under test */
+#include "../account_timer.h"   /* The timer wheel under test */
+#include "../account_key.h"     /* For Account_Encode() */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint64_t fired = 0;      /* Timers fired by the wheel alone */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Count a timer that fired.
+ *
+ * @param payload Not used.
+ * @param user_data Not used.
+ */
+static void Count_Fired(uint64_t payload, void* user_data)
+{
+    (void)payload;
+    (void)user_data;
+    fired++;
+}
+
+/**
+ * @brief Print the time of a phase per item.
+ *
+ * @param name The name of the phase.
+ * @param elapsed The time of the phase.
+ * @param count The number of items of the phase.
+ * @param unit The name of an item.
+ */
+static void Report(const char* name, uint64_t elapsed, uint64_t count, const char* unit)
+{
+    printf("%-40s %10.1f ns/%-7s %9.2f ms\n", name, (double)elapsed / (double)((count == 0U) ? 1U : count),
+           unit, (double)elapsed / 1e6);
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, argv[1] is the number of accounts and argv[2] the largest
+ *             time to live, in ticks.
+ * @return 0 if the benchmark completes, 1 if memory allocation failed.
+ */
+int main(int argc, char** argv)
+{
+    uint64_t count = 2000000U;          /* Number of accounts and timers */
+    uint64_t horizon = 1000000U;        /* Largest time to live */
+    uint64_t seed = 88172645463325252ULL;   /* State of the random deadlines */
+    Timer_Wheel_t wheel = { 0 };        /* The wheel measured alone */
+    account_store_t* store = NULL;      /* The store under test */
+    uint64_t* keys = NULL;              /* Key of each account */
+    uint64_t* deadline = NULL;          /* Deadline of each account, for the reference pass */
+    uint32_t* id = NULL;                /* Timer of each account */
+    account_handle_t* handle = NULL;    /* Handle of each account */
+    int8_t account[11];                 /* Account being built */
+    uint64_t start = 0;                 /* Start time of a phase */
+    uint64_t elapsed = 0;               /* Time of a phase */
+    uint64_t due = 0;                   /* Deadlines found by the reference pass */
+    uint64_t expired = 0;               /* Accounts removed by the expiry */
+    uint64_t tick = 0;                  /* Tick of the clock */
+    uint64_t i = 0;                     /* Account counter */
+
+    if (argc > 1)
+    {
+        count = strtoull(argv[1], NULL, 10);
+        count = (count == 0U) ? 1U : count;
+    }
+    if (argc > 2)
+    {
+        horizon = strtoull(argv[2], NULL, 10);
+        horizon = (horizon == 0U) ? 1U : horizon;
+    }
+
+    store = Account_Store_Create();
+    keys = (uint64_t*)malloc((size_t)count * sizeof(uint64_t));
+    deadline = (uint64_t*)malloc((size_t)count * sizeof(uint64_t));
+    id = (uint32_t*)malloc((size_t)count * sizeof(uint32_t));
+    handle = (account_handle_t*)malloc((size_t)count * sizeof(account_handle_t));
+    if (store == NULL || keys == NULL || deadline == NULL || id == NULL || handle == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        Bench_Make_Account(i, account);
+        Account_Encode(account, (uint32_t)strlen((const char*)account), &keys[i]);
+        deadline[i] = 1U + Bench_Random(&seed) % horizon;
+    }
+    printf("%llu timers, deadlines within %llu ticks\n\n", (unsigned long long)count, (unsigned long long)horizon);
+
+    /* The wheel alone */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        id[i] = Timer_Schedule(&wheel, deadline[i], i);
+    }
+    Report("wheel: schedule", Bench_Now_Ns() - start, count, "timer");
+
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i += 2U)
+    {
+        Timer_Cancel(&wheel, id[i]);
+        id[i] = Timer_Schedule(&wheel, 1U + Bench_Random(&seed) % horizon, i);
+    }
+    Report("wheel: cancel and schedule", Bench_Now_Ns() - start, (count + 1U) / 2U, "timer");
+
+    start = Bench_Now_Ns();
+    for (tick = 1U; tick <= horizon; tick++)
+    {
+        Timer_Advance(&wheel, tick, Count_Fired, NULL);
+    }
+    Report("wheel: fire", Bench_Now_Ns() - start, fired, "timer");
+    Timer_Destroy(&wheel);
+
+    /* The store */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        Account_Store_Add_Handle(store, keys[i], &handle[i]);
+    }
+    Report("store: add", Bench_Now_Ns() - start, count, "account");
+
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        Account_Store_Set_Ttl(store, handle[i], deadline[i]);
+    }
+    Report("store: set time to live", Bench_Now_Ns() - start, count, "account");
+
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i += 2U)
+    {
+        deadline[i] = 1U + Bench_Random(&seed) % horizon;
+        Account_Store_Set_Ttl(store, handle[i], deadline[i]);
+    }
+    Report("store: new time to live", Bench_Now_Ns() - start, (count + 1U) / 2U, "account");
+
+    /* What a job looking for the expired accounts pays at each tick */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        due += (deadline[i] <= 1U) ? 1U : 0U;
+    }
+    Report("reference: pass over deadlines", Bench_Now_Ns() - start, 1U, "tick");
+
+    start = Bench_Now_Ns();
+    for (tick = 1U; tick <= horizon; tick++)
+    {
+        expired += Account_Store_Expire(store, tick, NULL, NULL);
+    }
+    elapsed = Bench_Now_Ns() - start;
+    Report("store: expire (with removal)", elapsed, expired, "account");
+    Report("store: expire", elapsed, horizon, "tick");
+    printf("\n%llu of %llu accounts expired, %llu left, %llu due at tick 1\n", (unsigned long long)expired,
+           (unsigned long long)count, (unsigned long long)Account_Store_Count(store), (unsigned long long)due);
+
+    Account_Store_Destroy(store);
+    free(keys);
+    free(deadline);
+    free(id);
+    free(handle);
+
+    return 0;
+} /* EOF */
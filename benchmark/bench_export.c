@@ -0,0 +1,146 @@
+/**
+ * @file bench_export.c
+ * @brief This file contains the benchmark of the bulk output of the accounts.
+ *
+ * The program fills a store and writes all its accounts to the null device:
+ * - with one fprintf() per account, read from Account_Store_Iterate(), as the menu
+ *   listed them before,
+ * - with Export_Accounts() in each format and order,
+ * and reads them page by page with Account_Store_Next_Page(), printing the accounts
+ * written or read per second.
+ *
+ * Usage: bench_export [number_of_accounts]
+ *        (default 10000000)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* For Check_Account_Ctx() */
+#include "../account_store.h"   /* For the store and its cursor */
+#include "../account_export.h"  /* The output under test */
+#include "bench_common.h"       /* For Bench_Now_Ns() and Bench_Make_Account() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#ifdef _WIN32
+#define BENCH_NULL_DEVICE       "NUL"
+#else
+#define BENCH_NULL_DEVICE       "/dev/null"
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Print one account of a listing with fprintf(), numbered from 1.
+ *
+ * @param account The account.
+ * @param user_data The file.
+ * @return 1 to receive the next account.
+ */
+static int32_t Bench_Print(const int8_t* account, void* user_data)
+{
+    static uint64_t number = 0;     /* Number of the account */
+
+    number++;
+    fprintf((FILE*)user_data, "%llu. %s\n", (unsigned long long)number, account);
+    return 1;
+}
+
+/**
+ * @brief Print the time of a run.
+ *
+ * @param name The name of the run.
+ * @param start The start time of the run.
+ * @param count The number of accounts of the run.
+ */
+static void Bench_Report(const char* name, uint64_t start, uint64_t count)
+{
+    double elapsed = (double)(Bench_Now_Ns() - start) / 1e9;   /* Duration of the run in seconds */
+
+    printf("%-22s %8.3f s %12.0f accounts/s\n", name, elapsed, (double)count / elapsed);
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage at the top of this file.
+ * @return 0 if the benchmark completes, 1 if memory allocation failed.
+ */
+int main(int argc, char** argv)
+{
+    uint64_t count = (argc > 1) ? strtoull(argv[1], NULL, 10) : 10000000U;     /* Accounts of the store */
+    account_store_t* store = Account_Store_Create();    /* Store written out */
+    FILE* out = fopen(BENCH_NULL_DEVICE, "wb");         /* The null device */
+    static int8_t accounts[EXPORT_PAGE_SIZE][ACCOUNT_MAX_LENGTH + 1U];     /* Text of a page of accounts */
+    static const char* names[3] = { "export text", "export numbered", "export binary" };  /* Names of the formats */
+    Account_Cursor_t cursor;                /* Position of the page reads */
+    int8_t account[16];                     /* Text of the current account */
+    uint64_t key = 0;                       /* Key of the current account */
+    uint64_t written = 0;                   /* Accounts written or read by a run */
+    uint64_t start = 0;                     /* Start time of a run */
+    int64_t page = 0;                       /* Accounts of the current page */
+    char name[32];                          /* Name of a run */
+    uint32_t format = 0;                    /* Format counter */
+    int32_t sorted = 0;                     /* Order counter */
+    uint64_t i = 0;                         /* Account counter */
+
+    if (store == NULL || out == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        Bench_Make_Account(i, account);
+        Check_Account_Ctx(NULL, account, (uint8_t)strlen((const char*)account), &key);
+        Account_Store_Add(store, key);
+    }
+    /* Build the ordered index before the runs in alphabetical order */
+    Account_Store_Scan(store, 0U, ACCOUNT_KEY_NONE - 1U, NULL, NULL);
+    printf("%llu accounts\n", (unsigned long long)count);
+
+    start = Bench_Now_Ns();
+    Account_Store_Iterate(store, Bench_Print, out);
+    fflush(out);
+    Bench_Report("fprintf per line", start, count);
+
+    for (sorted = 0; sorted <= 1; sorted++)
+    {
+        for (format = EXPORT_TEXT; format <= EXPORT_BINARY; format++)
+        {
+            snprintf(name, sizeof(name), "%s%s", names[format], sorted ? " sorted" : "");
+            start = Bench_Now_Ns();
+            if (Export_Accounts(store, out, (export_format_t)format, sorted, &written) != EXPORT_OK)
+            {
+                printf("Error: Cannot write the accounts.\n");
+            }
+            fflush(out);
+            Bench_Report(name, start, written);
+        }
+    }
+
+    for (sorted = 0; sorted <= 1; sorted++)
+    {
+        start = Bench_Now_Ns();
+        written = 0;
+        Account_Store_Open_Cursor(store, sorted, &cursor);
+        do
+        {
+            page = Account_Store_Next_Page(store, &cursor, NULL, accounts, EXPORT_PAGE_SIZE);
+            written += (page > 0) ? (uint64_t)page : 0U;
+        } while (page > 0);
+        Bench_Report(sorted ? "pages sorted" : "pages", start, written);
+    }
+
+    fclose(out);
+    Account_Store_Destroy(store);
+
+    return 0;
+} /* EOF */
@@ -0,0 +1,165 @@
+/**
+ * @file bench_journal.c
+ * @brief This file contains the benchmark of the journal with group commit.
+ *
+ * The program adds and then removes distinct accounts with a journal open, once for
+ * each commit setting, and prints the sustained changes per second together with the
+ * number of commits (one fsync each). A run with compaction enabled shows the cost of
+ * folding the journal into a snapshot in the background, and the time to replay a
+ * journal at start-up is measured last.
+ *
+ * Usage: bench_journal [number_of_accounts] [directory]   (default 100000 and .)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* The account store under test */
+#include "bench_common.h"       /* For Bench_Now_Ns() and Bench_Make_Account() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SYNC_DIVISOR    100U    /* Committing every change is slow, run it on fewer accounts */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for one measured commit setting.
+ */
+typedef struct
+{
+    const char* name;           /* Name printed in the results. */
+    Journal_Config_t config;    /* Settings of the journal. */
+    uint64_t divisor;           /* The run uses number_of_accounts / divisor accounts. */
+} Bench_Setting_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const Bench_Setting_t settings[] =
+{
+    { "every change",           { 1U, 0U, 0U },         SYNC_DIVISOR },
+    { "64 changes",             { 64U, 0U, 0U },        1U },
+    { "4096 changes",           { 4096U, 0U, 0U },      1U },
+    { "4096 changes or 1 ms",   { 4096U, 1U, 0U },      1U },
+    { "4096 changes or 10 ms",  { 4096U, 10U, 0U },     1U },
+    { "+ compaction at 1 MiB",  { 4096U, 10U, 1U << 20 }, 1U },
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Add then remove accounts with a journal open.
+ *
+ * @param setting The commit setting.
+ * @param count The number of accounts.
+ * @param journal The path of the journal file.
+ * @param snapshot The path of the snapshot file.
+ */
+static void Run(const Bench_Setting_t* setting, uint64_t count, const char* journal, const char* snapshot)
+{
+    uint64_t i = 0;                 /* Loop counter */
+    uint64_t start = 0;             /* Start time of the run */
+    uint64_t elapsed = 0;           /* Time of the run */
+    int8_t account[11];             /* Account being processed */
+    Journal_Stats_t stats;          /* Counters of the journal */
+    journal_status_t status;        /* Result of opening the journal */
+
+    remove(journal);
+    status = Open_Journal(journal, snapshot, &setting->config);
+    if (status != JOURNAL_OK)
+    {
+        printf("Open_Journal failed: %s\n", Journal_Status_Message(status));
+        return;
+    }
+
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        Bench_Make_Account(i, account);
+        Add_Account(account);
+    }
+    for (i = 0; i < count; i++)
+    {
+        Bench_Make_Account(i, account);
+        Remove_Account(account);
+    }
+    Get_Journal_Stats(&stats);
+    Close_Journal(0);
+    elapsed = Bench_Now_Ns() - start;
+
+    printf("%-24s %10llu ops %12.0f ops/s %10llu commits %8.1f ops/commit %4llu compactions\n",
+           setting->name, (unsigned long long)(2U * count), 2e9 * (double)count / (double)elapsed,
+           (unsigned long long)stats.commits, (double)stats.records / (double)(stats.commits + (stats.commits == 0U)),
+           (unsigned long long)stats.compactions);
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, argv[1] is the number of accounts and argv[2] the directory of the files.
+ * @return 0 if the benchmark completes.
+ */
+int main(int argc, char** argv)
+{
+    uint64_t count = 100000U;       /* Number of accounts of a run */
+    const char* directory = ".";    /* Directory of the files */
+    char journal[1024];             /* Path of the journal file */
+    char snapshot[1024];            /* Path of the snapshot file */
+    char old[1040];                 /* Path of the old journal */
+    uint64_t i = 0;                 /* Loop counter */
+    uint64_t start = 0;             /* Start time of a measurement */
+    int8_t account[11];             /* Account being processed */
+    Journal_Config_t config = { 4096U, 0U, 0U };
+    Journal_Stats_t stats;          /* Counters of the journal */
+
+    if (argc > 1)
+    {
+        count = strtoull(argv[1], NULL, 10);
+    }
+    if (argc > 2)
+    {
+        directory = argv[2];
+    }
+    snprintf(journal, sizeof(journal), "%s/bench_journal.log", directory);
+    snprintf(snapshot, sizeof(snapshot), "%s/bench_journal.snap", directory);
+    snprintf(old, sizeof(old), "%s%s", journal, JOURNAL_OLD_SUFFIX);
+    printf("Accounts: %llu (added then removed)\n\n", (unsigned long long)count);
+
+    for (i = 0; i < sizeof(settings) / sizeof(settings[0]); i++)
+    {
+        Run(&settings[i], count / settings[i].divisor, journal, snapshot);
+    }
+
+    /* Write a journal of count additions, then replay it into an empty list */
+    remove(journal);
+    remove(snapshot);
+    Open_Journal(journal, NULL, &config);
+    for (i = 0; i < count; i++)
+    {
+        Bench_Make_Account(i, account);
+        Add_Account(account);
+    }
+    Close_Journal(0);
+    Load_Snapshot(snapshot, 0);
+
+    start = Bench_Now_Ns();
+    Open_Journal(journal, NULL, &config);
+    Get_Journal_Stats(&stats);
+    printf("\nReplay of %llu records: %.3f ms\n", (unsigned long long)stats.replayed,
+           (double)(Bench_Now_Ns() - start) / 1e6);
+    Close_Journal(0);
+
+    remove(journal);
+    remove(old);
+    remove(snapshot);
+
+    return 0;
+} /* EOF */
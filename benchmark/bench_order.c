@@ -0,0 +1,171 @@
+/**
+ * @file bench_order.c
+ * @brief This file contains the benchmark of the ordered index of the accounts.
+ *
+ * The list is filled with distinct accounts, then the program prints:
+ * - the time of the first ordered query, which builds the index,
+ * - the time of prefix queries of 1 to 4 characters, per query and per account found,
+ *   next to a scan of every account in order that keeps those with the prefix,
+ *   which is what a listing of the whole list costs,
+ * - the time of Add_Account_Key and Remove_Account_Key before and after the index is built.
+ *
+ * Usage: bench_order [number_of_accounts] [queries]
+ *        (default 1000000 and 2000)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* The store under test */
+#include "../account_key.h"     /* For Account_Encode() */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for the filter of the full scan.
+ */
+typedef struct
+{
+    const int8_t* prefix;       /* The prefix. */
+    size_t length;              /* The length of the prefix. */
+    uint64_t found;             /* Output, the number of accounts with the prefix. */
+} Filter_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint64_t* keys = NULL;           /* Keys of accounts 0 to 2 * count - 1, the first half is in the list */
+static uint64_t count = 1000000U;       /* Accounts in the list */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Keep the accounts of a full scan that start with the prefix.
+ *
+ * @param account The account.
+ * @param user_data The filter.
+ * @return 1 to receive the next account.
+ */
+static int32_t Filter_Visit(const int8_t* account, void* user_data)
+{
+    Filter_t* filter = (Filter_t*)user_data;    /* The filter */
+
+    filter->found += (memcmp(account, filter->prefix, filter->length) == 0) ? 1U : 0U;
+    return 1;
+}
+
+/**
+ * @brief Time the adds and removals of accounts that are not in the list.
+ *
+ * @param name The name of the run.
+ */
+static void Run_Changes(const char* name)
+{
+    uint64_t changes = (count < 100000U) ? count : 100000U;    /* Accounts added and removed */
+    uint64_t start = 0;         /* Start time of a phase */
+    uint64_t added = 0;         /* Time of the adds */
+    uint64_t i = 0;             /* Account counter */
+
+    start = Bench_Now_Ns();
+    for (i = 0; i < changes; i++)
+    {
+        Add_Account_Key(keys[count + i]);
+    }
+    added = Bench_Now_Ns() - start;
+    start = Bench_Now_Ns();
+    for (i = 0; i < changes; i++)
+    {
+        Remove_Account_Key(keys[count + i]);
+    }
+    printf("%-28s %7.1f ns/add %7.1f ns/remove\n", name, (double)added / (double)changes,
+           (double)(Bench_Now_Ns() - start) / (double)changes);
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage at the top of this file.
+ * @return 0 if the benchmark completes, 1 if memory allocation failed.
+ */
+int main(int argc, char** argv)
+{
+    uint64_t queries = 2000U;       /* Prefix queries of each length */
+    uint64_t seed = 88172645463325252ULL;   /* State of the random generator */
+    int8_t account[16];             /* Text of the current account */
+    int8_t prefix[16];              /* Current prefix */
+    Filter_t filter;                /* Filter of the full scan */
+    uint64_t start = 0;             /* Start time of a run */
+    uint64_t elapsed = 0;           /* Time of a run */
+    uint64_t found = 0;             /* Accounts found by the prefix queries */
+    uint64_t i = 0;                 /* Account or query counter */
+    uint32_t length = 0;            /* Length of the prefixes */
+
+    if (argc > 1)
+    {
+        count = strtoull(argv[1], NULL, 10);
+    }
+    if (argc > 2)
+    {
+        queries = strtoull(argv[2], NULL, 10);
+    }
+
+    keys = (uint64_t*)malloc((size_t)(2U * count) * sizeof(uint64_t));
+    if (keys == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+    for (i = 0; i < 2U * count; i++)
+    {
+        Bench_Make_Account(i, account);
+        Account_Encode(account, (uint32_t)strlen((const char*)account), &keys[i]);
+    }
+    for (i = 0; i < count; i++)
+    {
+        Add_Account_Key(keys[i]);
+    }
+    printf("%llu accounts in the list\n", (unsigned long long)count);
+    Run_Changes("without the ordered index");
+
+    /* The first query builds the index */
+    start = Bench_Now_Ns();
+    Search_Accounts_Prefix((const int8_t*)"", NULL, NULL);
+    printf("%-28s %7.1f ms\n", "build of the ordered index", (double)(Bench_Now_Ns() - start) / 1e6);
+    Run_Changes("with the ordered index");
+
+    for (length = 1U; length <= 4U; length++)
+    {
+        /* Prefixes of accounts in the list, so every query finds at least one account */
+        found = 0;
+        start = Bench_Now_Ns();
+        for (i = 0; i < queries; i++)
+        {
+            Bench_Make_Account(Bench_Random(&seed) % count, prefix);
+            prefix[(strlen((const char*)prefix) < length) ? strlen((const char*)prefix) : length] = '\0';
+            found += (uint64_t)Search_Accounts_Prefix(prefix, NULL, NULL);
+        }
+        elapsed = Bench_Now_Ns() - start;
+        printf("prefix of %u: %10.0f ns/query %9.1f accounts/query %7.1f ns/account", length,
+               (double)elapsed / (double)queries, (double)found / (double)queries,
+               (double)elapsed / (double)found);
+
+        /* The same kind of query answered by reading every account */
+        filter.prefix = prefix;
+        filter.length = strlen((const char*)prefix);
+        filter.found = 0;
+        start = Bench_Now_Ns();
+        Search_Accounts_Range(NULL, NULL, Filter_Visit, &filter);
+        printf("   full scan %10.0f ns/query\n", (double)(Bench_Now_Ns() - start));
+    }
+
+    free(keys);
+
+    return 0;
+} /* EOF */
@@ -0,0 +1,237 @@
+/**
+ * @file bench_rules.c
+ * @brief This file contains the benchmark of the compiled validation rules.
+ *
+ * The program builds the same mix of accounts as bench_check and checks them:
+ * - with the built-in rules, one Check_Account_Ctx() per account and Check_Batch(),
+ * - with a rule set equivalent to the built-in rules, which must give the same status
+ *   and the same key for every account,
+ * - with a rule set of prefixes and forbidden sequences, which must give the same status
+ *   as a direct check of every rule at every character,
+ * and prints the throughput of each one.
+ *
+ * Usage: bench_rules [number_of_accounts]   (default 1000000)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* For Check_Account_Ctx() */
+#include "../account_check.h"   /* For Check_Batch() */
+#include "../account_rules.h"   /* The rules under test */
+#include "bench_common.h"       /* For Bench_Now_Ns() and Bench_Random() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ROUNDS      20U         /* Number of times each validator runs over the inputs */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const char* const default_spec = "length 0-10\ncharset a-z A-Z 1-9\n";     /* The built-in rules */
+static const char* const complex_spec =
+    "# Accounts of the benchmark\n"
+    "length 2-10\n"
+    "charset a-z A-Z 0-9\n"
+    "prefix a b Xy 1 ; forbid 00 zz ab1 777 yX\n";                                  /* Rules with patterns */
+static const char* const prefixes[] = { "a", "b", "Xy", "1" };                     /* Prefixes of complex_spec */
+static const char* const sequences[] = { "00", "zz", "ab1", "777", "yX" };          /* Sequences of complex_spec */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Print the throughput of a validator.
+ *
+ * @param name The name of the validator.
+ * @param count The number of accounts checked in one round.
+ * @param elapsed The elapsed time of all rounds in nanoseconds.
+ */
+static void Report(const char* name, uint64_t count, uint64_t elapsed)
+{
+    printf("%-24s %10.2f ns/account %12.0f accounts/s\n", name, (double)elapsed / ((double)count * ROUNDS),
+           (double)count * ROUNDS / ((double)elapsed / 1e9));
+}
+
+/**
+ * @brief Check an account against complex_spec one rule at a time.
+ *
+ * @param ptr The pointer to the account.
+ * @param length The length of the account.
+ * @return The status of the account.
+ */
+static status_enum_t Reference_Check(const int8_t* ptr, uint8_t length)
+{
+    status_enum_t status = (length >= 2U && length <= 10U) ? CORRECT : LENGHT_INVALID;     /* Status of the account */
+    int32_t done = 0;           /* Set once the account has a prefix */
+    int32_t alive = 0;          /* Set while a prefix may still be met */
+    size_t size = 0;            /* Length of a pattern */
+    uint32_t i = 0;             /* Character counter */
+    uint32_t p = 0;             /* Pattern counter */
+
+    for (i = 0; (i < length) && (status == CORRECT); i++)
+    {
+        if (!((ptr[i] >= 'a' && ptr[i] <= 'z') || (ptr[i] >= 'A' && ptr[i] <= 'Z') || (ptr[i] >= '0' && ptr[i] <= '9')))
+        {
+            status = CHAR_INVALID;
+        }
+        alive = done;
+        for (p = 0; (p < sizeof(prefixes) / sizeof(prefixes[0])) && !done; p++)
+        {
+            size = strlen(prefixes[p]);
+            if (size >= i + 1U && memcmp(prefixes[p], ptr, i + 1U) == 0)
+            {
+                done = (size == i + 1U) ? 1 : 0;
+                alive = 1;
+            }
+        }
+        status = (status == CORRECT && !alive) ? PREFIX_INVALID : status;
+        for (p = 0; (p < sizeof(sequences) / sizeof(sequences[0])) && (status == CORRECT); p++)
+        {
+            size = strlen(sequences[p]);
+            if (size <= i + 1U && memcmp(sequences[p], &ptr[i + 1U - size], size) == 0)
+            {
+                status = SEQUENCE_INVALID;
+            }
+        }
+    }
+
+    return (status == CORRECT && !done) ? PREFIX_INVALID : status;
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, argv[1] is the number of accounts.
+ * @return 0 if every rule set gives the expected results, 1 if not.
+ */
+int main(int argc, char** argv)
+{
+    static const char chars[] = "abcxyzABCXYZ123789_0-#";    /* Mostly valid characters */
+    size_t count = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 10) : 1000000U;   /* Number of accounts */
+    uint64_t seed = 88172645463325252ULL;
+    int8_t* text = (int8_t*)malloc(count * 16U);                                   /* Storage of the accounts, 16 bytes each */
+    const int8_t** ptrs = (const int8_t**)malloc(count * sizeof(*ptrs));           /* Pointers to the accounts */
+    uint8_t* lens = (uint8_t*)malloc(count);                                        /* Lengths of the accounts */
+    status_enum_t* expected = (status_enum_t*)malloc(count * sizeof(status_enum_t));   /* Results of the reference */
+    status_enum_t* out = (status_enum_t*)malloc(count * sizeof(status_enum_t));        /* Results under test */
+    uint64_t* keys = (uint64_t*)malloc(count * sizeof(uint64_t));                   /* Keys of the built-in check */
+    account_rules_t* rules = NULL;      /* Rules under test */
+    Rules_Info_t info;                  /* Size of the rules */
+    rules_status_t compiled = RULES_OK; /* Result of compiling the rules */
+    uint64_t key = 0;                   /* Key of the current account */
+    uint64_t mismatches = 0;            /* Accounts with another result than the reference */
+    uint64_t start = 0;                 /* Start time of a measurement */
+    uint64_t rejected = 0;              /* Accounts rejected by the timed loops, keeps their results alive */
+    int32_t result = 0;                 /* Exit code */
+    size_t i = 0;                       /* Counter of accounts */
+    uint32_t j = 0;                     /* Counter of characters and rounds */
+    uint32_t s = 0;                     /* Counter of rule sets */
+
+    if (text == NULL || ptrs == NULL || lens == NULL || expected == NULL || out == NULL || keys == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+
+    /* Build the accounts: lengths 1 to 12, one character in 22 is invalid */
+    for (i = 0; i < count; i++)
+    {
+        lens[i] = (uint8_t)(1U + Bench_Random(&seed) % 12U);
+        ptrs[i] = &text[i * 16U];
+        for (j = 0; j < lens[i]; j++)
+        {
+            text[i * 16U + j] = (int8_t)chars[(j == 0U) ? (Bench_Random(&seed) % (sizeof(chars) - 1U))
+                                                        : (Bench_Random(&seed) % 18U)];
+        }
+    }
+    printf("Accounts: %llu\n\n", (unsigned long long)count);
+
+    /* Reference: the built-in rules */
+    for (i = 0; i < count; i++)
+    {
+        keys[i] = 0;
+        expected[i] = Check_Account_Ctx(NULL, ptrs[i], lens[i], &keys[i]);
+    }
+    start = Bench_Now_Ns();
+    for (j = 0; j < ROUNDS; j++)
+    {
+        for (i = 0; i < count; i++)
+        {
+            rejected += (Check_Account_Ctx(NULL, ptrs[i], lens[i], &key) != CORRECT) ? 1U : 0U;
+        }
+    }
+    Report("Check_Account_Ctx", count, Bench_Now_Ns() - start);
+    start = Bench_Now_Ns();
+    for (j = 0; j < ROUNDS; j++)
+    {
+        Check_Batch(ptrs, lens, count, out);
+    }
+    Report(Check_Batch_Kernel_Name(), count, Bench_Now_Ns() - start);
+
+    for (s = 0; s < 2U; s++)
+    {
+        compiled = Rules_Compile((s == 0U) ? default_spec : complex_spec, &rules, NULL);
+        if (compiled != RULES_OK)
+        {
+            printf("Error: Cannot compile the rules: %s.\n", Rules_Status_Message(compiled));
+            return 1;
+        }
+        Rules_Get_Info(rules, &info);
+        printf("\n%s rules: %u classes, %u states, %llu bytes\n", (s == 0U) ? "Built-in" : "Complex",
+               info.classes, info.states, (unsigned long long)info.bytes);
+
+        /* Compare every account with the reference before timing */
+        mismatches = 0;
+        for (i = 0; i < count; i++)
+        {
+            key = 0;
+            out[i] = Rules_Check(rules, ptrs[i], lens[i], &key);
+            if (s == 1U)
+            {
+                expected[i] = Reference_Check(ptrs[i], lens[i]);
+                keys[i] = (expected[i] == CORRECT) ? key : 0U;
+            }
+            mismatches += (out[i] != expected[i] || (out[i] == CORRECT && key != keys[i])) ? 1U : 0U;
+        }
+
+        start = Bench_Now_Ns();
+        for (j = 0; j < ROUNDS; j++)
+        {
+            for (i = 0; i < count; i++)
+            {
+                rejected += (Rules_Check(rules, ptrs[i], lens[i], &key) != CORRECT) ? 1U : 0U;
+            }
+        }
+        Report("Rules_Check", count, Bench_Now_Ns() - start);
+        start = Bench_Now_Ns();
+        for (j = 0; j < ROUNDS; j++)
+        {
+            Rules_Check_Batch(rules, ptrs, lens, count, out);
+        }
+        Report("Rules_Check_Batch", count, Bench_Now_Ns() - start);
+        mismatches += (memcmp(out, expected, count * sizeof(status_enum_t)) != 0) ? 1U : 0U;
+
+        if (mismatches != 0U)
+        {
+            printf("Error: %llu accounts differ from the reference\n", (unsigned long long)mismatches);
+            result = 1;
+        }
+        Rules_Free(rules);
+    }
+    printf("\nRejected by the timed loops: %llu\n", (unsigned long long)rejected);
+
+    free(text);
+    free(ptrs);
+    free(lens);
+    free(expected);
+    free(out);
+    free(keys);
+
+    return result;
+} /* EOF */
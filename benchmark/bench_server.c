@@ -0,0 +1,305 @@
+/**
+ * @file bench_server.c
+ * @brief This file contains the load generator of the socket server.
+ *
+ * Each client thread opens one connection and, until the time is up, sends a batch of
+ * pipelined requests with one write and reads their responses. The requests are 50%
+ * searches, 20% checks, 15% adds and 15% removes of accounts drawn from a fixed set,
+ * 5% of them invalid. The program prints the requests per second and the percentiles of
+ * the latency of a request, from its write to the read of its response.
+ *
+ * Without a socket path the program starts a server in a thread of its own on a temporary
+ * socket, with half of the accounts of the set in the list. With a path it loads the server
+ * already listening there (see the --serve option of the program).
+ *
+ * Usage: bench_server [connections [depth [seconds [socket_path]]]]
+ *        (default 4, 16 and 3)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* For filling the list of the local server */
+#include "../account_key.h"     /* For Account_Encode() */
+#include "../account_server.h"  /* For the protocol and the local server */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+#include <pthread.h>            /* For the client threads */
+#include <unistd.h>             /* For read(), write(), close(), getpid() */
+#include <sys/socket.h>         /* For the connections */
+#include <sys/un.h>             /* For struct sockaddr_un */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ACCOUNTS        200000U     /* Accounts the requests are drawn from */
+#define MAX_CLIENTS     256U        /* Largest number of client threads */
+#define MAX_DEPTH       1024U       /* Largest number of requests of a batch */
+#define MAX_SAMPLES     (1U << 20)  /* Latencies kept per client */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for the work of one client thread.
+ */
+typedef struct
+{
+    const char* path;           /* Socket of the server. */
+    uint32_t depth;             /* Requests of a batch. */
+    uint64_t deadline;          /* End of the run, in nanoseconds. */
+    uint64_t seed;              /* State of the random generator. */
+    uint64_t requests;          /* Output, requests answered. */
+    uint64_t errors;            /* Output, responses that do not match their request. */
+    uint64_t* samples;          /* Output, latency of each batch in nanoseconds. */
+    uint64_t count;             /* Output, number of samples. */
+} Client_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static Server_t local_server;   /* Server started by the program when no socket path is given */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Compare two times for qsort().
+ *
+ * @param a The first time.
+ * @param b The second time.
+ * @return A negative, zero or positive value as a is smaller, equal or larger.
+ */
+static int Compare_Times(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Transfer a whole buffer over a connection.
+ *
+ * @param fd The connection.
+ * @param buffer The bytes to write, or the buffer to read into.
+ * @param size The number of bytes.
+ * @param writing 1 to write, 0 to read.
+ * @return 1 if every byte was transferred, 0 if the connection failed.
+ */
+static int32_t Transfer(int fd, uint8_t* buffer, size_t size, int32_t writing)
+{
+    size_t done = 0;            /* Bytes transferred */
+    ssize_t n = 1;              /* Result of the last call */
+
+    while (done < size && n > 0)
+    {
+        n = writing ? write(fd, buffer + done, size - done) : read(fd, buffer + done, size - done);
+        done += (n > 0) ? (size_t)n : 0U;
+    }
+
+    return (done == size) ? 1 : 0;
+}
+
+/**
+ * @brief Body of a client thread.
+ *
+ * @param argument The work of the thread.
+ * @return NULL.
+ */
+static void* Client_Run(void* argument)
+{
+    static const uint8_t ops[20] = { 'S', 'S', 'S', 'S', 'S', 'S', 'S', 'S', 'S', 'S',
+                                     'C', 'C', 'C', 'C', 'A', 'A', 'A', 'R', 'R', 'R' };
+    Client_t* client = (Client_t*)argument;     /* The work of the thread */
+    struct sockaddr_un address;                 /* Address of the server */
+    uint8_t requests[MAX_DEPTH * (SERVER_HEADER_SIZE + 12U)];   /* Requests of the batch */
+    uint8_t responses[MAX_DEPTH * SERVER_RESPONSE_SIZE];        /* Responses of the batch */
+    uint8_t expected[MAX_DEPTH];                /* Op of each request of the batch */
+    int8_t account[16];                         /* Account of the current request */
+    size_t size = 0;                            /* Bytes of the requests of the batch */
+    size_t length = 0;                          /* Length of the current account */
+    uint64_t random = 0;                        /* Current random value */
+    uint64_t start = 0;                         /* Time the batch was written */
+    uint32_t i = 0;                             /* Request counter */
+    int32_t alive = 1;                          /* Cleared when the connection fails */
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);   /* The connection */
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, client->path, sizeof(address.sun_path) - 1U);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0)
+    {
+        printf("Error: Cannot connect to '%s'.\n", client->path);
+        alive = 0;
+    }
+
+    while (alive && Bench_Now_Ns() < client->deadline)
+    {
+        size = 0;
+        for (i = 0; i < client->depth; i++)
+        {
+            random = Bench_Random(&client->seed);
+            Bench_Make_Account(random % ACCOUNTS, account);
+            /* Spoil 5% of the accounts */
+            if ((random >> 32) % 20U == 0U)
+            {
+                account[0] = '_';
+            }
+            length = strlen((const char*)account);
+            expected[i] = ops[(random >> 40) % 20U];
+            requests[size] = (uint8_t)(length + 1U);
+            requests[size + 1U] = 0;
+            requests[size + 2U] = 0;
+            requests[size + 3U] = 0;
+            requests[size + 4U] = expected[i];
+            memcpy(&requests[size + 5U], account, length);
+            size += SERVER_HEADER_SIZE + 1U + length;
+        }
+
+        start = Bench_Now_Ns();
+        alive = Transfer(fd, requests, size, 1)
+                && Transfer(fd, responses, (size_t)client->depth * SERVER_RESPONSE_SIZE, 0);
+        if (alive && client->count < MAX_SAMPLES)
+        {
+            client->samples[client->count++] = Bench_Now_Ns() - start;
+        }
+        for (i = 0; alive && i < client->depth; i++)
+        {
+            client->errors += (responses[i * SERVER_RESPONSE_SIZE] != 3U
+                               || responses[i * SERVER_RESPONSE_SIZE + 4U] != expected[i]) ? 1U : 0U;
+        }
+        client->requests += alive ? client->depth : 0U;
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Body of the thread of the local server.
+ *
+ * @param argument Not used.
+ * @return NULL.
+ */
+static void* Server_Thread(void* argument)
+{
+    (void)argument;
+    Server_Run(&local_server);
+    return NULL;
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage at the top of this file.
+ * @return 0 if the benchmark completes, 1 if the server cannot be started or memory allocation failed.
+ */
+int main(int argc, char** argv)
+{
+    static Client_t clients[MAX_CLIENTS];   /* Work of the client threads */
+    pthread_t threads[MAX_CLIENTS];         /* The client threads */
+    pthread_t server_thread;                /* Thread of the local server */
+    Server_Config_t config = { NULL, 0 };   /* Socket of the local server */
+    char path[64];                          /* Socket of the server */
+    int8_t account[16];                     /* Account added to the local server */
+    uint64_t key = 0;                       /* Key of that account */
+    uint32_t connections = 4U;              /* Number of client threads */
+    uint32_t depth = 16U;                   /* Requests of a batch */
+    uint64_t seconds = 3U;                  /* Duration of the run */
+    uint64_t* samples = NULL;               /* Latencies of every client */
+    uint64_t count = 0;                     /* Number of latencies */
+    uint64_t requests = 0;                  /* Requests answered */
+    uint64_t errors = 0;                    /* Responses that do not match their request */
+    uint64_t start = 0;                     /* Start time of the run */
+    double elapsed = 0.0;                   /* Duration of the run in seconds */
+    uint32_t i = 0;                         /* Client counter */
+    int32_t local = (argc <= 4) ? 1 : 0;    /* Set when the program starts the server */
+
+    connections = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : connections;
+    depth = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 10) : depth;
+    seconds = (argc > 3) ? strtoull(argv[3], NULL, 10) : seconds;
+    connections = (connections < 1U) ? 1U : ((connections > MAX_CLIENTS) ? MAX_CLIENTS : connections);
+    depth = (depth < 1U) ? 1U : ((depth > MAX_DEPTH) ? MAX_DEPTH : depth);
+    snprintf(path, sizeof(path), "%s", local ? "" : argv[4]);
+
+    if (local)
+    {
+        /* Half of the accounts are in the list, so the searches and removes find half of theirs */
+        for (i = 0; i < ACCOUNTS; i += 2U)
+        {
+            Bench_Make_Account(i, account);
+            Account_Encode(account, (uint32_t)strlen((const char*)account), &key);
+            Add_Account_Key(key);
+        }
+        snprintf(path, sizeof(path), "/tmp/bench_server_%ld.sock", (long)getpid());
+        config.unix_path = path;
+        if (Server_Open(&local_server, &config) != SERVER_OK
+            || pthread_create(&server_thread, NULL, Server_Thread, NULL) != 0)
+        {
+            printf("Error: Cannot start the server on '%s'.\n", path);
+            return 1;
+        }
+    }
+
+    samples = (uint64_t*)malloc((size_t)connections * MAX_SAMPLES * sizeof(uint64_t));
+    if (samples == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+
+    start = Bench_Now_Ns();
+    for (i = 0; i < connections; i++)
+    {
+        clients[i].path = path;
+        clients[i].depth = depth;
+        clients[i].deadline = start + seconds * 1000000000ULL;
+        clients[i].seed = 88172645463325252ULL + i * 0x9E3779B97F4A7C15ULL;
+        clients[i].samples = &samples[(size_t)i * MAX_SAMPLES];
+        pthread_create(&threads[i], NULL, Client_Run, &clients[i]);
+    }
+    for (i = 0; i < connections; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    elapsed = (double)(Bench_Now_Ns() - start) / 1e9;
+
+    /* Gather the latencies of every client */
+    for (i = 0; i < connections; i++)
+    {
+        memmove(&samples[count], clients[i].samples, (size_t)clients[i].count * sizeof(uint64_t));
+        count += clients[i].count;
+        requests += clients[i].requests;
+        errors += clients[i].errors;
+    }
+    qsort(samples, (size_t)count, sizeof(uint64_t), Compare_Times);
+
+    printf("%u connections, %u requests per batch, %.1f s\n", connections, depth, elapsed);
+    printf("%.0f requests/s, %llu bad responses\n", (double)requests / elapsed, (unsigned long long)errors);
+    if (count > 0U)
+    {
+        printf("latency p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+               (double)samples[count / 2U] / 1e3, (double)samples[count * 99U / 100U] / 1e3,
+               (double)samples[count * 999U / 1000U] / 1e3, (double)samples[count - 1U] / 1e3);
+    }
+
+    if (local)
+    {
+        Server_Stop(&local_server);
+        pthread_join(server_thread, NULL);
+        printf("server: %llu requests in %llu reads\n", (unsigned long long)local_server.stats.requests,
+               (unsigned long long)local_server.stats.reads);
+        Server_Close(&local_server);
+    }
+    free(samples);
+
+    return 0;
+} /* EOF */
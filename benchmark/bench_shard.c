@@ -0,0 +1,398 @@
+/**
+ * @file bench_shard.c
+ * @brief This file contains the benchmark of the concurrent searches of the list.
+ *
+ * The list is filled with distinct accounts, then 1, 2, 4, ... reader threads look up
+ * accounts (half hits, half misses) and the total lookups per second are printed with
+ * the scaling over one thread (last column before the writer rate). Each thread count is run three ways:
+ * - Is_Account_Key_Exist(), served by the sharded set of the keys without a lock,
+ * - the same while one writer thread removes and adds accounts through the list,
+ * - Account_Store_Contains() behind a global lock, which is what sharing the list
+ *   between threads would need without the sharded set.
+ *
+ * The sharded set is checked first with the key 0 of the empty account, then the
+ * searches are checked once more threads than there are epoch slots have come and gone.
+ *
+ * Usage: bench_shard [number_of_accounts] [max_threads] [lookups_per_thread]
+ *        (default 1000000, 8 and 2000000)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* The list under test */
+#include "../account_store.h"   /* For Account_Store_Contains(), the reference */
+#include "../account_key.h"     /* For Account_Encode() */
+#include "../account_shard.h"   /* For the check of the key 0 */
+#include "../account_epoch.h"   /* For EPOCH_MAX_THREADS */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+#include <pthread.h>            /* For the reader and writer threads */
+#include <stdatomic.h>          /* For the stop flag of the writer */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define MAX_THREADS     128U    /* Maximum number of reader threads */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration for the searches under test.
+ */
+typedef enum
+{
+    TARGET_SHARD,               /* Lock-free lookups of the list in its sharded set. */
+    TARGET_GLOBAL_LOCK          /* Lookups of the live store through its filter and index under a lock. */
+} target_t;
+
+/**
+ * @brief Structure for the work of one thread.
+ */
+typedef struct
+{
+    target_t target;            /* The search to run. */
+    uint64_t seed;              /* Seed of the random accounts. */
+    uint64_t ops;               /* Number of operations. */
+    uint64_t hits;              /* Output, the number of accounts found. */
+} Worker_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static pthread_mutex_t global_lock = PTHREAD_MUTEX_INITIALIZER;    /* Lock of the reference searches */
+static uint64_t* keys = NULL;                               /* Keys of accounts 0 to 2 * count - 1 */
+static uint64_t count = 1000000U;                           /* Accounts in the list */
+static atomic_int stop_writer;                              /* Set when the readers are done */
+static _Atomic uint64_t writer_ops;                         /* Changes made by the writer */
+static _Atomic uint64_t churn_errors;                       /* Searches of Check_Thread_Churn() with an impossible result */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Body of a reader thread.
+ *
+ * Half of the keys are in the list, so half of the lookups are hits. The filter of the
+ * reference searches counts its queries, so they need a lock that excludes the others.
+ *
+ * @param argument The work of the thread.
+ * @return NULL.
+ */
+static void* Reader_Run(void* argument)
+{
+    Worker_t* worker = (Worker_t*)argument;     /* Work of the thread */
+    uint64_t i = 0;                             /* Lookup counter */
+    uint64_t key = 0;                           /* Key being looked up */
+
+    for (i = 0; i < worker->ops; i++)
+    {
+        key = keys[Bench_Random(&worker->seed) % (2U * count)];
+        if (worker->target == TARGET_SHARD)
+        {
+            worker->hits += (uint64_t)Is_Account_Key_Exist(key);
+        }
+        else
+        {
+            pthread_mutex_lock(&global_lock);
+            worker->hits += (uint64_t)Account_Store_Contains(Get_Account_Store(), key);
+            pthread_mutex_unlock(&global_lock);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Body of the writer thread: remove an account and add it back until stopped.
+ *
+ * @param argument The work of the thread.
+ * @return NULL.
+ */
+static void* Writer_Run(void* argument)
+{
+    Worker_t* worker = (Worker_t*)argument;     /* Work of the thread */
+    uint64_t key = 0;                           /* Key being changed */
+    uint64_t ops = 0;                           /* Changes made */
+
+    while (atomic_load(&stop_writer) == 0)
+    {
+        key = keys[Bench_Random(&worker->seed) % count];
+        Remove_Account_Key(key);
+        Add_Account_Key(key);
+        ops += 2U;
+    }
+    atomic_store(&writer_ops, ops);
+
+    return NULL;
+}
+
+/**
+ * @brief Run the readers and print their throughput.
+ *
+ * @param name The name of the run.
+ * @param target The search to run.
+ * @param threads The number of reader threads.
+ * @param ops The lookups of each reader.
+ * @param writer 1 to run the writer thread during the lookups.
+ * @param single In/out, the lookups per second of the run with one thread.
+ */
+static void Run(const char* name, target_t target, uint32_t threads, uint64_t ops, int32_t writer, double* single)
+{
+    pthread_t thread[MAX_THREADS];      /* Reader threads */
+    Worker_t worker[MAX_THREADS];       /* Work of the readers */
+    pthread_t writer_thread;            /* Writer thread */
+    Worker_t writer_work;               /* Work of the writer */
+    uint64_t start = 0;                 /* Start time of the run */
+    uint64_t elapsed = 0;               /* Time of the run */
+    uint64_t hits = 0;                  /* Accounts found by all readers */
+    double rate = 0.0;                  /* Lookups per second */
+    uint32_t j = 0;                     /* Thread counter */
+
+    atomic_store(&stop_writer, 0);
+    atomic_store(&writer_ops, 0U);
+    writer_work.seed = 0x2545F4914F6CDD1DULL;
+    if (writer)
+    {
+        pthread_create(&writer_thread, NULL, Writer_Run, &writer_work);
+    }
+
+    start = Bench_Now_Ns();
+    for (j = 0; j < threads; j++)
+    {
+        worker[j].target = target;
+        worker[j].seed = 88172645463325252ULL + j * 0x9E3779B97F4A7C15ULL;
+        worker[j].ops = ops;
+        worker[j].hits = 0;
+        pthread_create(&thread[j], NULL, Reader_Run, &worker[j]);
+    }
+    for (j = 0; j < threads; j++)
+    {
+        pthread_join(thread[j], NULL);
+        hits += worker[j].hits;
+    }
+    elapsed = Bench_Now_Ns() - start;
+
+    if (writer)
+    {
+        atomic_store(&stop_writer, 1);
+        pthread_join(writer_thread, NULL);
+    }
+
+    rate = (double)threads * (double)ops * 1e9 / (double)elapsed;
+    if (threads == 1U)
+    {
+        *single = rate;
+    }
+    printf("%-20s %3u threads %9.2f Mlookups/s %7.1f ns/lookup %5.1f%% hits %6.2fx", name, threads,
+           rate / 1e6, (double)elapsed / (double)ops, 100.0 * (double)hits / ((double)threads * (double)ops),
+           rate / *single);
+    if (writer)
+    {
+        printf(" %7.2f Mchanges/s", (double)atomic_load(&writer_ops) * 1e3 / (double)elapsed);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Check that the sharded set stores the key 0, of the empty account, like any other key.
+ *
+ * @param other A key other than 0.
+ * @return 1 if the set gives the expected results, 0 if not or if memory allocation failed.
+ */
+static int32_t Check_Key_Zero(uint64_t other)
+{
+    int32_t passed = 0;         /* Set once the set is allocated, cleared by the first unexpected result */
+    Shard_Store_t* store = Shard_Store_Create();    /* The set under test */
+
+    if (store != NULL)
+    {
+        passed = 1;
+        passed &= (Shard_Insert(store, other) == 1);
+        passed &= (Shard_Contains(store, 0U) == 0);
+        passed &= (Shard_Insert(store, 0U) == 1);
+        passed &= (Shard_Insert(store, 0U) == 0);
+        passed &= (Shard_Contains(store, 0U) == 1);
+        passed &= (Shard_Contains(store, ACCOUNT_KEY_NONE) == 0);
+        passed &= (Shard_Remove(store, 0U) == 1);
+        passed &= (Shard_Contains(store, 0U) == 0);
+        passed &= (Shard_Contains(store, other) == 1);
+        passed &= (Shard_Remove(store, other) == 1);
+        passed &= (Shard_Count(store) == 0U);
+        Shard_Store_Free(store);
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Body of a thread that searches the list once and ends.
+ *
+ * @param argument Unused.
+ * @return NULL.
+ */
+static void* Churn_Run(void* argument)
+{
+    (void)argument;
+    Is_Account_Key_Exist(keys[0]);
+
+    return NULL;
+}
+
+/**
+ * @brief Body of the reader of Check_Thread_Churn(): search the changed accounts until stopped.
+ *
+ * @param argument The number of accounts changed, a uint64_t*.
+ * @return NULL.
+ */
+static void* Churn_Read(void* argument)
+{
+    uint64_t changed = *(const uint64_t*)argument;  /* Accounts changed by the writer */
+    uint64_t i = 0;                                 /* Search counter */
+    int32_t found = 0;                              /* Result of the current search */
+
+    while (atomic_load(&stop_writer) == 0)
+    {
+        found = Search_Account_Key(keys[i % changed]);
+        if (found < -1 || found > 1)
+        {
+            atomic_fetch_add(&churn_errors, 1U);
+        }
+        i++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Check the searches once more threads than there are epoch slots have ended.
+ *
+ * The ended threads must have given their slots back, and a reader without a slot must
+ * still be protected. The list is filled and emptied again while a reader searches it,
+ * so the sets and tables it reads are retired under it; a build with
+ * -fsanitize=address reports them if they are freed too soon. The list must be empty,
+ * it is left empty.
+ *
+ * @return 1 if every search gave a possible result, 0 if not.
+ */
+static int32_t Check_Thread_Churn(void)
+{
+    pthread_t thread[MAX_THREADS];      /* Short-lived threads of a round */
+    pthread_t reader;                   /* Reader running during the changes */
+    uint64_t changed = (count < 4096U) ? count : 4096U;     /* Accounts added and removed */
+    uint32_t round = 0;                 /* Round counter */
+    uint32_t j = 0;                     /* Thread counter */
+    uint64_t i = 0;                     /* Account counter */
+
+    /* Each round starts and ends MAX_THREADS threads, past the EPOCH_MAX_THREADS slots */
+    for (round = 0; round < 2U * EPOCH_MAX_THREADS / MAX_THREADS + 1U; round++)
+    {
+        for (j = 0; j < MAX_THREADS; j++)
+        {
+            pthread_create(&thread[j], NULL, Churn_Run, NULL);
+        }
+        for (j = 0; j < MAX_THREADS; j++)
+        {
+            pthread_join(thread[j], NULL);
+        }
+    }
+
+    atomic_store(&stop_writer, 0);
+    atomic_store(&churn_errors, 0U);
+    pthread_create(&reader, NULL, Churn_Read, &changed);
+    for (round = 0; round < 64U; round++)
+    {
+        for (i = 0; i < changed; i++)
+        {
+            Add_Account_Key(keys[i]);
+        }
+        for (i = 0; i < changed; i++)
+        {
+            Remove_Account_Key(keys[i]);
+        }
+    }
+    atomic_store(&stop_writer, 1);
+    pthread_join(reader, NULL);
+
+    return (atomic_load(&churn_errors) == 0U) ? 1 : 0;
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, argv[1] is the number of accounts, argv[2] the largest
+ *             number of reader threads and argv[3] the lookups of each reader.
+ * @return 0 if the benchmark completes, 1 if memory allocation or a check failed.
+ */
+int main(int argc, char** argv)
+{
+    uint32_t max_threads = 8U;          /* Largest number of reader threads */
+    uint64_t ops = 2000000U;            /* Lookups of each reader */
+    uint32_t threads = 1U;              /* Number of reader threads of a run */
+    double single[3] = { 0.0, 0.0, 0.0 };   /* Rates of the one-thread runs */
+    int8_t account[11];                 /* Account being built */
+    uint64_t i = 0;                     /* Account counter */
+
+    if (argc > 1)
+    {
+        count = strtoull(argv[1], NULL, 10);
+        count = (count == 0U) ? 1U : count;
+    }
+    if (argc > 2)
+    {
+        max_threads = (uint32_t)strtoul(argv[2], NULL, 10);
+        max_threads = (max_threads == 0U) ? 1U : ((max_threads > MAX_THREADS) ? MAX_THREADS : max_threads);
+    }
+    if (argc > 3)
+    {
+        ops = strtoull(argv[3], NULL, 10);
+    }
+
+    keys = (uint64_t*)malloc((size_t)(2U * count) * sizeof(uint64_t));
+    if (keys == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+
+    if (Check_Key_Zero(0x123456789ULL) == 0)
+    {
+        printf("Error: The sharded set does not keep the key 0 apart from its empty slots.\n");
+        return 1;
+    }
+
+    for (i = 0; i < 2U * count; i++)
+    {
+        Bench_Make_Account(i, account);
+        Account_Encode(account, (uint32_t)strlen((const char*)account), &keys[i]);
+    }
+    if (Check_Thread_Churn() == 0)
+    {
+        printf("Error: A search gave an impossible result while threads came and went.\n");
+        return 1;
+    }
+
+    /* Accounts below count go into the list, the others are misses */
+    for (i = 0; i < count; i++)
+    {
+        Add_Account_Key(keys[i]);
+    }
+    printf("Accounts: %llu in %u shards, %llu lookups per thread\n\n",
+           (unsigned long long)Get_Account_Count(), SHARD_COUNT, (unsigned long long)ops);
+
+    for (threads = 1U; threads <= max_threads; threads *= 2U)
+    {
+        Run("sharded", TARGET_SHARD, threads, ops, 0, &single[0]);
+        Run("sharded + 1 writer", TARGET_SHARD, threads, ops, 1, &single[1]);
+        Run("global lock", TARGET_GLOBAL_LOCK, threads, ops, 0, &single[2]);
+        printf("\n");
+    }
+
+    free(keys);
+
+    return 0;
+} /* EOF */
@@ -0,0 +1,159 @@
+/**
+ * @file bench_snapshot.c
+ * @brief This file contains the benchmark of the start-up time with a snapshot.
+ *
+ * The program fills the store, saves it with Save_Snapshot, then compares two ways
+ * of getting the same list back at start-up: loading the snapshot with Load_Snapshot
+ * (with and without checksum verification) and adding every account again the way
+ * an import does. The time of the first lookups after loading is printed too, since
+ * they are the ones that fault the pages of the mapped file in.
+ *
+ * Usage: bench_snapshot [number_of_accounts] [snapshot_file]
+ *        (default 1000000 and bench_snapshot.snap)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* The account store under test */
+#include "bench_common.h"       /* For Bench_Now_Ns() and Bench_Make_Account() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define FIRST_LOOKUPS   1000U   /* Lookups measured right after loading */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Print one line of results.
+ *
+ * @param name The name of the measured step.
+ * @param elapsed The elapsed time in nanoseconds.
+ * @return The elapsed time in milliseconds.
+ */
+static double Report(const char* name, uint64_t elapsed)
+{
+    double ms = (double)elapsed / 1e6;
+
+    printf("%-32s %12.3f ms\n", name, ms);
+    return ms;
+}
+
+/**
+ * @brief Load the snapshot and measure the first lookups.
+ *
+ * @param path The snapshot file.
+ * @param verify Non-zero to verify the checksum of the records.
+ * @param count The number of accounts in the snapshot.
+ * @param hits Incremented for every account found.
+ * @return The load time in milliseconds, 0 if the load failed.
+ */
+static double Measure_Load(const char* path, int32_t verify, uint64_t count, uint64_t* hits)
+{
+    double ms = 0.0;                /* Load time */
+    uint64_t start = 0;             /* Start time of a measurement */
+    uint64_t i = 0;                 /* Loop counter */
+    int8_t account[11];             /* Account being looked up */
+    snapshot_status_t status;       /* Result of the load */
+
+    start = Bench_Now_Ns();
+    status = Load_Snapshot(path, verify);
+    if (status != SNAPSHOT_OK)
+    {
+        printf("Load_Snapshot failed: %s\n", Snapshot_Status_Message(status));
+    }
+    else
+    {
+        ms = Report(verify ? "Load_Snapshot (verify)" : "Load_Snapshot", Bench_Now_Ns() - start);
+
+        /* Spread the lookups over the whole file */
+        start = Bench_Now_Ns();
+        for (i = 0; i < FIRST_LOOKUPS; i++)
+        {
+            Bench_Make_Account((i * 7919U) % count, account);
+            *hits += (Search_Account(account) == 1);
+        }
+        Report("  first lookups", Bench_Now_Ns() - start);
+    }
+
+    return ms;
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, argv[1] is the number of accounts and argv[2] the snapshot file.
+ * @return 0 if the benchmark completes, 1 if the snapshot cannot be written.
+ */
+int main(int argc, char** argv)
+{
+    uint64_t count = 1000000U;      /* Number of accounts in the store */
+    const char* path = "bench_snapshot.snap";
+    uint64_t i = 0;                 /* Loop counter */
+    uint64_t start = 0;             /* Start time of a measurement */
+    uint64_t hits = 0;              /* Number of successful lookups, keeps the loops alive */
+    int8_t account[11];             /* Account being processed */
+    double rebuild = 0.0;           /* ms to rebuild the store by adding every account */
+    double load = 0.0;              /* ms to load the snapshot */
+    snapshot_status_t status;       /* Result of the save */
+
+    if (argc > 1)
+    {
+        count = strtoull(argv[1], NULL, 10);
+    }
+    if (argc > 2)
+    {
+        path = argv[2];
+    }
+    if (count == 0U)
+    {
+        count = 1U;
+    }
+    printf("Accounts: %llu\n\n", (unsigned long long)count);
+
+    /* Rebuild the store the way an import does */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        Bench_Make_Account(i, account);
+        if (!Is_Account_Exist(account))
+        {
+            Add_Account(account);
+        }
+    }
+    rebuild = Report("Rebuild with Add_Account", Bench_Now_Ns() - start);
+
+    start = Bench_Now_Ns();
+    status = Save_Snapshot(path);
+    Report("Save_Snapshot", Bench_Now_Ns() - start);
+    if (status != SNAPSHOT_OK)
+    {
+        printf("Save_Snapshot failed: %s\n", Snapshot_Status_Message(status));
+        return 1;
+    }
+
+    /* Load_Snapshot drops the current list first */
+    load = Measure_Load(path, 0, count, &hits);
+    Measure_Load(path, 1, count, &hits);
+
+    /* The first change copies the snapshot into the list */
+    start = Bench_Now_Ns();
+    Bench_Make_Account(count, account);
+    Add_Account(account);
+    Report("First Add_Account after load", Bench_Now_Ns() - start);
+
+    if (load > 0.0)
+    {
+        printf("\nSpeedup of the start-up over a rebuild: %.0fx\n", rebuild / load);
+    }
+    printf("(checksum %llu)\n", (unsigned long long)hits);
+    remove(path);
+
+    return 0;
+} /* EOF */
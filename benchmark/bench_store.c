@@ -0,0 +1,245 @@
+/**
+ * @file bench_store.c
+ * @brief This file contains the benchmark of the account store lookups.
+ *
+ * The program fills the store with distinct accounts the same way main.c does
+ * (Is_Account_Exist followed by Add_Account), then measures Search_Account hits and
+ * misses and Remove_Account. The same lookups are measured on a plain linked list
+ * walked with strcmp, which is how the store worked before the hash index, and the
+ * speedup per lookup is printed. The store is scanned in display order, and the
+ * handles returned by Add_Account are looked up.
+ * Then half of the accounts are replaced one by one, with the usage of the slot array
+ * printed before and after, and the other half is removed by handle once the handles
+ * of the replaced accounts are checked to be stale.
+ *
+ * Usage: bench_store [number_of_accounts]   (default 1000000)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* The account store under test */
+#include "bench_common.h"       /* For Bench_Now_Ns() and Bench_Make_Account() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define LIST_LOOKUPS    200U    /* Lookups measured on the linked list, each one walks the whole list */
+#define SCAN_PAGE       4096U   /* Keys read per page of the full scan */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for a node of the reference linked list.
+ */
+typedef struct List_Node
+{
+    int8_t account[11];         /* The account stored in the node. */
+    struct List_Node* next;     /* Pointer to the next node in the list. */
+} List_Node_t;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Search an account in the reference linked list.
+ *
+ * @param list The head of the list.
+ * @param account The account to search for.
+ * @return 1 if the account is found, 0 if not.
+ */
+static int32_t List_Search(const List_Node_t* list, const int8_t* account)
+{
+    int32_t found = 0;          /* Flag to indicate if the account is found */
+
+    while (list != NULL && found == 0)
+    {
+        found = (strcmp((const char*)list->account, (const char*)account) == 0);
+        list = list->next;
+    }
+    return found;
+}
+
+/**
+ * @brief Print one line of results.
+ *
+ * @param name The name of the measured operation.
+ * @param count The number of operations.
+ * @param elapsed The elapsed time in nanoseconds.
+ * @return The time of one operation in nanoseconds.
+ */
+static double Report(const char* name, uint64_t count, uint64_t elapsed)
+{
+    double per_op = (double)elapsed / (double)count;
+
+    printf("%-28s %10llu ops %12.1f ns/op %12.0f ops/s\n", name, (unsigned long long)count,
+           per_op, 1e9 / per_op);
+    return per_op;
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, argv[1] is the number of accounts.
+ * @return 0 if the benchmark completes, 1 if a stale handle names an account or the scan misses some.
+ */
+int main(int argc, char** argv)
+{
+    uint64_t count = 1000000U;      /* Number of accounts in the store */
+    uint64_t i = 0;                 /* Loop counter */
+    uint64_t start = 0;             /* Start time of a measurement */
+    uint64_t hits = 0;              /* Number of successful lookups, keeps the loops alive */
+    int8_t account[11];             /* Account being processed */
+    List_Node_t* list = NULL;       /* Reference linked list */
+    List_Node_t* nodes = NULL;      /* Storage of the reference list */
+    double store_miss = 0.0;        /* ns per miss in the store */
+    double list_miss = 0.0;         /* ns per miss in the list */
+    Pool_Stats_t pool;              /* Usage of the slot array */
+    account_handle_t* handles = NULL;   /* Handle of each account */
+    uint64_t* page = NULL;          /* Keys of a page of the full scan */
+    Account_Cursor_t cursor;        /* Position of the full scan */
+    int64_t read = 0;               /* Keys read by the last page */
+    uint64_t scanned = 0;           /* Keys read by the full scan */
+    uint64_t stale = 0;             /* Handles of removed accounts that still name one */
+
+    if (argc > 1)
+    {
+        count = strtoull(argv[1], NULL, 10);
+    }
+    handles = (account_handle_t*)malloc(((size_t)count + 1U) * sizeof(account_handle_t));
+    page = (uint64_t*)malloc(SCAN_PAGE * sizeof(uint64_t));
+    if (handles == NULL || page == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+    printf("Accounts: %llu\n\n", (unsigned long long)count);
+
+    /* Fill the store the way main.c does */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        Bench_Make_Account(i, account);
+        if (!Is_Account_Exist(account))
+        {
+            handles[i] = Add_Account(account);
+        }
+    }
+    Report("Is_Account_Exist+Add", count, Bench_Now_Ns() - start);
+
+    /* Look up accounts that are in the store */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        Bench_Make_Account(i, account);
+        hits += (Search_Account(account) == 1);
+    }
+    Report("Search_Account (hit)", count, Bench_Now_Ns() - start);
+
+    /* Look up accounts that are not in the store */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        Bench_Make_Account(count + i, account);
+        hits += (Search_Account(account) == 1);
+    }
+    store_miss = Report("Search_Account (miss)", count, Bench_Now_Ns() - start);
+
+    /* Build the reference list with the same accounts */
+    nodes = (List_Node_t*)malloc((size_t)count * sizeof(List_Node_t));
+    if (nodes != NULL)
+    {
+        for (i = 0; i < count; i++)
+        {
+            Bench_Make_Account(i, nodes[i].account);
+            nodes[i].next = list;
+            list = &nodes[i];
+        }
+        /* A miss walks the whole list, which is also what every Add paid before */
+        start = Bench_Now_Ns();
+        for (i = 0; i < LIST_LOOKUPS; i++)
+        {
+            Bench_Make_Account(count + i, account);
+            hits += List_Search(list, account);
+        }
+        list_miss = Report("linked list search (miss)", LIST_LOOKUPS, Bench_Now_Ns() - start);
+        free(nodes);
+    }
+
+    /* A full scan reads the slot array from end to end */
+    start = Bench_Now_Ns();
+    Open_Accounts_Cursor(&cursor, 0);
+    do
+    {
+        read = Next_Accounts_Page(&cursor, page, NULL, SCAN_PAGE);
+        scanned += (read > 0) ? (uint64_t)read : 0U;
+    } while (read > 0);
+    Report("full scan (display order)", scanned, Bench_Now_Ns() - start);
+
+    /* Look up every account by its handle */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count; i++)
+    {
+        hits += (uint64_t)Lookup_Account_Handle(handles[i], account);
+    }
+    Report("Lookup_Account_Handle", count, Bench_Now_Ns() - start);
+
+    Get_Pool_Stats(&pool);
+    printf("\nPool before churn: live %u, free %u, capacity %u\n", pool.live, pool.free, pool.capacity);
+
+    /* Replace the first half of the accounts with new ones */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count / 2U; i++)
+    {
+        Bench_Make_Account(i, account);
+        hits += (Remove_Account(account) == 1);
+        Bench_Make_Account(2U * count + i, account);
+        Add_Account(account);
+    }
+    Report("Remove_Account+Add_Account", count / 2U, Bench_Now_Ns() - start);
+
+    Get_Pool_Stats(&pool);
+    printf("Pool after churn:  live %u, free %u, capacity %u\n\n", pool.live, pool.free, pool.capacity);
+
+    /* The handles of the replaced accounts must not reach the accounts that took their slots */
+    for (i = 0; i < count / 2U; i++)
+    {
+        stale += (uint64_t)Lookup_Account_Handle(handles[i], account);
+    }
+
+    /* Remove the new accounts by name and the original ones by handle */
+    start = Bench_Now_Ns();
+    for (i = 0; i < count / 2U; i++)
+    {
+        Bench_Make_Account(2U * count + i, account);
+        hits += (Remove_Account(account) == 1);
+    }
+    Report("Remove_Account", count / 2U, Bench_Now_Ns() - start);
+    start = Bench_Now_Ns();
+    for (i = count / 2U; i < count; i++)
+    {
+        hits += (Remove_Account_Handle(handles[i]) == 1);
+    }
+    Report("Remove_Account_Handle", count - count / 2U, Bench_Now_Ns() - start);
+
+    if (list_miss > 0.0)
+    {
+        printf("\nSpeedup of a miss over the linked list: %.0fx\n", list_miss / store_miss);
+    }
+    printf("(checksum %llu)\n", (unsigned long long)hits);
+    free(handles);
+    free(page);
+
+    if (stale != 0U || scanned != count)
+    {
+        printf("Error: %llu stale handles still name an account, %llu accounts scanned\n",
+               (unsigned long long)stale, (unsigned long long)scanned);
+    }
+
+    return (stale != 0U || scanned != count) ? 1 : 0;
+} /* EOF */
@@ -0,0 +1,359 @@
+/**
+ * @file bench_view.c
+ * @brief This file contains the benchmark of the pinned views of a store.
+ *
+ * The store is filled with distinct accounts, then one writer thread adds and removes
+ * random accounts as fast as it can while reader threads scan whole views of the store.
+ * Every period changes the writer pins a view and hands it over with the number of
+ * accounts and the XOR of their keys it expects; a reader checks that the view lists
+ * exactly those accounts in strictly increasing order. While no view of the writer is
+ * waiting, a reader pins a view itself and checks that it lists as many accounts as it
+ * counts, in strictly increasing order. The writer rate, the time to pin a view and the
+ * accounts scanned per second are printed for 0, 1, 2, ... readers.
+ *
+ * Usage: bench_view [number_of_accounts] [max_readers] [changes] [period]
+ *        (default 1000000, 4, 4000000 and 100000)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_store.h"   /* The store under test */
+#include "../account_key.h"     /* For Account_Encode() */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+#include <pthread.h>            /* For the reader and writer threads */
+#include <stdatomic.h>          /* For the hand-over of the views */
+#include <sched.h>              /* For sched_yield() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define MAX_READERS     64U     /* Maximum number of reader threads */
+#define PAGE_SIZE       1024U   /* Accounts read per page of a view */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for a view handed over to the readers.
+ */
+typedef struct
+{
+    account_view_t* view;       /* The view. */
+    uint64_t count;             /* Accounts of the store when the view was pinned. */
+    uint64_t checksum;          /* XOR of their keys. */
+    int32_t own;                /* Set for a view a reader pinned, whose keys are not known. */
+} Published_t;
+
+/**
+ * @brief Structure for the work of a reader thread.
+ */
+typedef struct
+{
+    uint64_t views;             /* Output, the number of views scanned. */
+    uint64_t accounts;          /* Output, the number of accounts scanned. */
+    uint64_t errors;            /* Output, the number of views that did not match. */
+    uint64_t pins;              /* Output, the number of views the reader pinned itself. */
+} Reader_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static account_store_t* store = NULL;           /* The store under test */
+static uint64_t* keys = NULL;                   /* Keys of accounts 0 to 2 * count - 1 */
+static uint8_t* present = NULL;                 /* Set for the accounts in the store */
+static uint64_t count = 1000000U;               /* Accounts in the store at the start */
+static uint64_t live_count = 0;                 /* Accounts in the store */
+static uint64_t live_checksum = 0;              /* XOR of their keys */
+static _Atomic(Published_t*) mailbox;           /* Newest view not taken by a reader */
+static atomic_int stop_readers;                 /* Set when the writer is done */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Release a view handed over to the readers.
+ *
+ * @param published The view, may be NULL.
+ */
+static void Discard(Published_t* published)
+{
+    if (published != NULL)
+    {
+        Account_View_Release(published->view);
+        free(published);
+    }
+}
+
+/**
+ * @brief Scan a whole view and check it against what the writer expected.
+ *
+ * A view pinned by the reader is only checked against its own count and order.
+ *
+ * @param published The view.
+ * @param reader The work of the reader, updated.
+ */
+static void Check_View(const Published_t* published, Reader_t* reader)
+{
+    uint64_t page[PAGE_SIZE];   /* Keys of the current page */
+    Account_Cursor_t cursor;    /* Position in the view */
+    int64_t read = 1;           /* Accounts of the current page */
+    int64_t i = 0;              /* Account counter within the page */
+    uint64_t seen = 0;          /* Accounts of the view */
+    uint64_t checksum = 0;      /* XOR of their keys */
+    uint64_t previous = 0;      /* Key of the previous account */
+    int32_t ordered = 1;        /* Cleared when a key is not above the previous one */
+
+    Account_View_Open_Cursor(published->view, &cursor);
+    while (read > 0)
+    {
+        read = Account_View_Next_Page(published->view, &cursor, page, NULL, PAGE_SIZE);
+        for (i = 0; i < read; i++)
+        {
+            ordered = (seen > 0U && page[i] <= previous) ? 0 : ordered;
+            previous = page[i];
+            checksum ^= page[i];
+            seen++;
+        }
+    }
+
+    reader->views++;
+    reader->accounts += seen;
+    if (ordered == 0 || seen != published->count || (published->own == 0 && checksum != published->checksum) ||
+        Account_View_Count(published->view) != published->count)
+    {
+        reader->errors++;
+    }
+}
+
+/**
+ * @brief Body of a reader thread: scan the views of the writer until it is done.
+ *
+ * @param argument The work of the thread.
+ * @return NULL.
+ */
+static void* Reader_Run(void* argument)
+{
+    Reader_t* reader = (Reader_t*)argument;     /* Work of the thread */
+    Published_t* published = NULL;              /* View taken from the writer */
+
+    while (atomic_load(&stop_readers) == 0)
+    {
+        published = atomic_exchange(&mailbox, NULL);
+        /* Without a view of the writer, pin one while the writer keeps changing the store */
+        if (published == NULL && (published = (Published_t*)malloc(sizeof(Published_t))) != NULL)
+        {
+            published->view = Account_Store_Pin_View(store);
+            if (published->view != NULL)
+            {
+                published->count = Account_View_Count(published->view);
+                published->own = 1;
+                reader->pins++;
+            }
+        }
+        if (published != NULL && published->view != NULL)
+        {
+            Check_View(published, reader);
+        }
+        else
+        {
+            sched_yield();
+        }
+        Discard(published);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Add or remove a random account, keeping the expected count and checksum.
+ *
+ * @param seed In/out, the state of the random numbers.
+ */
+static void Change(uint64_t* seed)
+{
+    uint64_t n = Bench_Random(seed) % (2U * count);     /* Account being changed */
+
+    if (present[n])
+    {
+        Account_Store_Remove(store, keys[n]);
+        live_count--;
+    }
+    else
+    {
+        Account_Store_Add(store, keys[n]);
+        live_count++;
+    }
+    present[n] ^= 1U;
+    live_checksum ^= keys[n];
+}
+
+/**
+ * @brief Run the writer with a number of readers and print the rates.
+ *
+ * @param readers The number of reader threads.
+ * @param changes The changes made by the writer.
+ * @param period The changes between two views, 0 to never pin a view.
+ */
+static void Run(uint32_t readers, uint64_t changes, uint64_t period)
+{
+    pthread_t thread[MAX_READERS];      /* Reader threads */
+    Reader_t reader[MAX_READERS];       /* Work of the readers */
+    Published_t* published = NULL;      /* View being handed over */
+    uint64_t seed = 0x2545F4914F6CDD1DULL;  /* State of the random changes */
+    uint64_t start = 0;                 /* Start time of the run */
+    uint64_t elapsed = 0;               /* Time of the run */
+    uint64_t pin_start = 0;             /* Start time of a pin */
+    uint64_t pin_total = 0;             /* Time spent pinning views */
+    uint64_t pin_max = 0;               /* Longest pin */
+    uint64_t pins = 0;                  /* Views pinned */
+    uint64_t views = 0;                 /* Views scanned by all readers */
+    uint64_t own = 0;                   /* Views the readers pinned themselves */
+    uint64_t accounts = 0;              /* Accounts scanned by all readers */
+    uint64_t errors = 0;                /* Views that did not match */
+    uint64_t i = 0;                     /* Change counter */
+    uint32_t j = 0;                     /* Thread counter */
+
+    atomic_store(&stop_readers, 0);
+    for (j = 0; j < readers; j++)
+    {
+        memset(&reader[j], 0, sizeof(Reader_t));
+        pthread_create(&thread[j], NULL, Reader_Run, &reader[j]);
+    }
+
+    start = Bench_Now_Ns();
+    for (i = 1; i <= changes; i++)
+    {
+        Change(&seed);
+        if (period > 0U && i % period == 0U)
+        {
+            published = (Published_t*)malloc(sizeof(Published_t));
+            if (published != NULL)
+            {
+                pin_start = Bench_Now_Ns();
+                published->view = Account_Store_Pin_View(store);
+                pin_start = Bench_Now_Ns() - pin_start;
+                pin_total += pin_start;
+                pin_max = (pin_start > pin_max) ? pin_start : pin_max;
+                pins++;
+                published->count = live_count;
+                published->checksum = live_checksum;
+                published->own = 0;
+                /* A view no reader took yet is replaced by the newer one */
+                Discard(atomic_exchange(&mailbox, published));
+            }
+        }
+    }
+    elapsed = Bench_Now_Ns() - start;
+
+    atomic_store(&stop_readers, 1);
+    for (j = 0; j < readers; j++)
+    {
+        pthread_join(thread[j], NULL);
+        views += reader[j].views;
+        accounts += reader[j].accounts;
+        errors += reader[j].errors;
+        own += reader[j].pins;
+    }
+    Discard(atomic_exchange(&mailbox, NULL));
+
+    printf("%2u readers %s %8.2f Mchanges/s", readers, (period > 0U) ? "views" : "none ",
+           (double)changes * 1e3 / (double)elapsed);
+    if (pins > 0U)
+    {
+        printf(" pin %6.0f ns avg %7llu ns max", (double)pin_total / (double)pins, (unsigned long long)pin_max);
+    }
+    if (readers > 0U)
+    {
+        printf(" %6llu views (%llu pinned by readers) %8.2f Maccounts/s scanned %llu errors",
+               (unsigned long long)views, (unsigned long long)own, (double)accounts * 1e3 / (double)elapsed,
+               (unsigned long long)errors);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, argv[1] is the number of accounts, argv[2] the largest
+ *             number of reader threads, argv[3] the changes of each run and argv[4]
+ *             the changes between two views.
+ * @return 0 if the benchmark completes, 1 if memory allocation failed.
+ */
+int main(int argc, char** argv)
+{
+    uint32_t max_readers = 4U;          /* Largest number of reader threads */
+    uint64_t changes = 4000000U;        /* Changes of each run */
+    uint64_t period = 100000U;          /* Changes between two views */
+    uint32_t readers = 0;               /* Number of reader threads of a run */
+    int8_t account[11];                 /* Account being built */
+    uint64_t i = 0;                     /* Account counter */
+
+    if (argc > 1)
+    {
+        count = strtoull(argv[1], NULL, 10);
+        count = (count == 0U) ? 1U : count;
+    }
+    if (argc > 2)
+    {
+        max_readers = (uint32_t)strtoul(argv[2], NULL, 10);
+        max_readers = (max_readers > MAX_READERS) ? MAX_READERS : max_readers;
+    }
+    if (argc > 3)
+    {
+        changes = strtoull(argv[3], NULL, 10);
+    }
+    if (argc > 4)
+    {
+        period = strtoull(argv[4], NULL, 10);
+        period = (period == 0U) ? 1U : period;
+    }
+
+    store = Account_Store_Create();
+    keys = (uint64_t*)malloc((size_t)(2U * count) * sizeof(uint64_t));
+    present = (uint8_t*)calloc((size_t)(2U * count), sizeof(uint8_t));
+    if (store == NULL || keys == NULL || present == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+
+    /* Accounts below count start in the store, the others are added by the writer */
+    for (i = 0; i < 2U * count; i++)
+    {
+        Bench_Make_Account(i, account);
+        Account_Encode(account, (uint32_t)strlen((const char*)account), &keys[i]);
+        if (i < count)
+        {
+            Account_Store_Add(store, keys[i]);
+            present[i] = 1U;
+            live_count++;
+            live_checksum ^= keys[i];
+        }
+    }
+    /* Build the ordered index once, every run then keeps it up to date and published */
+    if (Account_Store_Prepare_Views(store) == 0)
+    {
+        return 1;
+    }
+    printf("Accounts: %llu, %llu changes per run, a view every %llu changes\n\n",
+           (unsigned long long)Account_Store_Count(store), (unsigned long long)changes,
+           (unsigned long long)period);
+
+    Run(0U, changes, 0U);
+    Run(0U, changes, period);
+    for (readers = 1U; readers <= max_readers; readers *= 2U)
+    {
+        Run(readers, changes, period);
+    }
+
+    Account_Store_Destroy(store);
+    free(keys);
+    free(present);
+
+    return 0;
+} /* EOF */
@@ -0,0 +1,791 @@
+/**
+ * @file bench_workload.c
+ * @brief This file contains the synthetic workloads and the trace replay of account_manage.c.
+ *
+ * In its first mode the program generates a workload and runs it against the list:
+ * - each operation is an addition, a removal, a search or a check, picked with the
+ *   weights of --mix,
+ * - the account of an operation is drawn from --keys accounts, uniformly or with a
+ *   Zipfian popularity of parameter --zipf (0 for uniform), the popular accounts
+ *   being scattered over the key space rather than being the first ones,
+ * - a share --invalid of the accounts is spoiled, half of them with an invalid
+ *   character and half made too long.
+ * The operations are made as the menu of main.c makes them: an addition is a
+ * Check_Account_Key() followed, for a valid account, by Add_Account_Key(), so it is
+ * counted as a check and an add. Before the workload, --preload accounts are added.
+ * With --record the whole run, preload included, is written to a trace (see
+ * account_trace.h), so a replay starts from the same empty list.
+ *
+ * In its second mode the program replays a trace, recorded by --record or by
+ * "main --trace", either as fast as it can (--pace max) or with the delays between
+ * the operations of the trace (--pace original). The results that differ from the
+ * recorded ones are counted, they tell that the list did not start the same way or
+ * that a change altered the behavior.
+ *
+ * The whole workload is built in memory before it runs, so reading the trace is not
+ * measured. Each operation is timed on its own, and the throughput and the mean,
+ * percentiles and worst time of each kind of operation are reported. With the
+ * original pacing an operation is timed from the moment it was due, so the time an
+ * operation waits behind a slow one is counted as well.
+ *
+ * Usage: bench_workload [--ops n] [--keys n] [--preload n] [--mix add,remove,search,check]
+ *                       [--zipf theta] [--invalid rate] [--seed n] [--record file]
+ *        bench_workload --replay file [--pace max|original]
+ *        (default 1000000 operations on 100000 accounts, half of them preloaded,
+ *        mix 20,10,60,10, zipf 0.99, 1% invalid)
+ *
+ * @author Viet Ha Nguyen
+ * @date 17/10/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "../account_manage.h"  /* The functions under test, Start_Trace() and Stop_Trace() */
+#include "../account_trace.h"   /* For reading the traces */
+#include "../account_key.h"     /* For Account_Encode() */
+#include "bench_common.h"       /* For Bench_Now_Ns(), Bench_Make_Account() and Bench_Random() */
+#include <math.h>               /* For pow() */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define OP_KINDS        5U          /* Kinds of operation of a trace */
+#define MAX_SPOILED     (ACCOUNT_MAX_LENGTH + 4U)   /* Longest account made too long */
+#define SLEEP_MARGIN_NS 2000000U    /* Delays longer than this are slept, the rest is waited actively */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure for an operation of a workload.
+ */
+typedef struct
+{
+    trace_op_t op;              /* The operation. */
+    uint8_t length;             /* Length of the account. */
+    int32_t expected;           /* Result recorded in the trace. */
+    size_t offset;              /* Position of the account in the text of the workload. */
+    uint64_t time_ns;           /* Time of the operation since the start of the trace. */
+} Work_t;
+
+/**
+ * @brief Structure for a workload.
+ */
+typedef struct
+{
+    Work_t* work;               /* The operations, in order. */
+    uint64_t count;             /* Number of operations. */
+    uint64_t capacity;          /* Operations the array can hold. */
+    int8_t* text;               /* The accounts of the operations, each one NUL terminated. */
+    size_t text_used;           /* Bytes of text in use. */
+    size_t text_capacity;       /* Bytes the text can hold. */
+    int32_t recorded;           /* Set when the workload comes from a trace, with its results. */
+} Workload_t;
+
+/**
+ * @brief Structure for the Zipfian generator of Gray et al., "Quickly Generating Billion-Record Synthetic Databases".
+ */
+typedef struct
+{
+    uint64_t items;             /* Number of items, ranked from 0, the most popular. */
+    double theta;               /* Skew, 0 for uniform, below 1. */
+    double zetan;               /* Sum of 1 / i^theta for i from 1 to items. */
+    double alpha;               /* 1 / (1 - theta). */
+    double eta;                 /* Correction of the approximation for the ranks above 1. */
+} Zipf_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const trace_op_t op_kinds[OP_KINDS] = { TRACE_ADD, TRACE_REMOVE, TRACE_SEARCH, TRACE_CHECK, TRACE_EXISTS };
+static const char* const op_names[OP_KINDS] = { "add", "remove", "search", "check", "exists" };
+static uint64_t rejected = 0;   /* Accounts reported to the callback function */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Count a rejected account, callback of the list.
+ *
+ * @param status The status of the account.
+ */
+static void Count_Rejected(status_enum_t status)
+{
+    (void)status;
+    rejected++;
+}
+
+/**
+ * @brief Compare two times for qsort().
+ *
+ * @param a The first time.
+ * @param b The second time.
+ * @return A negative, zero or positive value as a is smaller, equal or larger.
+ */
+static int Compare_Times(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Measure the cost of reading the clock twice.
+ *
+ * @return The median of many empty measurements in ns.
+ */
+static uint64_t Measure_Clock(void)
+{
+    uint64_t t[1001];           /* Empty measurements */
+    uint64_t start = 0;         /* Start of a measurement */
+    uint32_t i = 0;             /* Measurement counter */
+
+    for (i = 0; i < 1001U; i++)
+    {
+        start = Bench_Now_Ns();
+        t[i] = Bench_Now_Ns() - start;
+    }
+    qsort(t, 1001U, sizeof(uint64_t), Compare_Times);
+
+    return t[500];
+}
+
+/**
+ * @brief Draw a number uniformly from [0, 1).
+ *
+ * @param seed The state of the random generator.
+ * @return The number.
+ */
+static double Random_Unit(uint64_t* seed)
+{
+    return (double)(Bench_Random(seed) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Prepare the Zipfian generator.
+ *
+ * @param zipf Output, the generator.
+ * @param items The number of items.
+ * @param theta The skew, 0 for uniform, below 1.
+ */
+static void Zipf_Init(Zipf_t* zipf, uint64_t items, double theta)
+{
+    uint64_t i = 0;             /* Item counter */
+
+    zipf->items = items;
+    zipf->theta = theta;
+    zipf->zetan = 0.0;
+    zipf->alpha = 1.0;
+    zipf->eta = 1.0;
+    if (theta > 0.0)
+    {
+        for (i = 1U; i <= items; i++)
+        {
+            zipf->zetan += 1.0 / pow((double)i, theta);
+        }
+        zipf->alpha = 1.0 / (1.0 - theta);
+        zipf->eta = (1.0 - pow(2.0 / (double)items, 1.0 - theta)) /
+                    (1.0 - (1.0 + pow(0.5, theta)) / zipf->zetan);
+    }
+}
+
+/**
+ * @brief Draw the rank of an item.
+ *
+ * @param zipf The generator.
+ * @param seed The state of the random generator.
+ * @return The rank, 0 for the most popular item.
+ */
+static uint64_t Zipf_Next(const Zipf_t* zipf, uint64_t* seed)
+{
+    double u = Random_Unit(seed);   /* Uniform draw */
+    double uz = u * zipf->zetan;    /* Draw scaled to the sum of the weights */
+    uint64_t rank = 0;              /* Rank drawn */
+
+    if (zipf->theta <= 0.0)
+    {
+        rank = (uint64_t)(u * (double)zipf->items);
+    }
+    else if (uz < 1.0)
+    {
+        rank = 0U;
+    }
+    else if (uz < 1.0 + pow(0.5, zipf->theta))
+    {
+        rank = 1U;
+    }
+    else
+    {
+        rank = (uint64_t)((double)zipf->items * pow(zipf->eta * u - zipf->eta + 1.0, zipf->alpha));
+    }
+
+    return (rank < zipf->items) ? rank : zipf->items - 1U;
+}
+
+/**
+ * @brief Scatter a rank over the accounts, so the popular accounts are not the first ones.
+ *
+ * @param rank The rank.
+ * @param items The number of accounts.
+ * @return The number of the account.
+ */
+static uint64_t Scatter(uint64_t rank, uint64_t items)
+{
+    uint64_t x = (rank + 1U) * 0x9E3779B97F4A7C15ULL;   /* Fibonacci hash of the rank */
+
+    x ^= x >> 29;
+    return x % items;
+}
+
+/**
+ * @brief Spoil an account, with an invalid character or by making it too long.
+ *
+ * @param account The account, of at least MAX_SPOILED + 1 bytes.
+ * @param length The length of the account, updated.
+ * @param seed The state of the random generator.
+ */
+static void Spoil(int8_t* account, uint8_t* length, uint64_t* seed)
+{
+    uint64_t draw = Bench_Random(seed);     /* Choice of the damage */
+
+    if ((draw & 1U) != 0U)
+    {
+        account[(draw >> 1) % *length] = '#';
+    }
+    else
+    {
+        /* Pad the account past the longest one, with valid characters */
+        while (*length <= ACCOUNT_MAX_LENGTH + (uint32_t)((draw >> 1) % (MAX_SPOILED - ACCOUNT_MAX_LENGTH)))
+        {
+            account[*length] = '1';
+            (*length)++;
+        }
+        account[*length] = '\0';
+    }
+}
+
+/**
+ * @brief Append an operation to a workload.
+ *
+ * @param workload The workload.
+ * @param op The operation.
+ * @param account The account.
+ * @param length The length of the account.
+ * @param expected The recorded result.
+ * @param time_ns The time of the operation since the start of the trace.
+ * @return 1 if the operation is appended, 0 if memory allocation failed.
+ */
+static int32_t Workload_Push(Workload_t* workload, trace_op_t op, const int8_t* account, uint8_t length,
+                             int32_t expected, uint64_t time_ns)
+{
+    int32_t result = 1;         /* Result of the append */
+    Work_t* work = NULL;        /* The larger array of operations */
+    int8_t* text = NULL;        /* The larger text */
+
+    if (workload->count == workload->capacity)
+    {
+        work = (Work_t*)realloc(workload->work, (size_t)(2U * workload->capacity + 1024U) * sizeof(Work_t));
+        if (work == NULL)
+        {
+            result = 0;
+        }
+        else
+        {
+            workload->work = work;
+            workload->capacity = 2U * workload->capacity + 1024U;
+        }
+    }
+    if (result && workload->text_used + length + 1U > workload->text_capacity)
+    {
+        text = (int8_t*)realloc(workload->text, 2U * workload->text_capacity + 65536U);
+        if (text == NULL)
+        {
+            result = 0;
+        }
+        else
+        {
+            workload->text = text;
+            workload->text_capacity = 2U * workload->text_capacity + 65536U;
+        }
+    }
+
+    if (result)
+    {
+        work = &workload->work[workload->count];
+        work->op = op;
+        work->length = length;
+        work->expected = expected;
+        work->offset = workload->text_used;
+        work->time_ns = time_ns;
+        memcpy(&workload->text[workload->text_used], account, length);
+        workload->text[workload->text_used + length] = '\0';
+        workload->text_used += length + 1U;
+        workload->count++;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Generate a workload.
+ *
+ * @param workload Output, the workload.
+ * @param ops The number of operations.
+ * @param keys The number of accounts the operations are drawn from.
+ * @param mix The weights of the additions, removals, searches and checks.
+ * @param theta The skew of the popularity of the accounts, 0 for uniform.
+ * @param invalid The share of spoiled accounts.
+ * @param seed The state of the random generator.
+ * @return 1 if the workload is generated, 0 if memory allocation failed.
+ */
+static int32_t Generate(Workload_t* workload, uint64_t ops, uint64_t keys, const uint32_t* mix, double theta,
+                        double invalid, uint64_t* seed)
+{
+    int32_t result = 1;         /* Result of the generation */
+    Zipf_t zipf;                /* Popularity of the accounts */
+    uint32_t total = mix[0] + mix[1] + mix[2] + mix[3];     /* Sum of the weights */
+    uint32_t pick = 0;          /* Draw of the operation */
+    uint32_t kind = 0;          /* Kind of the operation */
+    int8_t account[MAX_SPOILED + 1U];   /* Account of the operation */
+    uint8_t length = 0;         /* Length of the account */
+    uint64_t key = 0;           /* Key of the account */
+    uint64_t i = 0;             /* Operation counter */
+
+    Zipf_Init(&zipf, keys, theta);
+    for (i = 0; i < ops && result; i++)
+    {
+        pick = (uint32_t)(Bench_Random(seed) % total);
+        kind = 0U;
+        while (pick >= mix[kind])
+        {
+            pick -= mix[kind];
+            kind++;
+        }
+
+        Bench_Make_Account(Scatter(Zipf_Next(&zipf, seed), keys), account);
+        length = (uint8_t)strlen((const char*)account);
+        if (Random_Unit(seed) < invalid)
+        {
+            Spoil(account, &length, seed);
+        }
+
+        /* An addition is checked first, and made only for a valid account */
+        if (op_kinds[kind] == TRACE_ADD)
+        {
+            result = Workload_Push(workload, TRACE_CHECK, account, length, 0, 0U);
+            if (result && Account_Encode(account, length, &key))
+            {
+                result = Workload_Push(workload, TRACE_ADD, account, length, 0, 0U);
+            }
+        }
+        else
+        {
+            result = Workload_Push(workload, op_kinds[kind], account, length, 0, 0U);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Read the operations of a trace into a workload.
+ *
+ * @param workload Output, the workload.
+ * @param path The path of the trace file.
+ * @return 0 if the trace is read, 1 if not, the reason is printed.
+ */
+static int32_t Load_Trace(Workload_t* workload, const char* path)
+{
+    int32_t result = 0;         /* Result of the load */
+    Trace_Reader_t reader;      /* The trace */
+    Trace_Record_t record;      /* Record being read */
+    trace_status_t status = Trace_Open(&reader, path);  /* Result of the opening */
+    int32_t read = 1;           /* Result of the last read */
+
+    if (status != TRACE_OK)
+    {
+        printf("Error: Cannot open trace '%s': %s.\n", path, Trace_Status_Message(status));
+        result = 1;
+    }
+    else
+    {
+        while (read == 1 && result == 0)
+        {
+            read = Trace_Read(&reader, &record);
+            if (read == 1 && Workload_Push(workload, record.op, record.account, record.length, record.result,
+                                           record.time_ns) == 0)
+            {
+                printf("Error: Memory allocation failed.\n");
+                result = 1;
+            }
+        }
+        if (read < 0)
+        {
+            printf("Error: Trace '%s' is damaged after %llu records.\n", path, (unsigned long long)reader.records);
+            result = 1;
+        }
+        Trace_Close(&reader);
+        workload->recorded = 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Wait until a time of the clock.
+ *
+ * @param due The time.
+ */
+static void Wait_Until(uint64_t due)
+{
+    uint64_t now = Bench_Now_Ns();  /* Current time */
+#ifndef _WIN32
+    struct timespec delay;          /* Time to sleep */
+#endif
+
+    while (now < due)
+    {
+        /* Sleep through most of a long delay, the clock is then waited for actively */
+        if (due - now > SLEEP_MARGIN_NS)
+        {
+#ifdef _WIN32
+            Sleep((DWORD)((due - now - SLEEP_MARGIN_NS) / 1000000U));
+#else
+            delay.tv_sec = (time_t)((due - now - SLEEP_MARGIN_NS) / 1000000000U);
+            delay.tv_nsec = (long)((due - now - SLEEP_MARGIN_NS) % 1000000000U);
+            nanosleep(&delay, NULL);
+#endif
+        }
+        now = Bench_Now_Ns();
+    }
+}
+
+/**
+ * @brief Make an operation of a workload on the list.
+ *
+ * @param workload The workload.
+ * @param work The operation.
+ * @return The result of the operation, as it is recorded in a trace.
+ */
+static int32_t Run_Work(Workload_t* workload, const Work_t* work)
+{
+    int8_t* account = &workload->text[work->offset];   /* Account of the operation */
+    uint64_t key = ACCOUNT_KEY_NONE;    /* Key of the account */
+    int32_t result = 0;                 /* Result of the operation */
+
+    switch (work->op)
+    {
+        case TRACE_CHECK:
+        {
+            Check_Account_Key(account, work->length, NULL);
+            result = (int32_t)Get_Status();
+            break;
+        }
+        case TRACE_ADD:
+        {
+            /* An account that cannot be packed into a key is refused without touching the list */
+            if (Account_Encode(account, work->length, &key))
+            {
+                result = Add_Account_Key(key);
+            }
+            break;
+        }
+        default:
+        {
+            if (Account_Encode(account, work->length, &key) == 0)
+            {
+                key = ACCOUNT_KEY_NONE;
+            }
+            result = (work->op == TRACE_REMOVE) ? Remove_Account_Key(key)
+                   : ((work->op == TRACE_SEARCH) ? Search_Account_Key(key) : Is_Account_Key_Exist(key));
+            break;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Make every operation of a workload on the list, timing each one.
+ *
+ * @param workload The workload.
+ * @param paced 1 to keep the delays of the trace, 0 to run as fast as possible.
+ * @param times Output, the time of each operation.
+ * @param differ Output, the number of results that differ from the recorded ones.
+ * @return The time of the whole run.
+ */
+static uint64_t Run(Workload_t* workload, int32_t paced, uint64_t* times, uint64_t* differ)
+{
+    uint64_t clock_cost = (paced) ? 0U : Measure_Clock();   /* Time of reading the clock twice */
+    uint64_t start = Bench_Now_Ns();    /* Start of the run */
+    uint64_t begin = 0;                 /* Start of an operation */
+    uint64_t end = 0;                   /* End of an operation */
+    int32_t result = 0;                 /* Result of an operation */
+    uint64_t i = 0;                     /* Operation counter */
+
+    *differ = 0;
+    for (i = 0; i < workload->count; i++)
+    {
+        if (paced)
+        {
+            /* Time the operation from when it was due, so a late start is counted */
+            begin = start + workload->work[i].time_ns;
+            Wait_Until(begin);
+        }
+        else
+        {
+            begin = Bench_Now_Ns();
+        }
+        result = Run_Work(workload, &workload->work[i]);
+        end = Bench_Now_Ns();
+        times[i] = (end - begin > clock_cost) ? end - begin - clock_cost : 0U;
+        *differ += (workload->recorded && result != workload->work[i].expected) ? 1U : 0U;
+    }
+
+    return Bench_Now_Ns() - start;
+}
+
+/**
+ * @brief Read a percentile of sorted times.
+ *
+ * @param sorted The times, in increasing order.
+ * @param count The number of times.
+ * @param percent The percentile.
+ * @return The percentile in ns.
+ */
+static double Percentile(const uint64_t* sorted, uint64_t count, double percent)
+{
+    uint64_t rank = (uint64_t)(percent / 100.0 * (double)(count - 1U) + 0.5);
+
+    return (double)sorted[rank];
+}
+
+/**
+ * @brief Print the throughput of a run and the times of each kind of operation.
+ *
+ * @param workload The workload.
+ * @param times The time of each operation.
+ * @param elapsed The time of the whole run.
+ * @return 1 if the times are printed, 0 if memory allocation failed.
+ */
+static int32_t Report(const Workload_t* workload, const uint64_t* times, uint64_t elapsed)
+{
+    int32_t result = 1;         /* Result of the report */
+    uint64_t* sorted = (uint64_t*)malloc((size_t)(workload->count + 1U) * sizeof(uint64_t));   /* Times of a kind */
+    uint64_t count = 0;         /* Operations of the kind */
+    uint64_t total = 0;         /* Sum of the times of the kind */
+    uint32_t kind = 0;          /* Kind counter */
+    uint64_t i = 0;             /* Operation counter */
+
+    printf("%llu operations in %.2f ms, %.3f Mops/s\n\n", (unsigned long long)workload->count,
+           (double)elapsed / 1e6, (double)workload->count * 1e3 / (double)((elapsed == 0U) ? 1U : elapsed));
+    if (sorted == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        result = 0;
+    }
+    else
+    {
+        printf("%-8s %10s %9s %9s %9s %9s %9s %11s\n", "op", "count", "mean ns", "p50", "p90", "p99", "p99.9",
+               "max");
+        for (kind = 0; kind < OP_KINDS; kind++)
+        {
+            count = 0;
+            total = 0;
+            for (i = 0; i < workload->count; i++)
+            {
+                if (workload->work[i].op == op_kinds[kind])
+                {
+                    sorted[count] = times[i];
+                    total += times[i];
+                    count++;
+                }
+            }
+            if (count != 0U)
+            {
+                qsort(sorted, (size_t)count, sizeof(uint64_t), Compare_Times);
+                printf("%-8s %10llu %9.1f %9.1f %9.1f %9.1f %9.1f %11.1f\n", op_names[kind],
+                       (unsigned long long)count, (double)total / (double)count, Percentile(sorted, count, 50.0),
+                       Percentile(sorted, count, 90.0), Percentile(sorted, count, 99.0),
+                       Percentile(sorted, count, 99.9), (double)sorted[count - 1U]);
+            }
+        }
+        free(sorted);
+    }
+
+    return result;
+}
+
+/**
+ * @brief The main function of the benchmark.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage at the top of this file.
+ * @return 0 if the benchmark completes, 1 if the arguments, the trace or the memory are lacking.
+ */
+int main(int argc, char** argv)
+{
+    uint64_t ops = 1000000U;            /* Operations to generate */
+    uint64_t keys = 100000U;            /* Accounts the operations are drawn from */
+    int64_t preload = -1;               /* Accounts added before the workload, -1 for half of the keys */
+    uint32_t mix[4] = { 20U, 10U, 60U, 10U };   /* Weights of the additions, removals, searches and checks */
+    double theta = 0.99;                /* Skew of the popularity */
+    double invalid = 0.01;              /* Share of spoiled accounts */
+    uint64_t seed = 88172645463325252ULL;   /* State of the random generator */
+    const char* record_path = NULL;     /* File given with --record */
+    const char* replay_path = NULL;     /* File given with --replay */
+    int32_t paced = 0;                  /* Set by --pace original */
+    Workload_t workload;                /* The operations to run */
+    uint64_t* times = NULL;             /* Time of each operation */
+    uint64_t elapsed = 0;               /* Time of the run */
+    uint64_t differ = 0;                /* Results that differ from the trace */
+    trace_status_t traced = TRACE_OK;   /* Result of the trace functions */
+    int8_t account[11];                 /* Account being preloaded */
+    uint64_t key = 0;                   /* Key of the account */
+    int32_t usage = 0;                  /* Set when the arguments are not valid */
+    int32_t result = 0;                 /* Exit code */
+    int32_t arg = 1;                    /* Argument counter */
+    int64_t i = 0;                      /* Account counter */
+
+    /* Read the options, each one takes a value */
+    for (arg = 1; (arg < argc) && (usage == 0); arg += 2)
+    {
+        if (arg + 1 >= argc)
+        {
+            usage = 1;
+        }
+        else if (strcmp(argv[arg], "--ops") == 0)
+        {
+            ops = strtoull(argv[arg + 1], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--keys") == 0)
+        {
+            keys = strtoull(argv[arg + 1], NULL, 10);
+            usage = (keys == 0U) ? 1 : 0;
+        }
+        else if (strcmp(argv[arg], "--preload") == 0)
+        {
+            preload = (int64_t)strtoull(argv[arg + 1], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--mix") == 0)
+        {
+            usage = (sscanf(argv[arg + 1], "%u,%u,%u,%u", &mix[0], &mix[1], &mix[2], &mix[3]) != 4 ||
+                     mix[0] + mix[1] + mix[2] + mix[3] == 0U) ? 1 : 0;
+        }
+        else if (strcmp(argv[arg], "--zipf") == 0)
+        {
+            theta = strtod(argv[arg + 1], NULL);
+            usage = (theta < 0.0 || theta >= 1.0) ? 1 : 0;
+        }
+        else if (strcmp(argv[arg], "--invalid") == 0)
+        {
+            invalid = strtod(argv[arg + 1], NULL);
+            usage = (invalid < 0.0 || invalid > 1.0) ? 1 : 0;
+        }
+        else if (strcmp(argv[arg], "--seed") == 0)
+        {
+            seed = strtoull(argv[arg + 1], NULL, 10);
+            usage = (seed == 0U) ? 1 : 0;
+        }
+        else if (strcmp(argv[arg], "--record") == 0)
+        {
+            record_path = argv[arg + 1];
+        }
+        else if (strcmp(argv[arg], "--replay") == 0)
+        {
+            replay_path = argv[arg + 1];
+        }
+        else if (strcmp(argv[arg], "--pace") == 0)
+        {
+            paced = (strcmp(argv[arg + 1], "original") == 0) ? 1 : 0;
+            usage = (paced == 0 && strcmp(argv[arg + 1], "max") != 0) ? 1 : 0;
+        }
+        else
+        {
+            usage = 1;
+        }
+    }
+    if (usage || (replay_path != NULL && record_path != NULL))
+    {
+        printf("Usage: %s [--ops n] [--keys n] [--preload n] [--mix add,remove,search,check]\n"
+               "       [--zipf theta] [--invalid rate] [--seed n] [--record file]\n"
+               "       %s --replay file [--pace max|original]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    RegisterCallback(Count_Rejected);
+    memset(&workload, 0, sizeof(workload));
+
+    if (replay_path != NULL)
+    {
+        result = Load_Trace(&workload, replay_path);
+        if (result == 0)
+        {
+            printf("Replaying %llu operations of '%s', %s\n\n", (unsigned long long)workload.count, replay_path,
+                   (paced) ? "with their original pacing" : "as fast as possible");
+        }
+    }
+    else
+    {
+        preload = (preload < 0) ? (int64_t)(keys / 2U) : preload;
+        if (Generate(&workload, ops, keys, mix, theta, invalid, &seed) == 0)
+        {
+            printf("Error: Memory allocation failed.\n");
+            result = 1;
+        }
+        printf("%llu operations on %llu accounts, %lld preloaded, mix %u,%u,%u,%u, zipf %.2f, %.1f%% invalid\n\n",
+               (unsigned long long)ops, (unsigned long long)keys, (long long)preload, mix[0], mix[1], mix[2],
+               mix[3], theta, invalid * 100.0);
+
+        /* The preload is recorded too, so a replay builds the same list */
+        if (result == 0 && record_path != NULL)
+        {
+            traced = Start_Trace(record_path);
+            if (traced != TRACE_OK)
+            {
+                printf("Error: Cannot create trace '%s': %s.\n", record_path, Trace_Status_Message(traced));
+                result = 1;
+            }
+        }
+        for (i = 0; i < preload && result == 0; i++)
+        {
+            Bench_Make_Account((uint64_t)i, account);
+            Account_Encode(account, (uint32_t)strlen((const char*)account), &key);
+            result = (Add_Account_Key(key) < 0) ? 1 : 0;
+        }
+    }
+
+    times = (uint64_t*)malloc((size_t)(workload.count + 1U) * sizeof(uint64_t));
+    if (result == 0 && times == NULL)
+    {
+        printf("Error: Memory allocation failed.\n");
+        result = 1;
+    }
+    if (result == 0)
+    {
+        elapsed = Run(&workload, paced, times, &differ);
+        result = (Report(&workload, times, elapsed) != 0) ? 0 : 1;
+        printf("\n%llu accounts in the list, %llu rejected by the checks", (unsigned long long)Get_Account_Count(),
+               (unsigned long long)rejected);
+        if (workload.recorded)
+        {
+            printf(", %llu results differ from the trace", (unsigned long long)differ);
+        }
+        printf("\n");
+    }
+
+    traced = Stop_Trace();
+    if (traced != TRACE_OK)
+    {
+        printf("Error: Cannot write trace '%s': %s.\n", record_path, Trace_Status_Message(traced));
+        result = 1;
+    }
+
+    free(times);
+    free(workload.work);
+    free(workload.text);
+
+    return result;
+} /* EOF */
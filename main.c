@@ -17,29 +17,828 @@
 #include <stdio.h>             /* Include standard input and output library for printf, printf, ... */
 #include <string.h>            /* For funtions such as strcpy(), strcmp(), NULL character */
 #include "account_manage.h"    /* Include header file for managing a list of student accounts */
+#include "account_key.h"       /* For Account_Encode() */
+#include "account_reader.h"    /* For reading the accounts without copying them */
+#include "account_server.h"    /* For serving the list over sockets */
+#include "account_dedupe.h"    /* For the parallel import of large files */
+#include "account_export.h"    /* For writing the list to a file */
+#include "account_rules.h"     /* For the validation rules given with --rules */
+#include <signal.h>            /* For stopping the server with Ctrl+C */
+#ifdef _WIN32
+#include <windows.h>           /* For QueryPerformanceCounter() */
+#else
+#include <time.h>              /* For clock_gettime() */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define DEFAULT_COMMIT_COUNT    64U                 /* Changes committed together by default */
+#define DEFAULT_COMMIT_WINDOW   10U                 /* Longest wait of a change before its commit, in ms */
+#define DEFAULT_COMPACT_SIZE    (16U * 1024U * 1024U) /* Journal size that starts a compaction */
+#define ERRORS_NONE             0                   /* The rejected accounts of an import are only counted */
+#define ERRORS_SYNC             1                   /* They are printed at once */
+#define ERRORS_ASYNC            2                   /* They are printed by the thread of a dispatcher */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static Server_t server;         /* This variable is used to stop the server from the signal handler. */
+static account_rules_t* rules;  /* This variable is used to keep the rules given with --rules until the program exits. */
 
 /*******************************************************************************
  * Code
  ******************************************************************************/
+/**
+ * @brief Get the length of a token as passed to the account checks.
+ *
+ * A token longer than 255 bytes would wrap around in a uint8_t, so its length is
+ * clamped, which keeps it LENGHT_INVALID.
+ *
+ * @param token The token.
+ * @return The length of the token, at most UINT8_MAX.
+ */
+static uint8_t Token_Length(const Account_Token_t* token)
+{
+    return (token->length > UINT8_MAX) ? (uint8_t)UINT8_MAX : (uint8_t)token->length;
+}
+
+/**
+ * @brief Get the key of a token for a removal or a search.
+ *
+ * @param token The token.
+ * @return The key of the token, ACCOUNT_KEY_NONE if it cannot be packed into a key.
+ */
+static uint64_t Token_Key(const Account_Token_t* token)
+{
+    uint64_t key = ACCOUNT_KEY_NONE;    /* Key of the token */
+
+    /* Account_Encode() leaves the key untouched when the token cannot be packed */
+    Account_Encode(token->ptr, (token->size < token->length) ? UINT32_MAX : (uint32_t)token->length, &key);
+    return key;
+}
+
+/**
+ * @brief Get the reason of a rejected account, for the import reports.
+ *
+ * @param status The status of the account, not CORRECT.
+ * @return The reason.
+ */
+static const char* Rejection_Reason(status_enum_t status)
+{
+    const char* reason = "account has invalid characters";     /* Reason of the status */
+
+    switch (status)
+    {
+        case LENGHT_INVALID:
+        {
+            reason = (rules == NULL) ? "length of account is more than 10" : "length of account is not accepted";
+            break;
+        }
+        case PREFIX_INVALID:
+        {
+            reason = "account does not start with a required prefix";
+            break;
+        }
+        case SEQUENCE_INVALID:
+        {
+            reason = "account contains a forbidden sequence";
+            break;
+        }
+        case CORRECT:
+        case CHAR_INVALID:
+        case EXPIRED:
+        {
+            break;
+        }
+    }
+
+    return reason;
+}
+
+/**
+ * @brief Print the accounts of an import rejected by the rules given with --rules.
+ *
+ * Only the statuses that were met are printed, so the report of an import with the
+ * built-in rules does not change.
+ *
+ * @param rejected The rejected accounts by status.
+ */
+static void Print_Rule_Rejections(const uint64_t* rejected)
+{
+    if (rejected[PREFIX_INVALID] > 0U)
+    {
+        printf("Rejected (PREFIX_INVALID): %llu\n", (unsigned long long)rejected[PREFIX_INVALID]);
+    }
+    if (rejected[SEQUENCE_INVALID] > 0U)
+    {
+        printf("Rejected (SEQUENCE_INVALID): %llu\n", (unsigned long long)rejected[SEQUENCE_INVALID]);
+    }
+}
+
+/**
+ * @brief Print the rejected accounts of an import delivered by the dispatcher.
+ *
+ * @param reports The reports of the rejected accounts.
+ * @param n The number of reports.
+ * @param user_data Not used.
+ */
+static void Print_Rejections(const Dispatch_Report_t* reports, uint32_t n, void* user_data)
+{
+    uint32_t i = 0;     /* Counter of reports */
+
+    (void)user_data;
+    for (i = 0; i < n; i++)
+    {
+        /* A summary of DISPATCH_COALESCE has no account, rejected accounts are never empty */
+        if (reports[i].length == 0U)
+        {
+            printf("Rejected %llu more accounts (%s), the last at byte %llu\n", (unsigned long long)reports[i].repeats,
+                   Rejection_Reason((status_enum_t)reports[i].status), (unsigned long long)reports[i].offset);
+        }
+        else
+        {
+            printf("Rejected at byte %llu: '%s%s' (%s)\n", (unsigned long long)reports[i].offset,
+                   (const char*)reports[i].token,
+                   (reports[i].length > strlen((const char*)reports[i].token)) ? "..." : "",
+                   Rejection_Reason((status_enum_t)reports[i].status));
+        }
+    }
+}
+
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return The time in ns.
+ */
+static uint64_t Now_Ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;     /* Ticks of the performance counter per second */
+    LARGE_INTEGER counter;              /* Current value of the performance counter */
+
+    if (frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;                /* Current time */
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Import accounts from a file without the menu.
+ *
+ * The file holds one account per line. Each account is checked, skipped if it is already
+ * in the list and added otherwise. Empty lines are ignored. At the end a report with the
+ * number of imported, rejected and duplicate accounts and the elapsed time is printed.
+ * The time is read from the wall clock, so it includes the waits for the input.
+ *
+ * @param path The path of the file, "-" for the standard input.
+ * @param errors ERRORS_NONE to count the rejected accounts only, ERRORS_SYNC to print each one
+ * at once, ERRORS_ASYNC to print them from the thread of a dispatcher.
+ * @param policy What the dispatcher does when its ring is full, for ERRORS_ASYNC.
+ * @return 0 if the file is imported, 1 if it cannot be opened.
+ */
+static int32_t Import_Accounts(const char* path, int32_t errors, dispatch_policy_t policy)
+{
+    FILE* input = stdin;                        /* File the accounts are read from */
+    Account_Reader_t reader;                    /* Reader of the file */
+    Account_Token_t token;                      /* Current account */
+    uint64_t key = 0;                           /* Key of the current account */
+    status_enum_t status = CORRECT;             /* Status of the current account */
+    uint64_t rejected[SEQUENCE_INVALID + 1] = { 0 };    /* Rejected accounts by status */
+    uint64_t imported = 0;                      /* Accounts added to the list */
+    uint64_t duplicates = 0;                    /* Accounts already in the list */
+    uint64_t total = 0;                         /* Accounts read */
+    uint64_t start = Now_Ns();                  /* Start time of the import, in ns */
+    double elapsed = 0.0;                       /* Duration of the import in seconds */
+    int32_t result = 0;                         /* Result of the import */
+    int32_t added = 0;                          /* Result of adding the current account */
+    Dispatcher_t dispatcher;                    /* Delivers the rejected accounts to Print_Rejections() */
+    Dispatch_Config_t config = { policy, DISPATCH_DEFAULT_CAPACITY, DISPATCH_DEFAULT_BATCH };
+    Dispatch_Stats_t delivery;                  /* Counters of the dispatcher */
+    size_t shown = 0;                           /* Bytes of a rejected account printed */
+
+    memset(&dispatcher, 0, sizeof(dispatcher));
+
+    /* Open the file unless the standard input is used */
+    if (strcmp(path, "-") != 0)
+    {
+        input = fopen(path, "rb");
+    }
+
+    if (input == NULL)
+    {
+        printf("Error: Cannot open '%s'.\n", path);
+        result = 1;
+    }
+    else if ((Reader_Open(&reader, input, 0) == 0)
+             || (errors == ERRORS_ASYNC && Dispatch_Start(&dispatcher, &config, Print_Rejections, NULL) == 0))
+    {
+        printf("Error: Memory allocation failed.\n");
+        result = 1;
+    }
+    else
+    {
+        /* Check each account straight from the chunk of the reader */
+        while (Reader_Next(&reader, &token))
+        {
+            total++;
+            /* Check the account and pack it into a key */
+            status = Check_Account_Ctx(NULL, token.ptr, Token_Length(&token), &key);
+            if (status != CORRECT)
+            {
+                rejected[status]++;
+                /* Only the bytes of the reader can be shown, a token may be longer than a chunk */
+                if (errors == ERRORS_SYNC)
+                {
+                    shown = (token.size < token.length) ? token.size : token.length;
+                    shown = (shown < DISPATCH_TOKEN_SIZE) ? shown : DISPATCH_TOKEN_SIZE;
+                    printf("Rejected at byte %llu: '%.*s%s' (%s)\n", (unsigned long long)token.offset, (int)shown,
+                           (const char*)token.ptr, (token.length > shown) ? "..." : "", Rejection_Reason(status));
+                }
+                else if (errors == ERRORS_ASYNC)
+                {
+                    Dispatch_Report(&dispatcher, (uint32_t)status, token.offset, token.ptr,
+                                    (uint32_t)((token.size < token.length) ? token.size : token.length));
+                }
+            }
+            /* Accounts that are already in the list are skipped */
+            else
+            {
+                added = Add_Account_Key(key);
+                imported += (added == 1) ? 1U : 0U;
+                duplicates += (added == 0) ? 1U : 0U;
+            }
+        }
+        Reader_Close(&reader);
+        /* The last rejected accounts are printed before the report */
+        Dispatch_Stop(&dispatcher);
+        Dispatch_Get_Stats(&dispatcher, &delivery);
+
+        /* Print the report */
+        elapsed = (double)(Now_Ns() - start) / 1e9;
+        printf("Imported:                  %llu\n", (unsigned long long)imported);
+        printf("Rejected (CHAR_INVALID):   %llu\n", (unsigned long long)rejected[CHAR_INVALID]);
+        printf("Rejected (LENGHT_INVALID): %llu\n", (unsigned long long)rejected[LENGHT_INVALID]);
+        Print_Rule_Rejections(rejected);
+        printf("Duplicates:                %llu\n", (unsigned long long)duplicates);
+        if (delivery.dropped > 0U)
+        {
+            printf("Reports dropped:           %llu\n", (unsigned long long)delivery.dropped);
+        }
+        printf("Elapsed:                   %.3f s (%.0f accounts/s)\n", elapsed,
+               (elapsed > 0.0) ? (double)total / elapsed : 0.0);
+    }
+
+    if (input != NULL && input != stdin)
+    {
+        fclose(input);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Import accounts from a file with the parallel dedupe stages.
+ *
+ * The result is the same as with Import_Accounts(), but the whole file is read first and
+ * checked and deduplicated on several threads (see account_dedupe.h). The report counts the
+ * duplicates found in the file and those already in the list apart, and gives the time of
+ * each stage. The rejected accounts are printed in input order once the file is checked.
+ *
+ * @param path The path of the file, "-" for the standard input.
+ * @param errors ERRORS_NONE to count the rejected accounts only, any other value to print them.
+ * @param threads The number of threads, 0 for one per processor.
+ * @return 0 if the file is imported, 1 if it cannot be opened, read or held in memory.
+ */
+static int32_t Import_Accounts_Parallel(const char* path, int32_t errors, uint32_t threads)
+{
+    FILE* input = stdin;                        /* File the accounts are read from */
+    Dedupe_Config_t config = { threads, (errors != ERRORS_NONE) ? 1 : 0 };  /* Settings of the import */
+    Dedupe_Stats_t stats;                       /* Results of the import */
+    dedupe_status_t status = DEDUPE_OK;         /* Result of the import */
+    Dispatch_Report_t* reports = NULL;          /* Rejected accounts */
+    uint64_t count = 0;                         /* Number of rejected accounts */
+    uint64_t i = 0;                             /* Report counter */
+    double elapsed = 0.0;                       /* Duration of the import in seconds */
+    int32_t result = 0;                         /* Result of the import */
+
+    /* Open the file unless the standard input is used */
+    if (strcmp(path, "-") != 0)
+    {
+        input = fopen(path, "rb");
+    }
+
+    if (input == NULL)
+    {
+        printf("Error: Cannot open '%s'.\n", path);
+        result = 1;
+    }
+    else
+    {
+        status = Dedupe_Import_File(Get_Account_Store(), input, &config, &stats, &reports, &count);
+        if (status != DEDUPE_OK)
+        {
+            printf("Error: Cannot import '%s': %s.\n", path, Dedupe_Status_Message(status));
+            result = 1;
+        }
+        else
+        {
+            for (i = 0; i < count; i++)
+            {
+                Print_Rejections(&reports[i], 1U, NULL);
+            }
+
+            /* Print the report */
+            elapsed = (double)(stats.load_ns + stats.check_ns + stats.partition_ns + stats.dedupe_ns
+                               + stats.merge_ns) / 1e9;
+            printf("Imported:                  %llu\n", (unsigned long long)stats.added);
+            printf("Rejected (CHAR_INVALID):   %llu\n", (unsigned long long)stats.rejected[CHAR_INVALID]);
+            printf("Rejected (LENGHT_INVALID): %llu\n", (unsigned long long)stats.rejected[LENGHT_INVALID]);
+            Print_Rule_Rejections(stats.rejected);
+            printf("Duplicates:                %llu\n",
+                   (unsigned long long)(stats.batch_duplicates + stats.store_duplicates));
+            printf("  within the file:         %llu\n", (unsigned long long)stats.batch_duplicates);
+            printf("  already in the list:     %llu\n", (unsigned long long)stats.store_duplicates);
+            if (stats.failed > 0U)
+            {
+                printf("Not added (no memory):     %llu\n", (unsigned long long)stats.failed);
+            }
+            printf("Elapsed:                   %.3f s (%.0f accounts/s, %.1f MB/s, %u threads)\n", elapsed,
+                   (elapsed > 0.0) ? (double)stats.accounts / elapsed : 0.0,
+                   (elapsed > 0.0) ? (double)stats.bytes / elapsed / 1e6 : 0.0, stats.threads);
+            printf("  read %.3f s, check %.3f s, partition %.3f s, dedupe %.3f s, merge %.3f s\n",
+                   (double)stats.load_ns / 1e9, (double)stats.check_ns / 1e9, (double)stats.partition_ns / 1e9,
+                   (double)stats.dedupe_ns / 1e9, (double)stats.merge_ns / 1e9);
+        }
+        free(reports);
+    }
+
+    if (input != NULL && input != stdin)
+    {
+        fclose(input);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Save the list of accounts to the snapshot file given on the command line
+ * and close the journal and the trace.
+ *
+ * @param path The path of the snapshot file, NULL if no snapshot is used.
+ * @return 0 if the list is saved or no snapshot is used, 1 if the save failed.
+ */
+static int32_t Save_List(const char* path)
+{
+    int32_t result = 0;                         /* Result of the save */
+    snapshot_status_t status = SNAPSHOT_OK;     /* Result of the snapshot write */
+    journal_status_t closed = JOURNAL_OK;       /* Result of closing the journal */
+    trace_status_t traced = TRACE_OK;           /* Result of closing the trace */
+
+    if (path != NULL)
+    {
+        status = Save_Snapshot(path);
+        if (status != SNAPSHOT_OK)
+        {
+            printf("Error: Cannot save snapshot '%s': %s.\n", path, Snapshot_Status_Message(status));
+            result = 1;
+        }
+    }
+
+    /* The journal is emptied only once the snapshot holds all of its changes */
+    closed = Close_Journal((path != NULL && status == SNAPSHOT_OK) ? 1 : 0);
+    if (closed != JOURNAL_OK)
+    {
+        printf("Error: Cannot close the journal: %s.\n", Journal_Status_Message(closed));
+        result = 1;
+    }
+
+    traced = Stop_Trace();
+    if (traced != TRACE_OK)
+    {
+        printf("Error: Cannot write the trace: %s.\n", Trace_Status_Message(traced));
+        result = 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Write the list of accounts to the file given on the command line.
+ *
+ * @param path The path of the file, "-" for the standard output.
+ * @param format The format of the accounts.
+ * @param sorted 1 for alphabetical order, 0 for display order.
+ * @return 0 if the list is written, 1 if not.
+ */
+static int32_t Export_List(const char* path, export_format_t format, int32_t sorted)
+{
+    int32_t to_stdout = (strcmp(path, "-") == 0) ? 1 : 0;  /* Set when the list goes to the standard output */
+    FILE* output = to_stdout ? stdout : fopen(path, (format == EXPORT_BINARY) ? "wb" : "w");   /* File of the list */
+    export_status_t status = EXPORT_IO_ERROR;   /* Result of the export */
+    uint64_t count = 0;                         /* Number of accounts written */
+
+    /* The list is read at startup, before any other thread uses it */
+    if (output != NULL)
+    {
+        status = Export_Accounts(Get_Account_Store(), output, format, sorted, &count);
+        if ((to_stdout ? fflush(output) : fclose(output)) != 0 && status == EXPORT_OK)
+        {
+            status = EXPORT_IO_ERROR;
+        }
+    }
+
+    if (status != EXPORT_OK)
+    {
+        printf("Error: Cannot export to '%s': %s.\n", path, Export_Status_Message(status));
+    }
+    else if (!to_stdout)
+    {
+        printf("Exported %llu accounts to '%s'.\n", (unsigned long long)count, path);
+    }
+
+    return (status == EXPORT_OK) ? 0 : 1;
+}
+
+/**
+ * @brief Stop the server when the program is interrupted.
+ *
+ * @param signal_number The signal, SIGINT or SIGTERM.
+ */
+static void Stop_Server(int signal_number)
+{
+    (void)signal_number;
+    Server_Stop(&server);
+}
+
+/**
+ * @brief Serve the list over sockets until the program is interrupted.
+ *
+ * @param config The sockets to listen on.
+ * @return 0 if the server stopped normally, 1 if it could not start or its loop failed.
+ */
+static int32_t Serve_Accounts(const Server_Config_t* config)
+{
+    server_status_t status = Server_Open(&server, config);     /* Result of the server functions */
+    int32_t result = 0;                                         /* Result of the serving */
+
+    if (status != SERVER_OK)
+    {
+        printf("Error: Cannot start the server: %s.\n", Server_Status_Message(status));
+        result = 1;
+    }
+    else
+    {
+        printf("Serving on");
+        if (config->unix_path != NULL)
+        {
+            printf(" %s", config->unix_path);
+        }
+        if (config->unix_path != NULL && config->tcp_port != 0U)
+        {
+            printf(" and");
+        }
+        if (config->tcp_port != 0U)
+        {
+            printf(" 127.0.0.1:%u", (unsigned)config->tcp_port);
+        }
+        printf(", press Ctrl+C to stop.\n");
+        fflush(stdout);
+        signal(SIGINT, Stop_Server);
+        signal(SIGTERM, Stop_Server);
+
+        status = Server_Run(&server);
+        if (status != SERVER_OK)
+        {
+            printf("Error: The server failed: %s.\n", Server_Status_Message(status));
+            result = 1;
+        }
+        signal(SIGINT, SIG_DFL);
+        signal(SIGTERM, SIG_DFL);
+        printf("Connections: %llu (%llu rejected), requests: %llu in %llu reads, protocol errors: %llu\n",
+               (unsigned long long)server.stats.connections, (unsigned long long)server.stats.rejected,
+               (unsigned long long)server.stats.requests, (unsigned long long)server.stats.reads,
+               (unsigned long long)server.stats.protocol_errors);
+        Server_Close(&server);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Print an account found by its beginning.
+ *
+ * @param account The account.
+ * @param user_data The number of the previous account, incremented.
+ * @return 1 to receive the next account.
+ */
+static int32_t Print_Match(const int8_t* account, void* user_data)
+{
+    int32_t* number = (int32_t*)user_data;  /* Number of the account */
+
+    (*number)++;
+    printf("%d. %s\n", *number, (const char*)account);
+    return 1;
+}
+
+/**
+ * @brief Write the counters and latency histograms of the list to the file given on
+ * the command line.
+ *
+ * @param path The path of the file, "-" for the standard output, NULL to write nothing.
+ */
+static void Write_Stats(const char* path)
+{
+    FILE* output = stdout;      /* File the statistics are written to */
+
+    if (path != NULL)
+    {
+        /* Open the file unless the standard output is used */
+        if (strcmp(path, "-") != 0)
+        {
+            output = fopen(path, "w");
+        }
+
+        if (output == NULL)
+        {
+            printf("Error: Cannot open '%s'.\n", path);
+        }
+        else
+        {
+            Dump_Account_Stats(output);
+            if (output != stdout)
+            {
+                fclose(output);
+            }
+        }
+    }
+}
+
 /**
  * @brief The main function of the program.
  *
  * This function is the entry point of the program. It initializes the program and
- * starts the main loop.
+ * starts the main loop. The options are:
+ * - "--snapshot <file>" loads the list from the snapshot file at start and saves it
+ *   back at exit. A missing file starts an empty list.
+ * - "--journal <file>" logs every change to the journal file, replays it at start and
+ *   folds it into the snapshot once it is large. It needs "--snapshot".
+ * - "--commit-count <n>" and "--commit-window <ms>" set when the changes logged to the
+ *   journal are forced to the disk: after n changes or ms milliseconds.
+ * - "--import <file>" (or "--import -" for the standard input) imports the accounts
+ *   of the file and exits without showing the menu.
+ * - "--errors <mode>" prints each account rejected by the import. With "sync" it is
+ *   printed at once; with "block", "drop" or "coalesce" it is queued and printed by
+ *   another thread, the mode telling what happens when the queue is full (see
+ *   account_dispatch.h). By default the rejected accounts are only counted.
+ * - "--serve <path>" and "--tcp <port>" serve check, add, remove and search requests on
+ *   a Unix domain socket and on a TCP port of 127.0.0.1 (see account_server.h) instead
+ *   of showing the menu, until the program is interrupted. Either one or both may be given.
+ * - "--bloom-rate <p>" sets the false-positive rate of the filter that answers most
+ *   lookups of absent accounts without the index, 0 turns it off. The default is 0.01.
+ * - "--stats <file>" (or "--stats -" for the standard output) writes the counters and
+ *   latency histograms of the list at exit. They are only collected in a build with
+ *   ACCOUNT_STATS defined.
+ * - "--rules <file>" checks the accounts with the validation rules of the file instead
+ *   of the built-in ones (see account_rules.h), in the menu, the imports and the server.
+ * - "--trace <file>" records the checks, additions, removals and searches of the session
+ *   into the trace file (see account_trace.h), to be replayed by bench_workload.
  *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
  * @return 0 if the program exits successfully.
  */
-int main(void)
+int main(int argc, char** argv)
 {
     int32_t choice = 0;         /* Initialize the choice variable to 0 */
-    int8_t account[10];         /* Initialize the account variable to an array of 10 characters */
+    Account_Reader_t console;   /* Reader of the accounts typed by the user */
+    Account_Token_t token;      /* Account typed by the user */
     status_enum_t status;       /* Initialize the status variable to a status_enum_t type */
+    uint64_t key = 0;           /* Initialize the key of the account to 0 */
+    const char* import_path = NULL;     /* File given with --import */
+    const char* snapshot_path = NULL;   /* File given with --snapshot */
+    const char* journal_path = NULL;    /* File given with --journal */
+    const char* stats_path = NULL;      /* File given with --stats */
+    const char* export_path = NULL;     /* File given with --export */
+    const char* rules_path = NULL;      /* File given with --rules */
+    const char* trace_path = NULL;      /* File given with --trace */
+    trace_status_t traced = TRACE_OK;   /* Result of starting the trace */
+    rules_status_t compiled = RULES_OK; /* Result of compiling the rules */
+    uint32_t line = 0;                  /* Line of the first bad rule */
+    export_format_t export_format = EXPORT_TEXT;    /* Format given with --export-format */
+    int32_t export_sorted = 0;          /* Set by --export-order sorted */
+    int32_t errors = ERRORS_NONE;       /* Mode given with --errors */
+    int64_t threads = -1;               /* Threads given with --threads, -1 to import one account at a time */
+    dispatch_policy_t policy = DISPATCH_BLOCK;  /* Policy given with --errors */
+    Server_Config_t serve = { NULL, 0 };        /* Sockets given with --serve and --tcp */
+    Journal_Config_t journal = { DEFAULT_COMMIT_COUNT, DEFAULT_COMMIT_WINDOW, DEFAULT_COMPACT_SIZE };
+    journal_status_t opened = JOURNAL_OK;   /* Result of opening the journal */
+    snapshot_status_t loaded = SNAPSHOT_OK; /* Result of loading the snapshot */
+    int32_t arg = 1;            /* Counter of the command line arguments */
+    int32_t usage = 0;          /* Set when the command line is not valid */
+    int32_t result = 0;         /* Exit code */
+    int8_t prefix[ACCOUNT_MAX_LENGTH + 2U]; /* Beginning of the accounts to find */
+    uint32_t length = 0;        /* Length of the prefix */
+    int32_t number = 0;         /* Number of the last account found */
+    int64_t found = 0;          /* Number of accounts found */
+    int32_t outcome = 0;        /* Result of the last removal or search */
 
     /* Set the status to CORRECT */
     status = CORRECT;
     /* Register the Show_Error function as a callback */
     RegisterCallback(Show_Error);
 
+    /* Read the options, each one takes a value */
+    for (arg = 1; (arg < argc) && (usage == 0); arg += 2)
+    {
+        if (arg + 1 < argc && strcmp(argv[arg], "--import") == 0)
+        {
+            import_path = argv[arg + 1];
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--snapshot") == 0)
+        {
+            snapshot_path = argv[arg + 1];
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--journal") == 0)
+        {
+            journal_path = argv[arg + 1];
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--commit-count") == 0)
+        {
+            journal.commit_count = (uint32_t)strtoul(argv[arg + 1], NULL, 10);
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--commit-window") == 0)
+        {
+            journal.commit_window_ms = (uint32_t)strtoul(argv[arg + 1], NULL, 10);
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--bloom-rate") == 0)
+        {
+            Set_Bloom_Rate(strtod(argv[arg + 1], NULL));
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--stats") == 0)
+        {
+            stats_path = argv[arg + 1];
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--serve") == 0)
+        {
+            serve.unix_path = argv[arg + 1];
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--tcp") == 0)
+        {
+            serve.tcp_port = (uint16_t)strtoul(argv[arg + 1], NULL, 10);
+            usage = (serve.tcp_port == 0U) ? 1 : 0;
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--rules") == 0)
+        {
+            rules_path = argv[arg + 1];
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--trace") == 0)
+        {
+            trace_path = argv[arg + 1];
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--export") == 0)
+        {
+            export_path = argv[arg + 1];
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--export-format") == 0)
+        {
+            export_format = (strcmp(argv[arg + 1], "binary") == 0) ? EXPORT_BINARY
+                          : ((strcmp(argv[arg + 1], "numbered") == 0) ? EXPORT_NUMBERED : EXPORT_TEXT);
+            usage = (export_format == EXPORT_TEXT && strcmp(argv[arg + 1], "text") != 0) ? 1 : 0;
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--export-order") == 0)
+        {
+            export_sorted = (strcmp(argv[arg + 1], "sorted") == 0) ? 1 : 0;
+            usage = (export_sorted == 0 && strcmp(argv[arg + 1], "display") != 0) ? 1 : 0;
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--threads") == 0)
+        {
+            threads = (int64_t)strtoul(argv[arg + 1], NULL, 10);
+            usage = (threads > (int64_t)DEDUPE_MAX_THREADS) ? 1 : 0;
+        }
+        else if (arg + 1 < argc && strcmp(argv[arg], "--errors") == 0)
+        {
+            errors = (strcmp(argv[arg + 1], "sync") == 0) ? ERRORS_SYNC : ERRORS_ASYNC;
+            policy = (strcmp(argv[arg + 1], "drop") == 0) ? DISPATCH_DROP
+                   : ((strcmp(argv[arg + 1], "coalesce") == 0) ? DISPATCH_COALESCE : DISPATCH_BLOCK);
+            usage = (errors == ERRORS_ASYNC && policy == DISPATCH_BLOCK && strcmp(argv[arg + 1], "block") != 0) ? 1 : 0;
+        }
+        else
+        {
+            usage = 1;
+        }
+    }
+
+    /* Report unknown options, and a journal without a snapshot to fold it into */
+    if (usage || (journal_path != NULL && snapshot_path == NULL))
+    {
+        printf("Usage: %s [--snapshot <file> [--journal <file>] [--commit-count <n>] [--commit-window <ms>]]\n"
+               "       [--import <file>|- [--errors sync|block|drop|coalesce] [--threads <n>]] [--serve <path>] [--tcp <port>]\n"
+               "       [--export <file>|- [--export-format text|numbered|binary] [--export-order display|sorted]]\n"
+               "       [--bloom-rate <p>] [--stats <file>|-] [--rules <file>] [--trace <file>]\n", argv[0]);
+        return 1;
+    }
+
+    /* Check the accounts with the rules of the file */
+    if (rules_path != NULL)
+    {
+        compiled = Rules_Load(rules_path, &rules, &line);
+        if (compiled == RULES_BAD_SPEC)
+        {
+            printf("Error: Cannot load rules '%s': %s on line %u.\n", rules_path, Rules_Status_Message(compiled),
+                   (unsigned)line);
+            return 1;
+        }
+        else if (compiled != RULES_OK)
+        {
+            printf("Error: Cannot load rules '%s': %s.\n", rules_path, Rules_Status_Message(compiled));
+            return 1;
+        }
+        Set_Account_Rules(rules);
+    }
+
+    /* Load the list from the snapshot */
+    if (snapshot_path != NULL)
+    {
+        loaded = Load_Snapshot(snapshot_path, 0);
+        if (loaded == SNAPSHOT_IO_ERROR)
+        {
+            printf("No snapshot '%s' yet, starting with an empty list.\n", snapshot_path);
+        }
+        else if (loaded != SNAPSHOT_OK)
+        {
+            printf("Error: Cannot load snapshot '%s': %s.\n", snapshot_path, Snapshot_Status_Message(loaded));
+            return 1;
+        }
+    }
+
+    /* Apply the changes made after the snapshot and log the next ones */
+    if (journal_path != NULL)
+    {
+        opened = Open_Journal(journal_path, snapshot_path, &journal);
+        if (opened != JOURNAL_OK)
+        {
+            printf("Error: Cannot open journal '%s': %s.\n", journal_path, Journal_Status_Message(opened));
+            return 1;
+        }
+    }
+
+    /* Record the operations of the session */
+    if (trace_path != NULL)
+    {
+        traced = Start_Trace(trace_path);
+        if (traced != TRACE_OK)
+        {
+            printf("Error: Cannot create trace '%s': %s.\n", trace_path, Trace_Status_Message(traced));
+            Close_Journal(0);
+            return 1;
+        }
+    }
+
+    /* Import the accounts of a file, write the list to a file if asked, save the list and exit */
+    if (import_path != NULL)
+    {
+        result = (threads < 0) ? Import_Accounts(import_path, errors, policy)
+                               : Import_Accounts_Parallel(import_path, errors, (uint32_t)threads);
+        if (export_path != NULL && Export_List(export_path, export_format, export_sorted) != 0)
+        {
+            result = 1;
+        }
+        Write_Stats(stats_path);
+        return (Save_List(snapshot_path) != 0) ? 1 : result;
+    }
+
+    /* Write the list to a file, save the list and exit */
+    if (export_path != NULL)
+    {
+        result = Export_List(export_path, export_format, export_sorted);
+        Write_Stats(stats_path);
+        return (Save_List(snapshot_path) != 0) ? 1 : result;
+    }
+
+    /* Serve the list over the sockets until interrupted, save the list and exit */
+    if (serve.unix_path != NULL || serve.tcp_port != 0U)
+    {
+        result = Serve_Accounts(&serve);
+        Write_Stats(stats_path);
+        return (Save_List(snapshot_path) != 0) ? 1 : result;
+    }
+
+    /* Read the accounts typed by the user one line at a time */
+    if (Reader_Open(&console, stdin, 1) == 0)
+    {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
+
     /* Start a do-while loop */
     do
     {
@@ -51,6 +850,8 @@ int main(void)
         printf("| 3. Display list of accounts                          |\n");
         printf("| 4. Find an account in list                           |\n");
         printf("| 5. Exit program                                      |\n");
+        printf("| 6. Display list of accounts in order                 |\n");
+        printf("| 7. Find accounts by their beginning                  |\n");
         printf("|______________________________________________________|\n");
         printf("\n");
 
@@ -70,11 +871,15 @@ int main(void)
                     printf("\nEnter account to add: ");
                     /* Flush the input buffer */
                     fflush(stdin);
-                    /* Read the user's account */
-                    scanf("%s", account);
+                    /* Read the user's account, stop at the end of the input */
+                    if (Reader_Next(&console, &token) == 0)
+                    {
+                        choice = 5;
+                        break;
+                    }
 
-                    /* Check the validity of the user's account */
-                    Check_Account(account, strlen(account));
+                    /* Check the validity of the user's account and pack it into a key */
+                    Check_Account_Key((int8_t*)token.ptr, Token_Length(&token), &key);
 
                     /* Get the status of the user's account */
                     status = Get_Status();
@@ -82,17 +887,30 @@ int main(void)
                 } /* Continue the loop until the account is correct */
                 while (status != CORRECT);
 
-                /* If the account does not exist in the list */
-                if (!Is_Account_Exist(account))
+                /* If the input ended before a correct account was entered */
+                if (status != CORRECT)
                 {
-                    /* Add the account to the list */
-                    Add_Account(account);
-                    printf("\nAdded account '%s' to your list . . .\n", account);
+                    break;
                 }
-                /* If the account already exists in the list */
-                else
+                /* Add the account to the list unless it already exists */
+                switch (Add_Account_Key(key))
                 {
-                    printf("\nError: Account is already exists. Please enter another account!!!\n");
+                    case 1:
+                    {
+                        printf("\nAdded account '%.*s' to your list . . .\n", (int)token.size, token.ptr);
+                        break;
+                    }
+                    /* If the account already exists in the list */
+                    case 0:
+                    {
+                        printf("\nError: Account is already exists. Please enter another account!!!\n");
+                        break;
+                    }
+                    /* Add_Account_Key() already reported the failed allocation */
+                    default:
+                    {
+                        break;
+                    }
                 }
                 /* Clear the console screen */
                 clear_console();
@@ -104,17 +922,23 @@ int main(void)
                 printf("\nEnter account to remove: ");
                 /* Flush the input buffer */
                 fflush(stdin);
-                /* Read the user's account */
-                scanf("%s", account);
+                /* Read the user's account, stop at the end of the input */
+                if (Reader_Next(&console, &token) == 0)
+                {
+                    choice = 5;
+                    break;
+                }
+                /* Remove the account once, then report the result */
+                outcome = Remove_Account_Key(Token_Key(&token));
                 /* If the account is successfully removed */
-                if (Remove_Account(account) == 1)
+                if (outcome == 1)
                 {
-                    printf("\nDeleted account '%s' from your list . . .\n", account);
+                    printf("\nDeleted account '%.*s' from your list . . .\n", (int)token.size, token.ptr);
                 }
                 /* If the account is not found in the list */
-                else if (Remove_Account(account) == 0)
+                else if (outcome == 0)
                 {
-                    printf("\nError: Account '%s' not found in your list!!!\n", account);
+                    printf("\nError: Account '%.*s' not found in your list!!!\n", (int)token.size, token.ptr);
                 }
                 /* If the user has not created any account yet */
                 else
@@ -141,17 +965,23 @@ int main(void)
                 printf("\nEnter account that you want to search: ");
                 /* Flush the input buffer */
                 fflush(stdin);
-                /* Read the user's account */
-                scanf("%s", account);
+                /* Read the user's account, stop at the end of the input */
+                if (Reader_Next(&console, &token) == 0)
+                {
+                    choice = 5;
+                    break;
+                }
+                /* Search for the account once, then report the result */
+                outcome = Search_Account_Key(Token_Key(&token));
                 /* If the account is found in the list */
-                if (Search_Account(account) == 1)
+                if (outcome == 1)
                 {
-                    printf("\nAccount '%s' is found in list . . .\n", account);
+                    printf("\nAccount '%.*s' is found in list . . .\n", (int)token.size, token.ptr);
                 }
                 /* If the account is not found in the list */
-                else if (Search_Account(account) == 0)
+                else if (outcome == 0)
                 {
-                    printf("\nAccount '%s' is not in list . . .\n", account);
+                    printf("\nAccount '%.*s' is not in list . . .\n", (int)token.size, token.ptr);
                 }
                 /* If the user has not created any account yet */
                 else
@@ -170,7 +1000,48 @@ int main(void)
                 /* Exit the switch statement */
                 break;
             }
-            /* If the user's choice is not 1, 2, 3, 4, or 5 */
+            case 6:
+            {
+                /* Display the accounts in alphabetical order */
+                Display_Sorted_Accounts();
+                /* Clear the console screen */
+                clear_console();
+                /* Exit the switch statement */
+                break;
+            }
+            case 7:
+            {
+                printf("\nEnter the beginning of the accounts to find: ");
+                /* Flush the input buffer */
+                fflush(stdin);
+                /* Read the prefix, stop at the end of the input */
+                if (Reader_Next(&console, &token) == 0)
+                {
+                    choice = 5;
+                    break;
+                }
+                /* Keep one character more than an account can hold, so a long prefix stays invalid */
+                length = (token.size > ACCOUNT_MAX_LENGTH) ? (ACCOUNT_MAX_LENGTH + 1U) : (uint32_t)token.size;
+                memcpy(prefix, token.ptr, length);
+                prefix[length] = '\0';
+
+                printf("\n");
+                number = 0;
+                found = Search_Accounts_Prefix(prefix, Print_Match, &number);
+                if (found < 0)
+                {
+                    printf("Error: No account can start with '%s'!!!\n", (char*)prefix);
+                }
+                else
+                {
+                    printf("%lld account(s) start with '%s' . . .\n", (long long)found, (char*)prefix);
+                }
+                /* Clear the console screen */
+                clear_console();
+                /* Exit the switch statement */
+                break;
+            }
+            /* If the user's choice is not between 1 and 7 */
             default:
             {
                 printf("\nYour input is not valid!!!\n\n");
@@ -183,7 +1054,12 @@ int main(void)
     } /* Continue the loop until the user chooses to exit */
     while (choice != 5);
 
-    /* Return 0 to indicate successful execution */
-    return 0;
+    /* Release the reader of the console */
+    Reader_Close(&console);
+
+    Write_Stats(stats_path);
+
+    /* Save the list to the snapshot, return 0 to indicate successful execution */
+    return Save_List(snapshot_path);
 } /* EOF */
 